@@ -0,0 +1,72 @@
+// Boost.Geometry Index
+//
+// Quickbook Examples
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+//[rtree_mapped_flat_rtree
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/flat_rtree.hpp>
+#include <boost/geometry/index/mapped_rtree.hpp>
+
+namespace bi = boost::interprocess;
+namespace bg = boost::geometry;
+namespace bgm = bg::model;
+namespace bgi = bg::index;
+
+int main()
+{
+    typedef bgm::point<float, 2, bg::cs::cartesian> point_t;
+    typedef bgm::box<point_t> box_t;
+
+    typedef std::pair<box_t, unsigned> value_t;
+    typedef bgi::rstar<16> params_t;
+
+    // create the index and save its image in the file
+    {
+        std::vector<value_t> values;
+        for ( unsigned i = 0 ; i < 10 ; ++i )
+        {
+            box_t b(point_t(i + 0.0f, i + 0.0f), point_t(i + 0.5f, i + 0.5f));
+            values.push_back(std::make_pair(b, i));
+        }
+
+        bgi::flat_rtree<value_t, params_t> tree(values);
+
+        std::ofstream file("rtree.bin", std::ios::binary);
+        tree.save(file);
+    }
+
+    // map the file into memory and query the index in place
+    {
+        bi::file_mapping file("rtree.bin", bi::read_only);
+        bi::mapped_region region(file, bi::read_only);
+
+        bgi::mapped_rtree<value_t, params_t> tree(region.get_address(), region.get_size());
+
+        std::cout << tree.size() << std::endl;
+
+        std::vector<value_t> result;
+        tree.query(bgi::nearest(point_t(0, 0), 3), std::back_inserter(result));
+
+        std::cout << result.size() << std::endl;
+    }
+
+    return 0;
+}
+
+//]
@@ -124,7 +124,10 @@ private:
 
         geometry::partition
             <
-                geometry::model::box<typename point_type<MultiPolygon>::type>
+                geometry::model::box<typename point_type<MultiPolygon>::type>,
+                detail::partition::include_all_policy,
+                detail::partition::include_all_policy,
+                detail::partition::adaptive_backend
             >::apply(polygon_iterators, item_visitor,
                      typename base::template expand_box<Strategy>(strategy),
                      typename base::template overlaps_box<Strategy>(strategy));
@@ -153,6 +153,7 @@ protected:
     {
         explicit partition_item(Iterator it)
             : m_it(it)
+            , m_box()
             , m_is_initialized(false)
         {}
 
@@ -326,7 +327,10 @@ protected:
 
         geometry::partition
             <
-                box_type
+                box_type,
+                detail::partition::include_all_policy,
+                detail::partition::include_all_policy,
+                detail::partition::adaptive_backend
             >::apply(ring_iterators, item_visitor,
                      expand_box<Strategy>(strategy),
                      overlaps_box<Strategy>(strategy));
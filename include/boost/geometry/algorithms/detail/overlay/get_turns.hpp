@@ -15,9 +15,12 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_GET_TURNS_HPP
 
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <iterator>
 #include <map>
+#include <vector>
 
 #include <boost/concept_check.hpp>
 #include <boost/core/ignore_unused.hpp>
@@ -496,6 +499,30 @@ struct section_visitor
 
 };
 
+// The sections of a geometry used to find its turns. Specialized for
+// geometries caching their sections, e.g. prepared geometries, which may
+// return only the sections overlapping the sections of the other geometry.
+template <bool Reverse, typename Geometry>
+struct geometry_sections
+{
+    static const bool cached = false;
+
+    template <typename RobustPolicy, typename Strategy, typename Sections>
+    static inline Sections const& apply(Geometry const& geometry,
+                                        RobustPolicy const& robust_policy,
+                                        Strategy const& strategy,
+                                        Sections& sections,
+                                        int source_index,
+                                        Sections const* )
+    {
+        typedef std::integer_sequence<std::size_t, 0, 1> dimensions;
+
+        geometry::sectionalize<Reverse, dimensions>(geometry, robust_policy,
+                                                    sections, strategy, source_index);
+        return sections;
+    }
+};
+
 template
 <
     typename Geometry1, typename Geometry2,
@@ -504,6 +531,60 @@ template
 >
 class get_turns_generic
 {
+    template <typename Turns, typename RobustPolicy>
+    using box_type_of = model::box
+        <
+            typename geometry::robust_point_type
+                <
+                    typename boost::range_value<Turns>::type::point_type,
+                    RobustPolicy
+                >::type
+        >;
+
+    template <typename Strategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    using visitor_type_of = section_visitor
+        <
+            Geometry1, Geometry2,
+            Reverse1, Reverse2,
+            TurnPolicy,
+            Strategy, RobustPolicy,
+            Turns, InterruptPolicy
+        >;
+
+    // The same partition is used by apply() and apply_parallel() so both
+    // generate the turns in the same order.
+    template <typename Box>
+    using partition_type_of = geometry::partition<Box>;
+
+    // The cached sections are created after the sections of the other
+    // geometry so they can be limited to the ones overlapping them
+    template <typename Sections, typename Strategy, typename RobustPolicy>
+    static inline void sections_of(Geometry1 const& geometry1,
+                                   Geometry2 const& geometry2,
+                                   Strategy const& strategy,
+                                   RobustPolicy const& robust_policy,
+                                   Sections& storage1, Sections& storage2,
+                                   Sections const*& sec1, Sections const*& sec2)
+    {
+        typedef geometry_sections<Reverse1, Geometry1> sections1;
+        typedef geometry_sections<Reverse2, Geometry2> sections2;
+        Sections const* const none = nullptr;
+
+        if (sections1::cached && ! sections2::cached)
+        {
+            sec2 = &sections2::apply(geometry2, robust_policy, strategy,
+                                     storage2, 1, none);
+            sec1 = &sections1::apply(geometry1, robust_policy, strategy,
+                                     storage1, 0, sec2);
+        }
+        else
+        {
+            sec1 = &sections1::apply(geometry1, robust_policy, strategy,
+                                     storage1, 0, none);
+            sec2 = &sections2::apply(geometry2, robust_policy, strategy,
+                                     storage2, 1, sec1);
+        }
+    }
 
 public:
     template <typename Strategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
@@ -516,46 +597,149 @@ public:
             InterruptPolicy& interrupt_policy)
     {
         // First create monotonic sections...
-        typedef typename boost::range_value<Turns>::type ip_type;
-        typedef typename ip_type::point_type point_type;
-
-        typedef model::box
-            <
-                typename geometry::robust_point_type
-                <
-                    point_type, RobustPolicy
-                >::type
-            > box_type;
+        typedef box_type_of<Turns, RobustPolicy> box_type;
         typedef geometry::sections<box_type, 2> sections_type;
 
-        sections_type sec1, sec2;
-        typedef std::integer_sequence<std::size_t, 0, 1> dimensions;
-
-        geometry::sectionalize<Reverse1, dimensions>(geometry1, robust_policy,
-                                                     sec1, strategy, 0);
-        geometry::sectionalize<Reverse2, dimensions>(geometry2, robust_policy,
-                                                     sec2, strategy, 1);
+        sections_type storage1, storage2;
+        sections_type const* sec1 = nullptr;
+        sections_type const* sec2 = nullptr;
+        sections_of(geometry1, geometry2, strategy, robust_policy,
+                    storage1, storage2, sec1, sec2);
 
         // ... and then partition them, intersecting overlapping sections in visitor method
-        section_visitor
+        visitor_type_of
             <
-                Geometry1, Geometry2,
-                Reverse1, Reverse2,
-                TurnPolicy,
-                Strategy, RobustPolicy,
-                Turns, InterruptPolicy
+                Strategy, RobustPolicy, Turns, InterruptPolicy
             > visitor(source_id1, geometry1, source_id2, geometry2,
                       strategy, robust_policy, turns, interrupt_policy);
 
-        geometry::partition
+        partition_type_of<box_type>::apply(*sec1, *sec2, visitor,
+            detail::section::get_section_box<Strategy>(strategy),
+            detail::section::overlaps_section_box<Strategy>(strategy));
+    }
+
+    // Parallel version. The pairs of overlapping sections are divided into
+    // 4 x executor.concurrency() parts, each part collecting its turns in its
+    // own container. Then the turns are appended in the order of the parts,
+    // so in the same order as in the sequential version.
+    // Interrupting policies may keep a state checked by the caller so they
+    // are handled by the sequential version.
+    template
+    <
+        typename Strategy, typename RobustPolicy,
+        typename Turns, typename InterruptPolicy,
+        typename Executor
+    >
+    static inline void apply_parallel(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            Strategy const& strategy,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            Executor const& executor)
+    {
+        if (InterruptPolicy::enabled)
+        {
+            apply(source_id1, geometry1, source_id2, geometry2,
+                  strategy, robust_policy, turns, interrupt_policy);
+            return;
+        }
+
+        typedef box_type_of<Turns, RobustPolicy> box_type;
+        typedef geometry::sections<box_type, 2> sections_type;
+        typedef visitor_type_of
             <
-                box_type
-            >::apply(sec1, sec2, visitor,
-                     detail::section::get_section_box<Strategy>(strategy),
-                     detail::section::overlaps_section_box<Strategy>(strategy));
+                Strategy, RobustPolicy, Turns, InterruptPolicy
+            > visitor_type;
+
+        sections_type storage1, storage2;
+        sections_type const* sec1 = nullptr;
+        sections_type const* sec2 = nullptr;
+        sections_of(geometry1, geometry2, strategy, robust_policy,
+                    storage1, storage2, sec1, sec2);
+
+        std::size_t const parts_count
+            = 4 * (std::max)(executor.concurrency(), std::size_t(1));
+        std::vector<Turns> parts_turns(parts_count);
+        std::vector<visitor_type> visitors;
+        visitors.reserve(parts_count);
+        for (auto& part_turns : parts_turns)
+        {
+            visitors.emplace_back(source_id1, geometry1, source_id2, geometry2,
+                                  strategy, robust_policy, part_turns,
+                                  interrupt_policy);
+        }
+
+        partition_type_of<box_type>::apply_parallel(*sec1, *sec2, visitors,
+            detail::section::get_section_box<Strategy>(strategy),
+            detail::section::overlaps_section_box<Strategy>(strategy),
+            detail::section::get_section_box<Strategy>(strategy),
+            detail::section::overlaps_section_box<Strategy>(strategy),
+            executor);
+
+        for (auto& part_turns : parts_turns)
+        {
+            std::move(boost::begin(part_turns), boost::end(part_turns),
+                      std::back_inserter(turns));
+        }
     }
 };
 
+// Calls apply_parallel of the dispatched get_turns if it is defined,
+// otherwise the turns are calculated sequentially.
+template
+<
+    typename Dispatch,
+    typename Geometry1, typename Geometry2,
+    typename Strategy, typename RobustPolicy,
+    typename Turns, typename InterruptPolicy,
+    typename Executor
+>
+inline auto apply_parallel(int source_id1, Geometry1 const& geometry1,
+                           int source_id2, Geometry2 const& geometry2,
+                           Strategy const& strategy,
+                           RobustPolicy const& robust_policy,
+                           Turns& turns,
+                           InterruptPolicy& interrupt_policy,
+                           Executor const& executor,
+                           int)
+    -> decltype(Dispatch::apply_parallel(source_id1, geometry1,
+                                         source_id2, geometry2,
+                                         strategy, robust_policy,
+                                         turns, interrupt_policy,
+                                         executor))
+{
+    return Dispatch::apply_parallel(source_id1, geometry1,
+                                    source_id2, geometry2,
+                                    strategy, robust_policy,
+                                    turns, interrupt_policy,
+                                    executor);
+}
+
+template
+<
+    typename Dispatch,
+    typename Geometry1, typename Geometry2,
+    typename Strategy, typename RobustPolicy,
+    typename Turns, typename InterruptPolicy,
+    typename Executor
+>
+inline void apply_parallel(int source_id1, Geometry1 const& geometry1,
+                           int source_id2, Geometry2 const& geometry2,
+                           Strategy const& strategy,
+                           RobustPolicy const& robust_policy,
+                           Turns& turns,
+                           InterruptPolicy& interrupt_policy,
+                           Executor const& ,
+                           long)
+{
+    Dispatch::apply(source_id1, geometry1,
+                    source_id2, geometry2,
+                    strategy, robust_policy,
+                    turns, interrupt_policy);
+}
+
 
 // Get turns for a range with a box, following Cohen-Sutherland (cs) approach
 template
@@ -1054,6 +1238,34 @@ struct get_turns_reversed
                      strategy, robust_policy,
                      turns, interrupt_policy);
     }
+
+    template
+    <
+        typename Strategy, typename RobustPolicy,
+        typename Turns, typename InterruptPolicy,
+        typename Executor
+    >
+    static inline void apply_parallel(int source_id1, Geometry1 const& g1,
+                                      int source_id2, Geometry2 const& g2,
+                                      Strategy const& strategy,
+                                      RobustPolicy const& robust_policy,
+                                      Turns& turns,
+                                      InterruptPolicy& interrupt_policy,
+                                      Executor const& executor)
+    {
+        detail::get_turns::apply_parallel
+            <
+                get_turns
+                    <
+                        GeometryTag2, GeometryTag1,
+                        Geometry2, Geometry1,
+                        Reverse2, Reverse1,
+                        TurnPolicy
+                    >
+            >(source_id2, g2, source_id1, g1,
+              strategy, robust_policy,
+              turns, interrupt_policy, executor, 0);
+    }
 };
 
 
@@ -1125,6 +1337,83 @@ inline void get_turns(Geometry1 const& geometry1,
                  turns, interrupt_policy);
 }
 
+/*!
+\brief \brief_calc2{turn points}, in parallel
+\ingroup overlay
+\details The overlapping pairs of monotonic sections of the geometries are
+    divided into parts visited concurrently by the executor, each part
+    collecting its own turns. The turns of the parts are appended in the
+    order of the parts so the result is the same as the result of the
+    sequential version. The geometries for which the turns are not calculated
+    from sections (e.g. a polygon and a box) and interrupting policies are
+    handled sequentially.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Turns type of turn-container (e.g. vector of "intersection/turn point"'s)
+\tparam Executor Executor type, e.g. util::thread_executor
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param intersection_strategy segments intersection strategy
+\param robust_policy policy to handle robustness issues
+\param turns container which will contain turn points
+\param interrupt_policy policy determining if process is stopped
+    when intersection is found
+\param executor executor calling the parts of the work
+ */
+template
+<
+    bool Reverse1, bool Reverse2,
+    typename AssignPolicy,
+    typename Geometry1,
+    typename Geometry2,
+    typename Strategy,
+    typename RobustPolicy,
+    typename Turns,
+    typename InterruptPolicy,
+    typename Executor
+>
+inline void get_turns(Geometry1 const& geometry1,
+                      Geometry2 const& geometry2,
+                      Strategy const& strategy,
+                      RobustPolicy const& robust_policy,
+                      Turns& turns,
+                      InterruptPolicy& interrupt_policy,
+                      Executor const& executor)
+{
+    concepts::check_concepts_and_equal_dimensions<Geometry1 const, Geometry2 const>();
+
+    typedef detail::overlay::get_turn_info<AssignPolicy> TurnPolicy;
+
+    detail::get_turns::apply_parallel
+        <
+            std::conditional_t
+                <
+                    reverse_dispatch<Geometry1, Geometry2>::type::value,
+                    dispatch::get_turns_reversed
+                    <
+                        typename tag<Geometry1>::type,
+                        typename tag<Geometry2>::type,
+                        Geometry1, Geometry2,
+                        Reverse1, Reverse2,
+                        TurnPolicy
+                    >,
+                    dispatch::get_turns
+                    <
+                        typename tag<Geometry1>::type,
+                        typename tag<Geometry2>::type,
+                        Geometry1, Geometry2,
+                        Reverse1, Reverse2,
+                        TurnPolicy
+                    >
+                >
+        >(0, geometry1,
+          1, geometry2,
+          strategy,
+          robust_policy,
+          turns, interrupt_policy,
+          executor, 0);
+}
+
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
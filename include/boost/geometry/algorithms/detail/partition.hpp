@@ -17,18 +17,25 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_PARTITION_HPP
 
 
+#include <atomic>
 #include <cstddef>
+#include <limits>
 #include <type_traits>
 #include <vector>
 
 #include <boost/range/begin.hpp>
 #include <boost/range/empty.hpp>
 #include <boost/range/end.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <boost/range/size.hpp>
 
 #include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/algorithms/detail/partition_sweep.hpp>
 #include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_system.hpp>
 #include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/static_assert.hpp>
+#include <boost/geometry/core/tags.hpp>
 
 
 namespace boost { namespace geometry
@@ -201,6 +208,90 @@ inline bool handle_two(IteratorVector1 const& input1,
     return true;
 }
 
+// The lowest level matches collected by the recursive partition instead of
+// visiting the pairs of items, used to visit them in parallel later.
+// The items of the matches are stored in two flat vectors.
+template <typename Iterator1, typename Iterator2>
+struct partition_tasks
+{
+    struct task
+    {
+        std::size_t first1, last1;
+        std::size_t first2, last2;
+        std::size_t cost;
+        bool one;
+    };
+
+    template <typename IteratorVector>
+    inline void add_one(IteratorVector const& input)
+    {
+        std::size_t const first = items1.size();
+        items1.insert(items1.end(), boost::begin(input), boost::end(input));
+        std::size_t const count = items1.size() - first;
+        task const t = { first, items1.size(), 0, 0, count * (count - 1) / 2, true };
+        tasks.push_back(t);
+    }
+
+    template <typename IteratorVector1, typename IteratorVector2>
+    inline void add_two(IteratorVector1 const& input1, IteratorVector2 const& input2)
+    {
+        std::size_t const first1 = items1.size();
+        std::size_t const first2 = items2.size();
+        items1.insert(items1.end(), boost::begin(input1), boost::end(input1));
+        items2.insert(items2.end(), boost::begin(input2), boost::end(input2));
+        std::size_t const cost = (items1.size() - first1) * (items2.size() - first2);
+        task const t = { first1, items1.size(), first2, items2.size(), cost, false };
+        tasks.push_back(t);
+    }
+
+    template <typename VisitPolicy>
+    inline bool visit(task const& t, VisitPolicy& visitor) const
+    {
+        return t.one
+             ? handle_one(boost::make_iterator_range(items1.begin() + t.first1,
+                                                     items1.begin() + t.last1),
+                          visitor)
+             : handle_two(boost::make_iterator_range(items1.begin() + t.first1,
+                                                     items1.begin() + t.last1),
+                          boost::make_iterator_range(items2.begin() + t.first2,
+                                                     items2.begin() + t.last2),
+                          visitor);
+    }
+
+    std::vector<Iterator1> items1;
+    std::vector<Iterator2> items2;
+    std::vector<task> tasks;
+};
+
+template <typename IteratorVector, typename Iterator1, typename Iterator2>
+inline bool handle_one(IteratorVector const& input,
+                       partition_tasks<Iterator1, Iterator2>& tasks)
+{
+    if (boost::size(input) > 1)
+    {
+        tasks.add_one(input);
+    }
+    return true;
+}
+
+template
+<
+    typename IteratorVector1,
+    typename IteratorVector2,
+    typename Iterator1,
+    typename Iterator2
+>
+inline bool handle_two(IteratorVector1 const& input1,
+                       IteratorVector2 const& input2,
+                       partition_tasks<Iterator1, Iterator2>& tasks)
+{
+    if (! boost::empty(input1) && ! boost::empty(input2))
+    {
+        tasks.add_two(input1, input2);
+    }
+    return true;
+}
+
 template <typename IteratorVector>
 inline bool recurse_ok(IteratorVector const& input,
                        std::size_t min_elements, std::size_t level)
@@ -587,13 +678,294 @@ public :
 };
 
 
+// The algorithms used by partition to find the pairs of items
+// Each backend visits the pairs in a different order. The algorithms whose
+// results depend on this order, e.g. the order of turns and so the results
+// of overlay, have to use the default recursive_backend. The others, e.g.
+// checking if the rings are disjoint, may use the sweep which also handles
+// many long and thin items the recursion can't separate.
+
+// Recursive division of the total box into halves on alternating dimensions
+struct recursive_backend {};
+
+// Sort-based plane sweep along the dimension with the least number of pairs
+// of items overlapping along it, see partition_sweep.hpp.
+// Only for cartesian boxes, for other coordinate systems recursive_backend
+// is used because the boxes can wrap around the antimeridian.
+struct sweep_backend {};
+
+// The plane sweep if the number of pairs checked by it is small compared to
+// the number of items, e.g. for items clustered in a tiny part of the total
+// box, the recursive partition otherwise
+struct adaptive_backend {};
+
+template
+<
+    typename Backend,
+    typename Box,
+    typename CSTag = typename geometry::cs_tag<Box>::type
+>
+struct partition_backend
+    : partition_backend<recursive_backend, Box, CSTag>
+{};
+
+template <typename Box, typename CSTag>
+struct partition_backend<recursive_backend, Box, CSTag>
+{
+    template
+    <
+        typename IteratorVector,
+        typename VisitPolicy,
+        typename ExpandPolicy,
+        typename OverlapsPolicy,
+        typename VisitBoxPolicy
+    >
+    static inline bool apply(Box const& total,
+                             IteratorVector const& input,
+                             std::size_t min_elements,
+                             VisitPolicy& visitor,
+                             ExpandPolicy const& expand_policy,
+                             OverlapsPolicy const& overlaps_policy,
+                             VisitBoxPolicy& box_policy)
+    {
+        return partition_one_range
+            <
+                0, Box
+            >::apply(total, input, 0, min_elements,
+                     visitor, expand_policy, overlaps_policy, box_policy);
+    }
+
+    template
+    <
+        typename IteratorVector1,
+        typename IteratorVector2,
+        typename VisitPolicy,
+        typename ExpandPolicy1,
+        typename OverlapsPolicy1,
+        typename ExpandPolicy2,
+        typename OverlapsPolicy2,
+        typename VisitBoxPolicy
+    >
+    static inline bool apply(Box const& total,
+                             IteratorVector1 const& input1,
+                             IteratorVector2 const& input2,
+                             std::size_t min_elements,
+                             VisitPolicy& visitor,
+                             ExpandPolicy1 const& expand_policy1,
+                             OverlapsPolicy1 const& overlaps_policy1,
+                             ExpandPolicy2 const& expand_policy2,
+                             OverlapsPolicy2 const& overlaps_policy2,
+                             VisitBoxPolicy& box_policy)
+    {
+        return partition_two_ranges
+            <
+                0, Box
+            >::apply(total, input1, input2, 0, min_elements,
+                     visitor, expand_policy1, overlaps_policy1,
+                     expand_policy2, overlaps_policy2, box_policy);
+    }
+};
+
+template <typename Box>
+struct partition_backend<sweep_backend, Box, cartesian_tag>
+{
+    template
+    <
+        typename IteratorVector,
+        typename VisitPolicy,
+        typename ExpandPolicy,
+        typename OverlapsPolicy,
+        typename VisitBoxPolicy
+    >
+    static inline bool apply(Box const& total,
+                             IteratorVector const& input,
+                             std::size_t ,
+                             VisitPolicy& visitor,
+                             ExpandPolicy const& expand_policy,
+                             OverlapsPolicy const& overlaps_policy,
+                             VisitBoxPolicy& box_policy)
+    {
+        box_policy.apply(total, 0);
+
+        auto items = make_sweep_items<Box>(input, expand_policy);
+        prepare_sweep(items, (std::numeric_limits<std::size_t>::max)());
+        return sweep_one(items, visitor, overlaps_policy);
+    }
+
+    template
+    <
+        typename IteratorVector1,
+        typename IteratorVector2,
+        typename VisitPolicy,
+        typename ExpandPolicy1,
+        typename OverlapsPolicy1,
+        typename ExpandPolicy2,
+        typename OverlapsPolicy2,
+        typename VisitBoxPolicy
+    >
+    static inline bool apply(Box const& total,
+                             IteratorVector1 const& input1,
+                             IteratorVector2 const& input2,
+                             std::size_t ,
+                             VisitPolicy& visitor,
+                             ExpandPolicy1 const& expand_policy1,
+                             OverlapsPolicy1 const& overlaps_policy1,
+                             ExpandPolicy2 const& expand_policy2,
+                             OverlapsPolicy2 const& overlaps_policy2,
+                             VisitBoxPolicy& box_policy)
+    {
+        box_policy.apply(total, 0);
+
+        auto items1 = make_sweep_items<Box>(input1, expand_policy1);
+        auto items2 = make_sweep_items<Box>(input2, expand_policy2);
+        prepare_sweep(items1, items2, (std::numeric_limits<std::size_t>::max)());
+        return sweep_two(items1, items2, visitor,
+                         overlaps_policy1, overlaps_policy2);
+    }
+};
+
+template <typename Box>
+struct partition_backend<adaptive_backend, Box, cartesian_tag>
+{
+    // The max average number of pairs per item checked by the sweep
+    static const std::size_t max_pairs_per_item = 16;
+
+    template
+    <
+        typename IteratorVector,
+        typename VisitPolicy,
+        typename ExpandPolicy,
+        typename OverlapsPolicy,
+        typename VisitBoxPolicy
+    >
+    static inline bool apply(Box const& total,
+                             IteratorVector const& input,
+                             std::size_t min_elements,
+                             VisitPolicy& visitor,
+                             ExpandPolicy const& expand_policy,
+                             OverlapsPolicy const& overlaps_policy,
+                             VisitBoxPolicy& box_policy)
+    {
+        auto items = make_sweep_items<Box>(input, expand_policy);
+        std::size_t const max_cost = items.size() * max_pairs_per_item;
+        if (prepare_sweep(items, max_cost) > max_cost)
+        {
+            return partition_backend<recursive_backend, Box>::apply(total,
+                        input, min_elements, visitor,
+                        expand_policy, overlaps_policy, box_policy);
+        }
+
+        box_policy.apply(total, 0);
+        return sweep_one(items, visitor, overlaps_policy);
+    }
+
+    template
+    <
+        typename IteratorVector1,
+        typename IteratorVector2,
+        typename VisitPolicy,
+        typename ExpandPolicy1,
+        typename OverlapsPolicy1,
+        typename ExpandPolicy2,
+        typename OverlapsPolicy2,
+        typename VisitBoxPolicy
+    >
+    static inline bool apply(Box const& total,
+                             IteratorVector1 const& input1,
+                             IteratorVector2 const& input2,
+                             std::size_t min_elements,
+                             VisitPolicy& visitor,
+                             ExpandPolicy1 const& expand_policy1,
+                             OverlapsPolicy1 const& overlaps_policy1,
+                             ExpandPolicy2 const& expand_policy2,
+                             OverlapsPolicy2 const& overlaps_policy2,
+                             VisitBoxPolicy& box_policy)
+    {
+        auto items1 = make_sweep_items<Box>(input1, expand_policy1);
+        auto items2 = make_sweep_items<Box>(input2, expand_policy2);
+        std::size_t const max_cost = (items1.size() + items2.size())
+                                   * max_pairs_per_item;
+        if (prepare_sweep(items1, items2, max_cost) > max_cost)
+        {
+            return partition_backend<recursive_backend, Box>::apply(total,
+                        input1, input2, min_elements, visitor,
+                        expand_policy1, overlaps_policy1,
+                        expand_policy2, overlaps_policy2, box_policy);
+        }
+
+        box_policy.apply(total, 0);
+        return sweep_two(items1, items2, visitor,
+                         overlaps_policy1, overlaps_policy2);
+    }
+};
+
+// Divides the tasks into contiguous parts of similar cost, one part per
+// visitor, and visits the parts concurrently. Each part is visited in the
+// order of the tasks so visiting the parts one after another with the same
+// visitor would give the same sequence of pairs as the sequential partition.
+template <typename Tasks, typename Visitors, typename Executor>
+inline bool visit_tasks(Tasks const& tasks, Visitors& visitors,
+                        Executor const& executor)
+{
+    std::size_t const parts_count = boost::size(visitors);
+    std::size_t const tasks_count = tasks.tasks.size();
+    if (parts_count == 0 || tasks_count == 0)
+    {
+        return true;
+    }
+
+    // Each task costs at least 1 for the tasks with few pairs to be spread
+    std::size_t total_cost = 0;
+    for (auto const& t : tasks.tasks)
+    {
+        total_cost += t.cost + 1;
+    }
+
+    std::vector<std::size_t> first_tasks(parts_count + 1, tasks_count);
+    first_tasks[0] = 0;
+    {
+        std::size_t cost = 0;
+        std::size_t part = 1;
+        for (std::size_t i = 0; i < tasks_count && part < parts_count; ++i)
+        {
+            cost += tasks.tasks[i].cost + 1;
+            while (part < parts_count && cost * parts_count >= total_cost * part)
+            {
+                first_tasks[part++] = i + 1;
+            }
+        }
+    }
+
+    std::atomic<bool> failed(false);
+    executor(parts_count, [&](std::size_t part)
+    {
+        auto& visitor = *(boost::begin(visitors) + part);
+        for (std::size_t i = first_tasks[part]; i < first_tasks[part + 1]; ++i)
+        {
+            if (failed.load())
+            {
+                return;
+            }
+            if (! tasks.visit(tasks.tasks[i], visitor))
+            {
+                failed.store(true); // Bail out if visitor returns false
+                return;
+            }
+        }
+    });
+
+    return ! failed.load();
+}
+
+
 }} // namespace detail::partition
 
 template
 <
     typename Box,
     typename IncludePolicy1 = detail::partition::include_all_policy,
-    typename IncludePolicy2 = detail::partition::include_all_policy
+    typename IncludePolicy2 = detail::partition::include_all_policy,
+    typename Backend = detail::partition::recursive_backend
 >
 class partition
 {
@@ -683,10 +1055,10 @@ public:
             expand_to_range<IncludePolicy1>(forward_range, total,
                                             iterator_vector, expand_policy);
 
-            return detail::partition::partition_one_range
+            return detail::partition::partition_backend
                 <
-                    0, Box
-                >::apply(total, iterator_vector, 0, min_elements,
+                    Backend, Box
+                >::apply(total, iterator_vector, min_elements,
                          visitor, expand_policy, overlaps_policy, box_visitor);
         }
         else
@@ -709,6 +1081,71 @@ public:
         return true;
     }
 
+    // Parallel version. The work is divided into boost::size(visitors)
+    // parts (e.g. 4 x executor.concurrency()), visited concurrently by the
+    // executor, each part by its own visitor. The parts contain the pairs in
+    // the order in which the sequential partition would visit them so
+    // merging the states of the visitors in the order of the parts gives
+    // deterministic results. If a visitor returns false the parts being
+    // visited are stopped before their next subset of pairs.
+    // The subsets of pairs are collected by the recursive partition so it is
+    // available only for recursive_backend, then the pairs are visited in the
+    // same order as by apply() of the same partition.
+    template
+    <
+        typename ForwardRange,
+        typename Visitors,
+        typename ExpandPolicy,
+        typename OverlapsPolicy,
+        typename Executor
+    >
+    static inline bool apply_parallel(ForwardRange const& forward_range,
+                                      Visitors& visitors,
+                                      ExpandPolicy const& expand_policy,
+                                      OverlapsPolicy const& overlaps_policy,
+                                      std::size_t min_elements,
+                                      Executor const& executor)
+    {
+        BOOST_GEOMETRY_STATIC_ASSERT(
+            (std::is_same<Backend, detail::partition::recursive_backend>::value),
+            "The parallel partition is implemented only for recursive_backend.",
+            Backend);
+
+        using iterator_t = typename boost::range_iterator
+            <
+                ForwardRange const
+            >::type;
+
+        detail::partition::partition_tasks<iterator_t, iterator_t> tasks;
+        detail::partition::visit_no_policy box_visitor;
+
+        if (std::size_t(boost::size(forward_range)) > min_elements)
+        {
+            std::vector<iterator_t> iterator_vector;
+            Box total;
+            assign_inverse(total);
+            expand_to_range<IncludePolicy1>(forward_range, total,
+                                            iterator_vector, expand_policy);
+
+            detail::partition::partition_one_range
+                <
+                    0, Box
+                >::apply(total, iterator_vector, 0, min_elements,
+                         tasks, expand_policy, overlaps_policy, box_visitor);
+        }
+        else
+        {
+            std::vector<iterator_t> iterator_vector;
+            for (auto it = boost::begin(forward_range); it != boost::end(forward_range); ++it)
+            {
+                iterator_vector.push_back(it);
+            }
+            detail::partition::handle_one(iterator_vector, tasks);
+        }
+
+        return detail::partition::visit_tasks(tasks, visitors, executor);
+    }
+
     template
     <
         typename ForwardRange1,
@@ -818,11 +1255,11 @@ public:
             expand_to_range<IncludePolicy2>(forward_range2, total,
                                             iterator_vector2, expand_policy2);
 
-            return detail::partition::partition_two_ranges
+            return detail::partition::partition_backend
                 <
-                    0, Box
+                    Backend, Box
                 >::apply(total, iterator_vector1, iterator_vector2,
-                         0, min_elements, visitor, expand_policy1,
+                         min_elements, visitor, expand_policy1,
                          overlaps_policy1, expand_policy2, overlaps_policy2,
                          box_visitor);
         }
@@ -846,6 +1283,108 @@ public:
 
         return true;
     }
+
+    // Parallel version for two ranges, see above
+    template
+    <
+        typename ForwardRange1,
+        typename ForwardRange2,
+        typename Visitors,
+        typename ExpandPolicy1,
+        typename OverlapsPolicy1,
+        typename ExpandPolicy2,
+        typename OverlapsPolicy2,
+        typename Executor
+    >
+    static inline bool apply_parallel(ForwardRange1 const& forward_range1,
+                                      ForwardRange2 const& forward_range2,
+                                      Visitors& visitors,
+                                      ExpandPolicy1 const& expand_policy1,
+                                      OverlapsPolicy1 const& overlaps_policy1,
+                                      ExpandPolicy2 const& expand_policy2,
+                                      OverlapsPolicy2 const& overlaps_policy2,
+                                      std::size_t min_elements,
+                                      Executor const& executor)
+    {
+        BOOST_GEOMETRY_STATIC_ASSERT(
+            (std::is_same<Backend, detail::partition::recursive_backend>::value),
+            "The parallel partition is implemented only for recursive_backend.",
+            Backend);
+
+        using iterator1_t = typename boost::range_iterator
+            <
+                ForwardRange1 const
+            >::type;
+
+        using iterator2_t = typename boost::range_iterator
+            <
+                ForwardRange2 const
+            >::type;
+
+        detail::partition::partition_tasks<iterator1_t, iterator2_t> tasks;
+        detail::partition::visit_no_policy box_visitor;
+
+        std::vector<iterator1_t> iterator_vector1;
+        std::vector<iterator2_t> iterator_vector2;
+
+        if (std::size_t(boost::size(forward_range1)) > min_elements
+            && std::size_t(boost::size(forward_range2)) > min_elements)
+        {
+            Box total;
+            assign_inverse(total);
+            expand_to_range<IncludePolicy1>(forward_range1, total,
+                                            iterator_vector1, expand_policy1);
+            expand_to_range<IncludePolicy2>(forward_range2, total,
+                                            iterator_vector2, expand_policy2);
+
+            detail::partition::partition_two_ranges
+                <
+                    0, Box
+                >::apply(total, iterator_vector1, iterator_vector2, 0,
+                         min_elements, tasks, expand_policy1, overlaps_policy1,
+                         expand_policy2, overlaps_policy2, box_visitor);
+        }
+        else
+        {
+            for (auto it = boost::begin(forward_range1); it != boost::end(forward_range1); ++it)
+            {
+                iterator_vector1.push_back(it);
+            }
+            for (auto it = boost::begin(forward_range2); it != boost::end(forward_range2); ++it)
+            {
+                iterator_vector2.push_back(it);
+            }
+            detail::partition::handle_two(iterator_vector1, iterator_vector2, tasks);
+        }
+
+        return detail::partition::visit_tasks(tasks, visitors, executor);
+    }
+
+    template
+    <
+        typename ForwardRange1,
+        typename ForwardRange2,
+        typename Visitors,
+        typename ExpandPolicy1,
+        typename OverlapsPolicy1,
+        typename ExpandPolicy2,
+        typename OverlapsPolicy2,
+        typename Executor
+    >
+    static inline bool apply_parallel(ForwardRange1 const& forward_range1,
+                                      ForwardRange2 const& forward_range2,
+                                      Visitors& visitors,
+                                      ExpandPolicy1 const& expand_policy1,
+                                      OverlapsPolicy1 const& overlaps_policy1,
+                                      ExpandPolicy2 const& expand_policy2,
+                                      OverlapsPolicy2 const& overlaps_policy2,
+                                      Executor const& executor)
+    {
+        return apply_parallel(forward_range1, forward_range2, visitors,
+                              expand_policy1, overlaps_policy1,
+                              expand_policy2, overlaps_policy2,
+                              default_min_elements, executor);
+    }
 };
 
 
@@ -0,0 +1,349 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_PARTITION_SWEEP_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DETAIL_PARTITION_SWEEP_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/size.hpp>
+
+#include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+namespace detail { namespace partition
+{
+
+// Plane sweep along one axis. The items are sorted by the min coordinate
+// of their boxes and each item is checked against the active items, i.e.
+// the ones whose max coordinate is not smaller than the min coordinate of
+// the current item. Contrary to the recursive partition the cost does not
+// depend on the distribution of the items in the total box but only on the
+// number of pairs of items overlapping along the axis.
+
+template <typename Box, typename Iterator>
+struct sweep_item
+{
+    using coor_t = typename coordinate_type<Box>::type;
+
+    Box box;
+    Iterator it;
+    std::size_t index;
+    coor_t min;
+    coor_t max;
+};
+
+struct sweep_item_less
+{
+    template <typename Item>
+    inline bool operator()(Item const& item1, Item const& item2) const
+    {
+        return item1.min < item2.min
+            || (! (item2.min < item1.min) && item1.index < item2.index);
+    }
+};
+
+template <std::size_t I, std::size_t N>
+struct sweep_interval
+{
+    template <typename Box, typename T>
+    static inline void apply(Box const& box, std::size_t axis, T& mi, T& ma)
+    {
+        if (axis == I)
+        {
+            mi = geometry::get<min_corner, I>(box);
+            ma = geometry::get<max_corner, I>(box);
+        }
+        else
+        {
+            sweep_interval<I + 1, N>::apply(box, axis, mi, ma);
+        }
+    }
+};
+
+template <std::size_t N>
+struct sweep_interval<N, N>
+{
+    template <typename Box, typename T>
+    static inline void apply(Box const& , std::size_t , T& , T& )
+    {}
+};
+
+template <typename Box, typename IteratorVector, typename ExpandPolicy>
+inline std::vector<sweep_item<Box, typename IteratorVector::value_type> >
+    make_sweep_items(IteratorVector const& input, ExpandPolicy const& expand_policy)
+{
+    std::vector<sweep_item<Box, typename IteratorVector::value_type> > result;
+    result.reserve(boost::size(input));
+    std::size_t index = 0;
+    for (auto const& it : input)
+    {
+        sweep_item<Box, typename IteratorVector::value_type> item;
+        geometry::assign_inverse(item.box);
+        expand_policy.apply(item.box, *it);
+        item.it = it;
+        item.index = index++;
+        result.push_back(item);
+    }
+    return result;
+}
+
+template <typename Items>
+inline void set_sweep_axis(Items& items, std::size_t axis)
+{
+    using box_t = decltype(items.front().box);
+    static const std::size_t dimension = geometry::dimension<box_t>::value;
+    for (auto& item : items)
+    {
+        sweep_interval<0, dimension>::apply(item.box, axis, item.min, item.max);
+    }
+}
+
+template <typename T>
+struct sweep_interval_less
+{
+    inline bool operator()(std::pair<T, T> const& i1, std::pair<T, T> const& i2) const
+    {
+        return i1.first < i2.first;
+    }
+};
+
+// The number of pairs of intervals overlapping along the axis (of the first
+// interval with the intervals starting inside of it), i.e. the number of
+// checks done by the sweep. The calculation stops when the number
+// exceeds max_cost.
+template <typename Intervals>
+inline std::size_t sweep_cost(Intervals const& sorted1, Intervals const& sorted2,
+                              std::size_t max_cost)
+{
+    using interval_t = typename Intervals::value_type;
+
+    std::size_t result = 0;
+    for (auto const& interval : sorted1)
+    {
+        auto const first = std::lower_bound(sorted2.begin(), sorted2.end(),
+                                            interval_t(interval.first, interval.first),
+                                            sweep_interval_less<typename interval_t::first_type>());
+        auto const last = std::upper_bound(first, sorted2.end(),
+                                           interval_t(interval.second, interval.second),
+                                           sweep_interval_less<typename interval_t::first_type>());
+        result += std::size_t(last - first);
+        if (result > max_cost)
+        {
+            break;
+        }
+    }
+    return result;
+}
+
+template <typename Items, typename Intervals>
+inline void sorted_sweep_intervals(Items const& items, std::size_t axis,
+                                   Intervals& intervals)
+{
+    using box_t = decltype(items.front().box);
+    using interval_t = typename Intervals::value_type;
+    static const std::size_t dimension = geometry::dimension<box_t>::value;
+
+    intervals.clear();
+    for (auto const& item : items)
+    {
+        interval_t interval;
+        sweep_interval<0, dimension>::apply(item.box, axis, interval.first, interval.second);
+        intervals.push_back(interval);
+    }
+    std::sort(intervals.begin(), intervals.end(),
+              sweep_interval_less<typename interval_t::first_type>());
+}
+
+// Finds the axis for which the number of checks done by the sweep is the
+// smallest and returns this number. If it is not greater than max_cost
+// the items are sorted for the sweep along this axis.
+template <typename Items1, typename Items2>
+inline std::size_t prepare_sweep(Items1& items1, Items2& items2, std::size_t max_cost,
+                                 bool same_items)
+{
+    using box_t = decltype(items1.front().box);
+    using coor_t = typename coordinate_type<box_t>::type;
+    static const std::size_t dimension = geometry::dimension<box_t>::value;
+
+    std::vector<std::pair<coor_t, coor_t> > intervals1, intervals2;
+    intervals1.reserve(items1.size());
+    intervals2.reserve(same_items ? 0 : items2.size());
+
+    std::size_t best_axis = 0;
+    std::size_t best_cost = (std::numeric_limits<std::size_t>::max)();
+    for (std::size_t axis = 0; axis < dimension; ++axis)
+    {
+        sorted_sweep_intervals(items1, axis, intervals1);
+        std::size_t cost = 0;
+        if (same_items)
+        {
+            cost = sweep_cost(intervals1, intervals1, max_cost);
+        }
+        else
+        {
+            sorted_sweep_intervals(items2, axis, intervals2);
+            cost = sweep_cost(intervals1, intervals2, max_cost);
+            if (cost <= max_cost)
+            {
+                cost += sweep_cost(intervals2, intervals1, max_cost - cost);
+            }
+        }
+
+        if (cost < best_cost)
+        {
+            best_cost = cost;
+            best_axis = axis;
+        }
+    }
+
+    if (best_cost <= max_cost)
+    {
+        set_sweep_axis(items1, best_axis);
+        std::sort(items1.begin(), items1.end(), sweep_item_less());
+        if (! same_items)
+        {
+            set_sweep_axis(items2, best_axis);
+            std::sort(items2.begin(), items2.end(), sweep_item_less());
+        }
+    }
+    return best_cost;
+}
+
+template <typename Items>
+inline std::size_t prepare_sweep(Items& items, std::size_t max_cost)
+{
+    return prepare_sweep(items, items, max_cost, true);
+}
+
+template <typename Items1, typename Items2>
+inline std::size_t prepare_sweep(Items1& items1, Items2& items2, std::size_t max_cost)
+{
+    return prepare_sweep(items1, items2, max_cost, false);
+}
+
+// Match the sorted items with themselves
+template <typename Items, typename VisitPolicy, typename OverlapsPolicy>
+inline bool sweep_one(Items const& items,
+                      VisitPolicy& visitor,
+                      OverlapsPolicy const& overlaps_policy)
+{
+    std::vector<typename Items::value_type const*> active;
+    for (auto const& item : items)
+    {
+        std::size_t count = 0;
+        for (auto const* a : active)
+        {
+            if (a->max < item.min)
+            {
+                continue; // Not overlapping any of the remaining items
+            }
+            active[count++] = a;
+
+            if (overlaps_policy.apply(a->box, *item.it))
+            {
+                // Pass the items in the order of the input like handle_one
+                bool const ok = a->index < item.index
+                              ? visitor.apply(*a->it, *item.it)
+                              : visitor.apply(*item.it, *a->it);
+                if (! ok)
+                {
+                    return false; // Bail out if visitor returns false
+                }
+            }
+        }
+        active.resize(count);
+        active.push_back(&item);
+    }
+    return true;
+}
+
+// Match the sorted items of range 1 with the sorted items of range 2
+template
+<
+    typename Items1, typename Items2,
+    typename VisitPolicy,
+    typename OverlapsPolicy1, typename OverlapsPolicy2
+>
+inline bool sweep_two(Items1 const& items1, Items2 const& items2,
+                      VisitPolicy& visitor,
+                      OverlapsPolicy1 const& overlaps_policy1,
+                      OverlapsPolicy2 const& overlaps_policy2)
+{
+    std::vector<typename Items1::value_type const*> active1;
+    std::vector<typename Items2::value_type const*> active2;
+
+    auto it1 = items1.begin();
+    auto it2 = items2.begin();
+    while (it1 != items1.end() || it2 != items2.end())
+    {
+        if (it2 == items2.end() || (it1 != items1.end() && ! (it2->min < it1->min)))
+        {
+            std::size_t count = 0;
+            for (auto const* a : active2)
+            {
+                if (a->max < it1->min)
+                {
+                    continue;
+                }
+                active2[count++] = a;
+
+                if (overlaps_policy2.apply(it1->box, *a->it)
+                    && ! visitor.apply(*it1->it, *a->it))
+                {
+                    return false; // Bail out if visitor returns false
+                }
+            }
+            active2.resize(count);
+            active1.push_back(&*it1);
+            ++it1;
+        }
+        else
+        {
+            std::size_t count = 0;
+            for (auto const* a : active1)
+            {
+                if (a->max < it2->min)
+                {
+                    continue;
+                }
+                active1[count++] = a;
+
+                if (overlaps_policy1.apply(it2->box, *a->it)
+                    && ! visitor.apply(*a->it, *it2->it))
+                {
+                    return false; // Bail out if visitor returns false
+                }
+            }
+            active1.resize(count);
+            active2.push_back(&*it2);
+            ++it2;
+        }
+    }
+    return true;
+}
+
+
+}} // namespace detail::partition
+
+}} // namespace boost::geometry
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_PARTITION_SWEEP_HPP
@@ -62,6 +62,21 @@ int point_in_range(Point const& point, Range const& range, Strategy const& strat
     return strategy.result(state);
 }
 
+// Strategies may check the whole ring at once, e.g. using an index
+template <typename Point, typename Ring, typename Strategy> inline
+auto point_in_ring(Point const& point, Ring const& ring, Strategy const& strategy, int)
+    -> decltype(strategy.apply_ring(point, ring))
+{
+    return strategy.apply_ring(point, ring);
+}
+
+template <typename Point, typename Ring, typename Strategy> inline
+int point_in_ring(Point const& point, Ring const& ring, Strategy const& strategy, long)
+{
+    detail::closed_clockwise_view<Ring const> view(ring);
+    return point_in_range(point, view, strategy);
+}
+
 }} // namespace detail::within
 
 namespace detail_dispatch { namespace within {
@@ -179,9 +194,8 @@ struct point_in_geometry<Ring, ring_tag>
             return -1;
         }
 
-        detail::closed_clockwise_view<Ring const> view(ring);
-        return detail::within::point_in_range(point, view,
-                                              strategy.relate(point, ring));
+        return detail::within::point_in_ring(point, ring,
+                                             strategy.relate(point, ring), 0);
     }
 };
 
@@ -0,0 +1,459 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_WITHIN_POINTS_IN_GEOMETRY_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DETAIL_WITHIN_POINTS_IN_GEOMETRY_HPP
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/size.hpp>
+#include <boost/range/value_type.hpp>
+
+#include <boost/geometry/algorithms/detail/within/point_in_geometry.hpp>
+#include <boost/geometry/algorithms/not_implemented.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/strategies/cartesian/point_in_poly_crossings_multiply.hpp>
+#include <boost/geometry/strategies/cartesian/point_in_poly_winding.hpp>
+
+#include <boost/geometry/util/select_calculation_type.hpp>
+#include <boost/geometry/views/detail/closed_clockwise_view.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace within
+{
+
+// Points are checked in blocks so the segments of a ring are traversed once
+// per block instead of once per point and the data of the points of a block
+// stays in cache.
+static const std::size_t points_block_size = 256;
+
+
+// Calls the point-in-ring strategy for each segment and each point of the
+// block, segment by segment. The results are the same as the results of
+// point_in_range since a strategy is applied to the segments of a point
+// in the same order.
+template <typename Strategy>
+struct points_in_range
+{
+    template <typename Point, typename Range>
+    static inline void apply(Point const* const* points, std::size_t count,
+                             Range const& range, Strategy const& strategy,
+                             int* codes)
+    {
+        typename Strategy::state_type states[points_block_size];
+        bool active[points_block_size];
+        std::fill(active, active + count, true);
+
+        auto it = boost::begin(range);
+        auto const end = boost::end(range);
+        for (auto previous = it++; it != end; ++previous, ++it)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (active[i])
+                {
+                    active[i] = strategy.apply(*points[i], *previous, *it, states[i]);
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            codes[i] = strategy.result(states[i]);
+        }
+    }
+};
+
+// The winding strategy counts only the segments overlapping the x
+// coordinate of the point, compared with a tolerance. So for each segment
+// the points are first filtered with a branchless, vectorizable check of
+// the x range of the segment, enlarged so that the tolerance of the
+// strategy is covered. Then the strategy is applied only for the points
+// passing the filter.
+template <typename P1, typename P2, typename CalculationType>
+struct points_in_range<strategy::within::cartesian_winding<P1, P2, CalculationType> >
+{
+    typedef strategy::within::cartesian_winding<P1, P2, CalculationType> strategy_type;
+
+    template <typename Point, typename Range>
+    static inline void apply(Point const* const* points, std::size_t count,
+                             Range const& range, strategy_type const& strategy,
+                             int* codes)
+    {
+        typedef typename select_calculation_type
+            <
+                Point,
+                typename boost::range_value<Range>::type,
+                CalculationType
+            >::type calc_t;
+        typedef typename std::conditional
+            <
+                std::is_floating_point<calc_t>::value, calc_t, double
+            >::type eps_t;
+
+        double const epsilon = 1000.0 * (std::max)(
+            double(std::numeric_limits<eps_t>::epsilon()),
+            std::numeric_limits<double>::epsilon());
+
+        typename strategy_type::state_type states[points_block_size];
+        bool active[points_block_size];
+        double xs[points_block_size];
+        unsigned char mask[points_block_size];
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            active[i] = true;
+            xs[i] = boost::numeric_cast<double>(geometry::get<0>(*points[i]));
+        }
+
+        auto it = boost::begin(range);
+        auto const end = boost::end(range);
+        for (auto previous = it++; it != end; ++previous, ++it)
+        {
+            double const x1 = boost::numeric_cast<double>(geometry::get<0>(*previous));
+            double const x2 = boost::numeric_cast<double>(geometry::get<0>(*it));
+            double const tolerance = epsilon
+                * (std::max)(double(1), (std::max)(std::abs(x1), std::abs(x2)));
+            double const min_x = (std::min)(x1, x2) - tolerance;
+            double const max_x = (std::max)(x1, x2) + tolerance;
+
+            bool any = false;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                mask[i] = (xs[i] >= min_x) & (xs[i] <= max_x);
+                any |= mask[i] != 0;
+            }
+            if (! any)
+            {
+                continue;
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (mask[i] && active[i])
+                {
+                    active[i] = strategy.apply(*points[i], *previous, *it, states[i]);
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            codes[i] = strategy.result(states[i]);
+        }
+    }
+};
+
+// Branchless version of the crossings_multiply strategy operating on
+// arrays of coordinates of the points, vectorizable by the compiler. The
+// calculations are the same as in the strategy.
+template <typename P1, typename P2, typename CalculationType>
+struct points_in_range<strategy::within::crossings_multiply<P1, P2, CalculationType> >
+{
+    typedef strategy::within::crossings_multiply<P1, P2, CalculationType> strategy_type;
+
+    template <typename Point, typename Range>
+    static inline void apply(Point const* const* points, std::size_t count,
+                             Range const& range, strategy_type const& ,
+                             int* codes)
+    {
+        typedef typename select_calculation_type
+            <
+                Point,
+                typename boost::range_value<Range>::type,
+                CalculationType
+            >::type calc_t;
+
+        calc_t txs[points_block_size];
+        calc_t tys[points_block_size];
+        unsigned char yflags[points_block_size];
+        unsigned char insides[points_block_size];
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            txs[i] = geometry::get<0>(*points[i]);
+            tys[i] = geometry::get<1>(*points[i]);
+            insides[i] = 0;
+        }
+
+        auto it = boost::begin(range);
+        auto const end = boost::end(range);
+        if (it != end)
+        {
+            calc_t const y0 = geometry::get<1>(*it);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                yflags[i] = y0 >= tys[i];
+            }
+        }
+
+        for (auto previous = it++; it != end; ++previous, ++it)
+        {
+            calc_t const x0 = geometry::get<0>(*previous);
+            calc_t const y0 = geometry::get<1>(*previous);
+            calc_t const x1 = geometry::get<0>(*it);
+            calc_t const y1 = geometry::get<1>(*it);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                calc_t const tx = txs[i];
+                calc_t const ty = tys[i];
+                unsigned char const yflag1 = y1 >= ty;
+                unsigned char const crossing
+                    = ((y1 - ty) * (x0 - x1) >= (x1 - tx) * (y0 - y1)) == (yflag1 != 0);
+                insides[i] ^= (yflags[i] != yflag1) & crossing;
+                yflags[i] = yflag1;
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            codes[i] = insides[i] ? 1 : -1;
+        }
+    }
+};
+
+
+// Strategies checking the whole ring at once, e.g. using an index, are
+// called for each point.
+template <typename Point, typename Ring, typename Strategy>
+inline auto points_in_ring(Point const* const* points, std::size_t count,
+                           Ring const& ring, Strategy const& strategy,
+                           int* codes, int)
+    -> decltype(strategy.apply_ring(*points[0], ring), void())
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        codes[i] = strategy.apply_ring(*points[i], ring);
+    }
+}
+
+template <typename Point, typename Ring, typename Strategy>
+inline void points_in_ring(Point const* const* points, std::size_t count,
+                           Ring const& ring, Strategy const& strategy,
+                           int* codes, long)
+{
+    detail::closed_clockwise_view<Ring const> view(ring);
+    points_in_range<Strategy>::apply(points, count, view, strategy, codes);
+}
+
+
+}} // namespace detail::within
+#endif // DOXYGEN_NO_DETAIL
+
+
+#ifndef DOXYGEN_NO_DISPATCH
+namespace detail_dispatch { namespace within
+{
+
+// Calculates the codes of the points of the block like point_in_geometry
+template
+<
+    typename Geometry,
+    typename Tag = typename geometry::tag<Geometry>::type
+>
+struct points_in_geometry
+    : not_implemented<Tag>
+{};
+
+template <typename Ring>
+struct points_in_geometry<Ring, ring_tag>
+{
+    template <typename Point, typename Strategy>
+    static inline void apply(Point const* const* points, std::size_t count,
+                             Ring const& ring, Strategy const& strategy,
+                             int* codes)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if ( boost::size(ring) < core_detail::closure::minimum_ring_size
+                                    <
+                                        geometry::closure<Ring>::value
+                                    >::value )
+        {
+            std::fill(codes, codes + count, -1);
+            return;
+        }
+
+        detail::within::points_in_ring(points, count, ring,
+                                       strategy.relate(*points[0], ring),
+                                       codes, 0);
+    }
+};
+
+template <typename Polygon>
+struct points_in_geometry<Polygon, polygon_tag>
+{
+    template <typename Point, typename Strategy>
+    static inline void apply(Point const* const* points, std::size_t count,
+                             Polygon const& polygon, Strategy const& strategy,
+                             int* codes)
+    {
+        typedef points_in_geometry<typename ring_type<Polygon>::type> per_ring;
+
+        per_ring::apply(points, count, exterior_ring(polygon), strategy, codes);
+
+        // The points inside the exterior ring and not yet found in a hole
+        Point const* subset[detail::within::points_block_size];
+        std::size_t indexes[detail::within::points_block_size];
+        int subset_codes[detail::within::points_block_size];
+
+        auto const& rings = interior_rings(polygon);
+        for (auto it = boost::begin(rings); it != boost::end(rings); ++it)
+        {
+            std::size_t subset_count = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (codes[i] == 1)
+                {
+                    subset[subset_count] = points[i];
+                    indexes[subset_count] = i;
+                    ++subset_count;
+                }
+            }
+            if (subset_count == 0)
+            {
+                break;
+            }
+
+            per_ring::apply(subset, subset_count, *it, strategy, subset_codes);
+
+            for (std::size_t j = 0; j < subset_count; ++j)
+            {
+                if (subset_codes[j] != -1)
+                {
+                    // If 0, return 0 (touch)
+                    // If 1 (inside hole) return -1 (outside polygon)
+                    codes[indexes[j]] = -subset_codes[j];
+                }
+            }
+        }
+    }
+};
+
+template <typename MultiPolygon>
+struct points_in_geometry<MultiPolygon, multi_polygon_tag>
+{
+    template <typename Point, typename Strategy>
+    static inline void apply(Point const* const* points, std::size_t count,
+                             MultiPolygon const& multi, Strategy const& strategy,
+                             int* codes)
+    {
+        typedef points_in_geometry
+            <
+                typename boost::range_value<MultiPolygon>::type
+            > per_polygon;
+
+        std::fill(codes, codes + count, -1);
+
+        // The points outside of the polygons checked so far
+        Point const* subset[detail::within::points_block_size];
+        std::size_t indexes[detail::within::points_block_size];
+        int subset_codes[detail::within::points_block_size];
+
+        for (auto it = boost::begin(multi); it != boost::end(multi); ++it)
+        {
+            std::size_t subset_count = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (codes[i] == -1)
+                {
+                    subset[subset_count] = points[i];
+                    indexes[subset_count] = i;
+                    ++subset_count;
+                }
+            }
+            if (subset_count == 0)
+            {
+                break;
+            }
+
+            per_polygon::apply(subset, subset_count, *it, strategy, subset_codes);
+
+            for (std::size_t j = 0; j < subset_count; ++j)
+            {
+                codes[indexes[j]] = subset_codes[j];
+            }
+        }
+    }
+};
+
+}} // namespace detail_dispatch::within
+#endif // DOXYGEN_NO_DISPATCH
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace within
+{
+
+// Calls f with the code of each point of the range, in the order of the
+// points. The codes are the same as the ones returned by point_in_geometry:
+// 1 - in the interior
+// 0 - in the boundary
+// -1 - in the exterior
+template <typename Points, typename Geometry, typename Strategy, typename F>
+inline void points_in_geometry(Points const& points, Geometry const& geometry,
+                               Strategy const& strategy, F&& f)
+{
+    typedef typename boost::range_value<Points>::type point_type;
+
+    point_type const* block[points_block_size];
+    int codes[points_block_size];
+
+    auto it = boost::begin(points);
+    auto const end = boost::end(points);
+    while (it != end)
+    {
+        std::size_t count = 0;
+        for ( ; it != end && count < points_block_size; ++it)
+        {
+            block[count++] = std::addressof(*it);
+        }
+
+        detail_dispatch::within::points_in_geometry
+            <
+                Geometry
+            >::apply(block, count, geometry, strategy, codes);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            f(codes[i]);
+        }
+    }
+}
+
+}} // namespace detail::within
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_WITHIN_POINTS_IN_GEOMETRY_HPP
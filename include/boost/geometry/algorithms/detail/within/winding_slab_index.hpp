@@ -0,0 +1,282 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_WITHIN_WINDING_SLAB_INDEX_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_DETAIL_WITHIN_WINDING_SLAB_INDEX_HPP
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/size.hpp>
+#include <boost/range/value_type.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/util/range.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace within
+{
+
+// Calls f(ring) for all rings, for polygons starting with the exterior ring
+template <typename Geometry, typename Tag = typename geometry::tag<Geometry>::type>
+struct for_each_ring
+{
+    template <typename F>
+    static inline void apply(Geometry const& ring, F&& f)
+    {
+        f(ring);
+    }
+};
+
+template <typename Polygon>
+struct for_each_ring<Polygon, polygon_tag>
+{
+    template <typename F>
+    static inline void apply(Polygon const& polygon, F&& f)
+    {
+        f(exterior_ring(polygon));
+        auto const& rings = interior_rings(polygon);
+        for (auto it = boost::begin(rings); it != boost::end(rings); ++it)
+        {
+            f(*it);
+        }
+    }
+};
+
+template <typename MultiPolygon>
+struct for_each_ring<MultiPolygon, multi_polygon_tag>
+{
+    template <typename F>
+    static inline void apply(MultiPolygon const& multi, F&& f)
+    {
+        for (auto it = boost::begin(multi); it != boost::end(multi); ++it)
+        {
+            for_each_ring<typename boost::range_value<MultiPolygon>::type>
+                ::apply(*it, f);
+        }
+    }
+};
+
+// The relative tolerance of the index of the segments of rings checked by the
+// cartesian winding strategy using CalculationType. The coordinates are
+// converted to double in the index.
+template <typename CalculationType>
+inline double winding_slab_epsilon()
+{
+    typedef typename std::conditional
+        <
+            std::is_floating_point<CalculationType>::value,
+            CalculationType, double
+        >::type eps_t;
+
+    return 1000.0 * (std::max)(double(std::numeric_limits<eps_t>::epsilon()),
+                               std::numeric_limits<double>::epsilon());
+}
+
+// Index of the segments of a ring grouped in slabs of equal width along x.
+// The winding strategy casts a vertical ray so only the segments overlapping
+// the x coordinate of the point contribute to the result. Each segment is
+// stored in all slabs its x range, enlarged by the tolerance used by the
+// strategy to compare coordinates, overlaps. So the segments of the slab of
+// the point are a superset of the segments contributing to the result.
+class winding_slab_index
+{
+public:
+    template <typename Ring>
+    inline winding_slab_index(Ring const& ring, double epsilon,
+                              std::size_t segments_per_slab)
+        : m_min(0)
+        , m_max(0)
+        , m_width(0)
+        , m_slabs_count(0)
+    {
+        std::size_t const count = segments_count(ring);
+        if (count == 0)
+        {
+            return;
+        }
+
+        std::vector<double> mins, maxs;
+        mins.reserve(count);
+        maxs.reserve(count);
+
+        m_min = (std::numeric_limits<double>::max)();
+        m_max = (std::numeric_limits<double>::lowest)();
+        double max_abs = 1;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            double const x1 = coordinate<0>(range::at(ring, i));
+            double const x2 = coordinate<0>(next_point(ring, i));
+            mins.push_back((std::min)(x1, x2));
+            maxs.push_back((std::max)(x1, x2));
+            m_min = (std::min)(m_min, mins.back());
+            m_max = (std::max)(m_max, maxs.back());
+            max_abs = (std::max)(max_abs, (std::max)(std::abs(x1), std::abs(x2)));
+        }
+
+        double const tolerance = max_abs * epsilon;
+        m_min -= tolerance;
+        m_max += tolerance;
+
+        // Long segments are stored in many slabs. Decrease the number of
+        // slabs until the size of the index is proportional to the number
+        // of segments.
+        std::size_t slabs_count = (std::max)(count / (std::max)(segments_per_slab,
+                                                                std::size_t(1)),
+                                             std::size_t(1));
+        std::size_t entries_count = 0;
+        for (;;)
+        {
+            set_slabs(slabs_count);
+            entries_count = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                entries_count += slab(maxs[i] + tolerance)
+                               - slab(mins[i] - tolerance) + 1;
+            }
+            if (slabs_count == 1 || entries_count <= 8 * count)
+            {
+                break;
+            }
+            slabs_count /= 2;
+        }
+
+        // Counting sort of the segments by slabs, in the order of the ring
+        m_offsets.assign(m_slabs_count + 1, 0);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t const last = slab(maxs[i] + tolerance);
+            for (std::size_t s = slab(mins[i] - tolerance); s <= last; ++s)
+            {
+                ++m_offsets[s + 1];
+            }
+        }
+        for (std::size_t s = 0; s < m_slabs_count; ++s)
+        {
+            m_offsets[s + 1] += m_offsets[s];
+        }
+        m_segments.resize(entries_count);
+        std::vector<std::size_t> positions(m_offsets.begin(), m_offsets.end() - 1);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t const last = slab(maxs[i] + tolerance);
+            for (std::size_t s = slab(mins[i] - tolerance); s <= last; ++s)
+            {
+                m_segments[positions[s]++] = i;
+            }
+        }
+    }
+
+    // The ring has to be the one passed into the constructor
+    template <typename Point, typename Ring, typename Strategy>
+    inline int apply(Point const& point, Ring const& ring,
+                     Strategy const& strategy) const
+    {
+        typename Strategy::state_type state;
+
+        double const x = coordinate<0>(point);
+        if (m_slabs_count == 0 || ! (x >= m_min && x <= m_max))
+        {
+            return strategy.result(state);
+        }
+
+        std::size_t const s = slab(x);
+        auto const first = m_segments.begin() + m_offsets[s];
+        auto const last = m_segments.begin() + m_offsets[s + 1];
+        for (auto it = first; it != last; ++it)
+        {
+            if (! strategy.apply(point, range::at(ring, *it),
+                                 next_point(ring, *it), state))
+            {
+                break;
+            }
+        }
+
+        return strategy.result(state);
+    }
+
+private:
+    template <std::size_t Dimension, typename Point>
+    static inline double coordinate(Point const& point)
+    {
+        return boost::numeric_cast<double>(geometry::get<Dimension>(point));
+    }
+
+    // The segments of an open ring include the closing segment. The order
+    // of the points doesn't matter since the direction of the segments
+    // changes only the sign of the winding number.
+    template <typename Ring>
+    static inline std::size_t segments_count(Ring const& ring)
+    {
+        std::size_t const size = boost::size(ring);
+        return size < 2 ? 0
+             : geometry::closure<Ring>::value == open ? size
+             : size - 1;
+    }
+
+    template <typename Ring>
+    static inline typename boost::range_value<Ring>::type const&
+        next_point(Ring const& ring, std::size_t i)
+    {
+        return range::at(ring, i + 1 < boost::size(ring) ? i + 1 : 0);
+    }
+
+    inline void set_slabs(std::size_t count)
+    {
+        m_width = (m_max - m_min) / double(count);
+        m_slabs_count = m_width > 0 ? count : 1;
+    }
+
+    // Monotonic with respect to x so the slabs of the enlarged range of
+    // a segment contain the slab of any x overlapping this range.
+    inline std::size_t slab(double x) const
+    {
+        if (! (x > m_min) || ! (m_width > 0))
+        {
+            return 0;
+        }
+        double const s = (x - m_min) / m_width;
+        return s < double(m_slabs_count) ?
+            (std::min)(std::size_t(s), m_slabs_count - 1) :
+            m_slabs_count - 1;
+    }
+
+    double m_min;
+    double m_max;
+    double m_width;
+    std::size_t m_slabs_count;
+    std::vector<std::size_t> m_offsets;
+    std::vector<std::size_t> m_segments;
+};
+
+}} // namespace detail::within
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_DETAIL_WITHIN_WINDING_SLAB_INDEX_HPP
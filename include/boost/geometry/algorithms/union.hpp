@@ -16,16 +16,36 @@
 #define BOOST_GEOMETRY_ALGORITHMS_UNION_HPP
 
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/numeric/conversion/cast.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/empty.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/size.hpp>
+#include <boost/range/value_type.hpp>
+
+#include <boost/geometry/algorithms/convert.hpp>
+#include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
 #include <boost/geometry/algorithms/detail/gc_group_elements.hpp>
 #include <boost/geometry/algorithms/detail/intersection/gc.hpp>
 #include <boost/geometry/algorithms/detail/overlay/intersection_insert.hpp>
 #include <boost/geometry/algorithms/detail/overlay/linear_linear.hpp>
 #include <boost/geometry/algorithms/detail/overlay/overlay.hpp>
 #include <boost/geometry/algorithms/detail/overlay/pointlike_pointlike.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
+#include <boost/geometry/algorithms/is_empty.hpp>
 #include <boost/geometry/algorithms/not_implemented.hpp>
 #include <boost/geometry/core/point_order.hpp>
 #include <boost/geometry/core/reverse_dispatch.hpp>
 #include <boost/geometry/geometries/adapted/boost_variant.hpp>
+#include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/geometries/concepts/check.hpp>
 #include <boost/geometry/policies/robustness/get_rescale_policy.hpp>
 #include <boost/geometry/strategies/default_strategy.hpp>
@@ -33,6 +53,9 @@
 #include <boost/geometry/strategies/relate/cartesian.hpp>
 #include <boost/geometry/strategies/relate/geographic.hpp>
 #include <boost/geometry/strategies/relate/spherical.hpp>
+#include <boost/geometry/util/parallel.hpp>
+#include <boost/geometry/util/range.hpp>
+#include <boost/geometry/util/type_traits.hpp>
 #include <boost/geometry/util/type_traits_std.hpp>
 #include <boost/geometry/views/detail/geometry_collection_view.hpp>
 #include <boost/geometry/views/detail/random_access_view.hpp>
@@ -876,7 +899,8 @@ template
     typename Geometry1,
     typename Geometry2,
     typename Collection,
-    typename Strategy
+    typename Strategy,
+    std::enable_if_t<util::is_geometry<Geometry1>::value, int> = 0
 >
 inline void union_(Geometry1 const& geometry1,
                    Geometry2 const& geometry2,
@@ -910,7 +934,8 @@ template
 <
     typename Geometry1,
     typename Geometry2,
-    typename Collection
+    typename Collection,
+    std::enable_if_t<util::is_geometry<Geometry1>::value, int> = 0
 >
 inline void union_(Geometry1 const& geometry1,
                    Geometry2 const& geometry2,
@@ -924,6 +949,345 @@ inline void union_(Geometry1 const& geometry1,
 }
 
 
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace union_
+{
+
+// Cascaded union of a range of polygons. The polygons are ordered
+// spatially and then merged pairwise, level by level, like in a balanced
+// binary tree. This way the nearby polygons are merged first and the
+// complexity of the partial results grows slowly, contrary to merging the
+// polygons one by one into the growing result.
+
+template <typename MultiPolygon, typename Box>
+struct cascaded_union_item
+{
+    typedef Box box_type;
+
+    MultiPolygon geometry;
+    Box box;
+};
+
+// The order of the centers of the boxes, sorted by x in vertical slices
+// and by y within each slice, like in the Sort-Tile-Recursive packing.
+template <typename Items>
+inline std::vector<std::size_t> cascaded_union_order(Items const& items)
+{
+    std::size_t const count = items.size();
+
+    std::vector<std::pair<double, double> > centers;
+    centers.reserve(count);
+    for (auto const& item : items)
+    {
+        centers.emplace_back(
+            (boost::numeric_cast<double>(geometry::get<min_corner, 0>(item.box))
+           + boost::numeric_cast<double>(geometry::get<max_corner, 0>(item.box))) / 2,
+            (boost::numeric_cast<double>(geometry::get<min_corner, 1>(item.box))
+           + boost::numeric_cast<double>(geometry::get<max_corner, 1>(item.box))) / 2);
+    }
+
+    std::vector<std::size_t> result(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        result[i] = i;
+    }
+
+    auto less_x = [&](std::size_t i1, std::size_t i2)
+    {
+        return centers[i1].first < centers[i2].first
+            || (! (centers[i2].first < centers[i1].first) && i1 < i2);
+    };
+    auto less_y = [&](std::size_t i1, std::size_t i2)
+    {
+        return centers[i1].second < centers[i2].second
+            || (! (centers[i2].second < centers[i1].second) && i1 < i2);
+    };
+
+    std::sort(result.begin(), result.end(), less_x);
+
+    std::size_t const slices = (std::max)(std::size_t(std::ceil(std::sqrt(double(count)))),
+                                          std::size_t(1));
+    std::size_t const slice_size = (count + slices - 1) / slices;
+    for (std::size_t first = 0; first < count; first += slice_size)
+    {
+        std::size_t const last = (std::min)(first + slice_size, count);
+        std::sort(result.begin() + first, result.begin() + last, less_y);
+    }
+
+    return result;
+}
+
+template <typename Item, typename Strategy>
+inline void cascaded_union_split(Item& item, typename Item::box_type const& other_box,
+                                 Item& result, Item& overlapping,
+                                 Strategy const& strategy)
+{
+    for (auto& polygon : item.geometry)
+    {
+        typename Item::box_type box;
+        geometry::envelope(polygon, box, strategy);
+        if (detail::disjoint::disjoint_box_box(box, other_box, strategy))
+        {
+            range::push_back(result.geometry, std::move(polygon));
+        }
+        else
+        {
+            range::push_back(overlapping.geometry, std::move(polygon));
+        }
+    }
+}
+
+// Merges two results. Only the polygons of one result whose boxes overlap
+// the box of the other result are passed into union_, the others can't
+// intersect the polygons of the other result.
+template <typename Item, typename Strategy>
+inline void cascaded_union_merge(Item& item1, Item& item2, Item& result,
+                                 Strategy const& strategy)
+{
+    result.box = item1.box;
+    geometry::expand(result.box, item2.box, strategy);
+
+    if (detail::disjoint::disjoint_box_box(item1.box, item2.box, strategy))
+    {
+        result.geometry = std::move(item1.geometry);
+        std::move(boost::begin(item2.geometry), boost::end(item2.geometry),
+                  range::back_inserter(result.geometry));
+        return;
+    }
+
+    Item overlapping1, overlapping2;
+    cascaded_union_split(item1, item2.box, result, overlapping1, strategy);
+    cascaded_union_split(item2, item1.box, result, overlapping2, strategy);
+
+    if (boost::empty(overlapping1.geometry) || boost::empty(overlapping2.geometry))
+    {
+        std::move(boost::begin(overlapping1.geometry), boost::end(overlapping1.geometry),
+                  range::back_inserter(result.geometry));
+        std::move(boost::begin(overlapping2.geometry), boost::end(overlapping2.geometry),
+                  range::back_inserter(result.geometry));
+    }
+    else
+    {
+        geometry::union_(overlapping1.geometry, overlapping2.geometry,
+                         result.geometry, strategy);
+    }
+}
+
+template <typename Polygons, typename MultiPolygon, typename Strategy, typename Executor>
+inline void cascaded_union(Polygons const& polygons, MultiPolygon& output,
+                           Strategy const& strategy, Executor const& executor)
+{
+    using point_type = typename geometry::point_type<MultiPolygon>::type;
+    using item_type = cascaded_union_item<MultiPolygon, model::box<point_type> >;
+
+    std::vector<item_type> items;
+    items.reserve(boost::size(polygons));
+    for (auto it = boost::begin(polygons); it != boost::end(polygons); ++it)
+    {
+        if (! geometry::is_empty(*it))
+        {
+            item_type item;
+            geometry::convert(*it, item.geometry);
+            geometry::envelope(*it, item.box, strategy);
+            items.push_back(std::move(item));
+        }
+    }
+
+    if (items.empty())
+    {
+        return;
+    }
+
+    {
+        std::vector<std::size_t> const order = cascaded_union_order(items);
+        std::vector<item_type> sorted;
+        sorted.reserve(items.size());
+        for (std::size_t i : order)
+        {
+            sorted.push_back(std::move(items[i]));
+        }
+        items = std::move(sorted);
+    }
+
+    // Merge the pairs of results of a level in parallel, each part of the
+    // work merging a contiguous range of pairs
+    std::size_t const concurrency = (std::max)(executor.concurrency(), std::size_t(1));
+    while (items.size() > 1)
+    {
+        std::size_t const pairs_count = items.size() / 2;
+        std::vector<item_type> next((items.size() + 1) / 2);
+
+        std::size_t const parts_count = (std::min)(pairs_count, 4 * concurrency);
+        executor(parts_count, [&](std::size_t part)
+        {
+            std::size_t const first = pairs_count * part / parts_count;
+            std::size_t const last = pairs_count * (part + 1) / parts_count;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                cascaded_union_merge(items[2 * i], items[2 * i + 1], next[i], strategy);
+            }
+        });
+
+        if (items.size() % 2 != 0)
+        {
+            next.back() = std::move(items.back());
+        }
+        items = std::move(next);
+    }
+
+    std::move(boost::begin(items.front().geometry), boost::end(items.front().geometry),
+              range::back_inserter(output));
+}
+
+}} // namespace detail::union_
+#endif // DOXYGEN_NO_DETAIL
+
+
+namespace resolve_strategy {
+
+template
+<
+    typename Strategy,
+    bool IsUmbrella = strategies::detail::is_umbrella_strategy<Strategy>::value
+>
+struct cascaded_union
+{
+    template <typename Polygons, typename MultiPolygon, typename Executor>
+    static inline void apply(Polygons const& polygons,
+                             MultiPolygon& output,
+                             Strategy const& strategy,
+                             Executor const& executor)
+    {
+        detail::union_::cascaded_union(polygons, output, strategy, executor);
+    }
+};
+
+template <typename Strategy>
+struct cascaded_union<Strategy, false>
+{
+    template <typename Polygons, typename MultiPolygon, typename Executor>
+    static inline void apply(Polygons const& polygons,
+                             MultiPolygon& output,
+                             Strategy const& strategy,
+                             Executor const& executor)
+    {
+        using strategies::relate::services::strategy_converter;
+
+        detail::union_::cascaded_union(polygons, output,
+                                       strategy_converter<Strategy>::get(strategy),
+                                       executor);
+    }
+};
+
+template <>
+struct cascaded_union<default_strategy, false>
+{
+    template <typename Polygons, typename MultiPolygon, typename Executor>
+    static inline void apply(Polygons const& polygons,
+                             MultiPolygon& output,
+                             default_strategy,
+                             Executor const& executor)
+    {
+        using strategy_type = typename strategies::relate::services::default_strategy
+            <
+                typename boost::range_value<Polygons>::type,
+                MultiPolygon
+            >::type;
+
+        detail::union_::cascaded_union(polygons, output, strategy_type(), executor);
+    }
+};
+
+} // resolve_strategy
+
+
+/*!
+\brief Combines the polygons of a range with each other \brief_strategy
+\ingroup union
+\details The polygons are ordered spatially and merged pairwise, level by
+    level (cascaded union). The pairs of a level are merged in parallel
+    using the executor. Only the polygons whose envelopes overlap are passed
+    into the overlay, the others are copied into the result.
+\tparam Polygons Range of polygons, not being a geometry
+\tparam MultiPolygon \tparam_geometry{MultiPolygon}
+\tparam Strategy \tparam_strategy{Union_}
+\tparam Executor Executor type, e.g. util::thread_executor
+\param polygons The polygons, possibly overlapping
+\param output The multi polygon to which the result is appended
+\param strategy \param_strategy{union_}
+\param executor The executor calling the merges
+ */
+template
+<
+    typename Polygons,
+    typename MultiPolygon,
+    typename Strategy,
+    typename Executor,
+    std::enable_if_t<util::is_not_geometry<Polygons>::value, int> = 0
+>
+inline void union_(Polygons const& polygons,
+                   MultiPolygon& output,
+                   Strategy const& strategy,
+                   Executor const& executor)
+{
+    concepts::check<typename boost::range_value<Polygons>::type const>();
+    concepts::check<MultiPolygon>();
+
+    resolve_strategy::cascaded_union
+        <
+            Strategy
+        >::apply(polygons, output, strategy, executor);
+}
+
+/*!
+\brief Combines the polygons of a range with each other \brief_strategy
+\ingroup union
+\details The polygons are ordered spatially and merged pairwise, level by
+    level (cascaded union).
+\tparam Polygons Range of polygons, not being a geometry
+\tparam MultiPolygon \tparam_geometry{MultiPolygon}
+\tparam Strategy \tparam_strategy{Union_}
+\param polygons The polygons, possibly overlapping
+\param output The multi polygon to which the result is appended
+\param strategy \param_strategy{union_}
+ */
+template
+<
+    typename Polygons,
+    typename MultiPolygon,
+    typename Strategy,
+    std::enable_if_t<util::is_not_geometry<Polygons>::value, int> = 0
+>
+inline void union_(Polygons const& polygons,
+                   MultiPolygon& output,
+                   Strategy const& strategy)
+{
+    geometry::union_(polygons, output, strategy, util::sequential_executor());
+}
+
+/*!
+\brief Combines the polygons of a range or of a multi polygon with each other
+\ingroup union
+\details The polygons are ordered spatially and merged pairwise, level by
+    level (cascaded union).
+\tparam Polygons Range of polygons or multi polygon
+\tparam MultiPolygon \tparam_geometry{MultiPolygon}
+\param polygons The polygons, possibly overlapping
+\param output The multi polygon to which the result is appended
+ */
+template <typename Polygons, typename MultiPolygon>
+inline void union_(Polygons const& polygons, MultiPolygon& output)
+{
+    concepts::check<typename boost::range_value<Polygons>::type const>();
+    concepts::check<MultiPolygon>();
+
+    resolve_strategy::cascaded_union
+        <
+            default_strategy
+        >::apply(polygons, output, default_strategy(), util::sequential_executor());
+}
+
+
 }} // namespace boost::geometry
 
 
@@ -0,0 +1,202 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_WITHIN_EACH_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_WITHIN_EACH_HPP
+
+
+#include <boost/range/value_type.hpp>
+
+#include <boost/geometry/algorithms/detail/within/points_in_geometry.hpp>
+
+#include <boost/geometry/core/point_type.hpp>
+
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/strategies/default_strategy.hpp>
+#include <boost/geometry/strategies/detail.hpp>
+#include <boost/geometry/strategies/relate/cartesian.hpp>
+#include <boost/geometry/strategies/relate/geographic.hpp>
+#include <boost/geometry/strategies/relate/services.hpp>
+#include <boost/geometry/strategies/relate/spherical.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+namespace resolve_strategy
+{
+
+template
+<
+    typename Strategy,
+    bool IsUmbrella = strategies::detail::is_umbrella_strategy<Strategy>::value
+>
+struct points_in_geometry
+{
+    template <typename Points, typename Geometry, typename F>
+    static inline void apply(Points const& points, Geometry const& geometry,
+                             Strategy const& strategy, F&& f)
+    {
+        detail::within::points_in_geometry(points, geometry, strategy, f);
+    }
+};
+
+template <typename Strategy>
+struct points_in_geometry<Strategy, false>
+{
+    template <typename Points, typename Geometry, typename F>
+    static inline void apply(Points const& points, Geometry const& geometry,
+                             Strategy const& strategy, F&& f)
+    {
+        using strategies::relate::services::strategy_converter;
+
+        detail::within::points_in_geometry(points, geometry,
+                                           strategy_converter<Strategy>::get(strategy),
+                                           f);
+    }
+};
+
+template <>
+struct points_in_geometry<default_strategy, false>
+{
+    template <typename Points, typename Geometry, typename F>
+    static inline void apply(Points const& points, Geometry const& geometry,
+                             default_strategy, F&& f)
+    {
+        typedef typename strategies::relate::services::default_strategy
+            <
+                typename boost::range_value<Points>::type,
+                Geometry
+            >::type strategy_type;
+
+        detail::within::points_in_geometry(points, geometry, strategy_type(), f);
+    }
+};
+
+} // namespace resolve_strategy
+
+
+/*!
+\brief Checks for each point of a range if it is completely inside a geometry
+    \brief_strategy
+\ingroup within
+\details The points are checked in blocks, each ring of the geometry is
+    traversed once per block of points instead of once per point. The results
+    are the same as the results of within called for each point.
+\tparam Points Range of points
+\tparam Geometry \tparam_geometry
+\tparam OutputIterator Output iterator accepting bool
+\tparam Strategy \tparam_strategy{Within}
+\param points The points
+\param geometry \param_geometry, ring, polygon or multi_polygon
+\param out Output iterator, for each point true is written if the point is
+    inside the geometry, else false
+\param strategy strategy to be used
+\return The output iterator
+ */
+template <typename Points, typename Geometry, typename OutputIterator, typename Strategy>
+inline OutputIterator within_each(Points const& points, Geometry const& geometry,
+                                  OutputIterator out, Strategy const& strategy)
+{
+    concepts::check<typename boost::range_value<Points>::type const>();
+    concepts::check<Geometry const>();
+
+    resolve_strategy::points_in_geometry
+        <
+            Strategy
+        >::apply(points, geometry, strategy, [&](int code)
+        {
+            *out++ = code == 1;
+        });
+    return out;
+}
+
+/*!
+\brief Checks for each point of a range if it is completely inside a geometry
+\ingroup within
+\details The points are checked in blocks, each ring of the geometry is
+    traversed once per block of points instead of once per point. The results
+    are the same as the results of within called for each point.
+\tparam Points Range of points
+\tparam Geometry \tparam_geometry
+\tparam OutputIterator Output iterator accepting bool
+\param points The points
+\param geometry \param_geometry, ring, polygon or multi_polygon
+\param out Output iterator, for each point true is written if the point is
+    inside the geometry, else false
+\return The output iterator
+ */
+template <typename Points, typename Geometry, typename OutputIterator>
+inline OutputIterator within_each(Points const& points, Geometry const& geometry,
+                                  OutputIterator out)
+{
+    return geometry::within_each(points, geometry, out, default_strategy());
+}
+
+/*!
+\brief Checks for each point of a range if it is inside or on the border of
+    a geometry \brief_strategy
+\ingroup covered_by
+\details The results are the same as the results of covered_by called for
+    each point.
+\tparam Points Range of points
+\tparam Geometry \tparam_geometry
+\tparam OutputIterator Output iterator accepting bool
+\tparam Strategy \tparam_strategy{Covered_by}
+\param points The points
+\param geometry \param_geometry, ring, polygon or multi_polygon
+\param out Output iterator, for each point true is written if the point is
+    inside or on the border of the geometry, else false
+\param strategy strategy to be used
+\return The output iterator
+ */
+template <typename Points, typename Geometry, typename OutputIterator, typename Strategy>
+inline OutputIterator covered_by_each(Points const& points, Geometry const& geometry,
+                                      OutputIterator out, Strategy const& strategy)
+{
+    concepts::check<typename boost::range_value<Points>::type const>();
+    concepts::check<Geometry const>();
+
+    resolve_strategy::points_in_geometry
+        <
+            Strategy
+        >::apply(points, geometry, strategy, [&](int code)
+        {
+            *out++ = code >= 0;
+        });
+    return out;
+}
+
+/*!
+\brief Checks for each point of a range if it is inside or on the border of
+    a geometry
+\ingroup covered_by
+\details The results are the same as the results of covered_by called for
+    each point.
+\tparam Points Range of points
+\tparam Geometry \tparam_geometry
+\tparam OutputIterator Output iterator accepting bool
+\param points The points
+\param geometry \param_geometry, ring, polygon or multi_polygon
+\param out Output iterator, for each point true is written if the point is
+    inside or on the border of the geometry, else false
+\return The output iterator
+ */
+template <typename Points, typename Geometry, typename OutputIterator>
+inline OutputIterator covered_by_each(Points const& points, Geometry const& geometry,
+                                      OutputIterator out)
+{
+    return geometry::covered_by_each(points, geometry, out, default_strategy());
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_WITHIN_EACH_HPP
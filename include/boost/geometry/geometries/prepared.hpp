@@ -0,0 +1,622 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_GEOMETRIES_PREPARED_HPP
+#define BOOST_GEOMETRY_GEOMETRIES_PREPARED_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/empty.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/range/size.hpp>
+
+#include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/algorithms/convert.hpp>
+#include <boost/geometry/algorithms/detail/envelope/interface.hpp>
+#include <boost/geometry/algorithms/detail/expand_by_epsilon.hpp>
+#include <boost/geometry/algorithms/detail/overlay/do_reverse.hpp>
+#include <boost/geometry/algorithms/detail/overlay/get_turns.hpp>
+#include <boost/geometry/algorithms/detail/sections/sectionalize.hpp>
+#include <boost/geometry/algorithms/detail/within/point_in_geometry.hpp>
+#include <boost/geometry/algorithms/detail/within/winding_slab_index.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/coordinate_system.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/point_order.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+#include <boost/geometry/core/static_assert.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/policies/robustness/no_rescale_policy.hpp>
+#include <boost/geometry/strategies/cartesian/point_in_poly_winding.hpp>
+#include <boost/geometry/strategies/envelope/services.hpp>
+#include <boost/geometry/util/math.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace prepared
+{
+
+// The rings and multi-polygons are ranges, the polygons are not
+template <typename Geometry, typename Tag = typename geometry::tag<Geometry>::type>
+class prepared_base
+{
+public:
+    explicit prepared_base(Geometry const& geometry)
+        : m_geometry(&geometry)
+    {}
+
+protected:
+    Geometry const* m_geometry;
+};
+
+template <typename Geometry>
+class range_prepared_base
+{
+public:
+    using iterator = typename boost::range_iterator<Geometry const>::type;
+    using const_iterator = iterator;
+
+    explicit range_prepared_base(Geometry const& geometry)
+        : m_geometry(&geometry)
+    {}
+
+    const_iterator begin() const { return boost::begin(*m_geometry); }
+    const_iterator end() const { return boost::end(*m_geometry); }
+
+protected:
+    Geometry const* m_geometry;
+};
+
+template <typename Geometry>
+class prepared_base<Geometry, ring_tag>
+    : public range_prepared_base<Geometry>
+{
+public:
+    explicit prepared_base(Geometry const& geometry)
+        : range_prepared_base<Geometry>(geometry)
+    {}
+};
+
+template <typename Geometry>
+class prepared_base<Geometry, multi_polygon_tag>
+    : public range_prepared_base<Geometry>
+{
+public:
+    explicit prepared_base(Geometry const& geometry)
+        : range_prepared_base<Geometry>(geometry)
+    {}
+};
+
+// Combines the codes of the rings like point_in_geometry
+template <typename Geometry, typename Tag = typename geometry::tag<Geometry>::type>
+struct combine_ring_codes
+{
+    static inline int apply(Geometry const& , int const* codes)
+    {
+        return codes[0];
+    }
+};
+
+template <typename Polygon>
+struct combine_ring_codes<Polygon, polygon_tag>
+{
+    static inline int apply(Polygon const& polygon, int const* codes)
+    {
+        int const code = codes[0];
+        if (code == 1)
+        {
+            std::size_t const count = boost::size(interior_rings(polygon));
+            for (std::size_t i = 1; i <= count; ++i)
+            {
+                if (codes[i] != -1)
+                {
+                    // If 0, return 0 (touch)
+                    // If 1 (inside hole) return -1 (outside polygon)
+                    return -codes[i];
+                }
+            }
+        }
+        return code;
+    }
+};
+
+template <typename MultiPolygon>
+struct combine_ring_codes<MultiPolygon, multi_polygon_tag>
+{
+    static inline int apply(MultiPolygon const& multi, int const* codes)
+    {
+        for (auto it = boost::begin(multi); it != boost::end(multi); ++it)
+        {
+            int const code = combine_ring_codes
+                <
+                    typename boost::range_value<MultiPolygon>::type
+                >::apply(*it, codes);
+
+            // inside or on the boundary
+            if (code >= 0)
+            {
+                return code;
+            }
+
+            codes += 1 + boost::size(interior_rings(*it));
+        }
+        return -1;
+    }
+};
+
+template <typename Strategy>
+struct is_cartesian_winding
+{
+    template <typename Side, typename CalculationType>
+    static std::true_type test(strategy::within::detail::cartesian_winding_base
+                                   <
+                                       Side, CalculationType
+                                   > const*);
+    static std::false_type test(...);
+
+    static const bool value = decltype(test(std::declval<Strategy const*>()))::value;
+};
+
+}} // namespace detail::prepared
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Areal geometry with cached data used to speed up repeated
+    evaluation of predicates.
+\details The prepared geometry refers to the areal geometry (which has to
+    outlive it and must not be modified) and stores its envelope, the
+    envelopes of its rings indexed with an rtree, the indexes of the
+    segments of the rings (the same as in cartesian_indexed_winding) and the
+    monotonic sections of the rings. It models the concept of the adapted
+    geometry so it can be passed to all algorithms.
+    The spatial predicates (within, covered_by, intersects, disjoint, relate,
+    relation) checking points against the prepared geometry use the cached
+    data instead of traversing all segments of the rings.
+\tparam Geometry \tparam_geometry{Ring, Polygon or MultiPolygon}
+\ingroup geometries
+
+\qbk{[heading Example]}
+\qbk{
+[pre
+bg::prepared<polygon_t> const prepared_zone(zone);
+for (auto const& pt : points)
+    if (bg::within(pt, prepared_zone)) ...
+]
+}
+*/
+template <typename Geometry>
+class prepared
+    : public detail::prepared::prepared_base<Geometry>
+{
+    using base_t = detail::prepared::prepared_base<Geometry>;
+    using point_t = typename geometry::point_type<Geometry>::type;
+
+    BOOST_GEOMETRY_STATIC_ASSERT(
+        (util::is_polygonal<Geometry>::value),
+        "Only Ring, Polygon and MultiPolygon can be prepared.",
+        Geometry);
+
+    BOOST_GEOMETRY_STATIC_ASSERT(
+        (std::is_same<typename geometry::cs_tag<Geometry>::type, cartesian_tag>::value),
+        "Not implemented for this coordinate system.",
+        typename geometry::cs_tag<Geometry>::type);
+
+public:
+    using geometry_type = Geometry;
+    using box_type = model::box<point_t>;
+    using sections_type = geometry::sections<box_type, 2>;
+
+    // The sections are reversed like the ones created by get_turns called
+    // by relate, intersection and union
+    static const bool sections_reversed = detail::overlay::do_reverse
+        <
+            geometry::point_order<Geometry>::value
+        >::value;
+
+    /// Constructor preparing the geometry
+    explicit prepared(Geometry const& geometry)
+        : base_t(geometry)
+    {
+        using envelope_strategy_t = typename strategies::envelope::services::default_strategy
+            <
+                Geometry, box_type
+            >::type;
+        using coor_t = typename coordinate_type<point_t>::type;
+
+        envelope_strategy_t const strategy;
+        geometry::envelope(geometry, m_envelope, strategy);
+
+        // Enlarged by the tolerance of the strategy comparing coordinates
+        m_enlarged_envelope = m_envelope;
+        detail::expand_by_epsilon(m_enlarged_envelope, math::scaled_epsilon<coor_t>(1000));
+
+        double const epsilon = detail::within::winding_slab_epsilon<coor_t>();
+        // The average number of segments per slab of the indexes of the rings
+        std::size_t const segments_per_slab = 4;
+
+        // The rings of polygons have consecutive indexes, the exterior ring
+        // of the first polygon is the first one
+        std::vector<index_value_t> values;
+        detail::within::for_each_ring<Geometry>::apply(geometry,
+            [&](ring_t const& ring)
+            {
+                std::size_t const i = m_rings.size();
+                m_rings.push_back(std::addressof(ring));
+                m_ring_indexes.emplace_back(ring, epsilon, segments_per_slab);
+
+                // The degenerated rings are not checked by point_in_geometry
+                if (boost::size(ring) >= core_detail::closure::minimum_ring_size
+                        <
+                            geometry::closure<ring_t>::value
+                        >::value)
+                {
+                    box_type box;
+                    geometry::envelope(ring, box, strategy);
+                    detail::expand_by_epsilon(box, math::scaled_epsilon<coor_t>(1000));
+                    values.emplace_back(box, i);
+                }
+            });
+        index_t(values).swap(m_index);
+
+        // The sections used by get_turns, e.g. called by relate(), within(),
+        // disjoint() or intersection() of linear or areal geometries
+        geometry::sectionalize
+            <
+                sections_reversed, std::integer_sequence<std::size_t, 0, 1>
+            >(geometry, detail::no_rescale_policy(), m_sections, strategy);
+
+        std::vector<index_value_t> section_values;
+        section_values.reserve(m_sections.size());
+        for (std::size_t i = 0; i < m_sections.size(); ++i)
+        {
+            section_values.emplace_back(m_sections[i].bounding_box, i);
+        }
+        index_t(section_values).swap(m_sections_index);
+    }
+
+    /// Returns the prepared geometry
+    Geometry const& geometry() const { return *this->m_geometry; }
+
+    /// Returns the envelope of the prepared geometry
+    box_type const& envelope() const { return m_envelope; }
+
+    /// Returns the sections of the prepared geometry
+    sections_type const& sections() const { return m_sections; }
+
+#ifndef DOXYGEN_NO_DETAIL
+    // Returns the sections overlapping the bounding box of the other
+    // sections, in the original order. Returns all sections without copying
+    // them if all of them overlap it.
+    inline sections_type const& sections(sections_type const& other,
+                                         sections_type& result) const
+    {
+        box_type total;
+        geometry::assign_inverse(total);
+        for (auto const& section : other)
+        {
+            geometry::expand(total, section.bounding_box);
+        }
+
+        std::vector<std::size_t> ids;
+        if (! boost::empty(other))
+        {
+            for (auto it = m_sections_index.qbegin(index::intersects(total));
+                 it != m_sections_index.qend(); ++it)
+            {
+                ids.push_back(it->second);
+            }
+        }
+        if (ids.size() == m_sections.size())
+        {
+            return m_sections;
+        }
+
+        std::sort(ids.begin(), ids.end());
+        result.clear();
+        for (std::size_t id : ids)
+        {
+            result.push_back(m_sections[id]);
+        }
+        return result;
+    }
+#endif // DOXYGEN_NO_DETAIL
+
+#ifndef DOXYGEN_NO_DETAIL
+    // 1 - in the interior, 0 - on the boundary, -1 - in the exterior
+    template <typename Point, typename Strategy>
+    inline int point_in_geometry(Point const& point, Strategy const& strategy) const
+    {
+        using pip_strategy_t = decltype(strategy.relate(point, std::declval<ring_t const&>()));
+
+        return point_in_geometry(point, strategy,
+            std::integral_constant
+                <
+                    bool, detail::prepared::is_cartesian_winding<pip_strategy_t>::value
+                >());
+    }
+#endif // DOXYGEN_NO_DETAIL
+
+private:
+    using ring_t = typename geometry::ring_type<Geometry>::type;
+    using index_value_t = std::pair<box_type, std::size_t>;
+    using index_t = index::rtree<index_value_t, index::rstar<16, 4> >;
+
+    template <typename Point, typename Strategy>
+    inline int point_in_geometry(Point const& point, Strategy const& strategy,
+                                 std::false_type) const
+    {
+        return detail::within::point_in_geometry(point, geometry(), strategy);
+    }
+
+    template <typename Point, typename Strategy>
+    inline int point_in_geometry(Point const& point, Strategy const& strategy,
+                                 std::true_type) const
+    {
+        if (geometry::get<0>(point) < geometry::get<min_corner, 0>(m_enlarged_envelope)
+            || geometry::get<0>(point) > geometry::get<max_corner, 0>(m_enlarged_envelope)
+            || geometry::get<1>(point) < geometry::get<min_corner, 1>(m_enlarged_envelope)
+            || geometry::get<1>(point) > geometry::get<max_corner, 1>(m_enlarged_envelope))
+        {
+            return -1;
+        }
+
+        // The rings not crossed by the vertical line of the point below it
+        // do not contain the point
+        box_type query_box;
+        geometry::set<min_corner, 0>(query_box, geometry::get<0>(point));
+        geometry::set<min_corner, 1>(query_box, geometry::get<min_corner, 1>(m_enlarged_envelope));
+        geometry::set<max_corner, 0>(query_box, geometry::get<0>(point));
+        geometry::set<max_corner, 1>(query_box, geometry::get<1>(point));
+
+        std::vector<int> codes(m_rings.size(), -1);
+        for (auto it = m_index.qbegin(index::intersects(query_box)); it != m_index.qend(); ++it)
+        {
+            std::size_t const i = it->second;
+            ring_t const& ring = *m_rings[i];
+            codes[i] = m_ring_indexes[i].apply(point, ring, strategy.relate(point, ring));
+        }
+
+        return detail::prepared::combine_ring_codes<Geometry>::apply(geometry(), codes.data());
+    }
+
+    box_type m_envelope;
+    box_type m_enlarged_envelope;
+    std::vector<ring_t const*> m_rings;
+    std::vector<detail::within::winding_slab_index> m_ring_indexes;
+    index_t m_index;
+    sections_type m_sections;
+    index_t m_sections_index;
+};
+
+
+#ifndef DOXYGEN_NO_TRAITS_SPECIALIZATIONS
+namespace traits
+{
+
+template <typename Geometry>
+struct tag<geometry::prepared<Geometry> >
+{
+    using type = typename geometry::tag<Geometry>::type;
+};
+
+template <typename Geometry>
+struct point_order<geometry::prepared<Geometry> >
+{
+    static const order_selector value = geometry::point_order<Geometry>::value;
+};
+
+template <typename Geometry>
+struct closure<geometry::prepared<Geometry> >
+{
+    static const closure_selector value = geometry::closure<Geometry>::value;
+};
+
+template <typename Polygon>
+struct ring_const_type<geometry::prepared<Polygon> >
+{
+    using type = typename geometry::ring_return_type<Polygon const>::type;
+};
+
+// Used to get the ring type, the rings can't be modified
+template <typename Polygon>
+struct ring_mutable_type<geometry::prepared<Polygon> >
+{
+    using type = typename geometry::ring_return_type<Polygon>::type;
+};
+
+template <typename Polygon>
+struct interior_const_type<geometry::prepared<Polygon> >
+{
+    using type = typename geometry::interior_return_type<Polygon const>::type;
+};
+
+template <typename Polygon>
+struct interior_mutable_type<geometry::prepared<Polygon> >
+{
+    using type = typename geometry::interior_return_type<Polygon>::type;
+};
+
+template <typename Polygon>
+struct exterior_ring<geometry::prepared<Polygon> >
+{
+    static inline typename geometry::ring_return_type<Polygon const>::type
+        get(geometry::prepared<Polygon> const& p)
+    {
+        return geometry::exterior_ring(p.geometry());
+    }
+};
+
+template <typename Polygon>
+struct interior_rings<geometry::prepared<Polygon> >
+{
+    static inline typename geometry::interior_return_type<Polygon const>::type
+        get(geometry::prepared<Polygon> const& p)
+    {
+        return geometry::interior_rings(p.geometry());
+    }
+};
+
+} // namespace traits
+#endif // DOXYGEN_NO_TRAITS_SPECIALIZATIONS
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace prepared
+{
+
+struct prepared_point_in_geometry
+{
+    template <typename Point, typename Prepared, typename Strategy>
+    static inline int apply(Point const& point, Prepared const& prepared,
+                            Strategy const& strategy)
+    {
+        return prepared.point_in_geometry(point, strategy);
+    }
+};
+
+struct prepared_envelope
+{
+    template <typename Prepared, typename Box, typename Strategy>
+    static inline void apply(Prepared const& prepared, Box& mbr, Strategy const& )
+    {
+        geometry::convert(prepared.envelope(), mbr);
+    }
+};
+
+}} // namespace detail::prepared
+
+namespace detail { namespace get_turns
+{
+
+// The cached sections are used if they are the same as the ones which
+// would be created, the source index of the sections is not used by
+// get_turns
+template <bool Reverse, typename Geometry>
+struct geometry_sections<Reverse, geometry::prepared<Geometry> >
+{
+    static const bool cached = true;
+
+    using prepared_type = geometry::prepared<Geometry>;
+
+    template <typename RobustPolicy, typename Strategy, typename Sections>
+    static inline Sections const& apply(prepared_type const& prepared,
+                                        RobustPolicy const& robust_policy,
+                                        Strategy const& strategy,
+                                        Sections& sections,
+                                        int source_index,
+                                        Sections const* other)
+    {
+        return apply(prepared, robust_policy, strategy, sections, source_index, other,
+            std::integral_constant
+                <
+                    bool,
+                    Reverse == prepared_type::sections_reversed
+                 && std::is_same<RobustPolicy, detail::no_rescale_policy>::value
+                 && std::is_same<Sections, typename prepared_type::sections_type>::value
+                >());
+    }
+
+private:
+    template <typename RobustPolicy, typename Strategy, typename Sections>
+    static inline Sections const& apply(prepared_type const& prepared,
+                                        RobustPolicy const& ,
+                                        Strategy const& ,
+                                        Sections& sections,
+                                        int ,
+                                        Sections const* other,
+                                        std::true_type)
+    {
+        return other == nullptr
+             ? prepared.sections()
+             : prepared.sections(*other, sections);
+    }
+
+    template <typename RobustPolicy, typename Strategy, typename Sections>
+    static inline Sections const& apply(prepared_type const& prepared,
+                                        RobustPolicy const& robust_policy,
+                                        Strategy const& strategy,
+                                        Sections& sections,
+                                        int source_index,
+                                        Sections const* other,
+                                        std::false_type)
+    {
+        return geometry_sections<Reverse, Geometry>::apply(prepared.geometry(),
+            robust_policy, strategy, sections, source_index, other);
+    }
+};
+
+}} // namespace detail::get_turns
+#endif // DOXYGEN_NO_DETAIL
+
+
+#ifndef DOXYGEN_NO_DISPATCH
+namespace detail_dispatch { namespace within
+{
+
+template <typename Geometry>
+struct point_in_geometry<geometry::prepared<Geometry>, ring_tag>
+    : detail::prepared::prepared_point_in_geometry
+{};
+
+template <typename Geometry>
+struct point_in_geometry<geometry::prepared<Geometry>, polygon_tag>
+    : detail::prepared::prepared_point_in_geometry
+{};
+
+template <typename Geometry>
+struct point_in_geometry<geometry::prepared<Geometry>, multi_polygon_tag>
+    : detail::prepared::prepared_point_in_geometry
+{};
+
+}} // namespace detail_dispatch::within
+
+namespace dispatch
+{
+
+template <typename Geometry>
+struct envelope<geometry::prepared<Geometry>, ring_tag>
+    : detail::prepared::prepared_envelope
+{};
+
+template <typename Geometry>
+struct envelope<geometry::prepared<Geometry>, polygon_tag>
+    : detail::prepared::prepared_envelope
+{};
+
+template <typename Geometry>
+struct envelope<geometry::prepared<Geometry>, multi_polygon_tag>
+    : detail::prepared::prepared_envelope
+{};
+
+} // namespace dispatch
+#endif // DOXYGEN_NO_DISPATCH
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_GEOMETRIES_PREPARED_HPP
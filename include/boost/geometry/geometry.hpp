@@ -107,6 +107,7 @@
 #include <boost/geometry/algorithms/union.hpp>
 #include <boost/geometry/algorithms/unique.hpp>
 #include <boost/geometry/algorithms/within.hpp>
+#include <boost/geometry/algorithms/within_each.hpp>
 
 // check includes all concepts
 #include <boost/geometry/geometries/concepts/check.hpp>
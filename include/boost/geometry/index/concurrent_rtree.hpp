@@ -0,0 +1,472 @@
+// Boost.Geometry Index
+//
+// R-tree allowing concurrent reads and single writer
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_CONCURRENT_RTREE_HPP
+#define BOOST_GEOMETRY_INDEX_CONCURRENT_RTREE_HPP
+
+// STD
+#include <mutex>
+#include <utility>
+
+// Boost
+#include <boost/container/new_allocator.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+// Boost.Geometry.Index
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/geometry/index/detail/left_right.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief The R-tree which may be queried concurrently with modifications.
+
+The container stores two instances of the rtree. The queries are performed
+on one of them while the other one is modified. Then the queries are switched
+to the modified instance and, after the queries started before the switch
+finish, the same modification is applied to the other instance.
+
+The queries never wait and see a consistent snapshot of the tree. Many
+threads may query the tree at the same time. The modifications are serialized
+and wait for the queries performed on the instance which is going to be
+modified. The memory used is twice the memory used by the rtree and each
+modification is performed twice. Many modifications may be grouped with
+modify() in order to publish them at once and wait for the readers once.
+
+\warning
+A thread holding a snapshot must not modify the container. The modification
+would wait for the snapshot to be released, i.e. forever. The same applies to
+calling a modifying function from within the function object passed to modify().
+
+\tparam Value           The type of objects stored in the container.
+\tparam Parameters      Compile-time parameters.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+\tparam Allocator       The allocator used to allocate/deallocate memory,
+                        construct/destroy nodes and Values.
+*/
+template
+<
+    typename Value,
+    typename Parameters,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>,
+    typename Allocator = boost::container::new_allocator<Value>
+>
+class concurrent_rtree
+{
+public:
+    /*! \brief The type of the rtree instances. */
+    typedef rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> rtree_type;
+
+    /*! \brief The type of Value stored in the container. */
+    typedef Value value_type;
+    /*! \brief R-tree parameters type. */
+    typedef Parameters parameters_type;
+    /*! \brief The function object extracting Indexable from Value. */
+    typedef IndexableGetter indexable_getter;
+    /*! \brief The function object comparing objects of type Value. */
+    typedef EqualTo value_equal;
+    /*! \brief The type of allocator used by the container. */
+    typedef Allocator allocator_type;
+    /*! \brief The Indexable type to which Value is translated. */
+    typedef typename rtree_type::indexable_type indexable_type;
+    /*! \brief The Box type used by the R-tree. */
+    typedef typename rtree_type::bounds_type bounds_type;
+    /*! \brief Unsigned integral type used by the container. */
+    typedef typename rtree_type::size_type size_type;
+
+private:
+    typedef detail::left_right<rtree_type> left_right_type;
+
+public:
+    /*!
+    \brief The consistent state of the tree.
+
+    The snapshot gives access to the rtree which is not modified as long as
+    the snapshot exists. The modifications wait for the snapshots created
+    before them so the snapshot shouldn't be kept longer than necessary.
+    In particular the thread holding the snapshot must release it before
+    modifying the container, otherwise the modification never returns.
+    */
+    class snapshot
+    {
+        friend class concurrent_rtree;
+
+        explicit snapshot(left_right_type const& lr)
+            : m_guard(lr)
+        {}
+
+    public:
+        /*!
+        \brief The move constructor.
+        */
+        snapshot(snapshot && other)
+            : m_guard(std::move(other.m_guard))
+        {}
+
+        /*!
+        \brief Returns the rtree.
+        */
+        rtree_type const& operator*() const
+        {
+            return m_guard.get();
+        }
+
+        /*!
+        \brief Returns the pointer to the rtree.
+        */
+        rtree_type const* operator->() const
+        {
+            return &m_guard.get();
+        }
+
+    private:
+        typename left_right_type::read_guard m_guard;
+    };
+
+    /*!
+    \brief The constructor creating an empty container.
+
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    If allocator copy constructor throws.
+    */
+    inline explicit concurrent_rtree(parameters_type const& parameters = parameters_type(),
+                                     indexable_getter const& getter = indexable_getter(),
+                                     value_equal const& equal = value_equal(),
+                                     allocator_type const& allocator = allocator_type())
+        : m_left_right(rtree_type(parameters, getter, equal, allocator))
+    {}
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm.
+
+    \param rng          The range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template <typename Range>
+    inline explicit concurrent_rtree(Range const& rng,
+                                     parameters_type const& parameters = parameters_type(),
+                                     indexable_getter const& getter = indexable_getter(),
+                                     value_equal const& equal = value_equal(),
+                                     allocator_type const& allocator = allocator_type())
+        : m_left_right(rtree_type(::boost::begin(rng), ::boost::end(rng), parameters, getter, equal, allocator))
+    {}
+
+    /*!
+    \brief The constructor creating the container containing the copies of the rtree.
+
+    \param tree         The rtree.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor throws.
+    \li If allocation throws or returns invalid value.
+    */
+    inline explicit concurrent_rtree(rtree_type const& tree)
+        : m_left_right(tree)
+    {}
+
+    /*!
+    \brief Insert a value to the index.
+
+    The value is visible for the queries started after the function returns.
+
+    \param value    The value which will be stored in the container.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+
+    \par Exception-safety
+    If the insertion into the first instance throws the container is not modified. Otherwise
+    the value is inserted. In both cases the container is left in a consistent state unless
+    the copying of the rtree throws.
+    */
+    inline void insert(value_type const& value)
+    {
+        modify([&](rtree_type & tree) { tree.insert(value); });
+    }
+
+    /*!
+    \brief Insert a range of values to the index.
+
+    The values are visible for the queries started after the function returns.
+
+    \param first    The beginning of the range of values. Has to be ForwardIterator.
+    \param last     The end of the range of values.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template <typename Iterator>
+    inline void insert(Iterator first, Iterator last)
+    {
+        modify([&](rtree_type & tree) { tree.insert(first, last); });
+    }
+
+    /*!
+    \brief Remove a value from the container.
+
+    \param value    The value which will be removed from the container.
+
+    \return         1 if the value was removed, 0 otherwise.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    inline size_type remove(value_type const& value)
+    {
+        size_type result = 0;
+        modify([&](rtree_type & tree) { result = tree.remove(value); });
+        return result;
+    }
+
+    /*!
+    \brief Remove a range of values from the container.
+
+    \param first    The beginning of the range of values. Has to be ForwardIterator.
+    \param last     The end of the range of values.
+
+    \return         The number of removed values.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template <typename Iterator>
+    inline size_type remove(Iterator first, Iterator last)
+    {
+        size_type result = 0;
+        modify([&](rtree_type & tree) { result = tree.remove(first, last); });
+        return result;
+    }
+
+    /*!
+    \brief Removes all values stored in the container.
+
+    \par Throws
+    Nothing.
+    */
+    inline void clear()
+    {
+        modify([](rtree_type & tree) { tree.clear(); });
+    }
+
+    /*!
+    \brief Modifies the tree with the function object.
+
+    The function object is called for both instances of the rtree so it has to
+    modify them in the same way, e.g. it may insert and remove Values. All of the
+    modifications are visible for the queries started after the function returns.
+
+    The function waits until the snapshots created before the modification are
+    released so it must not be called by a thread holding a snapshot of this
+    container, this would be a deadlock. The same is true for insert(), remove()
+    and clear() which call modify().
+
+    \par Example
+    \verbatim
+    tree.modify([&](Rtree::rtree_type & rt) {
+        rt.remove(old_position);
+        rt.insert(new_position);
+    });
+    \endverbatim
+
+    \param f        The function object taking rtree_type &.
+
+    \par Throws
+    If the function object throws.
+
+    \par Exception-safety
+    If the function object throws for the first instance the container is not modified.
+    If it throws for the second instance the modification of the first one is kept.
+    In both cases the container is left in a consistent state unless the copying of
+    the rtree throws.
+    */
+    template <typename Function>
+    inline void modify(Function && f)
+    {
+        std::lock_guard<std::mutex> lock(m_write_mutex);
+        m_left_right.write(f);                                                                     // MAY THROW
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates.
+
+    The query is performed on the consistent snapshot of the tree. It never waits
+    for the modifications. See rtree::query().
+
+    \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of values found.
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    */
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it) const
+    {
+        return m_left_right.read([&](rtree_type const& tree)
+        {
+            return tree.query(predicates, out_it);
+        });
+    }
+
+    /*!
+    \brief Returns the snapshot of the tree.
+
+    Many operations may be performed on the snapshot and all of them see the same
+    state of the tree.
+
+    \par Example
+    \verbatim
+    {
+        Rtree::snapshot s = tree.get_snapshot();
+        s->query(bgi::intersects(box), std::back_inserter(result));
+        std::size_t const size = s->size();
+    }
+    \endverbatim
+
+    \return     The snapshot.
+
+    \par Throws
+    Nothing.
+    */
+    snapshot get_snapshot() const
+    {
+        return snapshot(m_left_right);
+    }
+
+    /*!
+    \brief Returns the number of stored values.
+
+    \return         The number of stored values.
+
+    \par Throws
+    Nothing.
+    */
+    inline size_type size() const
+    {
+        return m_left_right.read([](rtree_type const& tree) { return tree.size(); });
+    }
+
+    /*!
+    \brief Query if the container is empty.
+
+    \return         true if the container is empty.
+
+    \par Throws
+    Nothing.
+    */
+    inline bool empty() const
+    {
+        return m_left_right.read([](rtree_type const& tree) { return tree.empty(); });
+    }
+
+    /*!
+    \brief Returns the box able to contain all values stored in the container.
+
+    \return     The box able to contain all values stored in the container or an invalid box if
+                there are no values in the container.
+
+    \par Throws
+    Nothing.
+    */
+    inline bounds_type bounds() const
+    {
+        return m_left_right.read([](rtree_type const& tree) { return tree.bounds(); });
+    }
+
+private:
+    concurrent_rtree(concurrent_rtree const&);
+    concurrent_rtree & operator=(concurrent_rtree const&);
+
+    left_right_type m_left_right;
+    std::mutex m_write_mutex;
+};
+
+/*!
+\brief Finds values meeting passed predicates.
+
+\ingroup rtree_functions
+
+\param tree         The concurrent rtree.
+\param predicates   Predicates.
+\param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+\return             The number of values found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Predicates, typename OutIter> inline
+typename concurrent_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+query(concurrent_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+      Predicates const& predicates,
+      OutIter out_it)
+{
+    return tree.query(predicates, out_it);
+}
+
+/*!
+\brief Insert a value to the index.
+
+\ingroup rtree_functions
+
+\param tree The concurrent rtree.
+\param v    The value which will be stored in the index.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline void insert(concurrent_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> & tree,
+                   Value const& v)
+{
+    tree.insert(v);
+}
+
+/*!
+\brief Remove a value from the container.
+
+\ingroup rtree_functions
+
+\param tree The concurrent rtree.
+\param v    The value which will be removed from the index.
+
+\return     1 if value was removed, 0 otherwise.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline typename concurrent_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+remove(concurrent_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> & tree,
+       Value const& v)
+{
+    return tree.remove(v);
+}
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_CONCURRENT_RTREE_HPP
@@ -52,6 +52,11 @@ struct bounds<Geometry, Bounds, segment_tag, box_tag>
     }
 };
 
+template <typename Geometry, typename Bounds>
+struct bounds<Geometry, Bounds, linestring_tag, box_tag>
+    : bounds<Geometry, Bounds, segment_tag, box_tag>
+{};
+
 
 } // namespace dispatch
 
@@ -123,6 +128,21 @@ struct expand<Bounds, Geometry, box_tag, segment_tag>
     }
 };
 
+template <typename Bounds, typename Geometry>
+struct expand<Bounds, Geometry, box_tag, linestring_tag>
+{
+    static inline void apply(Bounds & b, Geometry const& g)
+    {
+        geometry::expand(b, geometry::return_envelope<Bounds>(g));
+    }
+
+    template <typename Strategy>
+    static inline void apply(Bounds & b, Geometry const& g, Strategy const& s)
+    {
+        geometry::expand(b, geometry::return_envelope<Bounds>(g, s), s);
+    }
+};
+
 
 } // namespace dispatch
 
@@ -204,6 +224,11 @@ struct covered_by_bounds<Geometry, Bounds, segment_tag, box_tag>
     }
 };
 
+template <typename Geometry, typename Bounds>
+struct covered_by_bounds<Geometry, Bounds, linestring_tag, box_tag>
+    : covered_by_bounds<Geometry, Bounds, segment_tag, box_tag>
+{};
+
 
 } // namespace dispatch
 
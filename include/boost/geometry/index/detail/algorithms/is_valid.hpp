@@ -17,6 +17,8 @@
 
 #include <cstddef>
 
+#include <boost/range/empty.hpp>
+
 #include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/coordinate_dimension.hpp>
 #include <boost/geometry/core/static_assert.hpp>
@@ -81,6 +83,15 @@ struct is_valid<Indexable, segment_tag>
     }
 };
 
+template <typename Indexable>
+struct is_valid<Indexable, linestring_tag>
+{
+    static inline bool apply(Indexable const& ls)
+    {
+        return ! boost::empty(ls);
+    }
+};
+
 } // namespace dispatch
 
 template <typename Indexable>
@@ -118,6 +118,34 @@ private:
     Box m_box;
 };
 
+// Linestring -> Box
+
+template <typename Linestring, typename Box, typename Strategy, typename CSTag>
+struct bounded_view_base<Linestring, Box, Strategy, linestring_tag, box_tag, CSTag>
+{
+    typedef typename geometry::coordinate_type<Box>::type coordinate_type;
+
+    bounded_view_base(Linestring const& linestring, Strategy const& strategy)
+    {
+        geometry::envelope(linestring, m_box, strategy);
+    }
+
+    template <std::size_t Dimension>
+    inline coordinate_type get_min() const
+    {
+        return geometry::get<min_corner, Dimension>(m_box);
+    }
+
+    template <std::size_t Dimension>
+    inline coordinate_type get_max() const
+    {
+        return geometry::get<max_corner, Dimension>(m_box);
+    }
+
+private:
+    Box m_box;
+};
+
 // Box -> Box
 
 template <typename BoxIn, typename Box, typename Strategy, typename CSTag>
@@ -21,6 +21,7 @@
 
 #include <boost/geometry/algorithms/detail/covered_by/interface.hpp>
 #include <boost/geometry/algorithms/detail/disjoint/interface.hpp>
+#include <boost/geometry/algorithms/detail/distance/interface.hpp>
 #include <boost/geometry/algorithms/detail/intersects/interface.hpp>
 #include <boost/geometry/algorithms/detail/overlaps/interface.hpp>
 #include <boost/geometry/algorithms/detail/touches/interface.hpp>
@@ -146,6 +147,40 @@ struct comparable_distance_call<G1, G2, default_strategy>
 // calculate_distance
 // ------------------------------------------------------------------ //
 
+template
+<
+    typename G1, typename G2, typename Strategy
+>
+struct distance_call
+{
+    typedef typename geometry::distance_result
+        <
+            G1, G2, Strategy
+        >::type result_type;
+
+    static inline result_type apply(G1 const& g1, G2 const& g2, Strategy const& s)
+    {
+        return geometry::distance(g1, g2, s);
+    }
+};
+
+template
+<
+    typename G1, typename G2
+>
+struct distance_call<G1, G2, default_strategy>
+{
+    typedef typename geometry::default_distance_result
+        <
+            G1, G2
+        >::type result_type;
+
+    static inline result_type apply(G1 const& g1, G2 const& g2, default_strategy const&)
+    {
+        return geometry::distance(g1, g2);
+    }
+};
+
 template <typename Predicate, typename Indexable, typename Strategy, typename Tag>
 struct calculate_distance
 {
@@ -223,6 +258,55 @@ struct calculate_distance< predicates::path<SegmentOrLinestring>, Indexable, Str
     }
 };
 
+// Calculates the distance returned to the user, calculate_distance calculates
+// the comparable distance which may be e.g. squared
+
+template <typename Predicate, typename Indexable, typename Strategy>
+struct calculate_real_distance
+{
+    BOOST_GEOMETRY_STATIC_ASSERT_FALSE(
+        "Not implemented for this Predicate.",
+        Predicate, Indexable, Strategy);
+};
+
+template <typename PointRelation, typename Indexable, typename Strategy>
+struct calculate_real_distance< predicates::nearest<PointRelation>, Indexable, Strategy >
+{
+    typedef detail::relation<PointRelation> relation;
+    typedef distance_call
+        <
+            typename relation::value_type,
+            Indexable,
+            Strategy
+        > call_type;
+    typedef typename call_type::result_type result_type;
+
+    static inline result_type apply(predicates::nearest<PointRelation> const& p, Indexable const& i,
+                                    Strategy const& s)
+    {
+        return call_type::apply(relation::value(p.point_or_relation), i, s);
+    }
+};
+
+template <typename SegmentOrLinestring, typename Indexable, typename Strategy>
+struct calculate_real_distance< predicates::path<SegmentOrLinestring>, Indexable, Strategy >
+{
+    typedef calculate_distance
+        <
+            predicates::path<SegmentOrLinestring>, Indexable, Strategy, value_tag
+        > calculate_type;
+    typedef typename calculate_type::result_type result_type;
+
+    static inline result_type apply(predicates::path<SegmentOrLinestring> const& p, Indexable const& i,
+                                    Strategy const& s)
+    {
+        // the path distance is not comparable
+        result_type result = 0;
+        calculate_type::apply(p, i, s, result);
+        return result;
+    }
+};
+
 }}}} // namespace boost::geometry::index::detail
 
 #endif // BOOST_GEOMETRY_INDEX_RTREE_DISTANCE_PREDICATES_HPP
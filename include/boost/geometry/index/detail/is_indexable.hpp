@@ -42,6 +42,12 @@ struct is_indexable<Segment, geometry::segment_tag>
     static const bool value = true;
 };
 
+template <typename Linestring>
+struct is_indexable<Linestring, geometry::linestring_tag>
+{
+    static const bool value = true;
+};
+
 }}}} // namespave boost::geometry::index::detail
 
 #endif // BOOST_GEOMETRY_INDEX_DETAIL_IS_INDEXABLE_HPP
@@ -0,0 +1,172 @@
+// Boost.Geometry Index
+//
+// Left-Right concurrency control
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_LEFT_RIGHT_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_LEFT_RIGHT_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+#include <boost/core/no_exceptions_support.hpp>
+
+#include <boost/geometry/index/detail/assert.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail {
+
+// Two instances of an object are stored. The readers always access the one
+// indicated by the left-right index and the writer modifies the other one,
+// then switches the readers to it, waits until there are no readers of the
+// old one and applies the same modification to it. So the readers never wait
+// and always see a consistent state of the object. The writer waits for the
+// readers started before the switch.
+//
+// The readers are counted by two read indicators. A reader increments the
+// one indicated by the version index. The writer toggles the version index
+// and waits until the indicators are empty so it never waits for the readers
+// started after the switch.
+//
+// See: P. Ramalhete, A. Correia, "Left-Right: A Concurrency Control Technique
+// with Wait-Free Population Oblivious Reads", 2015.
+//
+// Only one writer is allowed at a time, it has to be ensured by the caller.
+// The writer must not hold a read_guard of the same object, it would wait for
+// itself.
+template <typename T>
+class left_right
+{
+    struct alignas(64) read_indicator
+    {
+        read_indicator() : count(0) {}
+
+        mutable std::atomic<std::size_t> count;
+    };
+
+public:
+    class read_guard
+    {
+    public:
+        explicit read_guard(left_right const& lr)
+            : m_lr(&lr)
+        {
+            m_version = m_lr->m_version_index.load();
+            m_lr->m_read_indicators[m_version].count.fetch_add(1);
+            m_instance = m_lr->m_left_right.load();
+        }
+
+        read_guard(read_guard && other)
+            : m_lr(other.m_lr), m_version(other.m_version), m_instance(other.m_instance)
+        {
+            other.m_lr = nullptr;
+        }
+
+        ~read_guard()
+        {
+            if (m_lr)
+            {
+                m_lr->m_read_indicators[m_version].count.fetch_sub(1);
+            }
+        }
+
+        T const& get() const
+        {
+            BOOST_GEOMETRY_INDEX_ASSERT(m_lr, "released read_guard");
+            return m_lr->m_instances[m_instance];
+        }
+
+    private:
+        read_guard(read_guard const&);
+        read_guard & operator=(read_guard const&);
+
+        left_right const* m_lr;
+        unsigned m_version;
+        unsigned m_instance;
+    };
+
+    explicit left_right(T const& t)
+        : m_instances{t, t}                                                                         // MAY THROW
+        , m_left_right(0)
+        , m_version_index(0)
+    {}
+
+    template <typename F>
+    auto read(F && f) const
+        -> decltype(f(std::declval<T const&>()))
+    {
+        read_guard guard(*this);
+        return f(guard.get());
+    }
+
+    // f is called for both instances so it has to modify them in the same way.
+    // If f throws the modified instance is replaced with the copy of the other one.
+    template <typename F>
+    void write(F && f)
+    {
+        unsigned const current = m_left_right.load();
+        unsigned const next = 1 - current;
+
+        // there are no readers of the next instance
+        BOOST_TRY
+        {
+            f(m_instances[next]);                                                                  // MAY THROW
+        }
+        BOOST_CATCH(...)
+        {
+            m_instances[next] = m_instances[current];                                              // MAY THROW
+            BOOST_RETHROW
+        }
+        BOOST_CATCH_END
+
+        m_left_right.store(next);
+        toggle_version_and_wait();
+
+        // there are no readers of the current instance anymore
+        BOOST_TRY
+        {
+            f(m_instances[current]);                                                               // MAY THROW
+        }
+        BOOST_CATCH(...)
+        {
+            m_instances[current] = m_instances[next];                                              // MAY THROW
+            BOOST_RETHROW
+        }
+        BOOST_CATCH_END
+    }
+
+private:
+    void toggle_version_and_wait()
+    {
+        unsigned const prev_version = m_version_index.load();
+        unsigned const next_version = 1 - prev_version;
+
+        // the readers of the next version could be left from the previous write
+        wait_for_readers(next_version);
+        m_version_index.store(next_version);
+        wait_for_readers(prev_version);
+    }
+
+    void wait_for_readers(unsigned version) const
+    {
+        while (m_read_indicators[version].count.load() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    T m_instances[2];
+    read_indicator m_read_indicators[2];
+    std::atomic<unsigned> m_left_right;
+    std::atomic<unsigned> m_version_index;
+};
+
+}}}} // namespace boost::geometry::index::detail
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_LEFT_RIGHT_HPP
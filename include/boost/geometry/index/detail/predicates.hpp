@@ -22,6 +22,7 @@
 
 #include <boost/geometry/algorithms/detail/covered_by/interface.hpp>
 #include <boost/geometry/algorithms/detail/disjoint/interface.hpp>
+#include <boost/geometry/algorithms/detail/distance/interface.hpp>
 #include <boost/geometry/algorithms/detail/intersects/interface.hpp>
 #include <boost/geometry/algorithms/detail/overlaps/interface.hpp>
 #include <boost/geometry/algorithms/detail/touches/interface.hpp>
@@ -88,6 +89,15 @@ struct spatial_predicate
     Geometry geometry;
 };
 
+template <typename Geometry, typename Distance, bool Negated>
+struct within_distance
+{
+    within_distance() {}
+    within_distance(Geometry const& g, Distance const& d) : geometry(g), distance(d) {}
+    Geometry geometry;
+    Distance distance;
+};
+
 // ------------------------------------------------------------------ //
 
 // CONSIDER: separated nearest<> and path<> may be replaced by
@@ -312,6 +322,54 @@ struct predicate_check<predicates::spatial_predicate<Geometry, Tag, true>, value
 
 // ------------------------------------------------------------------ //
 
+template <typename Strategy>
+struct within_distance_call
+{
+    template <typename G1, typename G2, typename Distance>
+    static inline bool apply(G1 const& g1, G2 const& g2, Distance const& d, Strategy const& s)
+    {
+        return geometry::distance(g1, g2, s) <= d;
+    }
+};
+
+template <>
+struct within_distance_call<default_strategy>
+{
+    template <typename G1, typename G2, typename Distance>
+    static inline bool apply(G1 const& g1, G2 const& g2, Distance const& d, default_strategy const&)
+    {
+        return geometry::distance(g1, g2) <= d;
+    }
+};
+
+// within distance predicate
+template <typename Geometry, typename Distance>
+struct predicate_check<predicates::within_distance<Geometry, Distance, false>, value_tag>
+{
+    typedef predicates::within_distance<Geometry, Distance, false> Pred;
+
+    template <typename Value, typename Indexable, typename Strategy>
+    static inline bool apply(Pred const& p, Value const&, Indexable const& i, Strategy const& s)
+    {
+        return within_distance_call<Strategy>::apply(p.geometry, i, p.distance, s);
+    }
+};
+
+// negated within distance predicate
+template <typename Geometry, typename Distance>
+struct predicate_check<predicates::within_distance<Geometry, Distance, true>, value_tag>
+{
+    typedef predicates::within_distance<Geometry, Distance, true> Pred;
+
+    template <typename Value, typename Indexable, typename Strategy>
+    static inline bool apply(Pred const& p, Value const&, Indexable const& i, Strategy const& s)
+    {
+        return !within_distance_call<Strategy>::apply(p.geometry, i, p.distance, s);
+    }
+};
+
+// ------------------------------------------------------------------ //
+
 template <typename DistancePredicates>
 struct predicate_check<predicates::nearest<DistancePredicates>, value_tag>
 {
@@ -504,6 +562,35 @@ struct predicate_check<predicates::spatial_predicate<Geometry, predicates::touch
 
 // ------------------------------------------------------------------ //
 
+// within distance predicate - the values may be closer than the box of the node
+// only if the minimum distance to the box is not greater than the distance
+template <typename Geometry, typename Distance>
+struct predicate_check<predicates::within_distance<Geometry, Distance, false>, bounds_tag>
+{
+    typedef predicates::within_distance<Geometry, Distance, false> Pred;
+
+    template <typename Value, typename Indexable, typename Strategy>
+    static inline bool apply(Pred const& p, Value const&, Indexable const& i, Strategy const& s)
+    {
+        return within_distance_call<Strategy>::apply(p.geometry, i, p.distance, s);
+    }
+};
+
+// negated within distance predicate
+template <typename Geometry, typename Distance>
+struct predicate_check<predicates::within_distance<Geometry, Distance, true>, bounds_tag>
+{
+    typedef predicates::within_distance<Geometry, Distance, true> Pred;
+
+    template <typename Value, typename Indexable, typename Strategy>
+    static inline bool apply(Pred const& , Value const&, Indexable const&, Strategy const&)
+    {
+        return true;
+    }
+};
+
+// ------------------------------------------------------------------ //
+
 template <typename DistancePredicates>
 struct predicate_check<predicates::nearest<DistancePredicates>, bounds_tag>
 {
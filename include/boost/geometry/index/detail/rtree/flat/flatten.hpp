@@ -0,0 +1,120 @@
+// Boost.Geometry Index
+//
+// R-tree flattening visitor implementation
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_FLATTEN_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_FLATTEN_HPP
+
+#include <limits>
+#include <vector>
+
+#include <boost/geometry/index/detail/exception.hpp>
+#include <boost/geometry/index/detail/rtree/flat/layout.hpp>
+#include <boost/geometry/index/detail/rtree/node/node.hpp>
+#include <boost/geometry/index/detail/rtree/utilities/view.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace flat {
+
+// Stores the nodes of the rtree in breadth-first order. The children of
+// internal nodes are queued and visited in the order of insertion into the
+// queue so the index of a node in the queue is its index in the flat rtree.
+template <typename MembersHolder, typename Nodes, typename Boxes, typename Values>
+class flatten
+    : public MembersHolder::visitor_const
+{
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+    typedef typename MembersHolder::node_pointer node_pointer;
+
+public:
+    flatten(Nodes & nodes, Boxes & boxes, Values & values)
+        : m_nodes(nodes), m_boxes(boxes), m_values(values)
+        , m_leafs_first(0), m_leaf_found(false)
+    {}
+
+    template <typename Rtree>
+    index_type apply(Rtree const& tree)
+    {
+        if (tree.empty())
+        {
+            return 0;
+        }
+
+        if (tree.size() > (std::numeric_limits<index_type>::max)())
+        {
+            throw_length_error("boost::geometry::index::flat_rtree: too many values");
+        }
+
+        utilities::view<Rtree> rtv(tree);
+
+        // the root
+        m_queue.push_back(node_pointer(0));                                                        // MAY THROW (A)
+        m_boxes.push_back(tree.bounds());                                                          // MAY THROW (A)
+        rtv.apply_visitor(*this);                                                                  // MAY THROW (A, C)
+
+        for (std::size_t i = 1 ; i < m_queue.size() ; ++i)
+        {
+            rtree::apply_visitor(*this, *m_queue[i]);                                              // MAY THROW (A, C)
+        }
+
+        return m_leafs_first;
+    }
+
+    void operator()(internal_node const& n)
+    {
+        auto const& elements = rtree::elements(n);
+
+        if (m_queue.size() + elements.size() > (std::numeric_limits<index_type>::max)())
+        {
+            throw_length_error("boost::geometry::index::flat_rtree: too many nodes");
+        }
+
+        node nd;
+        nd.first = index_type(m_queue.size());
+        nd.count = index_type(elements.size());
+        m_nodes.push_back(nd);                                                                     // MAY THROW (A)
+
+        for (auto const& el : elements)
+        {
+            m_queue.push_back(el.second);                                                          // MAY THROW (A)
+            m_boxes.push_back(el.first);                                                           // MAY THROW (A)
+        }
+    }
+
+    void operator()(leaf const& n)
+    {
+        auto const& elements = rtree::elements(n);
+
+        if (! m_leaf_found)
+        {
+            m_leafs_first = index_type(m_nodes.size());
+            m_leaf_found = true;
+        }
+
+        node nd;
+        nd.first = index_type(m_values.size());
+        nd.count = index_type(elements.size());
+        m_nodes.push_back(nd);                                                                     // MAY THROW (A)
+
+        m_values.insert(m_values.end(), elements.begin(), elements.end());                         // MAY THROW (A, C)
+    }
+
+private:
+    Nodes & m_nodes;
+    Boxes & m_boxes;
+    Values & m_values;
+
+    std::vector<node_pointer> m_queue;
+    index_type m_leafs_first;
+    bool m_leaf_found;
+};
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::flat
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_FLATTEN_HPP
@@ -0,0 +1,218 @@
+// Boost.Geometry Index
+//
+// R-tree flat layout binary image
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_IMAGE_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_IMAGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
+
+#include <boost/geometry/core/static_assert.hpp>
+
+#include <boost/geometry/index/detail/exception.hpp>
+#include <boost/geometry/index/detail/rtree/flat/layout.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace flat {
+
+// The image of the flat rtree is the header followed by the arrays of nodes,
+// coordinates and values exactly as they are stored in memory. Each array
+// starts at the offset aligned to image_alignment. So the image can be
+// mapped into memory and queried in place.
+//
+// The image is not portable. It can be read only on a platform with the same
+// byte order and by the program using the same types of Values and
+// coordinates. The sizes of types are stored in the header and checked.
+
+static const std::uint32_t image_version = 2;
+static const std::uint32_t image_byte_order = 0x01020304;
+static const std::size_t image_alignment = 64;
+
+struct image_header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t index_size;
+    std::uint32_t dimension;
+    std::uint32_t coordinate_size;
+    std::uint32_t value_size;
+    std::uint32_t value_alignment;
+    std::uint32_t reserved;
+    std::uint64_t nodes_count;
+    std::uint64_t leafs_first;
+    std::uint64_t values_count;
+    std::uint64_t nodes_offset;
+    std::uint64_t coords_offset;
+    std::uint64_t values_offset;
+    std::uint64_t size;
+};
+
+inline char const* image_magic()
+{
+    return "BGIFLAT";
+}
+
+inline std::uint64_t image_align(std::uint64_t offset)
+{
+    return (offset + image_alignment - 1) / image_alignment * image_alignment;
+}
+
+template <typename Layout>
+inline image_header make_image_header(Layout const& layout)
+{
+    typedef typename Layout::value_type value_type;
+    typedef typename Layout::coordinate_type coordinate_type;
+
+    // e.g. std::pair is not trivially copyable because of the assignment operator
+    BOOST_GEOMETRY_STATIC_ASSERT((std::is_trivially_copy_constructible<value_type>::value
+                               && std::is_trivially_destructible<value_type>::value),
+        "The Value has to be trivially copy constructible and destructible to be stored in the image.",
+        value_type);
+    BOOST_GEOMETRY_STATIC_ASSERT((std::is_trivially_copy_constructible<coordinate_type>::value
+                               && std::is_trivially_destructible<coordinate_type>::value),
+        "The coordinate type has to be trivially copy constructible and destructible to be stored in the image.",
+        coordinate_type);
+
+    image_header h;
+    std::memset(&h, 0, sizeof(image_header));
+    std::memcpy(h.magic, image_magic(), sizeof(h.magic));
+    h.version = image_version;
+    h.byte_order = image_byte_order;
+    h.index_size = sizeof(index_type);
+    h.dimension = Layout::dimension;
+    h.coordinate_size = sizeof(coordinate_type);
+    h.value_size = sizeof(value_type);
+    h.value_alignment = alignof(value_type);
+    h.nodes_count = layout.nodes_count;
+    h.leafs_first = layout.leafs_first;
+    h.values_count = layout.values_count;
+
+    std::uint64_t const coords_count = layout.empty() ? 0 : 2 * Layout::dimension * layout.nodes_count;
+    h.nodes_offset = image_align(sizeof(image_header));
+    h.coords_offset = image_align(h.nodes_offset + h.nodes_count * sizeof(node));
+    h.values_offset = image_align(h.coords_offset + coords_count * sizeof(coordinate_type));
+    h.size = h.values_offset + h.values_count * sizeof(value_type);
+
+    return h;
+}
+
+inline void write_image_padding(std::ostream & os, std::uint64_t & offset, std::uint64_t new_offset)
+{
+    static const char zeros[image_alignment] = {};
+    os.write(zeros, std::streamsize(new_offset - offset));
+    offset = new_offset;
+}
+
+// Writes the image of the flat rtree into the stream
+template <typename Layout>
+inline void write_image(std::ostream & os, Layout const& layout)
+{
+    typedef typename Layout::value_type value_type;
+    typedef typename Layout::coordinate_type coordinate_type;
+
+    image_header const h = make_image_header(layout);
+    std::uint64_t const coords_count = layout.empty() ? 0 : 2 * Layout::dimension * layout.nodes_count;
+
+    std::uint64_t offset = sizeof(image_header);
+    os.write(reinterpret_cast<char const*>(&h), sizeof(image_header));
+    write_image_padding(os, offset, h.nodes_offset);
+    os.write(reinterpret_cast<char const*>(layout.nodes), std::streamsize(h.nodes_count * sizeof(node)));
+    offset += h.nodes_count * sizeof(node);
+    write_image_padding(os, offset, h.coords_offset);
+    os.write(reinterpret_cast<char const*>(layout.coords), std::streamsize(coords_count * sizeof(coordinate_type)));
+    offset += coords_count * sizeof(coordinate_type);
+    write_image_padding(os, offset, h.values_offset);
+    os.write(reinterpret_cast<char const*>(layout.values), std::streamsize(h.values_count * sizeof(value_type)));
+}
+
+inline bool image_section_valid(std::uint64_t offset, std::uint64_t count, std::uint64_t element_size,
+                                std::uint64_t size)
+{
+    return offset % image_alignment == 0
+        && offset <= size
+        && count <= (size - offset) / element_size;
+}
+
+// Checks the header of the image and initializes the layout with the pointers
+// to the arrays stored in the image. The arrays themselves are not checked
+// so the image has to be created by write_image().
+template <typename Layout>
+inline void read_image(Layout & layout, void const* data, std::size_t size)
+{
+    typedef typename Layout::value_type value_type;
+    typedef typename Layout::coordinate_type coordinate_type;
+
+    // the expected header
+    Layout const empty_layout;
+    image_header const e = make_image_header(empty_layout);
+
+    if (data == 0 || size < sizeof(image_header))
+    {
+        throw_runtime_error("boost::geometry::index::mapped_rtree: the image is too small");
+    }
+
+    // the offsets of arrays are aligned so only the alignment of data has to be checked
+    std::size_t const alignment = (std::max)(alignof(node), (std::max)(alignof(coordinate_type), alignof(value_type)));
+    char const* const bytes = static_cast<char const*>(data);
+    if (reinterpret_cast<std::uintptr_t>(bytes) % alignment != 0)
+    {
+        throw_runtime_error("boost::geometry::index::mapped_rtree: the image is not aligned");
+    }
+
+    image_header h;
+    std::memcpy(&h, bytes, sizeof(image_header));
+
+    if (std::memcmp(h.magic, e.magic, sizeof(h.magic)) != 0)
+    {
+        throw_runtime_error("boost::geometry::index::mapped_rtree: invalid image");
+    }
+    if (h.version != e.version)
+    {
+        throw_runtime_error("boost::geometry::index::mapped_rtree: unsupported image version");
+    }
+    if (h.byte_order != e.byte_order)
+    {
+        throw_runtime_error("boost::geometry::index::mapped_rtree: different byte order of the image");
+    }
+    if (h.index_size != e.index_size
+        || h.dimension != e.dimension
+        || h.coordinate_size != e.coordinate_size
+        || h.value_size != e.value_size
+        || h.value_alignment != e.value_alignment)
+    {
+        throw_runtime_error("boost::geometry::index::mapped_rtree: the image stores different types");
+    }
+
+    std::uint64_t const coords_count = h.nodes_count == 0 ? 0 : 2 * Layout::dimension * h.nodes_count;
+    if (h.size > size
+        || h.leafs_first > h.nodes_count
+        || (h.nodes_count == 0) != (h.values_count == 0)
+        || ! image_section_valid(h.nodes_offset, h.nodes_count, sizeof(node), h.size)
+        || ! image_section_valid(h.coords_offset, coords_count, sizeof(coordinate_type), h.size)
+        || ! image_section_valid(h.values_offset, h.values_count, sizeof(value_type), h.size))
+    {
+        throw_runtime_error("boost::geometry::index::mapped_rtree: corrupted image");
+    }
+
+    layout.nodes = reinterpret_cast<node const*>(bytes + h.nodes_offset);
+    layout.coords = reinterpret_cast<coordinate_type const*>(bytes + h.coords_offset);
+    layout.values = reinterpret_cast<value_type const*>(bytes + h.values_offset);
+    layout.nodes_count = h.nodes_count;
+    layout.leafs_first = h.leafs_first;
+    layout.values_count = h.values_count;
+}
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::flat
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_IMAGE_HPP
@@ -0,0 +1,203 @@
+// Boost.Geometry Index
+//
+// R-tree flat layout
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_LAYOUT_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_LAYOUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/container/allocator_traits.hpp>
+#include <boost/container/vector.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace flat {
+
+// The flat rtree is stored in contiguous arrays. The nodes are stored in
+// breadth-first order so the children of a node are stored next to each
+// other and the leafs are stored at the end. The values are stored in the
+// order of leafs.
+//
+// The boxes of the children of a node are stored in a block of coordinates
+// as structure of arrays, there is one array for each corner and dimension.
+// The block of the children [first, first + count) starts at
+// first * 2 * dimension so the blocks of all nodes are contiguous and the
+// coordinates checked while a node is traversed are close in memory.
+// The box of the root is stored in the first block.
+
+// The indexes of nodes and values are 32-bit so a node takes 8 bytes,
+// the number of values is limited to the maximum value of index_type.
+typedef std::uint32_t index_type;
+
+// The children of an internal node are the nodes [first, first + count)
+// the children of a leaf are the values [first, first + count).
+struct node
+{
+    index_type first;
+    index_type count;
+};
+
+// The empty data of the node passed by the traversing algorithms
+struct no_node_box {};
+
+template <std::size_t I, std::size_t Dimension>
+struct load_box
+{
+    template <typename Box, typename Coord>
+    static inline void apply(Box & b, Coord const* coords, std::size_t count, std::size_t i)
+    {
+        geometry::set<min_corner, I>(b, coords[I * count + i]);
+        geometry::set<max_corner, I>(b, coords[(Dimension + I) * count + i]);
+        load_box<I + 1, Dimension>::apply(b, coords, count, i);
+    }
+};
+
+template <std::size_t Dimension>
+struct load_box<Dimension, Dimension>
+{
+    template <typename Box, typename Coord>
+    static inline void apply(Box & , Coord const* , std::size_t , std::size_t) {}
+};
+
+template <std::size_t I, std::size_t Dimension>
+struct store_box
+{
+    template <typename Box, typename Coord>
+    static inline void apply(Box const& b, Coord * coords, std::size_t count, std::size_t i)
+    {
+        coords[I * count + i] = geometry::get<min_corner, I>(b);
+        coords[(Dimension + I) * count + i] = geometry::get<max_corner, I>(b);
+        store_box<I + 1, Dimension>::apply(b, coords, count, i);
+    }
+};
+
+template <std::size_t Dimension>
+struct store_box<Dimension, Dimension>
+{
+    template <typename Box, typename Coord>
+    static inline void apply(Box const& , Coord * , std::size_t , std::size_t) {}
+};
+
+// The non-owning view of the arrays of the flat rtree
+template <typename Value, typename Box>
+struct layout
+{
+    typedef Value value_type;
+    typedef Box box_type;
+    typedef typename geometry::coordinate_type<Box>::type coordinate_type;
+    static const std::size_t dimension = geometry::dimension<Box>::value;
+
+    layout()
+        : nodes(0), coords(0), values(0)
+        , nodes_count(0), leafs_first(0), values_count(0)
+    {}
+
+    bool empty() const
+    {
+        return nodes_count == 0;
+    }
+
+    bool is_leaf(index_type i) const
+    {
+        return leafs_first <= i;
+    }
+
+    // The data of the node needed to get the boxes of its children, it's passed
+    // by the traversing algorithms. The boxes are not relative to the parent
+    // in this layout so nothing is needed.
+    typedef no_node_box node_box_type;
+
+    node_box_type root_node_box() const
+    {
+        return node_box_type();
+    }
+
+    node_box_type node_box(box_type const& ) const
+    {
+        return node_box_type();
+    }
+
+    // The box of the child i of the internal node parent
+    box_type box(node const& parent, node_box_type const& , index_type i) const
+    {
+        box_type result;
+        load_box<0, dimension>::apply(result, coords + 2 * dimension * std::size_t(parent.first),
+                                      std::size_t(parent.count), std::size_t(i - parent.first));
+        return result;
+    }
+
+    box_type root_box() const
+    {
+        box_type result;
+        load_box<0, dimension>::apply(result, coords, 1, 0);
+        return result;
+    }
+
+    node const* nodes;
+    coordinate_type const* coords;
+    value_type const* values;
+    index_type nodes_count;
+    index_type leafs_first;
+    index_type values_count;
+};
+
+// The coordinates of the boxes of the nodes viewed by the layout, owned by the flat rtree
+template <typename Value, typename Box, typename Allocator>
+class coordinates
+{
+    typedef typename geometry::coordinate_type<Box>::type coordinate_type;
+    static const std::size_t dimension = geometry::dimension<Box>::value;
+
+    typedef typename boost::container::allocator_traits
+        <
+            Allocator
+        >::template rebind_alloc<coordinate_type> coordinate_allocator_type;
+
+public:
+    typedef flat::layout<Value, Box> layout_type;
+
+    explicit coordinates(Allocator const& allocator)
+        : m_coords(coordinate_allocator_type(allocator))
+    {}
+
+    // Stores the boxes of the children of each node as structure of arrays,
+    // boxes[0] is the box of the root and boxes[i] is the box of the node i
+    // or of the value i if the parent is a leaf.
+    template <typename Nodes, typename Boxes>
+    void assign(Nodes const& nodes, index_type leafs_first, Boxes const& boxes)
+    {
+        m_coords.resize(2 * dimension * nodes.size());                                             // MAY THROW (A)
+        store_box<0, dimension>::apply(boxes[0], m_coords.data(), 1, 0);
+        for (std::size_t n = 0 ; n < leafs_first ; ++n)
+        {
+            node const& nd = nodes[n];
+            coordinate_type * const block = m_coords.data() + 2 * dimension * std::size_t(nd.first);
+            for (std::size_t i = 0 ; i < nd.count ; ++i)
+            {
+                store_box<0, dimension>::apply(boxes[nd.first + i], block, std::size_t(nd.count), i);
+            }
+        }
+    }
+
+    void apply(layout_type & l) const
+    {
+        l.coords = m_coords.data();
+    }
+
+private:
+    boost::container::vector<coordinate_type, coordinate_allocator_type> m_coords;
+};
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::flat
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_LAYOUT_HPP
@@ -0,0 +1,275 @@
+// Boost.Geometry Index
+//
+// R-tree flat layout storing quantized boxes
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_QUANTIZED_LAYOUT_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_QUANTIZED_LAYOUT_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <boost/container/allocator_traits.hpp>
+#include <boost/container/vector.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/static_assert.hpp>
+
+#include <boost/geometry/index/detail/rtree/flat/layout.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace flat {
+
+// The coordinates of a box are stored as integers relative to the box of
+// the parent node. The range of the parent box in each dimension is divided
+// into the maximum value of Quantized equal parts, the minimum coordinates
+// are rounded down and the maximum coordinates are rounded up, so the decoded
+// box always contains the original box.
+template <typename Quantized, typename Coord>
+struct quantization
+{
+    static inline Quantized max_value()
+    {
+        return (std::numeric_limits<Quantized>::max)();
+    }
+
+    static inline Coord decode(Coord pmin, Coord pmax, Quantized q)
+    {
+        // the ends of the range are decoded exactly
+        if (q == 0)
+        {
+            return pmin;
+        }
+        if (q == max_value())
+        {
+            return pmax;
+        }
+        return pmin + (pmax - pmin) * Coord(q) / Coord(max_value());
+    }
+
+    static inline Quantized encode_min(Coord pmin, Coord pmax, Coord c)
+    {
+        if (! (pmin < pmax) || ! (pmin < c))
+        {
+            return 0;
+        }
+
+        Coord const r = std::floor((c - pmin) / (pmax - pmin) * Coord(max_value()));
+        Quantized q = r < Coord(max_value()) ? Quantized(r) : max_value();
+
+        // the result of floating point operations may be slightly greater
+        while (q > 0 && c < decode(pmin, pmax, q))
+        {
+            --q;
+        }
+        return q;
+    }
+
+    static inline Quantized encode_max(Coord pmin, Coord pmax, Coord c)
+    {
+        if (! (pmin < pmax) || ! (c < pmax))
+        {
+            return max_value();
+        }
+
+        Coord const r = std::ceil((c - pmin) / (pmax - pmin) * Coord(max_value()));
+        Quantized q = r > Coord(0) ? Quantized(r) : Quantized(0);
+
+        // the result of floating point operations may be slightly smaller
+        while (q < max_value() && decode(pmin, pmax, q) < c)
+        {
+            ++q;
+        }
+        return q;
+    }
+};
+
+template <std::size_t I, std::size_t Dimension>
+struct decode_box
+{
+    template <typename Box, typename Quantized>
+    static inline void apply(Box & b, Box const& parent, Quantized const* qcoords, std::size_t count, std::size_t i)
+    {
+        typedef typename geometry::coordinate_type<Box>::type coord_t;
+        typedef quantization<Quantized, coord_t> quant;
+
+        coord_t const pmin = geometry::get<min_corner, I>(parent);
+        coord_t const pmax = geometry::get<max_corner, I>(parent);
+        geometry::set<min_corner, I>(b, quant::decode(pmin, pmax, qcoords[I * count + i]));
+        geometry::set<max_corner, I>(b, quant::decode(pmin, pmax, qcoords[(Dimension + I) * count + i]));
+        decode_box<I + 1, Dimension>::apply(b, parent, qcoords, count, i);
+    }
+};
+
+template <std::size_t Dimension>
+struct decode_box<Dimension, Dimension>
+{
+    template <typename Box, typename Quantized>
+    static inline void apply(Box & , Box const& , Quantized const* , std::size_t , std::size_t) {}
+};
+
+template <std::size_t I, std::size_t Dimension>
+struct encode_box
+{
+    template <typename Box, typename Quantized>
+    static inline void apply(Box const& b, Box const& parent, Quantized * qcoords, std::size_t count, std::size_t i)
+    {
+        typedef typename geometry::coordinate_type<Box>::type coord_t;
+        typedef quantization<Quantized, coord_t> quant;
+
+        coord_t const pmin = geometry::get<min_corner, I>(parent);
+        coord_t const pmax = geometry::get<max_corner, I>(parent);
+        qcoords[I * count + i] = quant::encode_min(pmin, pmax, geometry::get<min_corner, I>(b));
+        qcoords[(Dimension + I) * count + i] = quant::encode_max(pmin, pmax, geometry::get<max_corner, I>(b));
+        encode_box<I + 1, Dimension>::apply(b, parent, qcoords, count, i);
+    }
+};
+
+template <std::size_t Dimension>
+struct encode_box<Dimension, Dimension>
+{
+    template <typename Box, typename Quantized>
+    static inline void apply(Box const& , Box const& , Quantized * , std::size_t , std::size_t) {}
+};
+
+// The non-owning view of the arrays of the flat rtree storing quantized boxes.
+// The boxes of the children are stored in the same blocks as in the layout
+// but they're relative to the box of the parent. The box of the root is
+// stored separately with full precision.
+template <typename Value, typename Box, typename Quantized>
+struct quantized_layout
+{
+    typedef Value value_type;
+    typedef Box box_type;
+    typedef Quantized quantized_type;
+    typedef typename geometry::coordinate_type<Box>::type coordinate_type;
+    static const std::size_t dimension = geometry::dimension<Box>::value;
+
+    quantized_layout()
+        : nodes(0), qcoords(0), root_coords(0), values(0)
+        , nodes_count(0), leafs_first(0), values_count(0)
+    {}
+
+    bool empty() const
+    {
+        return nodes_count == 0;
+    }
+
+    bool is_leaf(index_type i) const
+    {
+        return leafs_first <= i;
+    }
+
+    // The boxes of the children are decoded using the box of the parent
+    typedef box_type node_box_type;
+
+    node_box_type root_node_box() const
+    {
+        return root_box();
+    }
+
+    node_box_type const& node_box(box_type const& b) const
+    {
+        return b;
+    }
+
+    // The box of the child i of the internal node parent
+    box_type box(node const& parent, node_box_type const& parent_box, index_type i) const
+    {
+        box_type result;
+        decode_box<0, dimension>::apply(result, parent_box,
+                                        qcoords + 2 * dimension * std::size_t(parent.first),
+                                        std::size_t(parent.count), std::size_t(i - parent.first));
+        return result;
+    }
+
+    box_type root_box() const
+    {
+        box_type result;
+        load_box<0, dimension>::apply(result, root_coords, 1, 0);
+        return result;
+    }
+
+    node const* nodes;
+    quantized_type const* qcoords;
+    coordinate_type const* root_coords;
+    value_type const* values;
+    index_type nodes_count;
+    index_type leafs_first;
+    index_type values_count;
+};
+
+// The quantized coordinates of the boxes of the nodes viewed by the quantized_layout,
+// owned by the flat rtree
+template <typename Value, typename Box, typename Quantized, typename Allocator>
+class quantized_coordinates
+{
+    typedef typename geometry::coordinate_type<Box>::type coordinate_type;
+    static const std::size_t dimension = geometry::dimension<Box>::value;
+
+    BOOST_GEOMETRY_STATIC_ASSERT((std::is_integral<Quantized>::value && std::is_unsigned<Quantized>::value),
+        "Quantized has to be an unsigned integral type.",
+        Quantized);
+    BOOST_GEOMETRY_STATIC_ASSERT((std::is_floating_point<coordinate_type>::value),
+        "Only floating point coordinates are supported.",
+        coordinate_type);
+
+    typedef typename boost::container::allocator_traits
+        <
+            Allocator
+        >::template rebind_alloc<Quantized> quantized_allocator_type;
+
+public:
+    typedef quantized_layout<Value, Box, Quantized> layout_type;
+
+    explicit quantized_coordinates(Allocator const& allocator)
+        : m_qcoords(quantized_allocator_type(allocator))
+        , m_root_coords()
+    {}
+
+    // Stores the boxes of the children of each node relative to the box of the node,
+    // boxes[0] is the box of the root and boxes[i] is the box of the node i
+    // or of the value i if the parent is a leaf. The nodes are stored in breadth-first
+    // order so the parents are encoded first and the boxes of the internal nodes
+    // are replaced with the decoded boxes.
+    template <typename Nodes, typename Boxes>
+    void assign(Nodes const& nodes, index_type leafs_first, Boxes & boxes)
+    {
+        store_box<0, dimension>::apply(boxes[0], m_root_coords, 1, 0);
+
+        m_qcoords.resize(2 * dimension * nodes.size());                                            // MAY THROW (A)
+        for (std::size_t n = 0 ; n < leafs_first ; ++n)
+        {
+            node const& nd = nodes[n];
+            Quantized * const block = m_qcoords.data() + 2 * dimension * std::size_t(nd.first);
+            for (std::size_t i = 0 ; i < nd.count ; ++i)
+            {
+                std::size_t const c = std::size_t(nd.first) + i;
+                encode_box<0, dimension>::apply(boxes[c], boxes[n], block, std::size_t(nd.count), i);
+                decode_box<0, dimension>::apply(boxes[c], boxes[n], block, std::size_t(nd.count), i);
+            }
+        }
+    }
+
+    void apply(layout_type & l) const
+    {
+        l.qcoords = m_qcoords.data();
+        l.root_coords = m_root_coords;
+    }
+
+private:
+    boost::container::vector<Quantized, quantized_allocator_type> m_qcoords;
+    coordinate_type m_root_coords[2 * dimension];
+};
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::flat
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_QUANTIZED_LAYOUT_HPP
@@ -0,0 +1,292 @@
+// Boost.Geometry Index
+//
+// R-tree flat layout queries implementation
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_QUERY_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_QUERY_HPP
+
+#include <type_traits>
+#include <utility>
+
+#include <boost/geometry/core/static_assert.hpp>
+
+#include <boost/geometry/index/detail/distance_predicates.hpp>
+#include <boost/geometry/index/detail/predicates.hpp>
+#include <boost/geometry/index/detail/rtree/flat/layout.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/distance_query.hpp>
+#include <boost/geometry/index/detail/translator.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace flat {
+
+template <typename Layout, typename Translator, typename Strategy, typename Predicates, typename OutIter>
+class spatial_query
+{
+    typedef typename Layout::box_type box_type;
+    typedef typename Layout::node_box_type node_box_type;
+
+public:
+    typedef std::size_t size_type;
+
+    spatial_query(Layout const& layout, Translator const& tr, Strategy const& strategy,
+                  Predicates const& pred, OutIter out_it)
+        : m_layout(layout)
+        , m_tr(tr)
+        , m_strategy(strategy)
+        , m_pred(pred)
+        , m_out_iter(out_it)
+        , m_found_count(0)
+    {}
+
+    size_type apply()
+    {
+        if (! m_layout.empty())
+        {
+            apply(0, m_layout.root_node_box());
+        }
+        return m_found_count;
+    }
+
+private:
+    void apply(index_type n, node_box_type const& n_box)
+    {
+        namespace id = index::detail;
+
+        node const& nd = m_layout.nodes[n];
+        index_type const last = nd.first + nd.count;
+        if (! m_layout.is_leaf(n))
+        {
+            // traverse nodes meeting predicates
+            for (index_type i = nd.first ; i < last ; ++i)
+            {
+                box_type const b = m_layout.box(nd, n_box, i);
+
+                // if node meets predicates (0 is dummy value)
+                if (id::predicates_check<id::bounds_tag>(m_pred, 0, b, m_strategy))
+                {
+                    if (m_layout.is_leaf(i))
+                    {
+                        apply_leaf(m_layout.nodes[i]);
+                    }
+                    else
+                    {
+                        apply(i, m_layout.node_box(b));
+                    }
+                }
+            }
+        }
+        else
+        {
+            apply_leaf(nd);
+        }
+    }
+
+    void apply_leaf(node const& nd)
+    {
+        namespace id = index::detail;
+
+        // get all values meeting predicates
+        index_type const last = nd.first + nd.count;
+        for (index_type i = nd.first ; i < last ; ++i)
+        {
+            auto const& v = m_layout.values[i];
+            // if value meets predicates
+            if (id::predicates_check<id::value_tag>(m_pred, v, m_tr(v), m_strategy))
+            {
+                *m_out_iter = v;
+                ++m_out_iter;
+                ++m_found_count;
+            }
+        }
+    }
+
+    Layout const m_layout;
+    Translator const& m_tr;
+    Strategy const& m_strategy;
+
+    Predicates const& m_pred;
+    OutIter m_out_iter;
+
+    size_type m_found_count;
+};
+
+template <typename Layout, typename Translator, typename Strategy, typename Predicates>
+class distance_query
+{
+    typedef typename Layout::value_type value_type;
+    typedef typename Layout::box_type box_type;
+
+    typedef index::detail::predicates_element
+        <
+            index::detail::predicates_find_distance<Predicates>::value, Predicates
+        > nearest_predicate_access;
+    typedef typename nearest_predicate_access::type nearest_predicate_type;
+    typedef typename indexable_type<Translator>::type indexable_type;
+
+    typedef index::detail::calculate_distance<nearest_predicate_type, indexable_type, Strategy, value_tag> calculate_value_distance;
+    typedef index::detail::calculate_distance<nearest_predicate_type, box_type, Strategy, bounds_tag> calculate_node_distance;
+    typedef typename calculate_value_distance::result_type value_distance_type;
+    typedef typename calculate_node_distance::result_type node_distance_type;
+
+    typedef typename Layout::node_box_type node_box_type;
+
+    // the node box is a base class so it takes no space if it's empty
+    struct branch_data
+        : node_box_type
+    {
+        branch_data(node_distance_type const& d, index_type i, node_box_type const& b)
+            : node_box_type(b), first(d), second(i)
+        {}
+
+        node_distance_type first;
+        index_type second;
+    };
+
+    struct branch_data_greater
+    {
+        bool operator()(branch_data const& b1, branch_data const& b2) const
+        {
+            return b1.first > b2.first;
+        }
+    };
+    typedef visitors::priority_queue<branch_data, branch_data_greater> branches_type;
+
+public:
+    typedef std::size_t size_type;
+
+    distance_query(Layout const& layout, Translator const& tr, Strategy const& strategy,
+                   Predicates const& pred)
+        : m_layout(layout)
+        , m_tr(tr)
+        , m_strategy(strategy)
+        , m_pred(pred)
+        , m_result((std::min)(size_type(layout.values_count), size_type(predicate().count)))
+    {}
+
+    template <typename OutIter>
+    size_type apply(OutIter out_it)
+    {
+        namespace id = index::detail;
+
+        if (m_layout.empty() || m_result.max_count() <= 0)
+        {
+            return 0;
+        }
+
+        index_type n = 0;
+        node_box_type n_box = m_layout.root_node_box();
+        for (;;)
+        {
+            node const& nd = m_layout.nodes[n];
+            index_type const last = nd.first + nd.count;
+            if (! m_layout.is_leaf(n))
+            {
+                // fill array of nodes meeting predicates
+                for (index_type i = nd.first ; i < last ; ++i)
+                {
+                    box_type const b = m_layout.box(nd, n_box, i);
+                    node_distance_type node_distance; // for distance predicate
+
+                    // if current node meets predicates (0 is dummy value)
+                    if (id::predicates_check<id::bounds_tag>(m_pred, 0, b, m_strategy)
+                        // and if distance is ok
+                        && calculate_node_distance::apply(predicate(), b, m_strategy, node_distance)
+                        // and if current node is closer than the furthest neighbor
+                        && ! m_result.ignore_branch(node_distance))
+                    {
+                        // add current node's data into the list
+                        m_branches.push(branch_data(node_distance, i, m_layout.node_box(b)));
+                    }
+                }
+            }
+            else
+            {
+                // search leaf for closest value meeting predicates
+                for (index_type i = nd.first ; i < last ; ++i)
+                {
+                    value_type const& v = m_layout.values[i];
+                    value_distance_type value_distance; // for distance predicate
+
+                    // if value meets predicates
+                    if (id::predicates_check<id::value_tag>(m_pred, v, m_tr(v), m_strategy)
+                        // and if distance is ok
+                        && calculate_value_distance::apply(predicate(), m_tr(v), m_strategy, value_distance))
+                    {
+                        // store value
+                        m_result.store(value_distance, boost::addressof(v));
+                    }
+                }
+            }
+
+            if (m_branches.empty()
+                || m_result.ignore_branch(m_branches.top().first))
+            {
+                break;
+            }
+
+            n = m_branches.top().second;
+            n_box = m_branches.top();
+            m_branches.pop();
+        }
+
+        return m_result.finish(out_it);
+    }
+
+private:
+    nearest_predicate_type const& predicate() const
+    {
+        return nearest_predicate_access::get(m_pred);
+    }
+
+    Layout const m_layout;
+    Translator const& m_tr;
+    Strategy const& m_strategy;
+
+    Predicates const& m_pred;
+
+    branches_type m_branches;
+    visitors::distance_query_result<value_distance_type, value_type> m_result;
+};
+
+template
+<
+    typename Layout, typename Translator, typename Strategy, typename Predicates, typename OutIter,
+    std::enable_if_t<(index::detail::predicates_count_distance<Predicates>::value == 0), int> = 0
+>
+inline std::size_t query(Layout const& layout, Translator const& tr, Strategy const& strategy,
+                         Predicates const& predicates, OutIter out_it)
+{
+    spatial_query
+        <
+            Layout, Translator, Strategy, Predicates, OutIter
+        > query_v(layout, tr, strategy, predicates, out_it);
+    return query_v.apply();
+}
+
+template
+<
+    typename Layout, typename Translator, typename Strategy, typename Predicates, typename OutIter,
+    std::enable_if_t<(index::detail::predicates_count_distance<Predicates>::value > 0), int> = 0
+>
+inline std::size_t query(Layout const& layout, Translator const& tr, Strategy const& strategy,
+                         Predicates const& predicates, OutIter out_it)
+{
+    BOOST_GEOMETRY_STATIC_ASSERT((index::detail::predicates_count_distance<Predicates>::value == 1),
+                                 "Only one distance predicate can be passed.",
+                                 Predicates);
+
+    distance_query
+        <
+            Layout, Translator, Strategy, Predicates
+        > distance_v(layout, tr, strategy, predicates);
+    return distance_v.apply(out_it);
+}
+
+}}}}}} // namespace boost::geometry::index::detail::rtree::flat
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_FLAT_QUERY_HPP
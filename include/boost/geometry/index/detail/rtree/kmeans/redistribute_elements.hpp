@@ -0,0 +1,281 @@
+// Boost.Geometry Index
+//
+// R-tree kmeans split algorithm implementation
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
+
+#include <algorithm>
+#include <limits>
+
+#include <boost/geometry/index/detail/algorithms/bounds.hpp>
+#include <boost/geometry/index/detail/rtree/node/node.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/insert.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+namespace kmeans {
+
+// The center of the bounding box of an element
+template <std::size_t Dimension>
+struct center
+{
+    static const std::size_t dimension = Dimension;
+    double coords[Dimension];
+};
+
+template <std::size_t I, std::size_t Dimension>
+struct center_of_box
+{
+    template <typename Box>
+    static inline void apply(Box const& box, center<Dimension> & c)
+    {
+        c.coords[I] = ( double(geometry::get<min_corner, I>(box))
+                      + double(geometry::get<max_corner, I>(box)) ) / 2;
+        center_of_box<I + 1, Dimension>::apply(box, c);
+    }
+};
+
+template <std::size_t Dimension>
+struct center_of_box<Dimension, Dimension>
+{
+    template <typename Box>
+    static inline void apply(Box const& , center<Dimension> & ) {}
+};
+
+template <std::size_t Dimension>
+inline double comparable_distance(center<Dimension> const& c1, center<Dimension> const& c2)
+{
+    double result = 0;
+    for (std::size_t i = 0 ; i < Dimension ; ++i)
+    {
+        double const d = c1.coords[i] - c2.coords[i];
+        result += d * d;
+    }
+    return result;
+}
+
+// The maximum number of Lloyd's iterations
+static const std::size_t max_iterations = 16;
+
+// Divide the centers into 2 clusters.
+// Group 0 or 1 is assigned to each center. At least min_count centers
+// is assigned to each group.
+template <typename Centers, typename Groups, typename Costs>
+inline void two_means(Centers const& centers, Groups & groups, Costs & costs,
+                      std::size_t min_count)
+{
+    typedef typename Centers::value_type center_type;
+
+    std::size_t const count = centers.size();
+    BOOST_GEOMETRY_INDEX_ASSERT(2 <= count && 2 * min_count <= count, "unexpected number of elements");
+
+    // the seeds - the farthest pair of centers
+    std::size_t seed1 = 0;
+    std::size_t seed2 = 1;
+    double greatest_distance = -1;
+    for ( std::size_t i = 0 ; i < count - 1 ; ++i )
+    {
+        for ( std::size_t j = i + 1 ; j < count ; ++j )
+        {
+            double const d = comparable_distance(centers[i], centers[j]);
+            if ( greatest_distance < d )
+            {
+                greatest_distance = d;
+                seed1 = i;
+                seed2 = j;
+            }
+        }
+    }
+
+    center_type means[2] = { centers[seed1], centers[seed2] };
+    std::size_t counts[2] = { 0, 0 };
+
+    for ( std::size_t i = 0 ; i < count ; ++i )
+    {
+        groups[i] = i == seed2 ? 1 : 0;
+    }
+
+    // Lloyd's iterations
+    for ( std::size_t iteration = 0 ; iteration < max_iterations ; ++iteration )
+    {
+        bool changed = false;
+        counts[0] = 0;
+        counts[1] = 0;
+        for ( std::size_t i = 0 ; i < count ; ++i )
+        {
+            double const d0 = comparable_distance(centers[i], means[0]);
+            double const d1 = comparable_distance(centers[i], means[1]);
+            std::size_t const g = d1 < d0 ? 1 : (d0 < d1 ? 0 : groups[i]);
+            changed = changed || g != groups[i];
+            groups[i] = g;
+            ++counts[g];
+        }
+
+        if ( ! changed && 0 < iteration )
+        {
+            break;
+        }
+
+        // calculate the means of nonempty groups
+        center_type sums[2];
+        for ( std::size_t d = 0 ; d < center_type::dimension ; ++d )
+        {
+            sums[0].coords[d] = 0;
+            sums[1].coords[d] = 0;
+        }
+        for ( std::size_t i = 0 ; i < count ; ++i )
+        {
+            for ( std::size_t d = 0 ; d < center_type::dimension ; ++d )
+            {
+                sums[groups[i]].coords[d] += centers[i].coords[d];
+            }
+        }
+        for ( std::size_t g = 0 ; g < 2 ; ++g )
+        {
+            if ( 0 < counts[g] )
+            {
+                for ( std::size_t d = 0 ; d < center_type::dimension ; ++d )
+                {
+                    means[g].coords[d] = sums[g].coords[d] / double(counts[g]);
+                }
+            }
+        }
+    }
+
+    // Move the centers closest to the underflowed group
+    for ( std::size_t g = 0 ; g < 2 ; ++g )
+    {
+        if ( counts[g] >= min_count )
+        {
+            continue;
+        }
+
+        std::size_t const other = 1 - g;
+        for ( std::size_t i = 0 ; i < count ; ++i )
+        {
+            costs[i] = groups[i] == other
+                     ? comparable_distance(centers[i], means[g])
+                     - comparable_distance(centers[i], means[other])
+                     : (std::numeric_limits<double>::max)();
+        }
+
+        for ( ; counts[g] < min_count ; ++counts[g], --counts[other] )
+        {
+            std::size_t const best = std::min_element(costs.begin(), costs.end()) - costs.begin();
+            groups[best] = g;
+            costs[best] = (std::numeric_limits<double>::max)();
+        }
+    }
+}
+
+} // namespace kmeans
+
+template <typename MembersHolder>
+struct redistribute_elements<MembersHolder, kmeans_tag>
+{
+    typedef typename MembersHolder::box_type box_type;
+    typedef typename MembersHolder::parameters_type parameters_type;
+    typedef typename MembersHolder::translator_type translator_type;
+    typedef typename MembersHolder::allocators_type allocators_type;
+
+    typedef typename MembersHolder::node node;
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    static const std::size_t dimension = geometry::dimension<box_type>::value;
+
+    template <typename Node>
+    static inline void apply(Node & n,
+                             Node & second_node,
+                             box_type & box1,
+                             box_type & box2,
+                             parameters_type const& parameters,
+                             translator_type const& translator,
+                             allocators_type & allocators)
+    {
+        typedef typename rtree::elements_type<Node>::type elements_type;
+        typedef typename elements_type::value_type element_type;
+
+        elements_type & elements1 = rtree::elements(n);
+        elements_type & elements2 = rtree::elements(second_node);
+
+        BOOST_GEOMETRY_INDEX_ASSERT(elements1.size() == parameters.get_max_elements() + 1, "unexpected elements number");
+
+        // copy original elements - use in-memory storage (std::allocator)
+        typedef typename rtree::container_from_elements_type<elements_type, element_type>::type
+            container_type;
+        container_type elements_copy(elements1.begin(), elements1.end());                                   // MAY THROW, STRONG (alloc, copy)
+
+        typedef kmeans::center<dimension> center_type;
+        typedef typename rtree::container_from_elements_type<elements_type, center_type>::type
+            centers_type;
+        typedef typename rtree::container_from_elements_type<elements_type, std::size_t>::type
+            groups_type;
+        typedef typename rtree::container_from_elements_type<elements_type, double>::type
+            costs_type;
+
+        std::size_t const elements_count = elements_copy.size();
+        centers_type centers(elements_count);                                                              // MAY THROW, STRONG (alloc)
+        groups_type groups(elements_count);                                                                // MAY THROW, STRONG (alloc)
+        costs_type costs(elements_count);                                                                  // MAY THROW, STRONG (alloc)
+
+        typename index::detail::strategy_type<parameters_type>::type const&
+            strategy = index::detail::get_strategy(parameters);
+
+        for ( std::size_t i = 0 ; i < elements_count ; ++i )
+        {
+            box_type b;
+            index::detail::bounds(rtree::element_indexable(elements_copy[i], translator), b, strategy);
+            kmeans::center_of_box<0, dimension>::apply(b, centers[i]);
+        }
+
+        kmeans::two_means(centers, groups, costs, parameters.get_min_elements());
+
+        // prepare nodes' elements containers
+        elements1.clear();
+        BOOST_GEOMETRY_INDEX_ASSERT(elements2.empty(), "second node's elements container should be empty");
+
+        BOOST_TRY
+        {
+            // copy elements to nodes
+            for ( std::size_t i = 0 ; i < elements_count ; ++i )
+            {
+                if ( groups[i] == 0 )
+                    elements1.push_back(elements_copy[i]);                                                  // MAY THROW, STRONG (copy)
+                else
+                    elements2.push_back(elements_copy[i]);                                                  // MAY THROW, STRONG (alloc, copy)
+            }
+
+            // calculate boxes
+            box1 = rtree::elements_box<box_type>(elements1.begin(), elements1.end(),
+                                                 translator, strategy);
+            box2 = rtree::elements_box<box_type>(elements2.begin(), elements2.end(),
+                                                 translator, strategy);
+        }
+        BOOST_CATCH(...)
+        {
+            elements1.clear();
+            elements2.clear();
+
+            rtree::destroy_elements<MembersHolder>::apply(elements_copy, allocators);
+
+            BOOST_RETHROW                                                                                     // RETHROW, BASIC
+        }
+        BOOST_CATCH_END
+    }
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
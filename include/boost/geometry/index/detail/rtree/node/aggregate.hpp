@@ -0,0 +1,191 @@
+// Boost.Geometry Index
+//
+// R-tree nodes aggregates
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_AGGREGATE_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_AGGREGATE_HPP
+
+#include <boost/geometry/index/parameters.hpp>
+
+#include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
+#include <boost/geometry/index/detail/rtree/node/variant_visitor.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+// The aggregates are stored only in the nodes of the rtrees created with
+// index::aggregated parameters
+
+template <typename Parameters>
+struct aggregate_traits
+{
+    static const bool enabled = false;
+    typedef void result_type;
+};
+
+template <typename Parameters, typename Aggregate>
+struct aggregate_traits< index::aggregated<Parameters, Aggregate> >
+{
+    static const bool enabled = true;
+    typedef Aggregate aggregate_type;
+    typedef typename Aggregate::result_type result_type;
+
+    static inline Aggregate const& get(index::aggregated<Parameters, Aggregate> const& parameters)
+    {
+        return parameters.aggregate();
+    }
+};
+
+template <typename Parameters, typename Strategy>
+struct aggregate_traits< index::parameters<Parameters, Strategy> >
+    : aggregate_traits<Parameters>
+{};
+
+// The base of the nodes storing the aggregate of the values of the subtree
+
+template <typename Parameters, bool Enabled = aggregate_traits<Parameters>::enabled>
+struct node_aggregate
+{};
+
+template <typename Parameters>
+struct node_aggregate<Parameters, true>
+{
+    node_aggregate()
+        : aggregate()
+    {}
+
+    typename aggregate_traits<Parameters>::result_type aggregate;
+};
+
+// Returns the aggregate stored in a node
+
+template <typename MembersHolder>
+class get_aggregate
+    : public MembersHolder::visitor_const
+{
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+public:
+    typedef typename aggregate_traits
+        <
+            typename MembersHolder::parameters_type
+        >::result_type aggregate_result_type;
+
+    get_aggregate()
+        : result(0)
+    {}
+
+    inline void operator()(internal_node const& n)
+    {
+        result = &n.aggregate;
+    }
+
+    inline void operator()(leaf const& n)
+    {
+        result = &n.aggregate;
+    }
+
+    static inline aggregate_result_type const& apply(typename MembersHolder::node const& n)
+    {
+        get_aggregate v;
+        rtree::apply_visitor(v, n);
+        return *v.result;
+    }
+
+    aggregate_result_type const* result;
+};
+
+// Copies the aggregate of a node into its copy
+
+template
+<
+    typename MembersHolder,
+    bool Enabled = aggregate_traits<typename MembersHolder::parameters_type>::enabled
+>
+struct copy_aggregate
+{
+    template <typename Node>
+    static inline void apply(Node const& , Node & )
+    {}
+};
+
+template <typename MembersHolder>
+struct copy_aggregate<MembersHolder, true>
+{
+    template <typename Node>
+    static inline void apply(Node const& src, Node & dst)
+    {
+        dst.aggregate = src.aggregate;
+    }
+};
+
+// Calculates the aggregate of a node from the aggregates of its children
+// or from its values. The nodes have to be updated bottom-up.
+
+template
+<
+    typename MembersHolder,
+    bool Enabled = aggregate_traits<typename MembersHolder::parameters_type>::enabled
+>
+struct update_aggregate
+{
+    template <typename Node>
+    static inline void apply(Node & , typename MembersHolder::parameters_type const& )
+    {}
+};
+
+template <typename MembersHolder>
+struct update_aggregate<MembersHolder, true>
+{
+    typedef typename MembersHolder::parameters_type parameters_type;
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    typedef aggregate_traits<parameters_type> traits;
+    typedef typename traits::aggregate_type aggregate_type;
+    typedef typename traits::result_type result_type;
+
+    static inline void apply(internal_node & n, parameters_type const& parameters)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        aggregate_type const& aggregate = traits::get(parameters);
+        result_type result = aggregate.identity();
+        for (typename elements_type::const_iterator it = elements.begin();
+             it != elements.end(); ++it)
+        {
+            result = aggregate.combine(result, get_aggregate<MembersHolder>::apply(*it->second));
+        }
+        n.aggregate = result;
+    }
+
+    static inline void apply(leaf & n, parameters_type const& parameters)
+    {
+        typedef typename rtree::elements_type<leaf>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        aggregate_type const& aggregate = traits::get(parameters);
+        result_type result = aggregate.identity();
+        for (typename elements_type::const_iterator it = elements.begin();
+             it != elements.end(); ++it)
+        {
+            result = aggregate.combine(result, aggregate.value(*it));
+        }
+        n.aggregate = result;
+    }
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_AGGREGATE_HPP
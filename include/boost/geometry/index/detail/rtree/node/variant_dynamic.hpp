@@ -23,6 +23,7 @@
 #include <boost/variant/variant.hpp>
 
 #include <boost/geometry/index/detail/rtree/options.hpp>
+#include <boost/geometry/index/detail/rtree/node/aggregate.hpp>
 #include <boost/geometry/index/detail/rtree/node/concept.hpp>
 #include <boost/geometry/index/detail/rtree/node/pairs.hpp>
 #include <boost/geometry/index/detail/rtree/node/scoped_deallocator.hpp>
@@ -35,6 +36,7 @@ namespace detail { namespace rtree {
 
 template <typename Value, typename Parameters, typename Box, typename Allocators, typename Tag>
 struct variant_internal_node
+    : public rtree::node_aggregate<Parameters>
 {
     typedef rtree::ptr_pair<Box, typename Allocators::node_pointer> element_type;
     typedef typename boost::container::allocator_traits
@@ -54,6 +56,7 @@ struct variant_internal_node
 
 template <typename Value, typename Parameters, typename Box, typename Allocators, typename Tag>
 struct variant_leaf
+    : public rtree::node_aggregate<Parameters>
 {
     typedef typename boost::container::allocator_traits
         <
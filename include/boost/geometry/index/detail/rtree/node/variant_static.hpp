@@ -26,6 +26,7 @@ namespace detail { namespace rtree {
 
 template <typename Value, typename Parameters, typename Box, typename Allocators>
 struct variant_internal_node<Value, Parameters, Box, Allocators, node_variant_static_tag>
+    : public rtree::node_aggregate<Parameters>
 {
     typedef detail::varray<
         rtree::ptr_pair<Box, typename Allocators::node_pointer>,
@@ -40,6 +41,7 @@ struct variant_internal_node<Value, Parameters, Box, Allocators, node_variant_st
 
 template <typename Value, typename Parameters, typename Box, typename Allocators>
 struct variant_leaf<Value, Parameters, Box, Allocators, node_variant_static_tag>
+    : public rtree::node_aggregate<Parameters>
 {
     typedef detail::varray<
         Value,
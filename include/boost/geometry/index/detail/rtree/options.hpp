@@ -31,12 +31,12 @@ struct choose_by_overlap_diff_tag {};
 
 // SplitTag
 struct split_default_tag {};
-//struct split_kmeans_tag {};
 
 // RedistributeTag
 struct linear_tag {};
 struct quadratic_tag {};
 struct rstar_tag {};
+struct kmeans_tag {};
 
 // NodeTag
 struct node_variant_dynamic_tag {};
@@ -100,18 +100,18 @@ struct options_type< index::rstar<MaxElements, MinElements, OverlapCostThreshold
     > type;
 };
 
-//template <size_t MaxElements, size_t MinElements>
-//struct options_type< kmeans<MaxElements, MinElements> >
-//{
-//    typedef options<
-//        kmeans<MaxElements, MinElements>,
-//        insert_default_tag,
-//        choose_by_content_diff_tag, // change it?
-//        split_kmeans_tag,
-//        int, // dummy tag - not used for now
-//        node_variant_static_tag
-//    > type;
-//};
+template <size_t MaxElements, size_t MinElements>
+struct options_type< index::kmeans<MaxElements, MinElements> >
+{
+    typedef options<
+        index::kmeans<MaxElements, MinElements>,
+        insert_default_tag,
+        choose_by_content_diff_tag,
+        split_default_tag,
+        kmeans_tag,
+        node_variant_static_tag
+    > type;
+};
 
 template <>
 struct options_type< index::dynamic_linear >
@@ -152,6 +152,19 @@ struct options_type< index::dynamic_rstar >
     > type;
 };
 
+template <>
+struct options_type< index::dynamic_kmeans >
+{
+    typedef options<
+        index::dynamic_kmeans,
+        insert_default_tag,
+        choose_by_content_diff_tag,
+        split_default_tag,
+        kmeans_tag,
+        node_variant_dynamic_tag
+    > type;
+};
+
 template <typename Parameters, typename Strategy>
 struct options_type< index::parameters<Parameters, Strategy> >
     : options_type<Parameters>
@@ -167,6 +180,21 @@ struct options_type< index::parameters<Parameters, Strategy> >
     > type;
 };
 
+template <typename Parameters, typename Aggregate>
+struct options_type< index::aggregated<Parameters, Aggregate> >
+    : options_type<Parameters>
+{
+    typedef typename options_type<Parameters>::type opt;
+    typedef options<
+        index::aggregated<Parameters, Aggregate>,
+        typename opt::insert_tag,
+        typename opt::choose_next_node_tag,
+        typename opt::split_tag,
+        typename opt::redistribute_tag,
+        typename opt::node_tag
+    > type;
+};
+
 }} // namespace detail::rtree
 
 }}} // namespace boost::geometry::index
@@ -27,6 +27,7 @@
 #include <boost/geometry/index/detail/algorithms/content.hpp>
 #include <boost/geometry/index/detail/algorithms/is_valid.hpp>
 #include <boost/geometry/index/detail/algorithms/nth_element.hpp>
+#include <boost/geometry/index/detail/rtree/node/aggregate.hpp>
 #include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
 #include <boost/geometry/index/detail/rtree/node/subtree_destroyer.hpp>
 #include <boost/geometry/index/parameters.hpp>
@@ -208,9 +209,26 @@ public:
         values_count = static_cast<size_type>(diff);
         entries.reserve(values_count);
 
+        expandable_box<box_type, strategy_type> hint_box(detail::get_strategy(parameters));
+        fill_entries(first, last, entries, hint_box, parameters, translator);                          // MAY THROW (A)
+
+        subtree_elements_counts subtree_counts = calculate_subtree_elements_counts(values_count, parameters, leafs_level);
+        internal_element el = per_level(entries.begin(), entries.end(), hint_box.get(), values_count, subtree_counts,
+                                        parameters, translator, allocators);
+
+        return el.second;
+    }
+
+protected:
+    template <typename InIt, typename Entries, typename ExpandableBox> inline static
+    void fill_entries(InIt first, InIt last,
+                      Entries & entries,
+                      ExpandableBox & hint_box,
+                      parameters_type const& parameters,
+                      translator_type const& translator)
+    {
         auto const& strategy = index::detail::get_strategy(parameters);
 
-        expandable_box<box_type, strategy_type> hint_box(strategy);
         for ( ; first != last ; ++first )
         {
             // NOTE: support for iterators not returning true references adapted
@@ -230,15 +248,8 @@ public:
             geometry::centroid(indexable, pt, strategy);
             entries.push_back(std::make_pair(pt, first));
         }
-
-        subtree_elements_counts subtree_counts = calculate_subtree_elements_counts(values_count, parameters, leafs_level);
-        internal_element el = per_level(entries.begin(), entries.end(), hint_box.get(), values_count, subtree_counts,
-                                        parameters, translator, allocators);
-
-        return el.second;
     }
 
-private:
     template <typename BoxType, typename Strategy>
     class expandable_box
     {
@@ -353,6 +364,8 @@ private:
             }
 #endif
 
+            rtree::update_aggregate<MembersHolder>::apply(l, parameters);
+
             auto_remover.release();
             return internal_element(elements_box.get(), n);
         }
@@ -377,6 +390,8 @@ private:
                           rtree::elements(in), elements_box,
                           parameters, translator, allocators);
 
+        rtree::update_aggregate<MembersHolder>::apply(in, parameters);
+
         auto_remover.release();
         return internal_element(elements_box.get(), n);
     }
@@ -418,15 +433,10 @@ private:
             return;
         }
 
-        size_type median_count = calculate_median_count(values_count, subtree_counts);
-        EIt median = first + median_count;
-
-        coordinate_type greatest_length;
-        std::size_t greatest_dim_index = 0;
-        pack_utils::biggest_edge<dimension>::apply(hint_box, greatest_length, greatest_dim_index);
         box_type left, right;
-        pack_utils::nth_element_and_half_boxes<0, dimension>
-            ::apply(first, median, last, hint_box, left, right, greatest_dim_index);
+        size_type median_count = split_packets(first, last, hint_box, values_count, subtree_counts,
+                                               left, right);
+        EIt median = first + median_count;
 
         per_level_packets(first, median, left,
                           median_count, subtree_counts, next_subtree_counts,
@@ -438,6 +448,27 @@ private:
                           parameters, translator, allocators);
     }
 
+    // Partition the elements at the object median along the greatest edge of the hint box
+    // and return the number of elements in the first packet.
+    template <typename EIt> inline static
+    size_type split_packets(EIt first, EIt last,
+                            box_type const& hint_box,
+                            size_type values_count,
+                            subtree_elements_counts const& subtree_counts,
+                            box_type & left, box_type & right)
+    {
+        size_type median_count = calculate_median_count(values_count, subtree_counts);
+        EIt median = first + median_count;
+
+        coordinate_type greatest_length;
+        std::size_t greatest_dim_index = 0;
+        pack_utils::biggest_edge<dimension>::apply(hint_box, greatest_length, greatest_dim_index);
+        pack_utils::nth_element_and_half_boxes<0, dimension>
+            ::apply(first, median, last, hint_box, left, right, greatest_dim_index);
+
+        return median_count;
+    }
+
     inline static
     subtree_elements_counts calculate_subtree_elements_counts(size_type elements_count, parameters_type const& parameters, size_type & leafs_level)
     {
@@ -0,0 +1,633 @@
+// Boost.Geometry Index
+//
+// R-tree space-filling curve packing
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_CURVE_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_CURVE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#include <boost/container/vector.hpp>
+
+#include <boost/geometry/algorithms/centroid.hpp>
+#include <boost/geometry/algorithms/detail/expand_by_epsilon.hpp>
+#include <boost/geometry/core/coordinate_system.hpp>
+#include <boost/geometry/core/cs.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/index/detail/algorithms/bounds.hpp>
+#include <boost/geometry/index/detail/algorithms/is_valid.hpp>
+#include <boost/geometry/index/detail/is_bounding_geometry.hpp>
+#include <boost/geometry/index/detail/rtree/node/aggregate.hpp>
+#include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
+#include <boost/geometry/index/detail/rtree/node/subtree_destroyer.hpp>
+#include <boost/geometry/index/parameters.hpp>
+
+#include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/normalize_spheroidal_coordinates.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree {
+
+namespace pack_utils {
+
+struct hilbert_curve_tag {};
+struct morton_curve_tag {};
+
+// The number of bits of the key used for each coordinate
+template <std::size_t Dimension>
+struct curve_bits
+{
+    static const std::size_t value = 64 / Dimension < 32 ? 64 / Dimension : 32;
+};
+
+template <typename CurveTag>
+struct curve_key
+{};
+
+// Spreads the bits of a coordinate so that Dimension - 1 zero bits are
+// placed between each two consecutive bits
+template <std::size_t Dimension>
+struct spread_bits
+{
+    static inline std::uint64_t apply(std::uint32_t c)
+    {
+        std::uint64_t result = 0;
+        for (std::size_t b = 0 ; b < curve_bits<Dimension>::value ; ++b)
+        {
+            result |= std::uint64_t((c >> b) & 1u) << (b * Dimension);
+        }
+        return result;
+    }
+};
+
+template <>
+struct spread_bits<1>
+{
+    static inline std::uint64_t apply(std::uint32_t c)
+    {
+        return c;
+    }
+};
+
+template <>
+struct spread_bits<2>
+{
+    static inline std::uint64_t apply(std::uint32_t c)
+    {
+        std::uint64_t x = c;
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x << 2)) & 0x3333333333333333ull;
+        x = (x | (x << 1)) & 0x5555555555555555ull;
+        return x;
+    }
+};
+
+template <>
+struct spread_bits<3>
+{
+    static inline std::uint64_t apply(std::uint32_t c)
+    {
+        std::uint64_t x = c & 0x1FFFFFu;
+        x = (x | (x << 32)) & 0x001F00000000FFFFull;
+        x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+        x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+        x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+        x = (x | (x << 2)) & 0x1249249249249249ull;
+        return x;
+    }
+};
+
+// Morton code - interleaved bits of coordinates, the first coordinate
+// is the most significant one
+template <>
+struct curve_key<morton_curve_tag>
+{
+    template <std::size_t Dimension>
+    static inline std::uint64_t apply(std::uint32_t (&coords)[Dimension])
+    {
+        return interleave<Dimension>(coords);
+    }
+
+    template <std::size_t Dimension>
+    static inline std::uint64_t interleave(std::uint32_t const (&coords)[Dimension])
+    {
+        std::uint64_t result = 0;
+        for (std::size_t d = 0 ; d < Dimension ; ++d)
+        {
+            result |= spread_bits<Dimension>::apply(coords[d]) << (Dimension - 1 - d);
+        }
+        return result;
+    }
+};
+
+// Hilbert index calculated with the algorithm described in
+// J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 381 (2004)
+template <std::size_t Dimension>
+struct hilbert_key
+{
+    static inline std::uint64_t apply(std::uint32_t (&coords)[Dimension])
+    {
+        static const std::size_t bits = curve_bits<Dimension>::value;
+        std::uint32_t const m = std::uint32_t(1) << (bits - 1);
+
+        // inverse undo
+        for (std::uint32_t q = m ; q > 1 ; q >>= 1)
+        {
+            std::uint32_t const p = q - 1;
+            for (std::size_t d = 0 ; d < Dimension ; ++d)
+            {
+                // branchless version of:
+                // if (coords[d] & q) invert low bits of coords[0]
+                // else exchange low bits of coords[0] and coords[d]
+                std::uint32_t const invert = std::uint32_t(0) - std::uint32_t((coords[d] & q) != 0);
+                std::uint32_t const t = (coords[0] ^ coords[d]) & p & ~invert;
+                coords[0] ^= (p & invert) ^ t;
+                coords[d] ^= t;
+            }
+        }
+
+        // gray encode
+        for (std::size_t d = 1 ; d < Dimension ; ++d)
+        {
+            coords[d] ^= coords[d - 1];
+        }
+        std::uint32_t t = 0;
+        for (std::uint32_t q = m ; q > 1 ; q >>= 1)
+        {
+            t ^= (q - 1) & (std::uint32_t(0) - std::uint32_t((coords[Dimension - 1] & q) != 0));
+        }
+        for (std::size_t d = 0 ; d < Dimension ; ++d)
+        {
+            coords[d] ^= t;
+        }
+
+        return curve_key<morton_curve_tag>::interleave<Dimension>(coords);
+    }
+};
+
+// Hilbert index in 2d calculated with a state machine processing
+// 4 bits of each coordinate at once. The states represent the orientation
+// of the curve in the current cell (swapped axes and complemented bits).
+template <>
+struct hilbert_key<2>
+{
+    static inline std::uint64_t apply(std::uint32_t (&coords)[2])
+    {
+        static const table_type table = make_table();
+
+        std::uint64_t result = 0;
+        std::uint32_t state = 0;
+        for (int shift = 28 ; shift >= 0 ; shift -= 4)
+        {
+            std::uint32_t const x = (coords[0] >> shift) & 0xFu;
+            std::uint32_t const y = (coords[1] >> shift) & 0xFu;
+            std::uint16_t const entry = table.entries[state][(x << 4) | y];
+            result = (result << 8) | (entry & 0xFFu);
+            state = entry >> 8;
+        }
+        return result;
+    }
+
+private:
+    struct table_type
+    {
+        // 8 bits of the key and the next state
+        std::uint16_t entries[4][256];
+    };
+
+    static inline table_type make_table()
+    {
+        table_type table;
+        for (std::uint32_t s = 0 ; s < 4 ; ++s)
+        {
+            for (std::uint32_t xy = 0 ; xy < 256 ; ++xy)
+            {
+                std::uint32_t swap = s & 1u;
+                std::uint32_t inverted = (s >> 1) & 1u;
+                std::uint32_t key = 0;
+                for (int b = 3 ; b >= 0 ; --b)
+                {
+                    std::uint32_t const bx = (xy >> (4 + b)) & 1u;
+                    std::uint32_t const by = (xy >> b) & 1u;
+                    std::uint32_t const rx = (swap ? by : bx) ^ inverted;
+                    std::uint32_t const ry = (swap ? bx : by) ^ inverted;
+                    key = (key << 2) | ((3u * rx) ^ ry);
+                    if (ry == 0)
+                    {
+                        inverted ^= rx;
+                        swap ^= 1u;
+                    }
+                }
+                table.entries[s][xy] = std::uint16_t(key | ((swap | (inverted << 1)) << 8));
+            }
+        }
+        return table;
+    }
+};
+
+template <>
+struct curve_key<hilbert_curve_tag>
+{
+    template <std::size_t Dimension>
+    static inline std::uint64_t apply(std::uint32_t (&coords)[Dimension])
+    {
+        return hilbert_key<Dimension>::apply(coords);
+    }
+};
+
+// The coordinate of a centroid in the range of the bounds of all elements.
+// The boxes of spherical and geographic elements spanning the antimeridian
+// can have max longitude greater than the max longitude of the centroids
+// so the longitudes smaller than the min longitude of the box are shifted
+// by the period instead of being clamped.
+template <std::size_t I, typename CSTag>
+struct curve_coordinate
+{
+    template <typename Point, typename Box>
+    static inline double apply(Point const& pt, Box const& )
+    {
+        return double(geometry::get<I>(pt));
+    }
+};
+
+template <typename Point>
+struct curve_longitude
+{
+    template <typename Box>
+    static inline double apply(Point const& pt, Box const& box)
+    {
+        typedef typename geometry::detail::cs_angular_units<Point>::type units_type;
+        double const period = math::detail::constants_on_spheroid<double, units_type>::period();
+
+        double const mi = double(geometry::get<min_corner, 0>(box));
+        double c = double(geometry::get<0>(pt));
+        if (c < mi)
+        {
+            c += period;
+        }
+        return c;
+    }
+};
+
+template <>
+struct curve_coordinate<0, spherical_equatorial_tag>
+{
+    template <typename Point, typename Box>
+    static inline double apply(Point const& pt, Box const& box)
+    {
+        return curve_longitude<Point>::apply(pt, box);
+    }
+};
+
+template <>
+struct curve_coordinate<0, spherical_polar_tag>
+    : curve_coordinate<0, spherical_equatorial_tag>
+{};
+
+template <>
+struct curve_coordinate<0, geographic_tag>
+    : curve_coordinate<0, spherical_equatorial_tag>
+{};
+
+template <std::size_t I, std::size_t Dimension>
+struct quantize_coordinates
+{
+    template <typename Point, typename Box>
+    static inline void apply(Point const& pt, Box const& box, std::uint32_t (&coords)[Dimension])
+    {
+        static const std::size_t bits = curve_bits<Dimension>::value;
+        double const cells = double((std::uint64_t(1) << bits) - 1);
+
+        double const mi = double(geometry::get<min_corner, I>(box));
+        double const ma = double(geometry::get<max_corner, I>(box));
+        double const c = curve_coordinate
+            <
+                I, typename geometry::cs_tag<Point>::type
+            >::apply(pt, box);
+
+        double q = ma > mi ? (c - mi) / (ma - mi) * cells : 0.0;
+        q = q < 0.0 ? 0.0 : (q > cells ? cells : q);
+        coords[I] = static_cast<std::uint32_t>(q);
+
+        quantize_coordinates<I + 1, Dimension>::apply(pt, box, coords);
+    }
+};
+
+template <std::size_t Dimension>
+struct quantize_coordinates<Dimension, Dimension>
+{
+    template <typename Point, typename Box>
+    static inline void apply(Point const& , Box const& , std::uint32_t (&)[Dimension])
+    {}
+};
+
+// The curve key of a centroid quantized in the bounds of all elements
+template <typename CurveTag>
+struct centroid_key
+{
+    template <typename Point, typename Box>
+    static inline std::uint64_t apply(Point const& pt, Box const& box)
+    {
+        static const std::size_t dimension = geometry::dimension<Point>::value;
+        std::uint32_t coords[dimension];
+        quantize_coordinates<0, dimension>::apply(pt, box, coords);
+        return curve_key<CurveTag>::apply(coords);
+    }
+};
+
+struct curve_entries_comparer
+{
+    template <typename CurveEntry>
+    bool operator()(CurveEntry const& e1, CurveEntry const& e2) const
+    {
+        return e1.first < e2.first;
+    }
+};
+
+} // namespace pack_utils
+
+// Bottom-up packing of elements sorted along a space-filling curve.
+//
+// The elements are sorted once by the curve key of their centroids.
+// Then the consecutive elements are stored in leafs and the consecutive
+// nodes in the internal nodes of the upper level until only the root remains.
+// All nodes but the last two of each level contain Max elements, the last two
+// are balanced so that the number of elements is not smaller than Min.
+
+template <typename MembersHolder, typename CurveTag>
+class pack_curve
+{
+    typedef typename MembersHolder::node node;
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    typedef typename MembersHolder::node_pointer node_pointer;
+    typedef typename MembersHolder::size_type size_type;
+    typedef typename MembersHolder::parameters_type parameters_type;
+    typedef typename MembersHolder::translator_type translator_type;
+    typedef typename MembersHolder::allocators_type allocators_type;
+
+    typedef typename MembersHolder::box_type box_type;
+    typedef typename geometry::point_type<box_type>::type point_type;
+    typedef typename detail::strategy_type<parameters_type>::type strategy_type;
+
+    typedef typename rtree::elements_type<internal_node>::type internal_elements;
+    typedef typename internal_elements::value_type internal_element;
+
+    typedef rtree::subtree_destroyer<MembersHolder> subtree_destroyer;
+
+public:
+    template <typename InIt, typename TmpAlloc> inline static
+    node_pointer apply(InIt first, InIt last,
+                       size_type & values_count,
+                       size_type & leafs_level,
+                       parameters_type const& parameters,
+                       translator_type const& translator,
+                       allocators_type & allocators,
+                       TmpAlloc const& temp_allocator)
+    {
+        typedef typename std::iterator_traits<InIt>::difference_type diff_type;
+
+        diff_type diff = std::distance(first, last);
+        if ( diff <= 0 )
+            return node_pointer(0);
+
+        values_count = static_cast<size_type>(diff);
+        leafs_level = 0;
+
+        auto const& strategy = index::detail::get_strategy(parameters);
+
+        // calculate centroids and the bounds of all elements
+        typedef std::pair<point_type, InIt> point_entry_type;
+        typedef typename boost::container::allocator_traits<TmpAlloc>::
+            template rebind_alloc<point_entry_type> temp_point_entry_allocator_type;
+        boost::container::vector<point_entry_type, temp_point_entry_allocator_type>
+            point_entries((temp_point_entry_allocator_type(temp_allocator)));
+        point_entries.reserve(values_count);
+
+        box_type hint_box;
+        geometry::assign_inverse(hint_box);
+        bool hint_box_initialized = false;
+        for ( ; first != last ; ++first )
+        {
+            // NOTE: the same as in pack, support for iterators not returning true references
+            typename std::iterator_traits<InIt>::reference in_ref = *first;
+            typename translator_type::result_type indexable = translator(in_ref);
+
+            BOOST_GEOMETRY_INDEX_ASSERT(detail::is_valid(indexable), "Indexable is invalid");
+
+            if ( hint_box_initialized )
+            {
+                detail::expand(hint_box, indexable, strategy);
+            }
+            else
+            {
+                detail::bounds(indexable, hint_box, strategy);
+                hint_box_initialized = true;
+            }
+
+            point_type pt;
+            geometry::centroid(indexable, pt, strategy);
+            point_entries.push_back(std::make_pair(pt, first));
+        }
+
+        // calculate the keys and sort
+        typedef std::pair<std::uint64_t, InIt> entry_type;
+        typedef typename boost::container::allocator_traits<TmpAlloc>::
+            template rebind_alloc<entry_type> temp_entry_allocator_type;
+        boost::container::vector<entry_type, temp_entry_allocator_type>
+            entries((temp_entry_allocator_type(temp_allocator)));
+        entries.reserve(values_count);
+
+        for (auto const& pe : point_entries)
+        {
+            entries.push_back(std::make_pair(pack_utils::centroid_key<CurveTag>::apply(pe.first, hint_box),
+                                             pe.second));
+        }
+        point_entries.clear();
+        point_entries.shrink_to_fit();
+
+        std::sort(entries.begin(), entries.end(), pack_utils::curve_entries_comparer());
+
+        // create the leafs
+        typedef typename boost::container::allocator_traits<TmpAlloc>::
+            template rebind_alloc<internal_element> temp_element_allocator_type;
+        typedef boost::container::vector<internal_element, temp_element_allocator_type> level_elements;
+
+        level_elements current((temp_element_allocator_type(temp_allocator)));
+        level_elements next((temp_element_allocator_type(temp_allocator)));
+        elements_destroyer<level_elements> current_destroyer(current, allocators);
+        elements_destroyer<level_elements> next_destroyer(next, allocators);
+
+        size_type const max_elements = parameters.get_max_elements();
+        size_type const min_elements = parameters.get_min_elements();
+
+        current.reserve(nodes_count(values_count, max_elements));                                   // MAY THROW (A)
+        for ( size_type i = 0 ; i < values_count ; )
+        {
+            size_type const count = node_elements_count(i, values_count, max_elements, min_elements);
+            current.push_back(create_leaf(entries.begin() + i, entries.begin() + i + count,
+                                          parameters, translator, allocators));                    // MAY THROW (A, C)
+            i += count;
+        }
+
+        // create internal nodes until only the root remains
+        while ( current.size() > 1 )
+        {
+            size_type const elements_count = current.size();
+            next.reserve(nodes_count(elements_count, max_elements));                                // MAY THROW (A)
+            for ( size_type i = 0 ; i < elements_count ; )
+            {
+                size_type const count = node_elements_count(i, elements_count, max_elements, min_elements);
+                next.push_back(create_internal_node(current.begin() + i, current.begin() + i + count,
+                                                    parameters, allocators));                       // MAY THROW (A)
+                i += count;
+            }
+
+            current.clear();
+            current.swap(next);
+            ++leafs_level;
+        }
+
+        node_pointer result = current.front().second;
+        current.clear();
+        return result;
+    }
+
+private:
+    // destroys subtrees which are not yet stored in any node in case of an exception
+    template <typename Elements>
+    class elements_destroyer
+    {
+    public:
+        elements_destroyer(Elements & elements, allocators_type & allocators)
+            : m_elements(elements), m_allocators(allocators)
+        {}
+
+        ~elements_destroyer()
+        {
+            for (auto & el : m_elements)
+            {
+                if ( el.second )
+                {
+                    subtree_destroyer dummy(el.second, m_allocators);
+                    el.second = 0;
+                }
+            }
+        }
+
+    private:
+        Elements & m_elements;
+        allocators_type & m_allocators;
+    };
+
+    inline static
+    size_type nodes_count(size_type count, size_type max_elements)
+    {
+        return (count + max_elements - 1) / max_elements;
+    }
+
+    // The number of elements stored in a node starting at the i-th element
+    inline static
+    size_type node_elements_count(size_type i, size_type count,
+                                  size_type max_elements, size_type min_elements)
+    {
+        size_type const left = count - i;
+        if ( left <= max_elements )
+        {
+            return left;
+        }
+        // the next node would be underflowed, balance the last two nodes
+        if ( left < max_elements + min_elements )
+        {
+            return left - min_elements;
+        }
+        return max_elements;
+    }
+
+    template <typename EIt> inline static
+    internal_element create_leaf(EIt first, EIt last,
+                                 parameters_type const& parameters,
+                                 translator_type const& translator,
+                                 allocators_type & allocators)
+    {
+        auto const& strategy = index::detail::get_strategy(parameters);
+
+        node_pointer n = rtree::create_node<allocators_type, leaf>::apply(allocators);                   // MAY THROW (A)
+        subtree_destroyer auto_remover(n, allocators);
+        leaf & l = rtree::get<leaf>(*n);
+
+        rtree::elements(l).reserve(std::distance(first, last));                                    // MAY THROW (A)
+
+        box_type elements_box;
+        detail::bounds(translator(*(first->second)), elements_box, strategy);
+        rtree::elements(l).push_back(*(first->second));                                             // MAY THROW (A?,C)
+        for ( ++first ; first != last ; ++first )
+        {
+            // NOTE: push_back() must be called at the end in order to support move_iterator.
+            //       The iterator is dereferenced 2x (no temporary reference) to support
+            //       non-true reference types and move_iterator without std::forward<>.
+            detail::expand(elements_box, translator(*(first->second)), strategy);
+            rtree::elements(l).push_back(*(first->second));                                         // MAY THROW (A?,C)
+        }
+
+#ifdef BOOST_GEOMETRY_INDEX_EXPERIMENTAL_ENLARGE_BY_EPSILON
+        // Enlarge bounds of a leaf node, the same as in pack
+        if ( BOOST_GEOMETRY_CONDITION((
+                ! index::detail::is_bounding_geometry
+                    <
+                        typename indexable_type<translator_type>::type
+                    >::value )) )
+        {
+            geometry::detail::expand_by_epsilon(elements_box);
+        }
+#endif
+
+        rtree::update_aggregate<MembersHolder>::apply(l, parameters);
+
+        auto_remover.release();
+        return internal_element(elements_box, n);
+    }
+
+    template <typename EIt> inline static
+    internal_element create_internal_node(EIt first, EIt last,
+                                          parameters_type const& parameters,
+                                          allocators_type & allocators)
+    {
+        auto const& strategy = index::detail::get_strategy(parameters);
+
+        node_pointer n = rtree::create_node<allocators_type, internal_node>::apply(allocators);          // MAY THROW (A)
+        subtree_destroyer auto_remover(n, allocators);
+        internal_node & in = rtree::get<internal_node>(*n);
+
+        rtree::elements(in).reserve(std::distance(first, last));                                   // MAY THROW (A)
+
+        box_type elements_box = first->first;
+        for ( ; first != last ; ++first )
+        {
+            detail::expand(elements_box, first->first, strategy);
+            rtree::elements(in).push_back(*first);                                                  // nothrow
+            // the subtree is owned by the new node now
+            first->second = 0;
+        }
+
+        rtree::update_aggregate<MembersHolder>::apply(in, parameters);
+
+        auto_remover.release();
+        return internal_element(elements_box, n);
+    }
+};
+
+}}}}} // namespace boost::geometry::index::detail::rtree
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_CURVE_HPP
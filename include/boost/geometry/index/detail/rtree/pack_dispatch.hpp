@@ -0,0 +1,117 @@
+// Boost.Geometry Index
+//
+// R-tree packing algorithms dispatch
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_DISPATCH_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_DISPATCH_HPP
+
+#include <boost/geometry/core/static_assert.hpp>
+
+#include <boost/geometry/index/detail/rtree/pack_create.hpp>
+#include <boost/geometry/index/detail/rtree/pack_curve.hpp>
+#include <boost/geometry/index/detail/rtree/pack_parallel.hpp>
+#include <boost/geometry/index/packing.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree {
+
+template <typename MembersHolder, typename Packing>
+struct pack_dispatch
+{
+    BOOST_GEOMETRY_STATIC_ASSERT_FALSE(
+        "Not implemented for this Packing algorithm.",
+        Packing);
+};
+
+template <typename MembersHolder>
+struct pack_dispatch<MembersHolder, index::default_packing>
+{
+    template <typename InIt, typename TmpAlloc>
+    static inline typename MembersHolder::node_pointer
+        apply(InIt first, InIt last,
+              typename MembersHolder::size_type & values_count,
+              typename MembersHolder::size_type & leafs_level,
+              MembersHolder & members,
+              index::default_packing const& ,
+              TmpAlloc const& temp_allocator)
+    {
+        return rtree::pack<MembersHolder>::apply(first, last, values_count, leafs_level,
+                                                 members.parameters(), members.translator(),
+                                                 members.allocators(), temp_allocator);
+    }
+};
+
+template <typename MembersHolder>
+struct pack_dispatch<MembersHolder, index::hilbert_packing>
+{
+    template <typename InIt, typename TmpAlloc>
+    static inline typename MembersHolder::node_pointer
+        apply(InIt first, InIt last,
+              typename MembersHolder::size_type & values_count,
+              typename MembersHolder::size_type & leafs_level,
+              MembersHolder & members,
+              index::hilbert_packing const& ,
+              TmpAlloc const& temp_allocator)
+    {
+        return rtree::pack_curve<MembersHolder, pack_utils::hilbert_curve_tag>
+            ::apply(first, last, values_count, leafs_level,
+                    members.parameters(), members.translator(),
+                    members.allocators(), temp_allocator);
+    }
+};
+
+template <typename MembersHolder>
+struct pack_dispatch<MembersHolder, index::morton_packing>
+{
+    template <typename InIt, typename TmpAlloc>
+    static inline typename MembersHolder::node_pointer
+        apply(InIt first, InIt last,
+              typename MembersHolder::size_type & values_count,
+              typename MembersHolder::size_type & leafs_level,
+              MembersHolder & members,
+              index::morton_packing const& ,
+              TmpAlloc const& temp_allocator)
+    {
+        return rtree::pack_curve<MembersHolder, pack_utils::morton_curve_tag>
+            ::apply(first, last, values_count, leafs_level,
+                    members.parameters(), members.translator(),
+                    members.allocators(), temp_allocator);
+    }
+};
+
+template <typename MembersHolder, typename Executor>
+struct pack_dispatch<MembersHolder, index::parallel_packing<Executor> >
+{
+    BOOST_GEOMETRY_STATIC_ASSERT(
+        (! index::detail::is_unsynchronized_allocator
+            <
+                typename MembersHolder::allocators_type::node_allocator_type
+            >::value),
+        "parallel_packing requires an allocator which can be used concurrently.",
+        typename MembersHolder::allocators_type::node_allocator_type);
+
+    template <typename InIt, typename TmpAlloc>
+    static inline typename MembersHolder::node_pointer
+        apply(InIt first, InIt last,
+              typename MembersHolder::size_type & values_count,
+              typename MembersHolder::size_type & leafs_level,
+              MembersHolder & members,
+              index::parallel_packing<Executor> const& packing,
+              TmpAlloc const& temp_allocator)
+    {
+        return rtree::pack_parallel<MembersHolder>
+            ::apply(first, last, values_count, leafs_level,
+                    members.parameters(), members.translator(),
+                    members.allocators(), temp_allocator,
+                    packing.executor());
+    }
+};
+
+}}}}} // namespace boost::geometry::index::detail::rtree
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_DISPATCH_HPP
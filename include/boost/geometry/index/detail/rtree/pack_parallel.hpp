@@ -0,0 +1,358 @@
+// Boost.Geometry Index
+//
+// R-tree parallel packing
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_PARALLEL_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_PARALLEL_HPP
+
+#include <vector>
+
+#include <boost/container/vector.hpp>
+
+#include <boost/geometry/index/detail/rtree/pack_create.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree {
+
+// Parallel version of the default packing algorithm.
+//
+// The top levels of the tree are planned first. The partitioning of the packets
+// is done level by level, all independent packets of a level are partitioned
+// concurrently. When the packets are small enough the subtrees are created
+// concurrently by the serial algorithm. Then the nodes of the top levels are
+// created from the subtrees.
+//
+// Exactly the same operations are performed on exactly the same ranges of elements
+// as in the serial algorithm so the resulting tree is identical.
+// The calls of the executor are never nested.
+
+template <typename MembersHolder>
+class pack_parallel
+    : public pack<MembersHolder>
+{
+    typedef pack<MembersHolder> base_t;
+
+    typedef typename MembersHolder::internal_node internal_node;
+
+    typedef typename MembersHolder::node_pointer node_pointer;
+    typedef typename MembersHolder::size_type size_type;
+    typedef typename MembersHolder::parameters_type parameters_type;
+    typedef typename MembersHolder::translator_type translator_type;
+    typedef typename MembersHolder::allocators_type allocators_type;
+
+    typedef typename MembersHolder::box_type box_type;
+    typedef typename geometry::point_type<box_type>::type point_type;
+    typedef typename detail::strategy_type<parameters_type>::type strategy_type;
+
+    typedef typename rtree::elements_type<internal_node>::type internal_elements;
+    typedef typename internal_elements::value_type internal_element;
+
+    typedef typename base_t::subtree_elements_counts subtree_elements_counts;
+    typedef typename base_t::template expandable_box<box_type, strategy_type> expandable_box;
+
+    typedef rtree::subtree_destroyer<MembersHolder> subtree_destroyer;
+
+public:
+    template <typename InIt, typename TmpAlloc, typename Executor> inline static
+    node_pointer apply(InIt first, InIt last,
+                       size_type & values_count,
+                       size_type & leafs_level,
+                       parameters_type const& parameters,
+                       translator_type const& translator,
+                       allocators_type & allocators,
+                       TmpAlloc const& temp_allocator,
+                       Executor const& executor)
+    {
+        typedef typename std::iterator_traits<InIt>::difference_type diff_type;
+
+        diff_type diff = std::distance(first, last);
+        if ( diff <= 0 )
+            return node_pointer(0);
+
+        typedef std::pair<point_type, InIt> entry_type;
+        typedef typename boost::container::allocator_traits<TmpAlloc>::
+            template rebind_alloc<entry_type> temp_entry_allocator_type;
+        typedef boost::container::vector<entry_type, temp_entry_allocator_type> entries_type;
+
+        temp_entry_allocator_type temp_entry_allocator(temp_allocator);
+        entries_type entries(temp_entry_allocator);
+
+        values_count = static_cast<size_type>(diff);
+        entries.reserve(values_count);
+
+        expandable_box hint_box(detail::get_strategy(parameters));
+        base_t::fill_entries(first, last, entries, hint_box, parameters, translator);                  // MAY THROW (A)
+
+        subtree_elements_counts subtree_counts = base_t::calculate_subtree_elements_counts(values_count, parameters, leafs_level);
+
+        // The subtrees containing at most this number of values are created by single tasks.
+        // Several tasks per thread are created to balance the work.
+        size_type const tasks_count = (std::max)(size_type(executor.concurrency()), size_type(1)) * 4;
+        size_type const task_values_count = (std::max)(values_count / tasks_count, size_type(1));
+
+        typedef typename entries_type::iterator entries_iterator;
+        planner<entries_iterator> plan(entries.begin(), entries.end(), hint_box.get(),
+                                       values_count, subtree_counts, task_values_count,
+                                       parameters, translator, allocators);
+
+        plan.partition(executor);                                                                   // MAY THROW (A)
+        plan.create_subtrees(executor);                                                             // MAY THROW (A, C)
+        return plan.create_root();                                                                  // MAY THROW (A)
+    }
+
+private:
+    template <typename EIt>
+    class planner
+    {
+        // Subtree - the equivalent of per_level() call
+        // Packets - the equivalent of per_level_packets() call
+        struct item
+        {
+            item(bool packets_, EIt first_, EIt last_, box_type const& hint_box_,
+                 size_type values_count_,
+                 subtree_elements_counts const& subtree_counts_,
+                 subtree_elements_counts const& next_subtree_counts_)
+                : is_packets(packets_), is_task(false)
+                , first(first_), last(last_), hint_box(hint_box_)
+                , values_count(values_count_)
+                , subtree_counts(subtree_counts_)
+                , next_subtree_counts(next_subtree_counts_)
+                , median_count(0), left(hint_box_), right(hint_box_)
+                , children_count(0)
+                , result(hint_box_, node_pointer(0))
+            {
+                children[0] = 0;
+                children[1] = 0;
+            }
+
+            bool is_packets;
+            bool is_task;
+
+            EIt first, last;
+            box_type hint_box;
+            size_type values_count;
+            subtree_elements_counts subtree_counts;
+            subtree_elements_counts next_subtree_counts;
+
+            // the result of partitioning of packets
+            size_type median_count;
+            box_type left, right;
+
+            std::size_t children[2];
+            std::size_t children_count;
+
+            // the subtree created by a task
+            internal_element result;
+        };
+
+    public:
+        planner(EIt first, EIt last, box_type const& hint_box,
+                size_type values_count,
+                subtree_elements_counts const& subtree_counts,
+                size_type task_values_count,
+                parameters_type const& parameters,
+                translator_type const& translator,
+                allocators_type & allocators)
+            : m_task_values_count(task_values_count)
+            , m_parameters(parameters)
+            , m_translator(translator)
+            , m_allocators(allocators)
+        {
+            m_items.push_back(item(false, first, last, hint_box, values_count,
+                                   subtree_counts, subtree_counts));
+        }
+
+        ~planner()
+        {
+            // destroy the subtrees which were not moved into the tree in case of an exception
+            for (item & i : m_items)
+            {
+                if ( i.result.second )
+                {
+                    subtree_destroyer dummy(i.result.second, m_allocators);
+                    i.result.second = 0;
+                }
+            }
+        }
+
+        // Partition the packets of the top levels level by level.
+        template <typename Executor>
+        void partition(Executor const& executor)
+        {
+            std::vector<std::size_t> current(1, 0);
+            std::vector<std::size_t> next;
+            std::vector<std::size_t> splits;
+
+            while ( ! current.empty() )
+            {
+                // partition all packets of this level concurrently
+                splits.clear();
+                for (std::size_t id : current)
+                {
+                    item const& i = m_items[id];
+                    if ( i.is_packets && i.subtree_counts.maxc < i.values_count )
+                    {
+                        splits.push_back(id);
+                    }
+                }
+
+                executor(splits.size(), [&](std::size_t s)
+                {
+                    item & i = m_items[splits[s]];
+                    i.median_count = base_t::split_packets(i.first, i.last, i.hint_box,
+                                                           i.values_count, i.subtree_counts,
+                                                           i.left, i.right);
+                });
+
+                // plan the next level
+                next.clear();
+                for (std::size_t id : current)
+                {
+                    expand(id, next);
+                }
+                current.swap(next);
+            }
+        }
+
+        // Create the subtrees concurrently.
+        template <typename Executor>
+        void create_subtrees(Executor const& executor)
+        {
+            std::vector<std::size_t> tasks;
+            for (std::size_t id = 0 ; id < m_items.size() ; ++id)
+            {
+                if ( m_items[id].is_task )
+                {
+                    tasks.push_back(id);
+                }
+            }
+
+            executor(tasks.size(), [&](std::size_t t)
+            {
+                item & i = m_items[tasks[t]];
+                i.result = base_t::per_level(i.first, i.last, i.hint_box, i.values_count,
+                                             i.subtree_counts, m_parameters, m_translator,
+                                             m_allocators);
+            });
+        }
+
+        // Create the nodes of the top levels.
+        node_pointer create_root()
+        {
+            return create_subtree(0).second;
+        }
+
+    private:
+        void expand(std::size_t id, std::vector<std::size_t> & next)
+        {
+            item & i = m_items[id];
+            if ( i.is_packets )
+            {
+                if ( i.values_count <= i.subtree_counts.maxc )
+                {
+                    // the end, move to the next level
+                    add_child(id, item(false, i.first, i.last, i.hint_box, i.values_count,
+                                       i.next_subtree_counts, i.next_subtree_counts), next);
+                }
+                else
+                {
+                    item left(true, i.first, i.first + i.median_count, i.left, i.median_count,
+                              i.subtree_counts, i.next_subtree_counts);
+                    item right(true, i.first + i.median_count, i.last, i.right,
+                               i.values_count - i.median_count,
+                               i.subtree_counts, i.next_subtree_counts);
+                    add_child(id, left, next);
+                    add_child(id, right, next);
+                }
+            }
+            else
+            {
+                if ( i.subtree_counts.maxc <= 1 || i.values_count <= m_task_values_count )
+                {
+                    // leaf or small subtree
+                    i.is_task = true;
+                }
+                else
+                {
+                    subtree_elements_counts next_subtree_counts = i.subtree_counts;
+                    next_subtree_counts.maxc /= m_parameters.get_max_elements();
+                    next_subtree_counts.minc /= m_parameters.get_max_elements();
+
+                    add_child(id, item(true, i.first, i.last, i.hint_box, i.values_count,
+                                       i.subtree_counts, next_subtree_counts), next);
+                }
+            }
+        }
+
+        void add_child(std::size_t id, item const& child, std::vector<std::size_t> & next)
+        {
+            std::size_t const child_id = m_items.size();
+            m_items.push_back(child);                                                               // MAY THROW (A)
+            item & i = m_items[id];
+            i.children[i.children_count++] = child_id;
+            next.push_back(child_id);                                                               // MAY THROW (A)
+        }
+
+        internal_element create_subtree(std::size_t id)
+        {
+            item & i = m_items[id];
+            if ( i.is_task )
+            {
+                internal_element result = i.result;
+                i.result.second = 0;
+                return result;
+            }
+
+            // create new internal node
+            node_pointer n = rtree::create_node<allocators_type, internal_node>::apply(m_allocators); // MAY THROW (A)
+            subtree_destroyer auto_remover(n, m_allocators);
+            internal_node & in = rtree::get<internal_node>(*n);
+
+            // reserve space for values
+            size_type nodes_count = base_t::calculate_nodes_count(i.values_count, i.subtree_counts);
+            rtree::elements(in).reserve(nodes_count);                                               // MAY THROW (A)
+
+            expandable_box elements_box(detail::get_strategy(m_parameters));
+            create_packets(i.children[0], rtree::elements(in), elements_box);
+
+            rtree::update_aggregate<MembersHolder>::apply(in, m_parameters);
+
+            auto_remover.release();
+            return internal_element(elements_box.get(), n);
+        }
+
+        void create_packets(std::size_t id, internal_elements & elements, expandable_box & elements_box)
+        {
+            item const& i = m_items[id];
+            if ( i.children_count == 2 )
+            {
+                create_packets(i.children[0], elements, elements_box);
+                create_packets(i.children[1], elements, elements_box);
+                return;
+            }
+
+            internal_element el = create_subtree(i.children[0]);
+
+            subtree_destroyer auto_remover(el.second, m_allocators);
+            elements.push_back(el);                                                                 // MAY THROW (A?,C)
+            auto_remover.release();
+
+            elements_box.expand(el.first);
+        }
+
+        std::vector<item> m_items;
+        size_type m_task_values_count;
+        parameters_type const& m_parameters;
+        translator_type const& m_translator;
+        allocators_type & m_allocators;
+    };
+};
+
+}}}}} // namespace boost::geometry::index::detail::rtree
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_PARALLEL_HPP
@@ -134,6 +134,7 @@ template <typename MembersHolder, typename Predicates>
 class distance_query_iterator
 {
     typedef typename MembersHolder::allocators_type allocators_type;
+    typedef visitors::distance_query_incremental<MembersHolder, Predicates> impl_type;
 
 public:
     typedef std::forward_iterator_tag iterator_category;
@@ -142,6 +143,9 @@ public:
     typedef typename allocators_type::difference_type difference_type;
     typedef typename allocators_type::const_pointer pointer;
 
+    typedef typename impl_type::value_distance_type comparable_distance_type;
+    typedef typename impl_type::real_distance_type distance_type;
+
     distance_query_iterator() = default;
 
     explicit distance_query_iterator(Predicates const& pred)
@@ -164,6 +168,16 @@ public:
         return boost::addressof(m_impl.dereference());
     }
 
+    comparable_distance_type const& comparable_distance() const
+    {
+        return m_impl.comparable_distance();
+    }
+
+    distance_type distance() const
+    {
+        return m_impl.distance();
+    }
+
     distance_query_iterator & operator++()
     {
         m_impl.increment();
@@ -193,7 +207,7 @@ public:
     }
 
 private:
-    visitors::distance_query_incremental<MembersHolder, Predicates> m_impl;
+    impl_type m_impl;
 };
 
 
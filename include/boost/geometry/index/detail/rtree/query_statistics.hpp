@@ -0,0 +1,100 @@
+// Boost.Geometry Index
+//
+// R-tree query statistics
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_QUERY_STATISTICS_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_QUERY_STATISTICS_HPP
+
+#include <cstddef>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief The counters of the work done by the queries of the rtree.
+
+The object may be passed to rtree::query(). The counters are not reset by the query
+so the statistics of many queries may be gathered by passing the same object.
+*/
+struct query_statistics
+{
+    query_statistics()
+        : internal_nodes(0)
+        , leafs(0)
+        , predicates(0)
+        , pruned_branches(0)
+        , max_branches(0)
+        , max_neighbors(0)
+    {}
+
+    /*! \brief The number of internal nodes visited. */
+    std::size_t internal_nodes;
+    /*! \brief The number of leafs visited. */
+    std::size_t leafs;
+    /*! \brief The number of elements of nodes and values for which the predicates were checked. */
+    std::size_t predicates;
+    /*! \brief The number of children of internal nodes which were not traversed. */
+    std::size_t pruned_branches;
+    /*! \brief The maximum size of the queue of branches of the k-nearest neighbors query. */
+    std::size_t max_branches;
+    /*! \brief The maximum number of neighbors stored by the k-nearest neighbors query. */
+    std::size_t max_neighbors;
+};
+
+namespace detail { namespace rtree {
+
+// The hooks called by the query visitors. By default nothing is gathered and
+// the calls are optimized out.
+struct no_query_statistics
+{
+    void visit_internal_node() {}
+    void visit_leaf() {}
+    void check_predicates() {}
+    void prune_branches(std::size_t) {}
+    void branches_size(std::size_t) {}
+    void neighbors_size(std::size_t) {}
+};
+
+// Stores the statistics in the object passed by the user
+class query_statistics_collector
+{
+public:
+    explicit query_statistics_collector(index::query_statistics & stats)
+        : m_stats(&stats)
+    {}
+
+    void visit_internal_node() { ++m_stats->internal_nodes; }
+    void visit_leaf() { ++m_stats->leafs; }
+    void check_predicates() { ++m_stats->predicates; }
+    void prune_branches(std::size_t count) { m_stats->pruned_branches += count; }
+
+    void branches_size(std::size_t size)
+    {
+        if (m_stats->max_branches < size)
+        {
+            m_stats->max_branches = size;
+        }
+    }
+
+    void neighbors_size(std::size_t size)
+    {
+        if (m_stats->max_neighbors < size)
+        {
+            m_stats->max_neighbors = size;
+        }
+    }
+
+private:
+    index::query_statistics * m_stats;
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_QUERY_STATISTICS_HPP
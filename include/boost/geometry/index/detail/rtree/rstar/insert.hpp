@@ -421,6 +421,8 @@ struct level_insert
         }
 
         base::recalculate_aabb_if_necessary(n);
+
+        base::update_aggregate(n);
     }
 
     inline void operator()(leaf &)
@@ -472,6 +474,8 @@ struct level_insert<InsertIndex, Value, MembersHolder, true>
         }
 
         base::recalculate_aabb_if_necessary(n);
+
+        base::update_aggregate(n);
     }
 
     inline void operator()(leaf & n)
@@ -485,6 +489,8 @@ struct level_insert<InsertIndex, Value, MembersHolder, true>
         rtree::elements(n).push_back(base::m_element);                                                  // MAY THROW, STRONG (V: alloc, copy)
 
         base::handle_possible_split(n);                                                                 // MAY THROW (V: alloc, copy, N: alloc)
+
+        base::update_aggregate(n);
     }
 };
 
@@ -526,6 +532,8 @@ struct level_insert<0, Value, MembersHolder, true>
         base::traverse(*this, n);                                                                       // MAY THROW (V: alloc, copy, N: alloc)
 
         base::recalculate_aabb_if_necessary(n);
+
+        base::update_aggregate(n);
     }
 
     inline void operator()(leaf & n)
@@ -541,6 +549,8 @@ struct level_insert<0, Value, MembersHolder, true>
         base::handle_possible_reinsert_or_split_of_root(n);                                             // MAY THROW (V: alloc, copy, N: alloc)
 
         base::recalculate_aabb_if_necessary(n);
+
+        base::update_aggregate(n);
     }
 };
 
@@ -18,6 +18,10 @@
 
 #include <iostream>
 
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/value_type.hpp>
+
 #include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/coordinate_dimension.hpp>
 #include <boost/geometry/core/static_assert.hpp>
@@ -129,6 +133,25 @@ struct print_indexable<Indexable, segment_tag>
     }
 };
 
+template <typename Indexable>
+struct print_indexable<Indexable, linestring_tag>
+{
+    typedef typename boost::range_value<Indexable>::type point_type;
+    static const size_t dimension = geometry::dimension<point_type>::value;
+
+    static inline void apply(std::ostream &os, Indexable const& i)
+    {
+        bool first = true;
+        for (auto it = boost::begin(i); it != boost::end(i); ++it)
+        {
+            os << (first ? "(" : "-(");
+            print_point<point_type, dimension>::apply(os, *it);
+            os << ')';
+            first = false;
+        }
+    }
+};
+
 } // namespace dispatch
 
 template <typename Indexable> inline
@@ -0,0 +1,108 @@
+// Boost.Geometry Index
+//
+// R-tree aggregate query visitor implementation
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_AGGREGATE_QUERY_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_AGGREGATE_QUERY_HPP
+
+#include <boost/geometry/index/detail/predicates.hpp>
+#include <boost/geometry/index/detail/rtree/node/aggregate.hpp>
+#include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
+#include <boost/geometry/index/parameters.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// Combines the aggregates of the children covered by the box and traverses
+// only the children intersecting the boundary of the box
+template <typename MembersHolder, typename Box>
+class aggregate_query
+    : public MembersHolder::visitor_const
+{
+    typedef typename MembersHolder::parameters_type parameters_type;
+    typedef typename MembersHolder::translator_type translator_type;
+
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    typedef rtree::aggregate_traits<parameters_type> traits;
+    typedef typename traits::aggregate_type aggregate_type;
+    typedef typename index::detail::strategy_type<parameters_type>::result_type strategy_type;
+
+public:
+    typedef typename traits::result_type aggregate_result_type;
+
+    inline aggregate_query(Box const& box,
+                           parameters_type const& parameters,
+                           translator_type const& tr)
+        : m_box(box)
+        , m_aggregate(traits::get(parameters))
+        , m_strategy(index::detail::get_strategy(parameters))
+        , m_tr(tr)
+        , result(m_aggregate.identity())
+    {}
+
+    inline void operator()(internal_node const& n)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        for (typename elements_type::const_iterator it = elements.begin();
+             it != elements.end(); ++it)
+        {
+            // the aggregate of the whole subtree is used if the node is covered
+            if (predicate<index::detail::predicates::covered_by_tag>(it->first))
+            {
+                result = m_aggregate.combine(result,
+                            rtree::get_aggregate<MembersHolder>::apply(*it->second));
+            }
+            else if (predicate<index::detail::predicates::intersects_tag>(it->first))
+            {
+                rtree::apply_visitor(*this, *it->second);
+            }
+        }
+    }
+
+    inline void operator()(leaf const& n)
+    {
+        typedef typename rtree::elements_type<leaf>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        for (typename elements_type::const_iterator it = elements.begin();
+             it != elements.end(); ++it)
+        {
+            if (predicate<index::detail::predicates::intersects_tag>(m_tr(*it)))
+            {
+                result = m_aggregate.combine(result, m_aggregate.value(*it));
+            }
+        }
+    }
+
+private:
+    template <typename Tag, typename Geometry>
+    inline bool predicate(Geometry const& g) const
+    {
+        return index::detail::spatial_predicate_call<Tag>::apply(g, m_box, m_strategy);
+    }
+
+    Box const& m_box;
+    aggregate_type const& m_aggregate;
+    strategy_type m_strategy;
+    translator_type const& m_tr;
+
+public:
+    aggregate_result_type result;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_AGGREGATE_QUERY_HPP
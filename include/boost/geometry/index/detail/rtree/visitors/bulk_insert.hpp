@@ -0,0 +1,498 @@
+// Boost.Geometry Index
+//
+// R-tree bulk inserting visitor implementation
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_BULK_INSERT_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_BULK_INSERT_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/core/no_exceptions_support.hpp>
+
+#include <boost/geometry/algorithms/centroid.hpp>
+
+#include <boost/geometry/index/detail/algorithms/bounds.hpp>
+#include <boost/geometry/index/detail/rtree/node/aggregate.hpp>
+#include <boost/geometry/index/detail/rtree/node/node.hpp>
+#include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
+#include <boost/geometry/index/detail/rtree/node/subtree_destroyer.hpp>
+#include <boost/geometry/index/detail/rtree/pack_create.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/insert.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// Inserts many values at once.
+//
+// The values are distributed between the children of the visited node using
+// the choose_next_node algorithm of the tree and each subtree is visited once
+// with all of its values. The node which would overflow is not split as in
+// the insert visitor. Instead its elements, the old ones and the new ones, are
+// divided into the minimal number of nodes using the top-down median split of
+// the packing algorithm. The new nodes are passed to the parent which divides
+// its own elements if needed and finally the new levels are added on top of
+// the root. So each node is modified at most once regardless of the number of
+// inserted values and all of the nodes are filled at least in half.
+template <typename MembersHolder>
+class bulk_insert
+    : public MembersHolder::visitor
+{
+    typedef typename MembersHolder::box_type box_type;
+    typedef typename MembersHolder::value_type value_type;
+    typedef typename MembersHolder::parameters_type parameters_type;
+    typedef typename MembersHolder::translator_type translator_type;
+    typedef typename MembersHolder::allocators_type allocators_type;
+
+    typedef typename MembersHolder::node node;
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    typedef rtree::subtree_destroyer<MembersHolder> subtree_destroyer;
+    typedef typename allocators_type::node_pointer node_pointer;
+    typedef typename allocators_type::size_type size_type;
+
+    typedef typename rtree::elements_type<internal_node>::type internal_elements;
+    typedef typename internal_elements::value_type internal_element;
+    typedef typename rtree::elements_type<leaf>::type leaf_elements;
+
+    typedef typename geometry::point_type<box_type>::type point_type;
+    static const std::size_t dimension = geometry::dimension<point_type>::value;
+
+    typedef std::vector<value_type> values_type;
+    typedef std::vector<internal_element> nodes_type;
+    typedef std::vector<size_type> indexes_type;
+    typedef typename indexes_type::iterator indexes_iterator;
+    typedef std::pair<point_type, size_type> entry_type;
+    typedef std::vector<entry_type> entries_type;
+
+public:
+    inline bulk_insert(node_pointer & root,
+                       size_type & leafs_level,
+                       values_type const& values,
+                       parameters_type const& parameters,
+                       translator_type const& translator,
+                       allocators_type & allocators)
+        : m_values(values)
+        , m_parameters(parameters)
+        , m_translator(translator)
+        , m_allocators(allocators)
+        , m_root_node(root)
+        , m_leafs_level(leafs_level)
+        , m_indexes(values.size())
+        , m_current_level(0)
+    {
+        for ( size_type i = 0 ; i < m_indexes.size() ; ++i )
+            m_indexes[i] = i;
+
+        m_first = m_indexes.begin();
+        m_last = m_indexes.end();
+    }
+
+    inline void operator()(internal_node & n)
+    {
+        internal_elements & children = rtree::elements(n);
+        size_type const children_count = children.size();
+        size_type const relative_level = m_leafs_level - m_current_level;
+        auto const& strategy = index::detail::get_strategy(m_parameters);
+
+        // choose the subtrees for the values and sort the values by subtrees
+        indexes_type counts(children_count + 1, 0);
+        indexes_type choices(m_last - m_first);
+        {
+            size_type i = 0;
+            for ( indexes_iterator it = m_first ; it != m_last ; ++it, ++i )
+            {
+                typename translator_type::result_type indexable = m_translator(m_values[*it]);
+                size_type const c = choose_next_node<MembersHolder>::apply(n, indexable, m_parameters,
+                                                                           relative_level);
+                // expand the box as in the insert visitor so the next values see the change
+                index::detail::expand(children[c].first, indexable, strategy);
+                choices[i] = c;
+                ++counts[c + 1];
+            }
+        }
+
+        for ( size_type c = 1 ; c <= children_count ; ++c )
+            counts[c] += counts[c - 1];
+
+        {
+            indexes_type sorted(m_last - m_first);
+            indexes_type offsets(counts.begin(), counts.end() - 1);
+            size_type i = 0;
+            for ( indexes_iterator it = m_first ; it != m_last ; ++it, ++i )
+                sorted[offsets[choices[i]]++] = *it;
+            std::copy(sorted.begin(), sorted.end(), m_first);
+        }
+
+        // visit the subtrees and gather the new nodes
+        nodes_type new_children;
+        BOOST_TRY
+        {
+            indexes_iterator const first = m_first;
+            for ( size_type c = 0 ; c < children_count ; ++c )
+            {
+                if ( counts[c] == counts[c + 1] )
+                    continue;
+
+                traverse_apply_visitor(children[c], first + counts[c], first + counts[c + 1]);      // MAY THROW (V, E: alloc, copy, N: alloc)
+
+                new_children.insert(new_children.end(), m_new_nodes.begin(), m_new_nodes.end()); // MAY THROW (E: alloc)
+                m_new_nodes.clear();
+            }
+        }
+        BOOST_CATCH(...)
+        {
+            rtree::destroy_elements<MembersHolder>::apply(m_new_nodes, m_allocators);
+            m_new_nodes.clear();
+            rtree::destroy_elements<MembersHolder>::apply(new_children, m_allocators);
+            BOOST_RETHROW                                                                           // RETHROW
+        }
+        BOOST_CATCH_END
+
+        if ( children.size() + new_children.size() <= m_parameters.get_max_elements() )
+        {
+            BOOST_TRY
+            {
+                for ( ; ! new_children.empty() ; new_children.pop_back() )
+                    children.push_back(new_children.back());                                        // MAY THROW (E: alloc)
+            }
+            BOOST_CATCH(...)
+            {
+                rtree::destroy_elements<MembersHolder>::apply(new_children, m_allocators);
+                BOOST_RETHROW                                                                       // RETHROW
+            }
+            BOOST_CATCH_END
+
+            m_box = rtree::elements_box<box_type>(children.begin(), children.end(), m_translator, strategy);
+            rtree::update_aggregate<MembersHolder>::apply(n, m_parameters);
+        }
+        else
+        {
+            // the node would overflow - divide the old and new children between the nodes
+            BOOST_TRY
+            {
+                new_children.insert(new_children.begin(), children.begin(), children.end());       // MAY THROW (E: alloc)
+            }
+            BOOST_CATCH(...)
+            {
+                rtree::destroy_elements<MembersHolder>::apply(new_children, m_allocators);
+                BOOST_RETHROW                                                                       // RETHROW
+            }
+            BOOST_CATCH_END
+
+            children.clear();
+            divide_elements(n, new_children);                                                       // MAY THROW (E: alloc, N: alloc)
+        }
+
+        if ( m_current_level == 0 )
+            grow_root();                                                                            // MAY THROW (E: alloc, N: alloc)
+    }
+
+    inline void operator()(leaf & n)
+    {
+        leaf_elements & elements = rtree::elements(n);
+        auto const& strategy = index::detail::get_strategy(m_parameters);
+
+        size_type const count = static_cast<size_type>(m_last - m_first);
+        if ( elements.size() + count <= m_parameters.get_max_elements() )
+        {
+            for ( indexes_iterator it = m_first ; it != m_last ; ++it )
+                elements.push_back(m_values[*it]);                                                  // MAY THROW (V, E: alloc, copy)
+
+            m_box = rtree::values_box<box_type>(elements.begin(), elements.end(), m_translator, strategy);
+            rtree::update_aggregate<MembersHolder>::apply(n, m_parameters);
+        }
+        else
+        {
+            // the leaf would overflow - divide the old and new values between the leafs
+            values_type values(elements.begin(), elements.end());                                  // MAY THROW (V, E: alloc, copy)
+            values.reserve(values.size() + count);                                                  // MAY THROW (E: alloc)
+            for ( indexes_iterator it = m_first ; it != m_last ; ++it )
+                values.push_back(m_values[*it]);                                                    // MAY THROW (V: copy)
+
+            elements.clear();
+            divide_elements(n, values);                                                             // MAY THROW (V, E: alloc, copy, N: alloc)
+        }
+
+        if ( m_current_level == 0 )
+            grow_root();                                                                            // MAY THROW (E: alloc, N: alloc)
+    }
+
+private:
+    void traverse_apply_visitor(internal_element & child, indexes_iterator first, indexes_iterator last)
+    {
+        // save previous traverse inputs and set new ones
+        indexes_iterator first_bckup = m_first;
+        indexes_iterator last_bckup = m_last;
+
+        m_first = first;
+        m_last = last;
+        ++m_current_level;
+
+        // next traversing step
+        rtree::apply_visitor(*this, *child.second);                                                 // MAY THROW (V, E: alloc, copy, N: alloc)
+
+        // restore previous traverse inputs
+        m_first = first_bckup;
+        m_last = last_bckup;
+        --m_current_level;
+
+        child.first = m_box;
+    }
+
+    // Divide the elements between the node n and the new nodes stored in m_new_nodes.
+    // The box of n is stored in m_box.
+    // The elements of internal nodes are owned by the function, in case of exception
+    // the nodes which are not yet stored in any node are destroyed.
+    template <typename Node, typename Elements>
+    void divide_elements(Node & n, Elements & elements)
+    {
+        auto const& strategy = index::detail::get_strategy(m_parameters);
+
+        entries_type entries;
+        size_type first_not_stored = 0;
+        BOOST_TRY
+        {
+            size_type const count = elements.size();
+            size_type const max_elements = m_parameters.get_max_elements();
+            size_type const groups_count = (count + max_elements - 1) / max_elements;
+
+            entries.reserve(count);                                                                 // MAY THROW (E: alloc)
+            for ( size_type i = 0 ; i < count ; ++i )
+            {
+                point_type pt;
+                geometry::centroid(rtree::element_indexable(elements[i], m_translator), pt, strategy);
+                entries.push_back(entry_type(pt, i));
+            }
+
+            divide_entries(entries.begin(), entries.end(), groups_count);
+
+            // the sizes of groups differ at most by 1 so they are between min and max elements
+            size_type const group_size = count / groups_count;
+            size_type const bigger_groups_count = count % groups_count;
+
+            typename entries_type::const_iterator it = entries.begin();
+            for ( size_type g = 0 ; g < groups_count ; ++g )
+            {
+                typename entries_type::const_iterator group_last
+                    = it + group_size + (g < bigger_groups_count ? 1 : 0);
+
+                if ( g == 0 )
+                {
+                    fill_node(n, elements, it, group_last, first_not_stored);                       // MAY THROW (V, E: alloc, copy)
+                    rtree::update_aggregate<MembersHolder>::apply(n, m_parameters);
+                    m_box = rtree::elements_box<box_type>(rtree::elements(n).begin(), rtree::elements(n).end(),
+                                                          m_translator, strategy);
+                }
+                else
+                {
+                    node_pointer new_node = rtree::create_node<allocators_type, Node>::apply(m_allocators); // MAY THROW (N: alloc)
+                    subtree_destroyer auto_remover(new_node, m_allocators);
+                    Node & nn = rtree::get<Node>(*new_node);
+
+                    fill_node(nn, elements, it, group_last, first_not_stored);                      // MAY THROW (V, E: alloc, copy)
+                    rtree::update_aggregate<MembersHolder>::apply(nn, m_parameters);
+
+                    box_type box = rtree::elements_box<box_type>(rtree::elements(nn).begin(), rtree::elements(nn).end(),
+                                                                 m_translator, strategy);
+                    m_new_nodes.push_back(internal_element(box, new_node));                         // MAY THROW (E: alloc)
+                    auto_remover.release();
+                }
+
+                it = group_last;
+            }
+        }
+        BOOST_CATCH(...)
+        {
+            // destroy the nodes which are not stored in any node
+            for ( typename entries_type::const_iterator it = entries.begin() + first_not_stored ;
+                  it != entries.end() ; ++it )
+            {
+                rtree::destroy_elements<MembersHolder>::apply(elements.begin() + it->second,
+                                                              elements.begin() + it->second + 1,
+                                                              m_allocators);
+            }
+            if ( entries.empty() )
+            {
+                rtree::destroy_elements<MembersHolder>::apply(elements, m_allocators);
+            }
+            rtree::destroy_elements<MembersHolder>::apply(m_new_nodes, m_allocators);
+            m_new_nodes.clear();
+            BOOST_RETHROW                                                                           // RETHROW
+        }
+        BOOST_CATCH_END
+    }
+
+    template <typename Node, typename Elements, typename EIt>
+    static void fill_node(Node & n, Elements const& elements, EIt first, EIt last,
+                          size_type & first_not_stored)
+    {
+        typename rtree::elements_type<Node>::type & node_elements = rtree::elements(n);
+        node_elements.reserve(static_cast<size_type>(last - first));                               // MAY THROW (E: alloc)
+        for ( ; first != last ; ++first )
+        {
+            node_elements.push_back(elements[first->second]);                                       // MAY THROW (V, E: alloc, copy)
+            ++first_not_stored;
+        }
+    }
+
+    // Reorder the entries so the consecutive groups of almost equal sizes are close
+    // to each other, the same way as the packing algorithm does.
+    void divide_entries(typename entries_type::iterator first,
+                        typename entries_type::iterator last,
+                        size_type groups_count) const
+    {
+        if ( groups_count <= 1 )
+            return;
+
+        size_type const count = static_cast<size_type>(last - first);
+        size_type const group_size = count / groups_count;
+        size_type const bigger_groups_count = count % groups_count;
+        size_type const left_groups_count = groups_count / 2;
+        size_type const left_count = left_groups_count * group_size
+                                   + (std::min)(left_groups_count, bigger_groups_count);
+
+        auto const& strategy = index::detail::get_strategy(m_parameters);
+        box_type box;
+        index::detail::bounds(first->first, box, strategy);
+        for ( typename entries_type::iterator it = first + 1 ; it != last ; ++it )
+            index::detail::expand(box, it->first, strategy);
+
+        typename coordinate_type<box_type>::type greatest_length;
+        std::size_t greatest_dim_index = 0;
+        pack_utils::biggest_edge<dimension>::apply(box, greatest_length, greatest_dim_index);
+        box_type left, right;
+        pack_utils::nth_element_and_half_boxes<0, dimension>
+            ::apply(first, first + left_count, last, box, left, right, greatest_dim_index);
+
+        divide_entries(first, first + left_count, left_groups_count);
+        divide_entries(first + left_count, last, groups_count - left_groups_count);
+    }
+
+    // Add the levels on top of the root until there is only one node left
+    void grow_root()
+    {
+        if ( m_new_nodes.empty() )
+            return;
+
+        nodes_type nodes;
+        BOOST_TRY
+        {
+            nodes.reserve(m_new_nodes.size() + 1);                                                  // MAY THROW (E: alloc)
+        }
+        BOOST_CATCH(...)
+        {
+            rtree::destroy_elements<MembersHolder>::apply(m_new_nodes, m_allocators);
+            m_new_nodes.clear();
+            BOOST_RETHROW                                                                           // RETHROW
+        }
+        BOOST_CATCH_END
+
+        nodes.push_back(internal_element(m_box, m_root_node));
+        nodes.insert(nodes.end(), m_new_nodes.begin(), m_new_nodes.end());
+        m_new_nodes.clear();
+
+        // the old root is owned by the nodes now
+        m_root_node = 0;
+
+        while ( 1 < nodes.size() )
+        {
+            node_pointer new_root = 0;
+            BOOST_TRY
+            {
+                new_root = rtree::create_node<allocators_type, internal_node>::apply(m_allocators); // MAY THROW (N: alloc)
+            }
+            BOOST_CATCH(...)
+            {
+                rtree::destroy_elements<MembersHolder>::apply(nodes, m_allocators);
+                m_leafs_level = 0;
+                BOOST_RETHROW                                                                       // RETHROW
+            }
+            BOOST_CATCH_END
+
+            internal_node & root = rtree::get<internal_node>(*new_root);
+            if ( nodes.size() <= m_parameters.get_max_elements() )
+            {
+                BOOST_TRY
+                {
+                    // at least 2 elements so the root is valid
+                    rtree::elements(root).reserve(nodes.size());                                    // MAY THROW (E: alloc)
+                }
+                BOOST_CATCH(...)
+                {
+                    rtree::destroy_node<allocators_type, internal_node>::apply(m_allocators, new_root);
+                    rtree::destroy_elements<MembersHolder>::apply(nodes, m_allocators);
+                    m_leafs_level = 0;
+                    BOOST_RETHROW                                                                   // RETHROW
+                }
+                BOOST_CATCH_END
+
+                for ( typename nodes_type::const_iterator it = nodes.begin() ; it != nodes.end() ; ++it )
+                    rtree::elements(root).push_back(*it);
+                rtree::update_aggregate<MembersHolder>::apply(root, m_parameters);
+
+                m_box = rtree::elements_box<box_type>(nodes.begin(), nodes.end(), m_translator,
+                                                      index::detail::get_strategy(m_parameters));
+                nodes.clear();
+                nodes.push_back(internal_element(m_box, new_root));
+            }
+            else
+            {
+                BOOST_TRY
+                {
+                    divide_elements(root, nodes);                                                   // MAY THROW (E: alloc, N: alloc)
+                }
+                BOOST_CATCH(...)
+                {
+                    // destroy the new root with the elements already stored in it
+                    rtree::visitors::destroy<MembersHolder>::apply(new_root, m_allocators);
+                    m_leafs_level = 0;
+                    BOOST_RETHROW                                                                   // RETHROW
+                }
+                BOOST_CATCH_END
+
+                nodes.clear();
+                nodes.push_back(internal_element(m_box, new_root));
+                nodes.insert(nodes.end(), m_new_nodes.begin(), m_new_nodes.end());
+                m_new_nodes.clear();
+            }
+
+            ++m_leafs_level;
+        }
+
+        m_root_node = nodes.front().second;
+    }
+
+    values_type const& m_values;
+    parameters_type const& m_parameters;
+    translator_type const& m_translator;
+    allocators_type & m_allocators;
+
+    node_pointer & m_root_node;
+    size_type & m_leafs_level;
+
+    indexes_type m_indexes;
+
+    // traversing input parameters
+    indexes_iterator m_first;
+    indexes_iterator m_last;
+    size_type m_current_level;
+
+    // traversing output parameters
+    box_type m_box;
+    nodes_type m_new_nodes;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_BULK_INSERT_HPP
@@ -0,0 +1,319 @@
+// Boost.Geometry Index
+//
+// R-tree bulk removing visitor implementation
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_BULK_REMOVE_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_BULK_REMOVE_HPP
+
+#include <vector>
+
+#include <boost/geometry/index/detail/algorithms/bounds.hpp>
+#include <boost/geometry/index/detail/rtree/node/aggregate.hpp>
+#include <boost/geometry/index/detail/rtree/node/node.hpp>
+#include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/bulk_insert.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/destroy.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// Removes many values at once.
+//
+// The tree is traversed once. The values are passed down to all of the children
+// which boxes cover them, as in the remove visitor, until they're found in leafs.
+// The nodes which underflow are removed from their parents and the values stored
+// in them are inserted back at the end with the bulk_insert visitor, so the tree
+// is rebalanced once regardless of the number of removed values.
+template <typename MembersHolder>
+class bulk_remove
+    : public MembersHolder::visitor
+{
+    typedef typename MembersHolder::box_type box_type;
+    typedef typename MembersHolder::value_type value_type;
+    typedef typename MembersHolder::parameters_type parameters_type;
+    typedef typename MembersHolder::translator_type translator_type;
+    typedef typename MembersHolder::allocators_type allocators_type;
+
+    typedef typename MembersHolder::node node;
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    typedef typename allocators_type::node_pointer node_pointer;
+    typedef typename allocators_type::size_type size_type;
+
+    typedef typename rtree::elements_type<internal_node>::type internal_elements;
+    typedef typename rtree::elements_type<leaf>::type leaf_elements;
+
+    typedef std::vector<value_type> values_type;
+    typedef std::vector<size_type> indexes_type;
+    typedef typename indexes_type::const_iterator indexes_iterator;
+
+    // Gathers the values stored in a subtree
+    class values_gatherer
+        : public MembersHolder::visitor
+    {
+    public:
+        explicit values_gatherer(values_type & values)
+            : m_values(values)
+        {}
+
+        inline void operator()(internal_node & n)
+        {
+            internal_elements & elements = rtree::elements(n);
+            for ( typename internal_elements::iterator it = elements.begin() ; it != elements.end() ; ++it )
+                rtree::apply_visitor(*this, *it->second);                                           // MAY THROW (V, E: alloc, copy)
+        }
+
+        inline void operator()(leaf & n)
+        {
+            leaf_elements & elements = rtree::elements(n);
+            m_values.insert(m_values.end(), elements.begin(), elements.end());                     // MAY THROW (V, E: alloc, copy)
+        }
+
+    private:
+        values_type & m_values;
+    };
+
+public:
+    inline bulk_remove(node_pointer & root,
+                       size_type & leafs_level,
+                       values_type const& values,
+                       parameters_type const& parameters,
+                       translator_type const& translator,
+                       allocators_type & allocators)
+        : m_values(values)
+        , m_parameters(parameters)
+        , m_translator(translator)
+        , m_allocators(allocators)
+        , m_root_node(root)
+        , m_leafs_level(leafs_level)
+        , m_indexes(values.size())
+        , m_is_value_removed(values.size(), false)
+        , m_removed_count(0)
+        , m_current_level(0)
+        , m_is_underflow(false)
+    {
+        for ( size_type i = 0 ; i < m_indexes.size() ; ++i )
+            m_indexes[i] = i;
+
+        m_first = m_indexes.begin();
+        m_last = m_indexes.end();
+    }
+
+    inline void operator()(internal_node & n)
+    {
+        internal_elements & children = rtree::elements(n);
+        auto const& strategy = index::detail::get_strategy(m_parameters);
+
+        // traverse children which boxes cover the values
+        indexes_type underflowed_children;
+        indexes_type candidates;
+        for ( size_type c = 0 ; c < children.size() ; ++c )
+        {
+            candidates.clear();
+            for ( indexes_iterator it = m_first ; it != m_last ; ++it )
+            {
+                if ( ! m_is_value_removed[*it]
+                  && index::detail::covered_by_bounds(m_translator(m_values[*it]),
+                                                      children[c].first, strategy) )
+                {
+                    candidates.push_back(*it);                                                      // MAY THROW (E: alloc)
+                }
+            }
+
+            if ( candidates.empty() )
+                continue;
+
+            size_type const removed_count = m_removed_count;
+
+            traverse_apply_visitor(children[c], candidates.begin(), candidates.end());             // MAY THROW (V, E: alloc, copy, N: alloc)
+
+            if ( removed_count != m_removed_count )
+            {
+                if ( m_is_underflow )
+                    underflowed_children.push_back(c);                                              // MAY THROW (E: alloc)
+                else
+                    children[c].first = m_box;
+            }
+        }
+
+        // move the underflowed nodes to the container,
+        // begin with the last ones so the indexes of the others are valid
+        for ( typename indexes_type::reverse_iterator it = underflowed_children.rbegin() ;
+              it != underflowed_children.rend() ; ++it )
+        {
+            typename internal_elements::iterator underfl_el_it = children.begin() + *it;
+            m_underflowed_nodes.push_back(underfl_el_it->second);                                   // MAY THROW (E: alloc)
+            rtree::move_from_back(children, underfl_el_it);
+            children.pop_back();
+        }
+
+        m_is_underflow = children.size() < m_parameters.get_min_elements();
+        m_box = rtree::elements_box<box_type>(children.begin(), children.end(), m_translator, strategy);
+
+        rtree::update_aggregate<MembersHolder>::apply(n, m_parameters);
+
+        if ( m_current_level == 0 )
+        {
+            BOOST_GEOMETRY_INDEX_ASSERT(&n == &rtree::get<internal_node>(*m_root_node), "node must be the root");
+
+            reinsert_removed_nodes_values();                                                        // MAY THROW (V, E: alloc, copy, N: alloc)
+        }
+    }
+
+    inline void operator()(leaf & n)
+    {
+        leaf_elements & elements = rtree::elements(n);
+        auto const& strategy = index::detail::get_strategy(m_parameters);
+
+        // find values and remove them
+        for ( indexes_iterator it = m_first ; it != m_last ; ++it )
+        {
+            if ( m_is_value_removed[*it] )
+                continue;
+
+            for ( typename leaf_elements::iterator el_it = elements.begin() ; el_it != elements.end() ; ++el_it )
+            {
+                if ( m_translator.equals(*el_it, m_values[*it], strategy) )
+                {
+                    rtree::move_from_back(elements, el_it);                                         // MAY THROW (V: copy)
+                    elements.pop_back();
+                    m_is_value_removed[*it] = true;
+                    ++m_removed_count;
+                    break;
+                }
+            }
+        }
+
+        BOOST_GEOMETRY_INDEX_ASSERT(0 < m_parameters.get_min_elements(), "min number of elements is too small");
+
+        m_is_underflow = elements.size() < m_parameters.get_min_elements();
+        m_box = rtree::values_box<box_type>(elements.begin(), elements.end(), m_translator, strategy);
+
+        rtree::update_aggregate<MembersHolder>::apply(n, m_parameters);
+    }
+
+    size_type removed_count() const
+    {
+        return m_removed_count;
+    }
+
+    ~bulk_remove()
+    {
+        // the nodes are left here only if an exception was thrown
+        destroy_removed_nodes();
+    }
+
+private:
+    void destroy_removed_nodes()
+    {
+        for ( typename std::vector<node_pointer>::iterator it = m_underflowed_nodes.begin() ;
+              it != m_underflowed_nodes.end() ; ++it )
+        {
+            rtree::visitors::destroy<MembersHolder>::apply(*it, m_allocators);
+        }
+        m_underflowed_nodes.clear();
+    }
+
+    void traverse_apply_visitor(typename internal_elements::value_type & child,
+                                indexes_iterator first, indexes_iterator last)
+    {
+        // save previous traverse inputs and set new ones
+        indexes_iterator first_bckup = m_first;
+        indexes_iterator last_bckup = m_last;
+
+        m_first = first;
+        m_last = last;
+        ++m_current_level;
+
+        // next traversing step
+        rtree::apply_visitor(*this, *child.second);                                                 // MAY THROW (V, E: alloc, copy, N: alloc)
+
+        // restore previous traverse inputs
+        m_first = first_bckup;
+        m_last = last_bckup;
+        --m_current_level;
+    }
+
+    void reinsert_removed_nodes_values()
+    {
+        values_type values;
+        for ( typename std::vector<node_pointer>::iterator it = m_underflowed_nodes.begin() ;
+              it != m_underflowed_nodes.end() ; ++it )
+        {
+            values_gatherer gatherer(values);
+            rtree::apply_visitor(gatherer, **it);                                                   // MAY THROW (V, E: alloc, copy)
+        }
+
+        destroy_removed_nodes();
+
+        // shorten the tree
+        // NOTE: if the min elements number is 1 or all values were removed
+        //       here the number of elements may be equal to 0
+        while ( 0 < m_leafs_level )
+        {
+            internal_elements & elements = rtree::elements(rtree::get<internal_node>(*m_root_node));
+            if ( 1 < elements.size() )
+                break;
+
+            node_pointer root_to_destroy = m_root_node;
+            if ( elements.empty() )
+            {
+                m_root_node = rtree::create_node<allocators_type, leaf>::apply(m_allocators);      // MAY THROW (N: alloc)
+                rtree::update_aggregate<MembersHolder>::apply(rtree::get<leaf>(*m_root_node), m_parameters);
+                m_leafs_level = 0;
+            }
+            else
+            {
+                m_root_node = elements[0].second;
+                --m_leafs_level;
+            }
+
+            rtree::destroy_node<allocators_type, internal_node>::apply(m_allocators, root_to_destroy);
+        }
+
+        if ( ! values.empty() )
+        {
+            visitors::bulk_insert<MembersHolder>
+                insert_v(m_root_node, m_leafs_level, values,
+                         m_parameters, m_translator, m_allocators);
+
+            rtree::apply_visitor(insert_v, *m_root_node);                                           // MAY THROW (V, E: alloc, copy, N: alloc)
+        }
+    }
+
+    values_type const& m_values;
+    parameters_type const& m_parameters;
+    translator_type const& m_translator;
+    allocators_type & m_allocators;
+
+    node_pointer & m_root_node;
+    size_type & m_leafs_level;
+
+    indexes_type m_indexes;
+    std::vector<bool> m_is_value_removed;
+    size_type m_removed_count;
+    std::vector<node_pointer> m_underflowed_nodes;
+
+    // traversing input parameters
+    indexes_iterator m_first;
+    indexes_iterator m_last;
+    size_type m_current_level;
+
+    // traversing output parameters
+    box_type m_box;
+    bool m_is_underflow;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_BULK_REMOVE_HPP
@@ -15,6 +15,7 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_COPY_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_COPY_HPP
 
+#include <boost/geometry/index/detail/rtree/node/aggregate.hpp>
 #include <boost/geometry/index/detail/rtree/node/subtree_destroyer.hpp>
 
 namespace boost { namespace geometry { namespace index {
@@ -63,6 +64,8 @@ public:
             auto_result.release();
         }
 
+        rtree::copy_aggregate<MembersHolder>::apply(n, rtree::get<internal_node>(*new_node));
+
         result = new_node.get();
         new_node.release();
     }
@@ -83,6 +86,8 @@ public:
             elements_dst.push_back(*it);                                                                // MAY THROW, STRONG (V: alloc, copy)
         }
 
+        rtree::copy_aggregate<MembersHolder>::apply(l, rtree::get<leaf>(*new_node));
+
         result = new_node.get();
         new_node.release();
     }
@@ -16,13 +16,17 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_DISTANCE_QUERY_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_DISTANCE_QUERY_HPP
 
+#include <iterator>
 #include <queue>
+#include <utility>
+#include <vector>
 
 #include <boost/geometry/index/detail/distance_predicates.hpp>
 #include <boost/geometry/index/detail/predicates.hpp>
 #include <boost/geometry/index/detail/priority_dequeue.hpp>
 #include <boost/geometry/index/detail/rtree/node/weak_visitor.hpp>
 #include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
+#include <boost/geometry/index/detail/rtree/query_statistics.hpp>
 #include <boost/geometry/index/detail/translator.hpp>
 #include <boost/geometry/index/parameters.hpp>
 
@@ -55,10 +59,10 @@ template <typename T, typename Comp>
 struct priority_dequeue : index::detail::priority_dequeue<T, std::vector<T>, Comp>
 {
     priority_dequeue() = default;
-    //void reserve(typename std::vector<T>::size_type n)
-    //{
-    //    this->c.reserve(n);
-    //}
+    void reserve(typename std::vector<T>::size_type n)
+    {
+        this->c.reserve(n);
+    }
     //void clear()
     //{
     //    this->c.clear();
@@ -69,10 +73,10 @@ template <typename T, typename Comp>
 struct priority_queue : std::priority_queue<T, std::vector<T>, Comp>
 {
     priority_queue() = default;
-    //void reserve(typename std::vector<T>::size_type n)
-    //{
-    //    this->c.reserve(n);
-    //}
+    void reserve(typename std::vector<T>::size_type n)
+    {
+        this->c.reserve(n);
+    }
     void clear()
     {
         this->c.clear();
@@ -152,8 +156,10 @@ private:
     neighbors_type m_neighbors;
 };
 
-template <typename MembersHolder, typename Predicates>
-class distance_query
+// The containers used by the distance_query. They may be kept between
+// queries so the memory is allocated only once.
+template <typename MembersHolder, typename NearestPredicate>
+class distance_query_buffers
 {
     typedef typename MembersHolder::value_type value_type;
     typedef typename MembersHolder::box_type box_type;
@@ -161,26 +167,17 @@ class distance_query
     typedef typename MembersHolder::translator_type translator_type;
 
     typedef typename index::detail::strategy_type<parameters_type>::type strategy_type;
-
-    typedef typename MembersHolder::node node;
-    typedef typename MembersHolder::internal_node internal_node;
-    typedef typename MembersHolder::leaf leaf;
-
-    typedef index::detail::predicates_element
-        <
-            index::detail::predicates_find_distance<Predicates>::value, Predicates
-        > nearest_predicate_access;
-    typedef typename nearest_predicate_access::type nearest_predicate_type;
     typedef typename indexable_type<translator_type>::type indexable_type;
 
-    typedef index::detail::calculate_distance<nearest_predicate_type, indexable_type, strategy_type, value_tag> calculate_value_distance;
-    typedef index::detail::calculate_distance<nearest_predicate_type, box_type, strategy_type, bounds_tag> calculate_node_distance;
-    typedef typename calculate_value_distance::result_type value_distance_type;
-    typedef typename calculate_node_distance::result_type node_distance_type;
-
     typedef typename MembersHolder::size_type size_type;
     typedef typename MembersHolder::node_pointer node_pointer;
 
+public:
+    typedef index::detail::calculate_distance<NearestPredicate, indexable_type, strategy_type, value_tag> calculate_value_distance;
+    typedef index::detail::calculate_distance<NearestPredicate, box_type, strategy_type, bounds_tag> calculate_node_distance;
+    typedef typename calculate_value_distance::result_type value_distance_type;
+    typedef typename calculate_node_distance::result_type node_distance_type;
+
     using neighbor_data = std::pair<value_distance_type, const value_type *>;
     using neighbors_type = std::vector<neighbor_data>;
 
@@ -196,17 +193,83 @@ class distance_query
     };
     using branches_type = priority_queue<branch_data, branch_data_comp>;
 
+    void clear()
+    {
+        branches.clear();
+        neighbors.clear();
+    }
+
+    branches_type branches;
+    neighbors_type neighbors;
+};
+
+template
+<
+    typename MembersHolder, typename Predicates,
+    typename Statistics = rtree::no_query_statistics
+>
+class distance_query
+{
+    typedef typename MembersHolder::value_type value_type;
+    typedef typename MembersHolder::box_type box_type;
+    typedef typename MembersHolder::parameters_type parameters_type;
+    typedef typename MembersHolder::translator_type translator_type;
+
+    typedef typename index::detail::strategy_type<parameters_type>::type strategy_type;
+
+    typedef typename MembersHolder::node node;
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    typedef index::detail::predicates_element
+        <
+            index::detail::predicates_find_distance<Predicates>::value, Predicates
+        > nearest_predicate_access;
+    typedef typename nearest_predicate_access::type nearest_predicate_type;
+    typedef typename indexable_type<translator_type>::type indexable_type;
+
+    typedef typename MembersHolder::size_type size_type;
+    typedef typename MembersHolder::node_pointer node_pointer;
+
+public:
+    typedef distance_query_buffers<MembersHolder, nearest_predicate_type> buffers_type;
+
+private:
+    typedef typename buffers_type::calculate_value_distance calculate_value_distance;
+    typedef typename buffers_type::calculate_node_distance calculate_node_distance;
+    typedef typename buffers_type::value_distance_type value_distance_type;
+    typedef typename buffers_type::node_distance_type node_distance_type;
+    typedef typename buffers_type::branch_data branch_data;
+
 public:
-    distance_query(MembersHolder const& members, Predicates const& pred)
+    distance_query(MembersHolder const& members, Predicates const& pred,
+                   Statistics const& stats = Statistics())
         : m_tr(members.translator())
         , m_strategy(index::detail::get_strategy(members.parameters()))
         , m_pred(pred)
+        , m_branches(m_buffers.branches)
+        , m_neighbors(m_buffers.neighbors)
+        , m_stats(stats)
     {
         m_neighbors.reserve((std::min)(members.values_count, size_type(max_count())));
         //m_branches.reserve(members.parameters().get_min_elements() * members.leafs_level); ?
         // min, max or average?
     }
 
+    // The buffers are cleared and used instead of the internal ones
+    distance_query(MembersHolder const& members, Predicates const& pred, buffers_type & buffers,
+                   Statistics const& stats = Statistics())
+        : m_tr(members.translator())
+        , m_strategy(index::detail::get_strategy(members.parameters()))
+        , m_pred(pred)
+        , m_branches(buffers.branches)
+        , m_neighbors(buffers.neighbors)
+        , m_stats(stats)
+    {
+        buffers.clear();
+        m_neighbors.reserve((std::min)(members.values_count, size_type(max_count())));
+    }
+
     template <typename OutIter>
     size_type apply(MembersHolder const& members, OutIter out_it)
     {
@@ -229,11 +292,13 @@ private:
             if (reverse_level > 0)
             {
                 internal_node& n = rtree::get<internal_node>(*ptr);
+                m_stats.visit_internal_node();
                 // fill array of nodes meeting predicates
                 for (auto const& p : rtree::elements(n))
                 {
                     node_distance_type node_distance; // for distance predicate
 
+                    m_stats.check_predicates();
                     // if current node meets predicates (0 is dummy value)
                     if (id::predicates_check<id::bounds_tag>(m_pred, 0, p.first, m_strategy)
                         // and if distance is ok
@@ -244,16 +309,23 @@ private:
                         // add current node's data into the list
                         m_branches.push(branch_data(node_distance, reverse_level - 1, p.second));
                     }
+                    else
+                    {
+                        m_stats.prune_branches(1);
+                    }
                 }
+                m_stats.branches_size(m_branches.size());
             }
             else
             {
                 leaf& n = rtree::get<leaf>(*ptr);
+                m_stats.visit_leaf();
                 // search leaf for closest value meeting predicates
                 for (auto const& v : rtree::elements(n))
                 {
                     value_distance_type value_distance; // for distance predicate
 
+                    m_stats.check_predicates();
                     // if value meets predicates
                     if (id::predicates_check<id::value_tag>(m_pred, v, m_tr(v), m_strategy)
                         // and if distance is ok
@@ -263,11 +335,14 @@ private:
                         store_value(value_distance, boost::addressof(v));
                     }
                 }
+                m_stats.neighbors_size(m_neighbors.size());
             }
 
             if (m_branches.empty()
                 || ignore_branch(m_branches.top().distance))
             {
+                // the remaining branches are further than the neighbors found
+                m_stats.prune_branches(m_branches.size());
                 break;
             }
 
@@ -325,8 +400,97 @@ private:
 
     Predicates const& m_pred;
 
-    branches_type m_branches;
-    neighbors_type m_neighbors;
+    buffers_type m_buffers;
+    typename buffers_type::branches_type & m_branches;
+    typename buffers_type::neighbors_type & m_neighbors;
+
+    Statistics m_stats;
+};
+
+// Performs many k-nearest neighbors queries one after another. The buffers
+// of the distance_query are reused by all of the queries. For each value
+// found a pair containing the index of the predicates and the value is
+// returned.
+template
+<
+    typename MembersHolder, typename PredicatesIt, typename OutIter,
+    typename Statistics = rtree::no_query_statistics
+>
+class batch_distance_query
+{
+    typedef typename MembersHolder::value_type value_type;
+    typedef typename MembersHolder::size_type size_type;
+
+    typedef typename std::iterator_traits<PredicatesIt>::value_type predicates_type;
+    typedef distance_query<MembersHolder, predicates_type, Statistics> distance_query_type;
+    typedef typename distance_query_type::buffers_type buffers_type;
+
+    // Passes the values found by a query to the output iterator as pairs
+    class pair_output_iterator
+    {
+    public:
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        pair_output_iterator(OutIter & out_it, size_type index)
+            : m_out_iter(out_it), m_index(index)
+        {}
+
+        pair_output_iterator & operator*() { return *this; }
+        pair_output_iterator & operator++() { return *this; }
+        pair_output_iterator & operator++(int) { return *this; }
+
+        pair_output_iterator & operator=(typename MembersHolder::value_type const& v)
+        {
+            *m_out_iter = std::pair<size_type, typename MembersHolder::value_type>(m_index, v);
+            ++m_out_iter;
+            return *this;
+        }
+
+    private:
+        OutIter & m_out_iter;
+        size_type m_index;
+    };
+
+public:
+    batch_distance_query(MembersHolder const& , PredicatesIt first, size_type count, OutIter out_it,
+                         Statistics const& stats = Statistics())
+        : m_pred_first(first)
+        , m_pred_count(count)
+        , m_out_iter(out_it)
+        , m_found_count(0)
+        , m_stats(stats)
+    {}
+
+    size_type apply(MembersHolder const& members)
+    {
+        return apply(members, 0, m_pred_count);
+    }
+
+    // Performs the queries [first, last) of the range of predicates
+    size_type apply(MembersHolder const& members, size_type first, size_type last)
+    {
+        for (size_type i = first ; i < last ; ++i)
+        {
+            distance_query_type distance_v(members, *(m_pred_first + i), m_buffers, m_stats);
+            m_found_count += distance_v.apply(members, pair_output_iterator(m_out_iter, i));        // MAY THROW
+        }
+        return m_found_count;
+    }
+
+private:
+    PredicatesIt m_pred_first;
+    size_type m_pred_count;
+    OutIter m_out_iter;
+
+    size_type m_found_count;
+
+    buffers_type m_buffers;
+
+    Statistics m_stats;
 };
 
 template <typename MembersHolder, typename Predicates>
@@ -353,9 +517,14 @@ class distance_query_incremental
 
     typedef index::detail::calculate_distance<nearest_predicate_type, indexable_type, strategy_type, value_tag> calculate_value_distance;
     typedef index::detail::calculate_distance<nearest_predicate_type, box_type, strategy_type, bounds_tag> calculate_node_distance;
-    typedef typename calculate_value_distance::result_type value_distance_type;
+    typedef index::detail::calculate_real_distance<nearest_predicate_type, indexable_type, strategy_type> calculate_real_distance;
     typedef typename calculate_node_distance::result_type node_distance_type;
 
+public:
+    typedef typename calculate_value_distance::result_type value_distance_type;
+    typedef typename calculate_real_distance::result_type real_distance_type;
+
+private:
     typedef typename allocators_type::size_type size_type;
     typedef typename allocators_type::const_reference const_reference;
     typedef typename allocators_type::node_pointer node_pointer;
@@ -386,6 +555,7 @@ public:
 //        , m_pred()
         , m_neighbors_count(0)
         , m_neighbor_ptr(nullptr)
+        , m_neighbor_distance()
     {}
 
     inline distance_query_incremental(Predicates const& pred)
@@ -394,6 +564,7 @@ public:
         , m_pred(pred)
         , m_neighbors_count(0)
         , m_neighbor_ptr(nullptr)
+        , m_neighbor_distance()
     {}
 
     inline distance_query_incremental(MembersHolder const& members, Predicates const& pred)
@@ -402,6 +573,7 @@ public:
         , m_pred(pred)
         , m_neighbors_count(0)
         , m_neighbor_ptr(nullptr)
+        , m_neighbor_distance()
     {}
 
     const_reference dereference() const
@@ -409,10 +581,28 @@ public:
         return *m_neighbor_ptr;
     }
 
+    // The distance calculated during the traversal, e.g. squared distance
+    value_distance_type const& comparable_distance() const
+    {
+        return m_neighbor_distance;
+    }
+
+    real_distance_type distance() const
+    {
+        return calculate_real_distance::apply(predicate(), (*m_tr)(*m_neighbor_ptr), m_strategy);
+    }
+
     void initialize(MembersHolder const& members)
     {
         if (0 < max_count())
         {
+            // reserve the memory up front so the containers are typically not
+            // reallocated during the increments, the neighbors and the branches
+            // of a few paths to the leafs, k may be as big as the size of the tree
+            std::size_t const capacity = members.parameters().get_max_elements() * (members.leafs_level + 1);
+            m_neighbors.reserve((std::min)(max_count(), capacity) + 1);                             // MAY THROW (E: alloc)
+            m_branches.reserve(capacity);                                                           // MAY THROW (E: alloc)
+
             apply(members.root, members.leafs_level);
             increment();
         }
@@ -427,7 +617,7 @@ public:
                 // there exists a next closest neighbor so we can increment
                 if (! m_neighbors.empty())
                 {
-                    m_neighbor_ptr = m_neighbors.top().second;
+                    set_neighbor(m_neighbors.top());
                     ++m_neighbors_count;
                     m_neighbors.pop_top();
                 }
@@ -447,7 +637,7 @@ public:
                 // if next neighbor is closer or as close as the closest branch, set next neighbor
                 if (! m_neighbors.empty() && m_neighbors.top().first <= closest_branch.distance )
                 {
-                    m_neighbor_ptr = m_neighbors.top().second;
+                    set_neighbor(m_neighbors.top());
                     ++m_neighbors_count;
                     m_neighbors.pop_top();
                     return;
@@ -484,6 +674,12 @@ public:
     }
 
 private:
+    void set_neighbor(neighbor_data const& neighbor)
+    {
+        m_neighbor_distance = neighbor.first;
+        m_neighbor_ptr = neighbor.second;
+    }
+
     void apply(node_pointer ptr, size_type reverse_level)
     {
         namespace id = index::detail;
@@ -567,6 +763,7 @@ private:
     neighbors_type m_neighbors;
     size_type m_neighbors_count;
     const value_type * m_neighbor_ptr;
+    value_distance_type m_neighbor_distance;
 };
 
 }}} // namespace detail::rtree::visitors
@@ -25,6 +25,7 @@
 
 #include <boost/geometry/index/detail/algorithms/bounds.hpp>
 #include <boost/geometry/index/detail/algorithms/content.hpp>
+#include <boost/geometry/index/detail/rtree/node/aggregate.hpp>
 #include <boost/geometry/index/detail/rtree/node/node.hpp>
 #include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
 #include <boost/geometry/index/detail/rtree/node/subtree_destroyer.hpp>
@@ -375,6 +376,18 @@ protected:
             // Furthermore it may be empty root - internal node.
             split(n);                                                                                           // MAY THROW (V, E: alloc, copy, N:alloc)
         }
+        else
+        {
+            update_aggregate(n);
+        }
+    }
+
+    // update the aggregate of the node after its elements are modified,
+    // the children have to be updated first
+    template <typename Node>
+    inline void update_aggregate(Node & n) const
+    {
+        rtree::update_aggregate<MembersHolder>::apply(n, m_parameters);
     }
 
     template <typename Visitor>
@@ -421,6 +434,9 @@ protected:
         // for exception safety
         subtree_destroyer additional_node_ptr(additional_nodes[0].second, m_allocators);
 
+        update_aggregate(n);
+        update_aggregate(rtree::get<Node>(*additional_nodes[0].second));
+
 #ifdef BOOST_GEOMETRY_INDEX_EXPERIMENTAL_ENLARGE_BY_EPSILON
         // Enlarge bounds of a leaf node.
         // It's because Points and Segments are compared WRT machine epsilon
@@ -466,6 +482,8 @@ protected:
             }
             BOOST_CATCH_END
 
+            update_aggregate(rtree::get<internal_node>(*new_root));
+
             m_root_node = new_root.get();
             ++m_leafs_level;
 
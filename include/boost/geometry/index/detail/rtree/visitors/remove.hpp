@@ -20,6 +20,7 @@
 
 #include <boost/geometry/index/parameters.hpp>
 #include <boost/geometry/index/detail/algorithms/bounds.hpp>
+#include <boost/geometry/index/detail/rtree/node/aggregate.hpp>
 #include <boost/geometry/index/detail/rtree/node/node.hpp>
 #include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
 #include <boost/geometry/index/detail/rtree/node/subtree_destroyer.hpp>
@@ -119,6 +120,8 @@ public:
                 m_is_underflow = store_underflowed_node(elements, underfl_el_it, relative_level);                       // MAY THROW (E: alloc, copy)
             }
 
+            rtree::update_aggregate<MembersHolder>::apply(n, m_parameters);
+
             // n is not root - adjust aabb
             if ( 0 != m_parent )
             {
@@ -183,6 +186,8 @@ public:
             // calc underflow
             m_is_underflow = elements.size() < m_parameters.get_min_elements();
 
+            rtree::update_aggregate<MembersHolder>::apply(n, m_parameters);
+
             // n is not root - adjust aabb
             if ( 0 != m_parent )
             {
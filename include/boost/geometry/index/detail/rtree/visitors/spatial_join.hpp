@@ -0,0 +1,279 @@
+// Boost.Geometry Index
+//
+// R-tree spatial join implementation
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_JOIN_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_JOIN_HPP
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
+#include <boost/geometry/index/detail/predicates.hpp>
+#include <boost/geometry/index/parameters.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// The predicate used by default, all pairs of values which indexables
+// intersect are returned.
+struct join_always_true
+{
+    template <typename Value1, typename Value2>
+    bool operator()(Value1 const&, Value2 const&) const
+    {
+        return true;
+    }
+};
+
+// Finds the pairs of values of two rtrees which indexables intersect and which
+// meet the binary predicate. Both trees are traversed at the same time, only
+// the pairs of nodes which boxes intersect are visited. If the levels of the
+// nodes are different, the node of the higher level is descended first.
+template <typename MembersHolder1, typename MembersHolder2, typename BinaryPredicate>
+class spatial_join
+{
+    typedef typename MembersHolder1::value_type value_type1;
+    typedef typename MembersHolder2::value_type value_type2;
+
+    typedef typename MembersHolder1::box_type box_type1;
+    typedef typename MembersHolder2::box_type box_type2;
+
+    typedef typename MembersHolder1::internal_node internal_node1;
+    typedef typename MembersHolder2::internal_node internal_node2;
+    typedef typename MembersHolder1::leaf leaf1;
+    typedef typename MembersHolder2::leaf leaf2;
+
+    typedef typename MembersHolder1::node_pointer node_pointer1;
+    typedef typename MembersHolder2::node_pointer node_pointer2;
+
+    typedef typename MembersHolder1::parameters_type parameters_type;
+    typedef typename MembersHolder1::translator_type translator_type1;
+    typedef typename MembersHolder2::translator_type translator_type2;
+
+    typedef typename index::detail::strategy_type<parameters_type>::type strategy_type;
+
+    typedef index::detail::spatial_predicate_call<index::detail::predicates::intersects_tag> intersects_call;
+
+public:
+    typedef typename MembersHolder1::size_type size_type;
+    typedef std::pair<value_type1, value_type2> result_type;
+
+    spatial_join(MembersHolder1 const& members1, box_type1 const& box1,
+                 MembersHolder2 const& members2, box_type2 const& box2,
+                 BinaryPredicate const& pred)
+        : m_tr1(members1.translator())
+        , m_tr2(members2.translator())
+        , m_strategy(index::detail::get_strategy(members1.parameters()))
+        , m_pred(pred)
+        , m_root(members1.root, box1, members1.leafs_level,
+                 members2.root, box2, members2.leafs_level)
+    {}
+
+    template <typename OutIter>
+    size_type apply(OutIter out_it) const
+    {
+        size_type found_count = 0;
+        if ( m_root.ptr1 && m_root.ptr2
+          && intersects_call::apply(m_root.box1, m_root.box2, m_strategy) )
+        {
+            apply(m_root, out_it, found_count);
+        }
+        return found_count;
+    }
+
+    // The pairs of subtrees are joined concurrently. The results are gathered
+    // in separate buffers and then copied to the output iterator in the same
+    // order as in the serial version.
+    template <typename OutIter, typename Executor>
+    size_type apply(OutIter out_it, Executor const& executor) const
+    {
+        if ( ! ( m_root.ptr1 && m_root.ptr2
+              && intersects_call::apply(m_root.box1, m_root.box2, m_strategy) ) )
+        {
+            return 0;
+        }
+
+        // Several tasks per thread are created to balance the work.
+        std::size_t const tasks_count = (std::max)(std::size_t(executor.concurrency()), std::size_t(1)) * 4;
+
+        std::vector<node_pair> pairs(1, m_root);
+        std::vector<node_pair> next;
+        while ( pairs.size() < tasks_count )
+        {
+            bool expanded = false;
+            next.clear();
+            for (node_pair const& p : pairs)
+            {
+                if ( p.level1 > 0 || p.level2 > 0 )
+                {
+                    for_each_children_pair(p, [&](node_pair const& child)
+                    {
+                        next.push_back(child);                                                      // MAY THROW (A)
+                    });
+                    expanded = true;
+                }
+                else
+                {
+                    next.push_back(p);                                                              // MAY THROW (A)
+                }
+            }
+            pairs.swap(next);
+
+            if ( ! expanded )
+            {
+                break;
+            }
+        }
+
+        std::vector<std::vector<result_type> > results(pairs.size());                               // MAY THROW (A)
+        executor(pairs.size(), [&](std::size_t i)
+        {
+            size_type dummy = 0;
+            std::back_insert_iterator<std::vector<result_type> > it(results[i]);
+            apply(pairs[i], it, dummy);                                                             // MAY THROW (A, C)
+        });
+
+        size_type found_count = 0;
+        for (std::vector<result_type> const& r : results)
+        {
+            for (result_type const& v : r)
+            {
+                *out_it = v;
+                ++out_it;
+            }
+            found_count += size_type(r.size());
+        }
+        return found_count;
+    }
+
+private:
+    struct node_pair
+    {
+        node_pair(node_pointer1 p1, box_type1 const& b1, size_type l1,
+                  node_pointer2 p2, box_type2 const& b2, size_type l2)
+            : ptr1(p1), box1(b1), level1(l1), ptr2(p2), box2(b2), level2(l2)
+        {}
+
+        node_pointer1 ptr1;
+        box_type1 box1;
+        size_type level1;
+        node_pointer2 ptr2;
+        box_type2 box2;
+        size_type level2;
+    };
+
+    template <typename OutIter>
+    void apply(node_pair const& p, OutIter & out_it, size_type & found_count) const
+    {
+        if ( p.level1 > 0 || p.level2 > 0 )
+        {
+            for_each_children_pair(p, [&](node_pair const& child)
+            {
+                apply(child, out_it, found_count);
+            });
+            return;
+        }
+
+        auto const& elements1 = rtree::elements(rtree::get<leaf1>(*p.ptr1));
+        auto const& elements2 = rtree::elements(rtree::get<leaf2>(*p.ptr2));
+        for (auto const& v1 : elements1)
+        {
+            auto const& i1 = m_tr1(v1);
+            // skip the values outside of the other node
+            if ( ! intersects_call::apply(i1, p.box2, m_strategy) )
+            {
+                continue;
+            }
+
+            for (auto const& v2 : elements2)
+            {
+                if ( intersects_call::apply(i1, m_tr2(v2), m_strategy)
+                  && m_pred(v1, v2) )
+                {
+                    *out_it = result_type(v1, v2);
+                    ++out_it;
+                    ++found_count;
+                }
+            }
+        }
+    }
+
+    // Calls f for the pairs of the children which boxes intersect. The node
+    // of the higher level is descended, if levels are equal both are descended.
+    template <typename F>
+    void for_each_children_pair(node_pair const& p, F && f) const
+    {
+        bool const descend1 = p.level1 > 0 && p.level1 >= p.level2;
+        bool const descend2 = p.level2 > 0 && p.level2 >= p.level1;
+
+        if ( descend1 && descend2 )
+        {
+            auto const& elements1 = rtree::elements(rtree::get<internal_node1>(*p.ptr1));
+            auto const& elements2 = rtree::elements(rtree::get<internal_node2>(*p.ptr2));
+            for (auto const& c1 : elements1)
+            {
+                // skip the children outside of the other node
+                if ( ! intersects_call::apply(c1.first, p.box2, m_strategy) )
+                {
+                    continue;
+                }
+
+                for (auto const& c2 : elements2)
+                {
+                    if ( intersects_call::apply(c1.first, c2.first, m_strategy) )
+                    {
+                        f(node_pair(c1.second, c1.first, p.level1 - 1,
+                                    c2.second, c2.first, p.level2 - 1));
+                    }
+                }
+            }
+        }
+        else if ( descend1 )
+        {
+            auto const& elements1 = rtree::elements(rtree::get<internal_node1>(*p.ptr1));
+            for (auto const& c1 : elements1)
+            {
+                if ( intersects_call::apply(c1.first, p.box2, m_strategy) )
+                {
+                    f(node_pair(c1.second, c1.first, p.level1 - 1,
+                                p.ptr2, p.box2, p.level2));
+                }
+            }
+        }
+        else
+        {
+            auto const& elements2 = rtree::elements(rtree::get<internal_node2>(*p.ptr2));
+            for (auto const& c2 : elements2)
+            {
+                if ( intersects_call::apply(p.box1, c2.first, m_strategy) )
+                {
+                    f(node_pair(p.ptr1, p.box1, p.level1,
+                                c2.second, c2.first, p.level2 - 1));
+                }
+            }
+        }
+    }
+
+    translator_type1 const& m_tr1;
+    translator_type2 const& m_tr2;
+    strategy_type m_strategy;
+
+    BinaryPredicate const& m_pred;
+
+    node_pair m_root;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_JOIN_HPP
@@ -16,8 +16,13 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_QUERY_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_QUERY_HPP
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
 #include <boost/geometry/index/detail/rtree/node/weak_visitor.hpp>
+#include <boost/geometry/index/detail/rtree/query_statistics.hpp>
 #include <boost/geometry/index/detail/predicates.hpp>
 #include <boost/geometry/index/parameters.hpp>
 
@@ -25,7 +30,11 @@ namespace boost { namespace geometry { namespace index {
 
 namespace detail { namespace rtree { namespace visitors {
 
-template <typename MembersHolder, typename Predicates, typename OutIter>
+template
+<
+    typename MembersHolder, typename Predicates, typename OutIter,
+    typename Statistics = rtree::no_query_statistics
+>
 struct spatial_query
 {
     typedef typename MembersHolder::parameters_type parameters_type;
@@ -41,12 +50,14 @@ struct spatial_query
     typedef typename allocators_type::node_pointer node_pointer;
     typedef typename allocators_type::size_type size_type;
 
-    spatial_query(MembersHolder const& members, Predicates const& p, OutIter out_it)
+    spatial_query(MembersHolder const& members, Predicates const& p, OutIter out_it,
+                  Statistics const& stats = Statistics())
         : m_tr(members.translator())
         , m_strategy(index::detail::get_strategy(members.parameters()))
         , m_pred(p)
         , m_out_iter(out_it)
         , m_found_count(0)
+        , m_stats(stats)
     {}
 
     size_type apply(node_pointer ptr, size_type reverse_level)
@@ -55,22 +66,30 @@ struct spatial_query
         if (reverse_level > 0)
         {
             internal_node& n = rtree::get<internal_node>(*ptr);
+            m_stats.visit_internal_node();
             // traverse nodes meeting predicates
             for (auto const& p : rtree::elements(n))
             {
+                m_stats.check_predicates();
                 // if node meets predicates (0 is dummy value)
                 if (id::predicates_check<id::bounds_tag>(m_pred, 0, p.first, m_strategy))
                 {
                     apply(p.second, reverse_level - 1);
                 }
+                else
+                {
+                    m_stats.prune_branches(1);
+                }
             }
         }
         else
         {
             leaf& n = rtree::get<leaf>(*ptr);
+            m_stats.visit_leaf();
             // get all values meeting predicates
             for (auto const& v : rtree::elements(n))
             {
+                m_stats.check_predicates();
                 // if value meets predicates
                 if (id::predicates_check<id::value_tag>(m_pred, v, m_tr(v), m_strategy))
                 {
@@ -97,6 +116,208 @@ private:
     OutIter m_out_iter;
 
     size_type m_found_count;
+
+    Statistics m_stats;
+};
+
+// Performs many spatial queries at once. Each node is visited once for all of
+// the queries which bounds predicates are met by the node. The predicates are
+// processed in chunks so the indexes of the active queries stay in the cache.
+// At each level the indexes of queries are distributed between the children
+// of a node so each predicate is read only once per node.
+template
+<
+    typename MembersHolder, typename PredicatesIt, typename OutIter,
+    typename Statistics = rtree::no_query_statistics
+>
+struct batch_spatial_query
+{
+    typedef typename MembersHolder::value_type value_type;
+    typedef typename MembersHolder::parameters_type parameters_type;
+    typedef typename MembersHolder::translator_type translator_type;
+    typedef typename MembersHolder::allocators_type allocators_type;
+
+    typedef typename index::detail::strategy_type<parameters_type>::type strategy_type;
+
+    typedef typename MembersHolder::node node;
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    typedef typename allocators_type::node_pointer node_pointer;
+    typedef typename allocators_type::size_type size_type;
+
+    typedef std::vector<size_type> indexes_type;
+
+    // The number of queries processed in one traversal
+    static const size_type chunk_size = 1024;
+
+    batch_spatial_query(MembersHolder const& members, PredicatesIt first, size_type count, OutIter out_it,
+                        Statistics const& stats = Statistics())
+        : m_tr(members.translator())
+        , m_strategy(index::detail::get_strategy(members.parameters()))
+        , m_pred_first(first)
+        , m_pred_count(count)
+        , m_out_iter(out_it)
+        , m_found_count(0)
+        , m_children_indexes(members.leafs_level)                                                   // MAY THROW (A)
+        , m_stats(stats)
+    {
+        for (std::vector<indexes_type> & level : m_children_indexes)
+        {
+            level.resize(members.parameters().get_max_elements() + 1);                             // MAY THROW (A)
+        }
+    }
+
+    size_type apply(node_pointer ptr, size_type reverse_level, indexes_type const& active)
+    {
+        namespace id = index::detail;
+
+        if (reverse_level > 0)
+        {
+            internal_node& n = rtree::get<internal_node>(*ptr);
+            m_stats.visit_internal_node();
+            auto const& elements = rtree::elements(n);
+            std::vector<indexes_type> & children = m_children_indexes[reverse_level - 1];
+
+            for (std::size_t c = 0 ; c < elements.size() ; ++c)
+            {
+                children[c].clear();
+            }
+
+            // distribute the active queries between the children meeting predicates
+            for (size_type i : active)
+            {
+                auto const& pred = *(m_pred_first + i);
+                for (std::size_t c = 0 ; c < elements.size() ; ++c)
+                {
+                    m_stats.check_predicates();
+                    // if node meets predicates (0 is dummy value)
+                    if (id::predicates_check<id::bounds_tag>(pred, 0, elements[c].first, m_strategy))
+                    {
+                        children[c].push_back(i);                                                   // MAY THROW (A)
+                    }
+                }
+            }
+
+            for (std::size_t c = 0 ; c < elements.size() ; ++c)
+            {
+                if (children[c].size() == 1)
+                {
+                    apply_one(elements[c].second, reverse_level - 1, children[c].front());
+                }
+                else if (! children[c].empty())
+                {
+                    apply(elements[c].second, reverse_level - 1, children[c]);
+                }
+                else
+                {
+                    m_stats.prune_branches(1);
+                }
+            }
+        }
+        else
+        {
+            leaf& n = rtree::get<leaf>(*ptr);
+            m_stats.visit_leaf();
+            // get all values meeting predicates of the active queries
+            for (auto const& v : rtree::elements(n))
+            {
+                for (size_type i : active)
+                {
+                    m_stats.check_predicates();
+                    // if value meets predicates
+                    if (id::predicates_check<id::value_tag>(*(m_pred_first + i), v, m_tr(v), m_strategy))
+                    {
+                        *m_out_iter = std::pair<size_type, value_type>(i, v);
+                        ++m_out_iter;
+                        ++m_found_count;
+                    }
+                }
+            }
+        }
+
+        return m_found_count;
+    }
+
+    // The same as the above but for one query, indexes don't have to be stored
+    void apply_one(node_pointer ptr, size_type reverse_level, size_type i)
+    {
+        namespace id = index::detail;
+
+        auto const& pred = *(m_pred_first + i);
+        if (reverse_level > 0)
+        {
+            internal_node& n = rtree::get<internal_node>(*ptr);
+            m_stats.visit_internal_node();
+            for (auto const& p : rtree::elements(n))
+            {
+                m_stats.check_predicates();
+                // if node meets predicates (0 is dummy value)
+                if (id::predicates_check<id::bounds_tag>(pred, 0, p.first, m_strategy))
+                {
+                    apply_one(p.second, reverse_level - 1, i);
+                }
+                else
+                {
+                    m_stats.prune_branches(1);
+                }
+            }
+        }
+        else
+        {
+            leaf& n = rtree::get<leaf>(*ptr);
+            m_stats.visit_leaf();
+            for (auto const& v : rtree::elements(n))
+            {
+                m_stats.check_predicates();
+                // if value meets predicates
+                if (id::predicates_check<id::value_tag>(pred, v, m_tr(v), m_strategy))
+                {
+                    *m_out_iter = std::pair<size_type, value_type>(i, v);
+                    ++m_out_iter;
+                    ++m_found_count;
+                }
+            }
+        }
+    }
+
+    size_type apply(MembersHolder const& members)
+    {
+        return apply(members, 0, m_pred_count);
+    }
+
+    // Performs the queries [first, last) of the range of predicates
+    size_type apply(MembersHolder const& members, size_type first, size_type last)
+    {
+        indexes_type active;
+        active.reserve((std::min)(last - first, chunk_size));                                      // MAY THROW (A)
+        for (size_type chunk_first = first ; chunk_first < last ; chunk_first += chunk_size)
+        {
+            size_type const chunk_last = (std::min)(chunk_first + chunk_size, last);
+            active.clear();
+            for (size_type i = chunk_first ; i < chunk_last ; ++i)
+            {
+                active.push_back(i);
+            }
+            apply(members.root, members.leafs_level, active);
+        }
+        return m_found_count;
+    }
+
+private:
+    translator_type const& m_tr;
+    strategy_type m_strategy;
+
+    PredicatesIt m_pred_first;
+    size_type m_pred_count;
+    OutIter m_out_iter;
+
+    size_type m_found_count;
+
+    // the indexes of queries passed to the children of a node for each level
+    std::vector<std::vector<indexes_type> > m_children_indexes;
+
+    Statistics m_stats;
 };
 
 template <typename MembersHolder, typename Predicates>
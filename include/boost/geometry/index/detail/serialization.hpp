@@ -177,6 +177,29 @@ void load_construct_data(Archive & ar, boost::geometry::index::rstar<Max, Min, R
 template<class Archive, size_t Max, size_t Min, size_t RE, size_t OCT>
 void serialize(Archive &, boost::geometry::index::rstar<Max, Min, RE, OCT> &, unsigned int) {}
 
+// boost::geometry::index::kmeans
+
+template<class Archive, size_t Max, size_t Min>
+void save_construct_data(Archive & ar, const boost::geometry::index::kmeans<Max, Min> * params, unsigned int )
+{
+    size_t max = params->get_max_elements(), min = params->get_min_elements();
+    ar << boost::serialization::make_nvp("max", max);
+    ar << boost::serialization::make_nvp("min", min);
+}
+template<class Archive, size_t Max, size_t Min>
+void load_construct_data(Archive & ar, boost::geometry::index::kmeans<Max, Min> * params, unsigned int )
+{
+    size_t max, min;
+    ar >> boost::serialization::make_nvp("max", max);
+    ar >> boost::serialization::make_nvp("min", min);
+    if ( max != params->get_max_elements() || min != params->get_min_elements() )
+        // TODO change exception type
+        BOOST_THROW_EXCEPTION(std::runtime_error("parameters not compatible"));
+    // the constructor musn't be called for this type
+    //::new(params)boost::geometry::index::kmeans<Max, Min>();
+}
+template<class Archive, size_t Max, size_t Min> void serialize(Archive &, boost::geometry::index::kmeans<Max, Min> &, unsigned int) {}
+
 // boost::geometry::index::dynamic_linear
 
 template<class Archive>
@@ -241,6 +264,25 @@ inline void load_construct_data(Archive & ar, boost::geometry::index::dynamic_rs
 }
 template<class Archive> void serialize(Archive &, boost::geometry::index::dynamic_rstar &, unsigned int) {}
 
+// boost::geometry::index::dynamic_kmeans
+
+template<class Archive>
+inline void save_construct_data(Archive & ar, const boost::geometry::index::dynamic_kmeans * params, unsigned int )
+{
+    size_t max = params->get_max_elements(), min = params->get_min_elements();
+    ar << boost::serialization::make_nvp("max", max);
+    ar << boost::serialization::make_nvp("min", min);
+}
+template<class Archive>
+inline void load_construct_data(Archive & ar, boost::geometry::index::dynamic_kmeans * params, unsigned int )
+{
+    size_t max, min;
+    ar >> boost::serialization::make_nvp("max", max);
+    ar >> boost::serialization::make_nvp("min", min);
+    ::new(params)boost::geometry::index::dynamic_kmeans(max, min);
+}
+template<class Archive> void serialize(Archive &, boost::geometry::index::dynamic_kmeans &, unsigned int) {}
+
 }} // boost::serialization
 
 // TODO - move to index/detail/serialization.hpp or maybe geometry/serialization.hpp
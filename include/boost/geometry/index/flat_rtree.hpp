@@ -0,0 +1,540 @@
+// Boost.Geometry Index
+//
+// Flat, read-only R-tree implementation
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_FLAT_RTREE_HPP
+#define BOOST_GEOMETRY_INDEX_FLAT_RTREE_HPP
+
+// STD
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+// Boost
+#include <boost/container/allocator_traits.hpp>
+#include <boost/container/new_allocator.hpp>
+#include <boost/container/vector.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+// Boost.Geometry.Index
+#include <boost/geometry/core/static_assert.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/geometry/index/detail/rtree/flat/flatten.hpp>
+#include <boost/geometry/index/detail/rtree/flat/image.hpp>
+#include <boost/geometry/index/detail/rtree/flat/layout.hpp>
+#include <boost/geometry/index/detail/rtree/flat/quantized_layout.hpp>
+#include <boost/geometry/index/detail/rtree/flat/query.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace flat {
+
+/*!
+\brief The layout of the flat_rtree storing the boxes of nodes with full precision.
+*/
+struct layout {};
+
+/*!
+\brief The layout of the flat_rtree storing quantized boxes of nodes.
+
+The coordinates of the box of each node are stored as unsigned integers of type \c Quantized
+relative to the box of its parent node. They're rounded outward so the stored boxes contain
+the original ones. E.g. for 2-dimensional boxes of \c double coordinates the boxes of nodes
+take 8 bytes for \c std::uint16_t and 4 bytes for \c std::uint8_t instead of 32 bytes.
+The boxes are decoded during the traversal and the Values are stored with full precision
+so the predicates are checked exactly and the results of the queries are the same.
+Only the boxes of nodes are quantized so the total memory usage decreases only slightly
+if the Values are much bigger than the boxes of nodes. The queries are slower because the
+boxes are decoded and more nodes may be traversed. Only the floating point coordinate
+types are supported.
+
+\tparam Quantized       The unsigned integral type storing the quantized coordinates.
+*/
+template <typename Quantized = std::uint16_t>
+struct quantized_layout {};
+
+} // namespace flat
+
+namespace detail { namespace rtree { namespace flat {
+
+template <typename Layout, typename Value, typename Box, typename Allocator>
+struct coordinates_storage
+{
+    BOOST_GEOMETRY_STATIC_ASSERT_FALSE(
+        "Not implemented for this Layout.",
+        Layout);
+};
+
+template <typename Value, typename Box, typename Allocator>
+struct coordinates_storage<index::flat::layout, Value, Box, Allocator>
+{
+    typedef coordinates<Value, Box, Allocator> type;
+};
+
+template <typename Quantized, typename Value, typename Box, typename Allocator>
+struct coordinates_storage<index::flat::quantized_layout<Quantized>, Value, Box, Allocator>
+{
+    typedef quantized_coordinates<Value, Box, Quantized, Allocator> type;
+};
+
+}}} // namespace detail::rtree::flat
+
+template <typename FlatRtree, typename Aggregate>
+class flat_rtree_aggregates;
+
+/*!
+\brief The flat, read-only R-tree.
+
+The R-tree which can't be modified after construction. It's created from
+the existing rtree or from a range of Values with the packing algorithm.
+The nodes are stored in breadth-first order in one contiguous array, the
+boxes of the nodes are stored as structure of arrays and the Values are
+stored contiguously in the order of leafs. This way the queries are more
+cache-friendly than in the case of the rtree.
+
+The boxes of nodes are stored as defined by the \c Layout, with full precision
+(flat::layout) or quantized (flat::quantized_layout).
+
+\tparam Value           The type of objects stored in the container.
+\tparam Parameters      Compile-time parameters, the same as in the rtree.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+\tparam Allocator       The allocator used to allocate/deallocate memory.
+\tparam Layout          The layout of the boxes of nodes, flat::layout or flat::quantized_layout.
+*/
+template
+<
+    typename Value,
+    typename Parameters,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>,
+    typename Allocator = boost::container::new_allocator<Value>,
+    typename Layout = flat::layout
+>
+class flat_rtree
+{
+public:
+    /*! \brief The type of Value stored in the container. */
+    typedef Value value_type;
+    /*! \brief R-tree parameters type. */
+    typedef Parameters parameters_type;
+    /*! \brief The function object extracting Indexable from Value. */
+    typedef IndexableGetter indexable_getter;
+    /*! \brief The function object comparing objects of type Value. */
+    typedef EqualTo value_equal;
+    /*! \brief The type of allocator used by the container. */
+    typedef Allocator allocator_type;
+    /*! \brief The layout of the boxes of nodes. */
+    typedef Layout layout_tag;
+
+    /*! \brief The rtree type from which the flat rtree can be created. */
+    typedef rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> rtree_type;
+
+    /*! \brief The Indexable type to which Value is translated. */
+    typedef typename rtree_type::indexable_type indexable_type;
+    /*! \brief The Box type used by the R-tree. */
+    typedef typename rtree_type::bounds_type bounds_type;
+
+private:
+    typedef detail::translator<IndexableGetter, EqualTo> translator_type;
+    typedef typename index::detail::strategy_type<parameters_type>::type strategy_type;
+
+    typedef detail::rtree::flat::node node_type;
+    typedef typename detail::rtree::flat::coordinates_storage
+        <
+            Layout, Value, bounds_type, Allocator
+        >::type coordinates_type;
+    typedef typename coordinates_type::layout_type layout_type;
+
+    typedef boost::container::allocator_traits<Allocator> allocator_traits_type;
+    typedef typename allocator_traits_type::template rebind_alloc<node_type> node_allocator_type;
+
+    typedef boost::container::vector<Value, Allocator> values_type;
+    typedef boost::container::vector<node_type, node_allocator_type> nodes_type;
+
+public:
+    /*! \brief Unsigned integral type used by the container. */
+    typedef typename values_type::size_type size_type;
+    /*! \brief Type of reference to Value. */
+    typedef typename values_type::const_reference const_reference;
+    /*! \brief Type of const iterator, category RandomAccessIterator. */
+    typedef typename values_type::const_iterator const_iterator;
+
+    /*!
+    \brief The constructor creating an empty container.
+
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    If allocator default constructor throws.
+    */
+    inline explicit flat_rtree(parameters_type const& parameters = parameters_type(),
+                               indexable_getter const& getter = indexable_getter(),
+                               value_equal const& equal = value_equal(),
+                               allocator_type const& allocator = allocator_type())
+        : m_translator(getter, equal)
+        , m_parameters(parameters)
+        , m_values(allocator)
+        , m_nodes(node_allocator_type(allocator))
+        , m_coords(allocator)
+        , m_leafs_first(0)
+    {}
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm.
+
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Iterator>
+    inline flat_rtree(Iterator first, Iterator last,
+                      parameters_type const& parameters = parameters_type(),
+                      indexable_getter const& getter = indexable_getter(),
+                      value_equal const& equal = value_equal(),
+                      allocator_type const& allocator = allocator_type())
+        : m_translator(getter, equal)
+        , m_parameters(parameters)
+        , m_values(allocator)
+        , m_nodes(node_allocator_type(allocator))
+        , m_coords(allocator)
+        , m_leafs_first(0)
+    {
+        rtree_type tree(first, last, parameters, getter, equal, allocator);
+        flatten(tree);
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm.
+
+    \param rng          The range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Range>
+    inline explicit flat_rtree(Range const& rng,
+                               parameters_type const& parameters = parameters_type(),
+                               indexable_getter const& getter = indexable_getter(),
+                               value_equal const& equal = value_equal(),
+                               allocator_type const& allocator = allocator_type())
+        : m_translator(getter, equal)
+        , m_parameters(parameters)
+        , m_values(allocator)
+        , m_nodes(node_allocator_type(allocator))
+        , m_coords(allocator)
+        , m_leafs_first(0)
+    {
+        rtree_type tree(::boost::begin(rng), ::boost::end(rng), parameters, getter, equal, allocator);
+        flatten(tree);
+    }
+
+    /*!
+    \brief The constructor creating the flat copy of the rtree.
+
+    The structure of the rtree is preserved.
+
+    \param tree         The rtree.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template <typename Alloc>
+    inline explicit flat_rtree(rtree<Value, Parameters, IndexableGetter, EqualTo, Alloc> const& tree,
+                               allocator_type const& allocator = allocator_type())
+        : m_translator(tree.indexable_get(), tree.value_eq())
+        , m_parameters(tree.parameters())
+        , m_values(allocator)
+        , m_nodes(node_allocator_type(allocator))
+        , m_coords(allocator)
+        , m_leafs_first(0)
+    {
+        flatten(tree);
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
+
+    This query function performs spatial and k-nearest neighbor searches in the same
+    way as rtree::query(). The same predicates may be passed.
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If predicates copy throws.
+
+    \warning
+    Only one \c nearest() predicate may be passed to the query. Passing more of them results in compile-time error.
+
+    \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of values found.
+    */
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it) const
+    {
+        return detail::rtree::flat::query(layout(), m_translator,
+                                          index::detail::get_strategy(m_parameters),
+                                          predicates, out_it);
+    }
+
+    /*!
+    \brief Returns the number of stored values.
+
+    \return         The number of stored values.
+
+    \par Throws
+    Nothing.
+    */
+    inline size_type size() const
+    {
+        return m_values.size();
+    }
+
+    /*!
+    \brief Query if the container is empty.
+
+    \return         true if the container is empty.
+
+    \par Throws
+    Nothing.
+    */
+    inline bool empty() const
+    {
+        return m_values.empty();
+    }
+
+    /*!
+    \brief Returns the box able to contain all values stored in the container.
+
+    Returns the box able to contain all values stored in the container.
+    If the container is empty the result of \c geometry::assign_inverse() is returned.
+
+    \return     The box able to contain all values stored in the container or an invalid box if
+                there are no values in the container.
+
+    \par Throws
+    Nothing.
+    */
+    inline bounds_type bounds() const
+    {
+        bounds_type result;
+        // in order to suppress the uninitialized variable warnings
+        geometry::assign_inverse(result);
+
+        if ( ! m_nodes.empty() )
+        {
+            result = layout().root_box();
+        }
+
+        return result;
+    }
+
+    /*!
+    \brief Returns the iterator to the first element.
+
+    The Values are returned in the order in which they're stored in leafs.
+
+    \return     The iterator to the first element.
+
+    \par Throws
+    Nothing.
+    */
+    const_iterator begin() const
+    {
+        return m_values.begin();
+    }
+
+    /*!
+    \brief Returns the iterator following the last element.
+
+    \return     The iterator following the last element.
+
+    \par Throws
+    Nothing.
+    */
+    const_iterator end() const
+    {
+        return m_values.end();
+    }
+
+    /*!
+    \brief Returns parameters.
+
+    \return     The parameters object.
+
+    \par Throws
+    Nothing.
+    */
+    inline parameters_type parameters() const
+    {
+        return m_parameters;
+    }
+
+    /*!
+    \brief Returns function retrieving Indexable from Value.
+
+    \return     The indexable_getter object.
+
+    \par Throws
+    Nothing.
+    */
+    indexable_getter indexable_get() const
+    {
+        return static_cast<IndexableGetter const&>(m_translator);
+    }
+
+    /*!
+    \brief Returns function comparing Values
+
+    \return     The value_equal function.
+
+    \par Throws
+    Nothing.
+    */
+    value_equal value_eq() const
+    {
+        return static_cast<EqualTo const&>(m_translator);
+    }
+
+    /*!
+    \brief Returns allocator used by the flat rtree.
+
+    \return     The allocator.
+
+    \par Throws
+    If allocator copy constructor throws.
+    */
+    allocator_type get_allocator() const
+    {
+        return m_values.get_allocator();
+    }
+
+    /*!
+    \brief Writes the binary image of the flat rtree into the stream.
+
+    The image can be mapped into memory and queried in place with the mapped_rtree.
+    It can be read only on a platform with the same byte order and by the program
+    using the same Value and Parameters types. The Value has to be trivially copyable.
+    The stream should be opened in binary mode. Only the flat rtree using flat::layout
+    can be saved.
+
+    \param os     The output stream.
+
+    \par Throws
+    If the stream throws.
+    */
+    void save(std::ostream & os) const
+    {
+        BOOST_GEOMETRY_STATIC_ASSERT((std::is_same<Layout, flat::layout>::value),
+            "Only the flat_rtree using flat::layout can be saved.",
+            Layout);
+
+        detail::rtree::flat::write_image(os, layout());
+    }
+
+private:
+    template <typename Rtree>
+    void flatten(Rtree const& tree)
+    {
+        typedef detail::rtree::utilities::view<Rtree> view_type;
+        typedef std::vector<bounds_type> boxes_type;
+
+        boxes_type boxes;
+        detail::rtree::flat::flatten
+            <
+                typename view_type::members_holder, nodes_type, boxes_type, values_type
+            > flatten_v(m_nodes, boxes, m_values);
+
+        m_values.reserve(tree.size());                                                             // MAY THROW (A)
+        m_leafs_first = flatten_v.apply(tree);                                                     // MAY THROW (A, C)
+
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        m_coords.assign(m_nodes, m_leafs_first, boxes);                                            // MAY THROW (A)
+    }
+
+    template <typename FlatRtree, typename Aggregate>
+    friend class flat_rtree_aggregates;
+
+    layout_type layout() const
+    {
+        layout_type result;
+        result.nodes = m_nodes.data();
+        m_coords.apply(result);
+        result.values = m_values.data();
+        result.nodes_count = m_nodes.size();
+        result.leafs_first = m_leafs_first;
+        result.values_count = m_values.size();
+        return result;
+    }
+
+    translator_type m_translator;
+    parameters_type m_parameters;
+
+    values_type m_values;
+    nodes_type m_nodes;
+    coordinates_type m_coords;
+    detail::rtree::flat::index_type m_leafs_first;
+};
+
+/*!
+\brief Finds values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
+
+\ingroup rtree_functions
+
+\param tree         The flat rtree.
+\param predicates   Predicates.
+\param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+\return             The number of values found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Layout, typename Predicates, typename OutIter> inline
+typename flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator, Layout>::size_type
+query(flat_rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator, Layout> const& tree,
+      Predicates const& predicates,
+      OutIter out_it)
+{
+    return tree.query(predicates, out_it);
+}
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_FLAT_RTREE_HPP
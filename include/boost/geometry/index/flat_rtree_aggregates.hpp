@@ -0,0 +1,211 @@
+// Boost.Geometry Index
+//
+// Aggregates of the values stored in the nodes of the flat R-tree
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_FLAT_RTREE_AGGREGATES_HPP
+#define BOOST_GEOMETRY_INDEX_FLAT_RTREE_AGGREGATES_HPP
+
+// STD
+#include <cstddef>
+#include <vector>
+
+// Boost.Geometry.Index
+#include <boost/geometry/index/flat_rtree.hpp>
+
+#include <boost/geometry/index/detail/predicates.hpp>
+#include <boost/geometry/index/detail/rtree/flat/layout.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief The aggregates of the values stored in the subtrees of the nodes of the flat rtree.
+
+The aggregate of the values of each node is calculated once during the construction.
+The aggregate of the values intersecting a box is then calculated by combining
+the aggregates of the nodes covered by the box and of the values of the remaining
+nodes intersecting the box, so the nodes covered by the box are not traversed.
+E.g. the number of values in a viewport may be found this way without visiting
+the leafs inside the viewport.
+
+The flat rtree is not copied, it has to exist as long as the aggregates are used.
+
+\par Example
+\verbatim
+bgi::flat_rtree_aggregates<FlatRtree> counts(tree);
+std::size_t n = counts.query(viewport);
+\endverbatim
+
+\tparam FlatRtree   The type of the flat rtree.
+\tparam Aggregate   The aggregate, e.g. count_aggregate.
+*/
+template <typename FlatRtree, typename Aggregate = count_aggregate>
+class flat_rtree_aggregates
+{
+    typedef typename FlatRtree::layout_type layout_type;
+    typedef typename FlatRtree::strategy_type strategy_type;
+    typedef typename layout_type::box_type box_type;
+    typedef typename layout_type::node_box_type node_box_type;
+
+    typedef detail::rtree::flat::index_type index_type;
+    typedef detail::rtree::flat::node node_type;
+
+public:
+    /*! \brief The type of the aggregated values. */
+    typedef typename Aggregate::result_type result_type;
+    /*! \brief The type of the aggregate. */
+    typedef Aggregate aggregate_type;
+
+    /*!
+    \brief The constructor calculating the aggregates of all nodes.
+
+    \param tree         The flat rtree.
+    \param aggregate    The aggregate object.
+
+    \par Throws
+    If allocation throws.
+    If the operations of the Aggregate throw.
+    */
+    explicit flat_rtree_aggregates(FlatRtree const& tree, Aggregate const& aggregate = Aggregate())
+        : m_tree(tree)
+        , m_aggregate(aggregate)
+    {
+        layout_type const layout = m_tree.layout();
+
+        m_nodes.resize(std::size_t(layout.nodes_count), m_aggregate.identity());                   // MAY THROW (A)
+
+        // the nodes are stored in breadth-first order so the children are stored after the parents
+        for (std::size_t n = std::size_t(layout.nodes_count) ; n-- > 0 ; )
+        {
+            node_type const& nd = layout.nodes[n];
+            index_type const last = nd.first + nd.count;
+            result_type & result = m_nodes[n];
+            if (layout.is_leaf(n))
+            {
+                for (index_type i = nd.first ; i < last ; ++i)
+                {
+                    result = m_aggregate.combine(result, m_aggregate.value(layout.values[i]));
+                }
+            }
+            else
+            {
+                for (index_type i = nd.first ; i < last ; ++i)
+                {
+                    result = m_aggregate.combine(result, m_nodes[std::size_t(i)]);
+                }
+            }
+        }
+    }
+
+    /*!
+    \brief Returns the aggregate of the values which Indexables intersect the box.
+
+    \param box      The box.
+
+    \return         The aggregate of the values.
+
+    \par Throws
+    If the operations of the Aggregate throw.
+    */
+    template <typename Box>
+    result_type query(Box const& box) const
+    {
+        result_type result = m_aggregate.identity();
+
+        layout_type const layout = m_tree.layout();
+        if (! layout.empty())
+        {
+            strategy_type const strategy = index::detail::get_strategy(m_tree.parameters());
+            box_type const root_box = layout.root_box();
+            if (covered_by(root_box, box, strategy))
+            {
+                result = m_nodes[0];
+            }
+            else if (intersects(root_box, box, strategy))
+            {
+                apply(layout, 0, layout.root_node_box(), box, strategy, result);
+            }
+        }
+
+        return result;
+    }
+
+    /*!
+    \brief Returns the aggregate of all values.
+
+    \par Throws
+    Nothing.
+    */
+    result_type total() const
+    {
+        return m_nodes.empty() ? m_aggregate.identity() : m_nodes[0];
+    }
+
+private:
+    template <typename Box>
+    void apply(layout_type const& layout, index_type n, node_box_type const& n_box,
+               Box const& box, strategy_type const& strategy, result_type & result) const
+    {
+        node_type const& nd = layout.nodes[n];
+        index_type const last = nd.first + nd.count;
+        if (layout.is_leaf(n))
+        {
+            auto const& tr = m_tree.m_translator;
+            for (index_type i = nd.first ; i < last ; ++i)
+            {
+                auto const& v = layout.values[i];
+                if (intersects(tr(v), box, strategy))
+                {
+                    result = m_aggregate.combine(result, m_aggregate.value(v));
+                }
+            }
+        }
+        else
+        {
+            for (index_type i = nd.first ; i < last ; ++i)
+            {
+                box_type const b = layout.box(nd, n_box, i);
+                // the aggregate of the whole node is used if the node is covered
+                if (covered_by(b, box, strategy))
+                {
+                    result = m_aggregate.combine(result, m_nodes[std::size_t(i)]);
+                }
+                else if (intersects(b, box, strategy))
+                {
+                    apply(layout, i, layout.node_box(b), box, strategy, result);
+                }
+            }
+        }
+    }
+
+    template <typename G, typename Box>
+    static bool intersects(G const& g, Box const& box, strategy_type const& strategy)
+    {
+        return index::detail::spatial_predicate_call
+            <
+                index::detail::predicates::intersects_tag
+            >::apply(g, box, strategy);
+    }
+
+    template <typename Box>
+    static bool covered_by(box_type const& b, Box const& box, strategy_type const& strategy)
+    {
+        return index::detail::spatial_predicate_call
+            <
+                index::detail::predicates::covered_by_tag
+            >::apply(b, box, strategy);
+    }
+
+    FlatRtree const& m_tree;
+    Aggregate m_aggregate;
+    std::vector<result_type> m_nodes;
+};
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_FLAT_RTREE_AGGREGATES_HPP
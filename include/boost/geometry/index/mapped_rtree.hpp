@@ -0,0 +1,298 @@
+// Boost.Geometry Index
+//
+// Memory-mapped, read-only R-tree implementation
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_MAPPED_RTREE_HPP
+#define BOOST_GEOMETRY_INDEX_MAPPED_RTREE_HPP
+
+// STD
+#include <cstddef>
+
+// Boost.Geometry.Index
+#include <boost/geometry/index/flat_rtree.hpp>
+
+#include <boost/geometry/index/detail/rtree/flat/image.hpp>
+#include <boost/geometry/index/detail/rtree/flat/layout.hpp>
+#include <boost/geometry/index/detail/rtree/flat/query.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief The read-only R-tree querying the binary image stored in memory.
+
+The image is created by flat_rtree::save(). It may be e.g. a file mapped into
+memory. The image is queried in place, nothing is copied and no memory is
+allocated, so the tree is ready right after the construction and the pages
+of the mapped file can be shared by many processes.
+
+The memory is not owned by the mapped_rtree. It has to stay valid as long as
+the mapped_rtree is used. The header of the image is checked in the constructor,
+the rest of the data is not.
+
+\tparam Value           The type of objects stored in the container, the same as in the flat_rtree.
+\tparam Parameters      Compile-time parameters, the same as in the flat_rtree.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+*/
+template
+<
+    typename Value,
+    typename Parameters,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>
+>
+class mapped_rtree
+{
+public:
+    /*! \brief The type of Value stored in the container. */
+    typedef Value value_type;
+    /*! \brief R-tree parameters type. */
+    typedef Parameters parameters_type;
+    /*! \brief The function object extracting Indexable from Value. */
+    typedef IndexableGetter indexable_getter;
+    /*! \brief The function object comparing objects of type Value. */
+    typedef EqualTo value_equal;
+
+    /*! \brief The flat rtree type which image can be queried. */
+    typedef flat_rtree<Value, Parameters, IndexableGetter, EqualTo> flat_rtree_type;
+
+    /*! \brief The Indexable type to which Value is translated. */
+    typedef typename flat_rtree_type::indexable_type indexable_type;
+    /*! \brief The Box type used by the R-tree. */
+    typedef typename flat_rtree_type::bounds_type bounds_type;
+
+    /*! \brief Unsigned integral type used by the container. */
+    typedef std::size_t size_type;
+    /*! \brief Type of reference to Value. */
+    typedef Value const& const_reference;
+    /*! \brief Type of const iterator, category RandomAccessIterator. */
+    typedef Value const* const_iterator;
+
+private:
+    typedef detail::translator<IndexableGetter, EqualTo> translator_type;
+    typedef detail::rtree::flat::layout<Value, bounds_type> layout_type;
+
+public:
+    /*!
+    \brief The constructor creating an empty container.
+
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+
+    \par Throws
+    Nothing.
+    */
+    inline explicit mapped_rtree(parameters_type const& parameters = parameters_type(),
+                                 indexable_getter const& getter = indexable_getter(),
+                                 value_equal const& equal = value_equal())
+        : m_translator(getter, equal)
+        , m_parameters(parameters)
+    {}
+
+    /*!
+    \brief The constructor.
+
+    The header of the image is checked. The data is not copied.
+
+    \param data         The pointer to the image created by flat_rtree::save(). It has to be aligned
+                        at least as the Value and the coordinates, e.g. to the page boundary.
+    \param size         The size of the image in bytes.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+
+    \par Throws
+    std::runtime_error if the image is invalid, was created for different types or on a platform
+    with different byte order.
+    */
+    inline mapped_rtree(void const* data, std::size_t size,
+                        parameters_type const& parameters = parameters_type(),
+                        indexable_getter const& getter = indexable_getter(),
+                        value_equal const& equal = value_equal())
+        : m_translator(getter, equal)
+        , m_parameters(parameters)
+    {
+        detail::rtree::flat::read_image(m_layout, data, size);                                     // MAY THROW
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
+
+    This query function performs spatial and k-nearest neighbor searches in the same
+    way as rtree::query(). The same predicates may be passed.
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If predicates copy throws.
+
+    \warning
+    Only one \c nearest() predicate may be passed to the query. Passing more of them results in compile-time error.
+
+    \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of values found.
+    */
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it) const
+    {
+        return detail::rtree::flat::query(m_layout, m_translator,
+                                          index::detail::get_strategy(m_parameters),
+                                          predicates, out_it);
+    }
+
+    /*!
+    \brief Returns the number of stored values.
+
+    \return         The number of stored values.
+
+    \par Throws
+    Nothing.
+    */
+    inline size_type size() const
+    {
+        return size_type(m_layout.values_count);
+    }
+
+    /*!
+    \brief Query if the container is empty.
+
+    \return         true if the container is empty.
+
+    \par Throws
+    Nothing.
+    */
+    inline bool empty() const
+    {
+        return m_layout.values_count == 0;
+    }
+
+    /*!
+    \brief Returns the box able to contain all values stored in the container.
+
+    If the container is empty the result of \c geometry::assign_inverse() is returned.
+
+    \return     The box able to contain all values stored in the container or an invalid box if
+                there are no values in the container.
+
+    \par Throws
+    Nothing.
+    */
+    inline bounds_type bounds() const
+    {
+        bounds_type result;
+        // in order to suppress the uninitialized variable warnings
+        geometry::assign_inverse(result);
+
+        if ( ! m_layout.empty() )
+        {
+            result = m_layout.root_box();
+        }
+
+        return result;
+    }
+
+    /*!
+    \brief Returns the iterator to the first element.
+
+    The Values are returned in the order in which they're stored in leafs.
+
+    \return     The iterator to the first element.
+
+    \par Throws
+    Nothing.
+    */
+    const_iterator begin() const
+    {
+        return m_layout.values;
+    }
+
+    /*!
+    \brief Returns the iterator following the last element.
+
+    \return     The iterator following the last element.
+
+    \par Throws
+    Nothing.
+    */
+    const_iterator end() const
+    {
+        return m_layout.values + m_layout.values_count;
+    }
+
+    /*!
+    \brief Returns parameters.
+
+    \return     The parameters object.
+
+    \par Throws
+    Nothing.
+    */
+    inline parameters_type parameters() const
+    {
+        return m_parameters;
+    }
+
+    /*!
+    \brief Returns function retrieving Indexable from Value.
+
+    \return     The indexable_getter object.
+
+    \par Throws
+    Nothing.
+    */
+    indexable_getter indexable_get() const
+    {
+        return static_cast<IndexableGetter const&>(m_translator);
+    }
+
+    /*!
+    \brief Returns function comparing Values
+
+    \return     The value_equal function.
+
+    \par Throws
+    Nothing.
+    */
+    value_equal value_eq() const
+    {
+        return static_cast<EqualTo const&>(m_translator);
+    }
+
+private:
+    translator_type m_translator;
+    parameters_type m_parameters;
+    layout_type m_layout;
+};
+
+/*!
+\brief Finds values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
+
+\ingroup rtree_functions
+
+\param tree         The mapped rtree.
+\param predicates   Predicates.
+\param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+\return             The number of values found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo,
+          typename Predicates, typename OutIter> inline
+typename mapped_rtree<Value, Parameters, IndexableGetter, EqualTo>::size_type
+query(mapped_rtree<Value, Parameters, IndexableGetter, EqualTo> const& tree,
+      Predicates const& predicates,
+      OutIter out_it)
+{
+    return tree.query(predicates, out_it);
+}
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_MAPPED_RTREE_HPP
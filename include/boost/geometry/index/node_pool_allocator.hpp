@@ -0,0 +1,313 @@
+// Boost.Geometry Index
+//
+// Pool allocator for R-tree nodes
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_NODE_POOL_ALLOCATOR_HPP
+#define BOOST_GEOMETRY_INDEX_NODE_POOL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <boost/container/throw_exception.hpp>
+
+#include <boost/geometry/index/detail/assert.hpp>
+#include <boost/geometry/index/packing.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail {
+
+// Stores the memory blocks of the same size in slabs containing a fixed
+// number of blocks. The free blocks of each size are kept in a singly-linked
+// list stored in place of the blocks. The slabs are released at once when
+// all of the blocks are deallocated, e.g. when the rtree is cleared.
+//
+// The pool is not synchronized. It is meant to be used by one container
+// so it's used by one modifying thread at a time. The number of distinct
+// sizes is small (one per node type) so the size classes are searched
+// linearly.
+class node_pool
+{
+    struct free_block
+    {
+        free_block * next;
+    };
+
+    struct size_class
+    {
+        std::size_t block_size;
+        free_block * free_list;
+    };
+
+    static const std::size_t alignment = alignof(std::max_align_t);
+
+public:
+    explicit node_pool(std::size_t blocks_per_slab)
+        : m_blocks_per_slab(blocks_per_slab > 0 ? blocks_per_slab : 1)
+        , m_used_blocks(0)
+        , m_capacity(0)
+    {}
+
+    ~node_pool()
+    {
+        release();
+    }
+
+    void * allocate(std::size_t size)
+    {
+        size_class & sc = get_size_class(block_size(size));                                        // MAY THROW (alloc)
+
+        if ( ! sc.free_list )
+            add_slab(sc);                                                                           // MAY THROW (alloc)
+
+        free_block * b = sc.free_list;
+        sc.free_list = b->next;
+        ++m_used_blocks;
+        return b;
+    }
+
+    void deallocate(void * p, std::size_t size)
+    {
+        std::size_t const bs = block_size(size);
+        std::vector<size_class>::iterator it = m_size_classes.begin();
+        for ( ; it != m_size_classes.end() && it->block_size != bs ; ++it ) {}
+
+        BOOST_GEOMETRY_INDEX_ASSERT(it != m_size_classes.end(), "the block wasn't allocated by this pool");
+        BOOST_GEOMETRY_INDEX_ASSERT(0 < m_used_blocks, "the block wasn't allocated by this pool");
+
+        free_block * b = static_cast<free_block*>(p);
+        b->next = it->free_list;
+        it->free_list = b;
+
+        if ( 0 == --m_used_blocks )
+            release();
+    }
+
+    std::size_t blocks_per_slab() const { return m_blocks_per_slab; }
+    std::size_t capacity() const { return m_capacity; }
+
+private:
+    node_pool(node_pool const&);
+    node_pool & operator=(node_pool const&);
+
+    static std::size_t block_size(std::size_t size)
+    {
+        if ( size < sizeof(free_block) )
+            size = sizeof(free_block);
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    size_class & get_size_class(std::size_t bs)
+    {
+        for ( std::vector<size_class>::iterator it = m_size_classes.begin() ;
+              it != m_size_classes.end() ; ++it )
+        {
+            if ( it->block_size == bs )
+                return *it;
+        }
+
+        size_class sc = { bs, 0 };
+        m_size_classes.push_back(sc);                                                               // MAY THROW (alloc)
+        return m_size_classes.back();
+    }
+
+    void add_slab(size_class & sc)
+    {
+        if ( sc.block_size > (std::size_t(-1) - alignment) / m_blocks_per_slab )
+            boost::container::throw_bad_alloc();
+
+        m_slabs.reserve(m_slabs.size() + 1);                                                        // MAY THROW (alloc)
+        char * slab = static_cast<char*>(::operator new(sc.block_size * m_blocks_per_slab));        // MAY THROW (alloc)
+        m_slabs.push_back(slab);
+        m_capacity += sc.block_size * m_blocks_per_slab;
+
+        // link the blocks in the order of addresses
+        for ( std::size_t i = m_blocks_per_slab ; i > 0 ; --i )
+        {
+            free_block * b = reinterpret_cast<free_block*>(slab + (i - 1) * sc.block_size);
+            b->next = sc.free_list;
+            sc.free_list = b;
+        }
+    }
+
+    void release()
+    {
+        for ( std::vector<char*>::iterator it = m_slabs.begin() ; it != m_slabs.end() ; ++it )
+            ::operator delete(*it);
+
+        m_slabs.clear();
+        m_size_classes.clear();
+        m_capacity = 0;
+    }
+
+    std::size_t m_blocks_per_slab;
+    std::size_t m_used_blocks;
+    std::size_t m_capacity;
+    std::vector<size_class> m_size_classes;
+    std::vector<char*> m_slabs;
+};
+
+} // namespace detail
+
+/*!
+\brief The allocator storing the nodes of the rtree in a pool.
+
+The rtree creates and destroys the nodes one by one, e.g. when they're splitted or underflow.
+This allocator may be passed as the \c Allocator of the rtree in order to avoid calling
+the global operator new for each of them. The memory is allocated in slabs, each of them
+containing the number of memory blocks passed in the constructor, 64 by default. The number
+of blocks doesn't depend on the parameters of the rtree. The size of a block is equal
+to the size of the allocated object, e.g. the node which size depends on the maximum number of
+elements. Deallocated blocks are kept in per-size free lists and reused. When all of the blocks
+are deallocated, e.g. when the rtree is cleared or destroyed, all of the slabs are released.
+Only single objects are allocated from the pool, arrays (e.g. the elements of the nodes of
+the rtree with run-time parameters) are allocated with the global operator new.
+
+The copies of the allocator share the same pool. The rtree copy constructor creates
+a new pool for the copy so each rtree uses its own pool and the pool is not synchronized.
+Therefore the same allocator object shouldn't be passed into rtrees modified in different
+threads. For the same reason the rtree using this allocator can't be created with
+parallel_packing, which creates the nodes concurrently.
+
+\tparam T   The type of allocated objects.
+*/
+template <typename T>
+class node_pool_allocator
+{
+    template <typename U>
+    friend class node_pool_allocator;
+
+public:
+    typedef T value_type;
+    typedef T * pointer;
+    typedef T const* const_pointer;
+    typedef T & reference;
+    typedef T const& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef node_pool_allocator<U> other;
+    };
+
+    /*!
+    \brief The constructor creating a new pool allocating 64 blocks at once.
+
+    \par Throws
+    If allocation throws.
+    */
+    node_pool_allocator()
+        : m_pool(std::make_shared<detail::node_pool>(64))
+    {}
+
+    /*!
+    \brief The constructor creating a new pool.
+
+    \param blocks_per_slab  The number of memory blocks allocated at once.
+
+    \par Throws
+    If allocation throws.
+    */
+    explicit node_pool_allocator(std::size_t blocks_per_slab)
+        : m_pool(std::make_shared<detail::node_pool>(blocks_per_slab))
+    {}
+
+    /*!
+    \brief The converting constructor sharing the pool.
+
+    \par Throws
+    Nothing.
+    */
+    template <typename U>
+    node_pool_allocator(node_pool_allocator<U> const& other)
+        : m_pool(other.m_pool)
+    {}
+
+    pointer allocate(size_type n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "Overaligned types are not supported.");
+
+        if ( n > max_size() )
+            boost::container::throw_bad_alloc();
+
+        if ( n != 1 )
+            return static_cast<pointer>(::operator new(n * sizeof(T)));                            // MAY THROW (alloc)
+
+        return static_cast<pointer>(m_pool->allocate(sizeof(T)));                                  // MAY THROW (alloc)
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        if ( n != 1 )
+            ::operator delete(p);
+        else
+            m_pool->deallocate(p, sizeof(T));
+    }
+
+    size_type max_size() const
+    {
+        return size_type(-1) / sizeof(T);
+    }
+
+    /*!
+    \brief Returns the allocator using a new pool.
+
+    It's used by the copy constructor of the rtree.
+    */
+    node_pool_allocator select_on_container_copy_construction() const
+    {
+        return node_pool_allocator(m_pool->blocks_per_slab());                                     // MAY THROW (alloc)
+    }
+
+    /*!
+    \brief Returns the number of bytes of memory allocated by the pool.
+    */
+    size_type capacity() const
+    {
+        return m_pool->capacity();
+    }
+
+    template <typename U>
+    bool operator==(node_pool_allocator<U> const& other) const
+    {
+        return m_pool == other.m_pool;
+    }
+
+    template <typename U>
+    bool operator!=(node_pool_allocator<U> const& other) const
+    {
+        return m_pool != other.m_pool;
+    }
+
+private:
+    std::shared_ptr<detail::node_pool> m_pool;
+};
+
+namespace detail {
+
+template <typename T>
+struct is_unsynchronized_allocator<node_pool_allocator<T> >
+    : std::true_type
+{};
+
+} // namespace detail
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_NODE_POOL_ALLOCATOR_HPP
@@ -0,0 +1,125 @@
+// Boost.Geometry Index
+//
+// R-tree packing algorithms
+//
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_PACKING_HPP
+#define BOOST_GEOMETRY_INDEX_PACKING_HPP
+
+#include <type_traits>
+
+#include <boost/geometry/util/parallel.hpp>
+#include <boost/geometry/util/thread_executor.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+/*!
+\brief The default packing algorithm.
+
+Top-down recursive packing. The elements are split at the object median
+along the greatest edge of the bounding box of the current set of elements.
+Nodes are filled as tightly as possible.
+*/
+struct default_packing {};
+
+/*!
+\brief Hilbert curve packing algorithm.
+
+The elements are sorted once by the Hilbert index of their centroids and
+the leafs and internal nodes are filled sequentially. The tree is built
+bottom-up. In general this algorithm is faster than the default one
+but the overlap of the nodes is slightly greater.
+*/
+struct hilbert_packing {};
+
+/*!
+\brief Morton curve (Z-order) packing algorithm.
+
+The elements are sorted once by the Morton code of their centroids and
+the leafs and internal nodes are filled sequentially. The tree is built
+bottom-up. This is the fastest of the packing algorithms but the nodes
+overlap more than in the case of hilbert_packing.
+*/
+struct morton_packing {};
+
+/*!
+\brief Parallel version of the default packing algorithm.
+
+The independent parts of the tree are created concurrently by the Executor.
+The resulting tree is identical to the one created by default_packing.
+
+The Executor has to provide concurrency() member function returning the
+number of tasks which can be executed concurrently and operator()(count, f)
+calling f(i) for each i in [0, count), possibly concurrently, and returning
+when all calls are finished. By default std::threads are used.
+
+The allocator of the rtree is used concurrently so it has to be thread-safe.
+In particular node_pool_allocator can't be used.
+
+\tparam Executor   The type of the executor.
+*/
+template <typename Executor = util::thread_executor>
+class parallel_packing
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param executor   The executor object.
+    */
+    explicit parallel_packing(Executor const& executor = Executor())
+        : m_executor(executor)
+    {}
+
+    Executor const& executor() const
+    {
+        return m_executor;
+    }
+
+private:
+    Executor m_executor;
+};
+
+namespace detail {
+
+template <typename Packing>
+struct is_packing
+    : std::false_type
+{};
+
+template <>
+struct is_packing<default_packing>
+    : std::true_type
+{};
+
+template <>
+struct is_packing<hilbert_packing>
+    : std::true_type
+{};
+
+template <>
+struct is_packing<morton_packing>
+    : std::true_type
+{};
+
+template <typename Executor>
+struct is_packing<parallel_packing<Executor> >
+    : std::true_type
+{};
+
+// The allocators which can't be used concurrently, see parallel_packing
+template <typename Allocator>
+struct is_unsynchronized_allocator
+    : std::false_type
+{};
+
+} // namespace detail
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_PACKING_HPP
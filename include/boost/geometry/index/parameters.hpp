@@ -15,6 +15,7 @@
 #ifndef BOOST_GEOMETRY_INDEX_PARAMETERS_HPP
 #define BOOST_GEOMETRY_INDEX_PARAMETERS_HPP
 
+#include <cstddef>
 #include <limits>
 
 #include <boost/geometry/core/static_assert.hpp>
@@ -150,12 +151,30 @@ struct rstar
     static size_t get_overlap_cost_threshold() { return OverlapCostThreshold; }
 };
 
-//template <size_t MaxElements, size_t MinElements>
-//struct kmeans
-//{
-//    static const size_t max_elements = MaxElements;
-//    static const size_t min_elements = MinElements;
-//};
+/*!
+\brief K-means r-tree creation algorithm parameters.
+
+Overflowed nodes are split into two groups by k-means clustering (k = 2) of the
+centers of elements' bounding boxes. This results in compact, less overlapping
+nodes for clustered data.
+
+\tparam MaxElements     Maximum number of elements in nodes.
+\tparam MinElements     Minimum number of elements in nodes. Default: 0.3*Max.
+*/
+template <size_t MaxElements,
+          size_t MinElements = detail::default_min_elements_s<MaxElements>::value>
+struct kmeans
+{
+    BOOST_GEOMETRY_STATIC_ASSERT((0 < MinElements && 2*MinElements <= MaxElements+1),
+        "Invalid MaxElements or MinElements.",
+        std::integer_sequence<size_t, MaxElements, MinElements>);
+
+    static const size_t max_elements = MaxElements;
+    static const size_t min_elements = MinElements;
+
+    static size_t get_max_elements() { return MaxElements; }
+    static size_t get_min_elements() { return MinElements; }
+};
 
 /*!
 \brief Linear r-tree creation algorithm parameters - run-time version.
@@ -260,6 +279,35 @@ private:
     size_t m_overlap_cost_threshold;
 };
 
+/*!
+\brief K-means r-tree creation algorithm parameters - run-time version.
+*/
+class dynamic_kmeans
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param max_elements     Maximum number of elements in nodes.
+    \param min_elements     Minimum number of elements in nodes. Default: 0.3*Max.
+    */
+    explicit dynamic_kmeans(size_t max_elements,
+                            size_t min_elements = detail::default_min_elements_d())
+        : m_max_elements(max_elements)
+        , m_min_elements(detail::default_min_elements_d_calc(max_elements, min_elements))
+    {
+        if (!(0 < m_min_elements && 2*m_min_elements <= m_max_elements+1))
+            detail::throw_invalid_argument("invalid min or/and max parameters of dynamic_kmeans");
+    }
+
+    size_t get_max_elements() const { return m_max_elements; }
+    size_t get_min_elements() const { return m_min_elements; }
+
+private:
+    size_t m_max_elements;
+    size_t m_min_elements;
+};
+
 
 template <typename Parameters, typename Strategy>
 class parameters
@@ -286,6 +334,71 @@ public:
 };
 
 
+/*!
+\brief The aggregate counting the values.
+
+The Aggregate passed to aggregated or flat_rtree_aggregates has to define \c result_type
+and the member functions \c identity() returning the neutral element, \c value(v) returning
+the aggregate of a single Value and \c combine(a, b) combining two aggregates.
+\c combine() has to be associative.
+*/
+struct count_aggregate
+{
+    typedef std::size_t result_type;
+
+    result_type identity() const
+    {
+        return 0;
+    }
+
+    template <typename Value>
+    result_type value(Value const& ) const
+    {
+        return 1;
+    }
+
+    result_type combine(result_type const& a, result_type const& b) const
+    {
+        return a + b;
+    }
+};
+
+/*!
+\brief The parameters of the rtree storing the aggregates of the values in the nodes.
+
+The aggregate of the values stored in the subtree of each node is kept up to date
+by the insertion, the removal and the packing. Then the aggregate of the values
+intersecting a box is calculated by rtree::aggregate() without traversing the nodes
+covered by the box.
+
+\tparam Parameters     The parameters of the rtree, e.g. rstar<16>.
+\tparam Aggregate      The aggregate, e.g. count_aggregate.
+*/
+template <typename Parameters, typename Aggregate = count_aggregate>
+class aggregated
+    : public Parameters
+    , private Aggregate
+{
+public:
+    aggregated()
+        : Parameters(), Aggregate()
+    {}
+
+    aggregated(Parameters const& params)
+        : Parameters(params), Aggregate()
+    {}
+
+    aggregated(Parameters const& params, Aggregate const& aggregate)
+        : Parameters(params), Aggregate(aggregate)
+    {}
+
+    Aggregate const& aggregate() const
+    {
+        return static_cast<Aggregate const&>(*this);
+    }
+};
+
+
 namespace detail
 {
 
@@ -303,6 +416,11 @@ struct strategy_type< parameters<Parameters, Strategy> >
     typedef Strategy const& result_type;
 };
 
+template <typename Parameters, typename Aggregate>
+struct strategy_type< aggregated<Parameters, Aggregate> >
+    : strategy_type<Parameters>
+{};
+
 
 template <typename Parameters>
 struct get_strategy_impl
@@ -322,6 +440,16 @@ struct get_strategy_impl<parameters<Parameters, Strategy> >
     }
 };
 
+template <typename Parameters, typename Aggregate>
+struct get_strategy_impl<aggregated<Parameters, Aggregate> >
+{
+    static inline typename strategy_type<Parameters>::result_type
+        apply(aggregated<Parameters, Aggregate> const& parameters)
+    {
+        return get_strategy_impl<Parameters>::apply(parameters);
+    }
+};
+
 template <typename Parameters>
 inline typename strategy_type<Parameters>::result_type
     get_strategy(Parameters const& parameters)
@@ -279,6 +279,39 @@ within(Geometry const& g)
                 >(g);
 }
 
+/*!
+\brief Generate \c within_distance() predicate.
+
+Generate a predicate defining Value and Geometry relationship. With this
+predicate query returns indexed Values that are not further from the passed
+Geometry than the passed distance. Value is returned by the query if
+<tt>bg::distance(Geometry, Indexable) <= distance</tt> returns <tt>true</tt>.
+The distance is calculated using the strategy of the rtree so the predicate
+may be used in cartesian, spherical and geographic coordinate systems.
+The nodes which boxes are further than the distance are not traversed.
+
+\par Example
+\verbatim
+bgi::query(spatial_index, bgi::within_distance(pt, 10.0), std::back_inserter(result));
+// at most 5 values nearest to pt not further than 10
+bgi::query(spatial_index, bgi::nearest(pt, 5) && bgi::within_distance(pt, 10.0), std::back_inserter(result));
+\endverbatim
+
+\ingroup predicates
+
+\tparam Geometry    The Geometry type.
+\tparam Distance    The type of distance.
+
+\param g            The Geometry object.
+\param distance     The maximum distance.
+*/
+template <typename Geometry, typename Distance> inline
+detail::predicates::within_distance<Geometry, Distance, false>
+within_distance(Geometry const& g, Distance const& distance)
+{
+    return detail::predicates::within_distance<Geometry, Distance, false>(g, distance);
+}
+
 /*!
 \brief Generate satisfies() predicate.
 
@@ -397,6 +430,13 @@ operator!(spatial_predicate<Geometry, Tag, Negated> const& p)
     return spatial_predicate<Geometry, Tag, !Negated>(p.geometry);
 }
 
+template <typename Geometry, typename Distance, bool Negated> inline
+within_distance<Geometry, Distance, !Negated>
+operator!(within_distance<Geometry, Distance, Negated> const& p)
+{
+    return within_distance<Geometry, Distance, !Negated>(p.geometry, p.distance);
+}
+
 // operator&& generators
 
 template <typename Pred1, typename Pred2> inline
@@ -23,6 +23,9 @@
 
 // Boost
 #include <boost/container/new_allocator.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/range/size.hpp>
 #include <boost/tuple/tuple.hpp>
 
 // Boost.Geometry
@@ -64,24 +67,31 @@
 
 #include <boost/geometry/index/detail/algorithms/is_valid.hpp>
 
+#include <boost/geometry/index/detail/rtree/query_statistics.hpp>
+
+#include <boost/geometry/index/detail/rtree/visitors/bulk_insert.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/bulk_remove.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/insert.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/iterator.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/remove.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/copy.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/destroy.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/spatial_query.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/spatial_join.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/distance_query.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/count.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/children_box.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/aggregate_query.hpp>
 
 #include <boost/geometry/index/detail/rtree/linear/linear.hpp>
 #include <boost/geometry/index/detail/rtree/quadratic/quadratic.hpp>
 #include <boost/geometry/index/detail/rtree/rstar/rstar.hpp>
-//#include <boost/geometry/extensions/index/detail/rtree/kmeans/kmeans.hpp>
+#include <boost/geometry/index/detail/rtree/kmeans/kmeans.hpp>
 
-#include <boost/geometry/index/detail/rtree/pack_create.hpp>
+#include <boost/geometry/index/detail/rtree/pack_dispatch.hpp>
 
 #include <boost/geometry/index/inserter.hpp>
+#include <boost/geometry/index/packing.hpp>
 
 #include <boost/geometry/index/detail/rtree/utilities/view.hpp>
 
@@ -101,6 +111,7 @@
 #include <boost/geometry/index/detail/serialization.hpp>
 #endif
 
+#include <boost/geometry/util/parallel.hpp>
 #include <boost/geometry/util/range.hpp>
 #include <boost/geometry/util/type_traits.hpp>
 
@@ -112,6 +123,9 @@
 
 namespace boost { namespace geometry { namespace index {
 
+template <typename Rtree, typename Geometry>
+class nearest_query_context;
+
 /*!
 \brief The R-tree spatial index.
 
@@ -140,8 +154,10 @@ An object of IndexableGetter type translates from Value to Indexable each time
 r-tree requires it. This operation is done for each Value access.
 The Indexable should not be calculated each time since it could harm
 the performance. The default IndexableGetter can translate all types adapted
-to Point, Box or Segment concepts (called Indexables). Furthermore, it can
-handle <tt>std::pair<Indexable, T></tt>, <tt>std::tuple<Indexable, ...></tt>
+to Point, Box, Segment or Linestring concepts (called Indexables). The box of
+a Linestring is calculated from all of its points each time r-tree requires it
+so for Linestrings with many points it may be faster to store the boxes.
+Furthermore, it can handle <tt>std::pair<Indexable, T></tt>, <tt>std::tuple<Indexable, ...></tt>
 and <tt>boost::tuple<Indexable, ...></tt>. For example, for Value
 of type <tt>std::pair<Box, int></tt>, the default IndexableGetter translates
 from <tt>std::pair<Box, int> const&</tt> to <tt>Box const&</tt>.
@@ -315,7 +331,11 @@ private:
     typedef typename members_holder::node_pointer node_pointer;
     typedef typename members_holder::allocator_traits_type allocator_traits_type;
 
+    typedef std::vector<value_type> values_type;
+
     friend class detail::rtree::utilities::view<rtree>;
+    template <typename V, typename P, typename I, typename E, typename A>
+    friend class rtree;
 #ifdef BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL_SERIALIZATION
     friend class detail::rtree::private_view<rtree>;
     friend class detail::rtree::const_private_view<rtree>;
@@ -348,6 +368,12 @@ public:
             value_type, allocators_type
         > const_query_iterator;
 
+    /*! \brief The type of the aggregate of Values, void if the parameters are not index::aggregated. */
+    typedef typename index::detail::rtree::aggregate_traits
+        <
+            parameters_type
+        >::result_type aggregate_result_type;
+
 public:
 
     /*!
@@ -588,6 +614,81 @@ public:
         pack_construct(::boost::begin(rng), ::boost::end(rng), temp_allocator);
     }
 
+    /*!
+    \brief The constructor.
+
+    The tree is created using the packing algorithm passed as an argument, e.g.
+    \c boost::geometry::index::hilbert_packing.
+
+    \par Example
+    \verbatim
+    bgi::rtree<Value, bgi::linear<16> > rt(values.begin(), values.end(), bgi::hilbert_packing());
+    \endverbatim
+
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param packing      The packing algorithm.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template
+    <
+        typename Iterator, typename Packing,
+        std::enable_if_t<detail::is_packing<Packing>::value, int> = 0
+    >
+    inline rtree(Iterator first, Iterator last,
+                 Packing const& packing,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        pack_construct(first, last, packing, boost::container::new_allocator<void>());
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using the packing algorithm passed as an argument, e.g.
+    \c boost::geometry::index::hilbert_packing.
+
+    \param rng          The range of Values.
+    \param packing      The packing algorithm.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template
+    <
+        typename Range, typename Packing,
+        std::enable_if_t<detail::is_packing<Packing>::value, int> = 0
+    >
+    inline rtree(Range const& rng,
+                 Packing const& packing,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        pack_construct(::boost::begin(rng), ::boost::end(rng), packing,
+                       boost::container::new_allocator<void>());
+    }
+
     /*!
     \brief The destructor.
 
@@ -992,6 +1093,135 @@ public:
         return this->remove_dispatch(conv_or_rng, is_conv_t());
     }
 
+    /*!
+    \brief Insert a range of values to the index at once.
+
+    In contrast to insert() the values are not inserted one by one. They're grouped
+    by the subtrees into which they're going to be inserted and each subtree is
+    modified once. The nodes which would overflow are not split but their elements
+    are divided into the minimal number of nodes using the packing algorithm and the
+    tree is rebalanced once. If the number of inserted values is not smaller than the
+    number of values stored in the container the whole tree is created again using
+    the packing algorithm.
+
+    This is significantly faster than insert() for big ranges of values. The resulting
+    tree may be slightly worse than the one created by the balancing algorithm passed
+    in parameters.
+
+    \param first    The beginning of the range of values.
+    \param last     The end of the range of values.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+
+    \warning
+    This operation only guarantees that there will be no memory leaks.
+    After an exception is thrown the R-tree may be left in an inconsistent state,
+    elements must not be inserted or removed. Other operations are allowed however
+    some of them may return invalid data.
+    */
+    template <typename Iterator>
+    inline void bulk_insert(Iterator first, Iterator last)
+    {
+        values_type values(first, last);                                                            // MAY THROW (V, E: alloc, copy)
+        this->raw_bulk_insert(values);
+    }
+
+    /*!
+    \brief Insert a range of values to the index at once.
+
+    See bulk_insert(Iterator, Iterator).
+
+    \param rng      The range of values.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+
+    \warning
+    This operation only guarantees that there will be no memory leaks.
+    After an exception is thrown the R-tree may be left in an inconsistent state,
+    elements must not be inserted or removed. Other operations are allowed however
+    some of them may return invalid data.
+    */
+    template <typename Range>
+    inline void bulk_insert(Range const& rng)
+    {
+        BOOST_GEOMETRY_STATIC_ASSERT((range::detail::is_range<Range>::value),
+            "The argument has to be a Range.",
+            Range);
+
+        values_type values(boost::const_begin(rng), boost::const_end(rng));                        // MAY THROW (V, E: alloc, copy)
+        this->raw_bulk_insert(values);
+    }
+
+    /*!
+    \brief Remove a range of values from the container at once.
+
+    In contrast to remove() the values are not removed one by one. The tree is
+    traversed once and the nodes which underflow are removed and their elements
+    are inserted back at the end with bulk_insert(), so the tree is rebalanced once.
+    As remove() it removes only one value for each one passed in the range.
+
+    \param first    The beginning of the range of values.
+    \param last     The end of the range of values.
+
+    \return         The number of removed values.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+
+    \warning
+    This operation only guarantees that there will be no memory leaks.
+    After an exception is thrown the R-tree may be left in an inconsistent state,
+    elements must not be inserted or removed. Other operations are allowed however
+    some of them may return invalid data.
+    */
+    template <typename Iterator>
+    inline size_type bulk_remove(Iterator first, Iterator last)
+    {
+        if ( !m_members.root )
+            return 0;
+
+        values_type values(first, last);                                                            // MAY THROW (V, E: alloc, copy)
+        return this->raw_bulk_remove(values);
+    }
+
+    /*!
+    \brief Remove a range of values from the container at once.
+
+    See bulk_remove(Iterator, Iterator).
+
+    \param rng      The range of values.
+
+    \return         The number of removed values.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+
+    \warning
+    This operation only guarantees that there will be no memory leaks.
+    After an exception is thrown the R-tree may be left in an inconsistent state,
+    elements must not be inserted or removed. Other operations are allowed however
+    some of them may return invalid data.
+    */
+    template <typename Range>
+    inline size_type bulk_remove(Range const& rng)
+    {
+        BOOST_GEOMETRY_STATIC_ASSERT((range::detail::is_range<Range>::value),
+            "The argument has to be a Range.",
+            Range);
+
+        if ( !m_members.root )
+            return 0;
+
+        values_type values(boost::const_begin(rng), boost::const_end(rng));                        // MAY THROW (V, E: alloc, copy)
+        return this->raw_bulk_remove(values);
+    }
+
     /*!
     \brief Finds values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
 
@@ -1084,133 +1314,531 @@ public:
     size_type query(Predicates const& predicates, OutIter out_it) const
     {
         return m_members.root
-             ? query_dispatch(predicates, out_it)
+             ? query_dispatch(predicates, out_it, detail::rtree::no_query_statistics())
              : 0;
     }
 
     /*!
-    \brief Returns a query iterator pointing at the begin of the query range.
+    \brief Finds values meeting passed predicates gathering the statistics of the query.
 
-    This method returns an iterator which may be used to perform iterative queries.
-    For the information about predicates which may be passed to this method see query().
+    This query function performs spatial and k-nearest neighbor searches in the same way
+    as query() and additionally counts the visited nodes, the checks of the predicates,
+    the branches which were not traversed and the sizes of the queues of the k-nearest
+    neighbors query. The counters are not reset so the statistics of many queries may be
+    gathered by passing the same object. The queries performed without the statistics
+    are not slowed down.
 
     \par Example
     \verbatim
-    for ( Rtree::const_query_iterator it = tree.qbegin(bgi::nearest(pt, 10000)) ;
-          it != tree.qend() ; ++it )
-    {
-        // do something with value
-        if ( has_enough_nearest_values() )
-            break;
-    }
-
-    // C++11 (auto)
-    for ( auto it = tree.qbegin(bgi::nearest(pt, 3)) ; it != tree.qend() ; ++it )
-    {
-        // do something with value
-    }
-
-    // C++14 (generic lambda expression)
-    std::for_each(tree.qbegin(bgi::nearest(pt, 3)), tree.qend(), [](auto const& val){
-        // do something with value
-    });
+    bgi::query_statistics stats;
+    tree.query(bgi::intersects(box), std::back_inserter(result), stats);
+    std::cout << stats.internal_nodes << ' ' << stats.leafs << ' ' << stats.predicates << std::endl;
     \endverbatim
 
-    \par Iterator category
-    ForwardIterator
-
     \par Throws
+    If Value copy constructor or copy assignment throws.
     If predicates copy throws.
-    If allocation throws.
-
-    \warning
-    The modification of the rtree may invalidate the iterators.
 
     \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+    \param stats        The statistics object which counters are incremented.
 
-    \return             The iterator pointing at the begin of the query range.
+    \return             The number of values found.
     */
-    template <typename Predicates>
-    const_query_iterator qbegin(Predicates const& predicates) const
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it, query_statistics & stats) const
     {
-        return const_query_iterator(qbegin_(predicates));
+        return m_members.root
+             ? query_dispatch(predicates, out_it, detail::rtree::query_statistics_collector(stats))
+             : 0;
     }
 
     /*!
-    \brief Returns a query iterator pointing at the end of the query range.
+    \brief Finds values meeting passed predicates using the buffers of the context.
 
-    This method returns an iterator which may be used to check if the query has ended.
+    This query function performs the k-nearest neighbor search in the same way as
+    query() but the memory allocated by the query is kept in the context and reused
+    by the subsequent queries performed with the same context. Only the predicates
+    containing \c nearest() predicate may be passed.
 
     \par Example
     \verbatim
-    for ( Rtree::const_query_iterator it = tree.qbegin(bgi::nearest(pt, 10000)) ;
-          it != tree.qend() ; ++it )
-    {
-        // do something with value
-        if ( has_enough_nearest_values() )
-            break;
-    }
-
-    // C++11 (auto)
-    for ( auto it = tree.qbegin(bgi::nearest(pt, 3)) ; it != tree.qend() ; ++it )
+    bgi::nearest_query_context<Rtree, Point> context;
+    for ( Point const& pt : points )
     {
-        // do something with value
+        result.clear();
+        tree.query(bgi::nearest(pt, 5), std::back_inserter(result), context);
     }
-
-    // C++14 (generic lambda expression)
-    std::for_each(tree.qbegin(bgi::nearest(pt, 3)), tree.qend(), [](auto const& val){
-        // do something with value
-    });
     \endverbatim
 
-    \par Iterator category
-    ForwardIterator
-
     \par Throws
-    Nothing
+    If Value copy constructor or copy assignment throws.
+    If memory allocation throws.
 
-    \warning
-    The modification of the rtree may invalidate the iterators.
+    \param predicates   Predicates containing \c nearest() predicate.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+    \param context      The context which may be used by one query at a time.
 
-    \return             The iterator pointing at the end of the query range.
+    \return             The number of values found.
     */
-    const_query_iterator qend() const
+    template <typename Predicates, typename OutIter, typename Geometry>
+    size_type query(Predicates const& predicates, OutIter out_it,
+                    nearest_query_context<rtree, Geometry> & context) const
     {
-        return const_query_iterator();
-    }
+        typedef typename nearest_query_context<rtree, Geometry>::buffers_type buffers_type;
+        typedef detail::rtree::visitors::distance_query<members_holder, Predicates> distance_query_type;
 
-private:
-    template <typename Predicates>
-    using query_iterator_t = std::conditional_t
-        <
-            detail::predicates_count_distance<Predicates>::value == 0,
-            detail::rtree::iterators::spatial_query_iterator<members_holder, Predicates>,
-            detail::rtree::iterators::distance_query_iterator<members_holder, Predicates>
-        >;
+        BOOST_GEOMETRY_STATIC_ASSERT((detail::predicates_count_distance<Predicates>::value == 1),
+                                     "Exactly one distance predicate has to be passed.",
+                                     Predicates);
+        BOOST_GEOMETRY_STATIC_ASSERT((std::is_same<buffers_type, typename distance_query_type::buffers_type>::value),
+                                     "The context created for different Geometry.",
+                                     Predicates, Geometry);
+
+        if ( ! m_members.root )
+        {
+            return 0;
+        }
+
+        distance_query_type distance_v(m_members, predicates, context.m_buffers);
+        return distance_v.apply(m_members, out_it);
+    }
 
-#ifdef BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL_ITERATORS
-public:
-#else
-private:
-#endif
     /*!
-    \brief Returns a query iterator pointing at the begin of the query range.
+    \brief Finds values meeting passed predicates for many queries at once.
 
-    This method returns an iterator which may be used to perform iterative queries.
-    For the information about predicates which may be passed to this method see query().
+    This query function performs many searches at once. For each value meeting
+    the predicates of a query a pair containing the index of the predicates in
+    the range and the value is returned.
 
-    The type of the returned iterator depends on the type of passed Predicates but the iterator of this type
-    may be assigned to the variable of const_query_iterator type. If you'd like to use the type of the iterator
-    returned by this method you may get the type e.g. by using C++11 decltype or Boost.Typeof library.
-    This iterator may be compared with iterators returned by both versions of qend() method.
+    In the case of spatial predicates the queries are performed in one traversal
+    of the tree. Each node is visited only once for all of the queries which
+    predicates are met by the node. The pairs are not returned in any particular
+    order. In particular they are not grouped by the queries.
+
+    In the case of predicates containing \c nearest() predicate the queries are
+    performed one after another reusing the same buffers. The pairs are grouped
+    by the queries and returned in the order of the predicates.
 
     \par Example
     \verbatim
-    // Store the result in the container using std::copy() - it requires both iterators of the same type
-    std::copy(tree.qbegin_(bgi::intersects(box)), tree.qend_(bgi::intersects(box)), std::back_inserter(result));
+    std::vector<decltype(bgi::intersects(box))> predicates;
+    for ( ... )
+        predicates.push_back(bgi::intersects(box));
+    std::vector<std::pair<size_type, Value>> result;
+    tree.batch_query(predicates, std::back_inserter(result));
+    \endverbatim
 
-    // Store the result in the container using std::copy() and type-erased iterators
-    Rtree::const_query_iterator first = tree.qbegin_(bgi::intersects(box));
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If memory allocation throws.
+
+    \param predicates   The random access range of predicates.
+    \param out_it       The output iterator of std::pair<size_type, value_type>,
+                        e.g. generated by std::back_inserter().
+
+    \return             The number of pairs returned.
+    */
+    template <typename PredicatesRange, typename OutIter>
+    size_type batch_query(PredicatesRange const& predicates, OutIter out_it) const
+    {
+        return m_members.root
+             ? batch_query_dispatch(predicates, out_it, detail::rtree::no_query_statistics())
+             : 0;
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates for many queries at once gathering
+           the statistics of the queries.
+
+    This query function performs the queries in the same way as batch_query() without
+    the executor and additionally counts the visited nodes, the checks of the predicates,
+    the branches which were not traversed and the sizes of the queues of the k-nearest
+    neighbors queries. The counters are not reset.
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If memory allocation throws.
+
+    \param predicates   The random access range of predicates.
+    \param out_it       The output iterator of std::pair<size_type, value_type>,
+                        e.g. generated by std::back_inserter().
+    \param stats        The statistics object which counters are incremented.
+
+    \return             The number of pairs returned.
+    */
+    template <typename PredicatesRange, typename OutIter>
+    size_type batch_query(PredicatesRange const& predicates, OutIter out_it,
+                          query_statistics & stats) const
+    {
+        return m_members.root
+             ? batch_query_dispatch(predicates, out_it,
+                                    detail::rtree::query_statistics_collector(stats))
+             : 0;
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates for many queries at once, in parallel.
+
+    This query function performs the queries in the same way as the serial version
+    but the range of predicates is divided into parts which are processed concurrently
+    with the executor. Each part uses its own buffers. The pairs are returned in the
+    same order as in the case of the serial version performed for each part
+    separately and the parts are returned in the order of the predicates. If the
+    executor can't run tasks concurrently the serial version is used.
+
+    \par Example
+    \verbatim
+    std::vector<decltype(bgi::nearest(pt, 5))> predicates;
+    for ( ... )
+        predicates.push_back(bgi::nearest(pt, 5));
+    std::vector<std::pair<size_type, Value>> result;
+    tree.batch_query(predicates, std::back_inserter(result), bg::util::thread_executor());
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If memory allocation throws.
+
+    \param predicates   The random access range of predicates.
+    \param out_it       The output iterator of std::pair<size_type, value_type>,
+                        e.g. generated by std::back_inserter().
+    \param executor     The executor, e.g. boost::geometry::util::thread_executor.
+
+    \return             The number of pairs returned.
+    */
+    template <typename PredicatesRange, typename OutIter, typename Executor>
+    size_type batch_query(PredicatesRange const& predicates, OutIter out_it,
+                          Executor const& executor) const
+    {
+        typedef typename ::boost::range_iterator<PredicatesRange const>::type predicates_iterator;
+        typedef typename std::iterator_traits<predicates_iterator>::value_type predicates_type;
+
+        BOOST_GEOMETRY_STATIC_ASSERT((detail::predicates_count_distance<predicates_type>::value <= 1),
+                                     "Only one distance predicate can be passed.",
+                                     predicates_type);
+
+        if ( ! m_members.root )
+        {
+            return 0;
+        }
+
+        size_type const count = size_type(::boost::size(predicates));
+
+        // the number of parts processed concurrently, more than the concurrency to balance the work
+        size_type const concurrency = size_type(executor.concurrency());
+        size_type const parts_count = concurrency > 1
+                                    ? (std::min)(count, size_type(concurrency * 4))
+                                    : 1;
+        if ( parts_count <= 1 )
+        {
+            return batch_query_dispatch(predicates, out_it,
+                                        detail::rtree::no_query_statistics());                          // MAY THROW
+        }
+
+        typedef typename std::conditional
+            <
+                (detail::predicates_count_distance<predicates_type>::value == 0),
+                detail::rtree::visitors::batch_spatial_query
+                    <
+                        members_holder, predicates_iterator, batch_query_output_iterator
+                    >,
+                detail::rtree::visitors::batch_distance_query
+                    <
+                        members_holder, predicates_iterator, batch_query_output_iterator
+                    >
+            >::type batch_query_part_type;
+
+        predicates_iterator const first = ::boost::begin(predicates);
+
+        std::vector<batch_query_results> results(parts_count);                                     // MAY THROW (A)
+        executor(parts_count, [&](std::size_t part)
+        {
+            size_type const part_first = count * part / parts_count;
+            size_type const part_last = count * (part + 1) / parts_count;
+            batch_query_part_type query(m_members, first, count, std::back_inserter(results[part]));
+            query.apply(m_members, part_first, part_last);                                         // MAY THROW
+        });
+
+        size_type found_count = 0;
+        for (batch_query_results const& part_results : results)
+        {
+            for (batch_query_result const& r : part_results)
+            {
+                *out_it = r;
+                ++out_it;
+            }
+            found_count += part_results.size();
+        }
+        return found_count;
+    }
+
+    /*!
+    \brief Finds pairs of values of this and other rtree which indexables intersect.
+
+    This function performs the spatial join of two rtrees. Both trees are traversed
+    at the same time and only the pairs of nodes which boxes intersect are visited.
+    For each pair of values which indexables intersect and which meet the binary
+    predicate a std::pair containing the value of this rtree and the value of the
+    other rtree is returned.
+
+    \par Example
+    \verbatim
+    std::vector<std::pair<Parcel, Zone>> result;
+    parcels.join(zones, [](Parcel const& p, Zone const& z) { return area_within(p, z) > 0.5; },
+                 std::back_inserter(result));
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If the predicate throws.
+
+    \param other        The other rtree.
+    \param pred         The binary predicate called for values of this and other rtree.
+    \param out_it       The output iterator of std::pair<value_type, Rtree::value_type>,
+                        e.g. generated by std::back_inserter().
+
+    \return             The number of pairs returned.
+    */
+    template <typename Rtree, typename BinaryPredicate, typename OutIter>
+    size_type join(Rtree const& other, BinaryPredicate const& pred, OutIter out_it) const
+    {
+        detail::rtree::visitors::spatial_join
+            <
+                members_holder, typename Rtree::members_holder, BinaryPredicate
+            > join_v(m_members, bounds(), other.m_members, other.bounds(), pred);
+        return join_v.apply(out_it);
+    }
+
+    /*!
+    \brief Finds pairs of values of this and other rtree which indexables intersect, in parallel.
+
+    This function performs the spatial join in the same way as the serial version
+    but the pairs of subtrees are joined concurrently with the executor.
+    The pairs are returned in the same order as in the case of the serial version.
+
+    \par Example
+    \verbatim
+    parcels.join(zones, pred, std::back_inserter(result), bg::util::thread_executor());
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If the predicate throws.
+    If memory allocation throws.
+
+    \warning
+    The predicate may be called concurrently from different threads.
+
+    \param other        The other rtree.
+    \param pred         The binary predicate called for values of this and other rtree.
+    \param out_it       The output iterator of std::pair<value_type, Rtree::value_type>.
+    \param executor     The executor, e.g. boost::geometry::util::thread_executor.
+
+    \return             The number of pairs returned.
+    */
+    template <typename Rtree, typename BinaryPredicate, typename OutIter, typename Executor>
+    size_type join(Rtree const& other, BinaryPredicate const& pred, OutIter out_it,
+                   Executor const& executor) const
+    {
+        detail::rtree::visitors::spatial_join
+            <
+                members_holder, typename Rtree::members_holder, BinaryPredicate
+            > join_v(m_members, bounds(), other.m_members, other.bounds(), pred);
+        return join_v.apply(out_it, executor);
+    }
+
+    /*!
+    \brief Returns a query iterator pointing at the begin of the query range.
+
+    This method returns an iterator which may be used to perform iterative queries.
+    For the information about predicates which may be passed to this method see query().
+
+    \par Example
+    \verbatim
+    for ( Rtree::const_query_iterator it = tree.qbegin(bgi::nearest(pt, 10000)) ;
+          it != tree.qend() ; ++it )
+    {
+        // do something with value
+        if ( has_enough_nearest_values() )
+            break;
+    }
+
+    // C++11 (auto)
+    for ( auto it = tree.qbegin(bgi::nearest(pt, 3)) ; it != tree.qend() ; ++it )
+    {
+        // do something with value
+    }
+
+    // C++14 (generic lambda expression)
+    std::for_each(tree.qbegin(bgi::nearest(pt, 3)), tree.qend(), [](auto const& val){
+        // do something with value
+    });
+    \endverbatim
+
+    \par Iterator category
+    ForwardIterator
+
+    \par Throws
+    If predicates copy throws.
+    If allocation throws.
+
+    \warning
+    The modification of the rtree may invalidate the iterators.
+
+    \param predicates   Predicates.
+
+    \return             The iterator pointing at the begin of the query range.
+    */
+    template <typename Predicates>
+    const_query_iterator qbegin(Predicates const& predicates) const
+    {
+        return const_query_iterator(qbegin_(predicates));
+    }
+
+    /*!
+    \brief Returns a query iterator pointing at the end of the query range.
+
+    This method returns an iterator which may be used to check if the query has ended.
+
+    \par Example
+    \verbatim
+    for ( Rtree::const_query_iterator it = tree.qbegin(bgi::nearest(pt, 10000)) ;
+          it != tree.qend() ; ++it )
+    {
+        // do something with value
+        if ( has_enough_nearest_values() )
+            break;
+    }
+
+    // C++11 (auto)
+    for ( auto it = tree.qbegin(bgi::nearest(pt, 3)) ; it != tree.qend() ; ++it )
+    {
+        // do something with value
+    }
+
+    // C++14 (generic lambda expression)
+    std::for_each(tree.qbegin(bgi::nearest(pt, 3)), tree.qend(), [](auto const& val){
+        // do something with value
+    });
+    \endverbatim
+
+    \par Iterator category
+    ForwardIterator
+
+    \par Throws
+    Nothing
+
+    \warning
+    The modification of the rtree may invalidate the iterators.
+
+    \return             The iterator pointing at the end of the query range.
+    */
+    const_query_iterator qend() const
+    {
+        return const_query_iterator();
+    }
+
+    /*!
+    \brief Returns the iterator returning the nearest values one by one, pointing at the begin of the query range.
+
+    This method returns the iterator which may be used to perform the incremental k-nearest neighbors query,
+    e.g. in order to find the nearest values meeting some condition which can't be expressed with predicates.
+    Exactly one distance predicate has to be passed, it may be combined with spatial predicates in the same
+    way as in the case of query(). The values are returned in the order of increasing distance.
+
+    Unlike the type-erased const_query_iterator returned by qbegin() the type of the returned iterator depends
+    on the type of passed Predicates. It isn't allocated on the heap, the incrementation isn't virtual and the
+    iterator gives access to the distance of the current value. The memory for the internal queues is reserved
+    when the iterator is created.
+
+    \par Example
+    \verbatim
+    for ( auto it = tree.nearest_qbegin(bgi::nearest(pt, 10000)) ; it != tree.nearest_qend() ; ++it )
+    {
+        // stop when the values are too far
+        if ( it.distance() > max_distance )
+            break;
+        // the distance used internally, e.g. squared distance for points
+        do_something(*it, it.comparable_distance());
+    }
+    \endverbatim
+
+    \par Iterator category
+    ForwardIterator
+
+    \par Throws
+    If predicates copy throws.
+    If allocation throws.
+
+    \warning
+    The modification of the rtree may invalidate the iterators.
+
+    \param predicates   Predicates.
+
+    \return             The iterator pointing at the nearest value.
+    */
+    template <typename Predicates>
+    detail::rtree::iterators::distance_query_iterator<members_holder, Predicates>
+    nearest_qbegin(Predicates const& predicates) const
+    {
+        BOOST_GEOMETRY_STATIC_ASSERT((detail::predicates_count_distance<Predicates>::value == 1),
+            "Exactly one distance predicate has to be passed.",
+            Predicates);
+
+        typedef detail::rtree::iterators::distance_query_iterator<members_holder, Predicates> iterator_type;
+
+        return m_members.root
+             ? iterator_type(m_members, predicates)
+             : iterator_type(predicates);
+    }
+
+    /*!
+    \brief Returns the iterator pointing at the end of the range returned by nearest_qbegin().
+
+    \par Throws
+    Nothing
+
+    \return             The iterator pointing at the end of the query range.
+    */
+    detail::rtree::iterators::end_query_iterator<value_type, allocators_type>
+    nearest_qend() const
+    {
+        return detail::rtree::iterators::end_query_iterator<value_type, allocators_type>();
+    }
+
+private:
+    template <typename Predicates>
+    using query_iterator_t = std::conditional_t
+        <
+            detail::predicates_count_distance<Predicates>::value == 0,
+            detail::rtree::iterators::spatial_query_iterator<members_holder, Predicates>,
+            detail::rtree::iterators::distance_query_iterator<members_holder, Predicates>
+        >;
+
+#ifdef BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL_ITERATORS
+public:
+#else
+private:
+#endif
+    /*!
+    \brief Returns a query iterator pointing at the begin of the query range.
+
+    This method returns an iterator which may be used to perform iterative queries.
+    For the information about predicates which may be passed to this method see query().
+
+    The type of the returned iterator depends on the type of passed Predicates but the iterator of this type
+    may be assigned to the variable of const_query_iterator type. If you'd like to use the type of the iterator
+    returned by this method you may get the type e.g. by using C++11 decltype or Boost.Typeof library.
+    This iterator may be compared with iterators returned by both versions of qend() method.
+
+    \par Example
+    \verbatim
+    // Store the result in the container using std::copy() - it requires both iterators of the same type
+    std::copy(tree.qbegin_(bgi::intersects(box)), tree.qend_(bgi::intersects(box)), std::back_inserter(result));
+
+    // Store the result in the container using std::copy() and type-erased iterators
+    Rtree::const_query_iterator first = tree.qbegin_(bgi::intersects(box));
     Rtree::const_query_iterator last = tree.qend_();
     std::copy(first, last, std::back_inserter(result));
 
@@ -1502,7 +2130,62 @@ public:
             detail::rtree::apply_visitor(box_v, *m_members.root);
         }
 
-        return result;
+        return result;
+    }
+
+    /*!
+    \brief Returns the aggregate of the Values which Indexables intersect the box.
+
+    The aggregates of the nodes are stored in the rtree created with
+    index::aggregated parameters. The aggregates of the nodes covered by the box
+    are combined without traversing them so only the nodes intersecting the
+    boundary of the box are visited.
+
+    \param box     The box.
+
+    \return         The aggregate or the identity of the aggregate if there are no such Values.
+
+    \par Throws
+    If the aggregate throws.
+    */
+    template <typename Box>
+    inline aggregate_result_type aggregate(Box const& box) const
+    {
+        typedef detail::rtree::aggregate_traits<parameters_type> traits;
+        BOOST_GEOMETRY_STATIC_ASSERT((traits::enabled),
+            "The rtree has to be created with index::aggregated parameters.",
+            parameters_type);
+
+        detail::rtree::visitors::aggregate_query
+            <
+                members_holder, Box
+            > aggregate_v(box, m_members.parameters(), m_members.translator());
+
+        if ( m_members.root )
+            detail::rtree::apply_visitor(aggregate_v, *m_members.root);
+
+        return aggregate_v.result;
+    }
+
+    /*!
+    \brief Returns the aggregate of all Values stored in the container.
+
+    \return         The aggregate or the identity of the aggregate if the container is empty.
+
+    \par Throws
+    If the aggregate throws.
+    */
+    inline aggregate_result_type aggregate() const
+    {
+        typedef detail::rtree::aggregate_traits<parameters_type> traits;
+        BOOST_GEOMETRY_STATIC_ASSERT((traits::enabled),
+            "The rtree has to be created with index::aggregated parameters.",
+            parameters_type);
+
+        if ( !m_members.root )
+            return traits::get(m_members.parameters()).identity();
+
+        return detail::rtree::get_aggregate<members_holder>::apply(*m_members.root);
     }
 
     /*!
@@ -1708,6 +2391,94 @@ private:
         return 0;
     }
 
+    /*!
+    \brief Insert the values to the index at once.
+
+    \param values   The values which will be stored in the container.
+
+    \par Exception-safety
+    nothrow (memory leaks)
+    */
+    inline void raw_bulk_insert(values_type const& values)
+    {
+        if ( values.empty() )
+            return;
+
+        // repack the whole tree if it's small in comparison to the number of new values
+        if ( !m_members.root || m_members.values_count <= values.size() )
+        {
+            values_type all_values;
+            all_values.reserve(m_members.values_count + values.size());                            // MAY THROW (E: alloc)
+            all_values.insert(all_values.end(), this->begin(), this->end());                       // MAY THROW (V, E: alloc, copy)
+            all_values.insert(all_values.end(), values.begin(), values.end());                     // MAY THROW (V, E: alloc, copy)
+
+            typedef detail::rtree::pack_dispatch<members_holder, index::default_packing> pack;
+            size_type vc = 0, ll = 0;
+            node_pointer new_root = pack::apply(all_values.begin(), all_values.end(), vc, ll, m_members,
+                                                index::default_packing(),
+                                                boost::container::new_allocator<void>());          // MAY THROW (V, E: alloc, copy, N: alloc)
+
+            if ( m_members.root )
+                detail::rtree::visitors::destroy<members_holder>::apply(m_members.root, m_members.allocators());
+
+            m_members.root = new_root;
+            m_members.values_count = vc;
+            m_members.leafs_level = ll;
+            return;
+        }
+
+        detail::rtree::visitors::bulk_insert<members_holder>
+            insert_v(m_members.root, m_members.leafs_level, values,
+                     m_members.parameters(), m_members.translator(), m_members.allocators());
+
+        BOOST_TRY
+        {
+            detail::rtree::apply_visitor(insert_v, *m_members.root);                               // MAY THROW (V, E: alloc, copy, N: alloc)
+        }
+        BOOST_CATCH(...)
+        {
+            // the whole tree is destroyed if the exception is thrown while the root is created
+            if ( !m_members.root )
+            {
+                m_members.values_count = 0;
+                m_members.leafs_level = 0;
+            }
+            BOOST_RETHROW                                                                           // RETHROW
+        }
+        BOOST_CATCH_END
+
+        // If exception is thrown, m_values_count may be invalid
+        m_members.values_count += values.size();
+    }
+
+    /*!
+    \brief Remove the values from the container at once.
+
+    \param values   The values which will be removed from the container.
+
+    \par Exception-safety
+    nothrow (memory leaks)
+    */
+    inline size_type raw_bulk_remove(values_type const& values)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(m_members.root, "The root must exist");
+
+        if ( values.empty() )
+            return 0;
+
+        detail::rtree::visitors::bulk_remove<members_holder>
+            remove_v(m_members.root, m_members.leafs_level, values,
+                     m_members.parameters(), m_members.translator(), m_members.allocators());
+
+        detail::rtree::apply_visitor(remove_v, *m_members.root);                                   // MAY THROW (V, E: alloc, copy, N: alloc)
+
+        // If exception is thrown, m_values_count may be invalid
+        BOOST_GEOMETRY_INDEX_ASSERT(remove_v.removed_count() <= m_members.values_count, "unexpected state");
+        m_members.values_count -= remove_v.removed_count();
+
+        return remove_v.removed_count();
+    }
+
     /*!
     \brief Create an empty R-tree i.e. new empty root node and clear other attributes.
 
@@ -1719,6 +2490,8 @@ private:
         BOOST_GEOMETRY_INDEX_ASSERT(0 == m_members.root, "the tree is already created");
 
         m_members.root = detail::rtree::create_node<allocators_type, leaf>::apply(m_members.allocators()); // MAY THROW (N: alloc)
+        detail::rtree::update_aggregate<members_holder>
+            ::apply(detail::rtree::get<leaf>(*m_members.root), m_members.parameters());
         m_members.values_count = 0;
         m_members.leafs_level = 0;
     }
@@ -1849,6 +2622,10 @@ private:
         return result;
     }
 
+    typedef std::pair<size_type, value_type> batch_query_result;
+    typedef std::vector<batch_query_result> batch_query_results;
+    typedef std::back_insert_iterator<batch_query_results> batch_query_output_iterator;
+
     /*!
     \brief Return values meeting predicates.
 
@@ -1857,13 +2634,13 @@ private:
     */
     template
     <
-        typename Predicates, typename OutIter,
+        typename Predicates, typename OutIter, typename Statistics,
         std::enable_if_t<(detail::predicates_count_distance<Predicates>::value == 0), int> = 0
     >
-    size_type query_dispatch(Predicates const& predicates, OutIter out_it) const
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, Statistics const& stats) const
     {
-        detail::rtree::visitors::spatial_query<members_holder, Predicates, OutIter>
-            query(m_members, predicates, out_it);
+        detail::rtree::visitors::spatial_query<members_holder, Predicates, OutIter, Statistics>
+            query(m_members, predicates, out_it, stats);
         return query.apply(m_members);
     }
 
@@ -1875,21 +2652,59 @@ private:
     */
     template
     <
-        typename Predicates, typename OutIter,
+        typename Predicates, typename OutIter, typename Statistics,
         std::enable_if_t<(detail::predicates_count_distance<Predicates>::value > 0), int> = 0
     >
-    size_type query_dispatch(Predicates const& predicates, OutIter out_it) const
+    size_type query_dispatch(Predicates const& predicates, OutIter out_it, Statistics const& stats) const
     {
         BOOST_GEOMETRY_STATIC_ASSERT((detail::predicates_count_distance<Predicates>::value == 1),
                                      "Only one distance predicate can be passed.",
                                      Predicates);
 
-        detail::rtree::visitors::distance_query<members_holder, Predicates>
-            distance_v(m_members, predicates);
+        detail::rtree::visitors::distance_query<members_holder, Predicates, Statistics>
+            distance_v(m_members, predicates, stats);
 
         return distance_v.apply(m_members, out_it);
     }
 
+    /*!
+    \brief Perform many queries at once, in one traversal of the tree in the case of
+           spatial queries.
+
+    \par Exception-safety
+    strong
+    */
+    template <typename PredicatesRange, typename OutIter, typename Statistics>
+    size_type batch_query_dispatch(PredicatesRange const& predicates, OutIter out_it,
+                                   Statistics const& stats) const
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(m_members.root, "The root must exist");
+
+        typedef typename ::boost::range_iterator<PredicatesRange const>::type predicates_iterator;
+        typedef typename std::iterator_traits<predicates_iterator>::value_type predicates_type;
+
+        BOOST_GEOMETRY_STATIC_ASSERT((detail::predicates_count_distance<predicates_type>::value <= 1),
+                                     "Only one distance predicate can be passed.",
+                                     predicates_type);
+
+        typedef typename std::conditional
+            <
+                (detail::predicates_count_distance<predicates_type>::value == 0),
+                detail::rtree::visitors::batch_spatial_query
+                    <
+                        members_holder, predicates_iterator, OutIter, Statistics
+                    >,
+                detail::rtree::visitors::batch_distance_query
+                    <
+                        members_holder, predicates_iterator, OutIter, Statistics
+                    >
+            >::type batch_query_type;
+
+        batch_query_type query(m_members, ::boost::begin(predicates),
+                               size_type(::boost::size(predicates)), out_it, stats);
+        return query.apply(m_members);                                                             // MAY THROW
+    }
+
     /*!
     \brief Count elements corresponding to value or indexable.
 
@@ -1929,11 +2744,28 @@ private:
     template<typename Iterator, typename PackAlloc>
     inline void pack_construct(Iterator first, Iterator last, PackAlloc const& temp_allocator)
     {
-        typedef detail::rtree::pack<members_holder> pack;
+        pack_construct(first, last, index::default_packing(), temp_allocator);
+    }
+
+    /*!
+    \brief Create the tree using the packing algorithm.
+
+    \param first             The beginning of the range of Values.
+    \param last              The end of the range of Values.
+    \param packing           The packing algorithm.
+    \param temp_allocator    The temporary allocator object to be used by the packing algorithm.
+
+    \par Throws
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Iterator, typename Packing, typename PackAlloc>
+    inline void pack_construct(Iterator first, Iterator last, Packing const& packing,
+                               PackAlloc const& temp_allocator)
+    {
+        typedef detail::rtree::pack_dispatch<members_holder, Packing> pack;
         size_type vc = 0, ll = 0;
-        m_members.root = pack::apply(first, last, vc, ll,
-                                     m_members.parameters(), m_members.translator(),
-                                     m_members.allocators(), temp_allocator);
+        m_members.root = pack::apply(first, last, vc, ll, m_members, packing, temp_allocator);
         m_members.values_count = vc;
         m_members.leafs_level = ll;
     }
@@ -2071,6 +2903,86 @@ remove(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> & tree,
     return tree.remove(conv_or_rng);
 }
 
+/*!
+\brief Insert a range of values to the index at once.
+
+It calls <tt>rtree::bulk_insert(Iterator, Iterator)</tt>.
+
+\ingroup rtree_functions
+
+\param tree     The spatial index.
+\param first    The beginning of the range of values.
+\param last     The end of the range of values.
+*/
+template<typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+         typename Iterator>
+inline void bulk_insert(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> & tree,
+                        Iterator first, Iterator last)
+{
+    tree.bulk_insert(first, last);
+}
+
+/*!
+\brief Insert a range of values to the index at once.
+
+It calls <tt>rtree::bulk_insert(Range const&)</tt>.
+
+\ingroup rtree_functions
+
+\param tree     The spatial index.
+\param rng      The range of values.
+*/
+template<typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+         typename Range>
+inline void bulk_insert(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> & tree,
+                        Range const& rng)
+{
+    tree.bulk_insert(rng);
+}
+
+/*!
+\brief Remove a range of values from the container at once.
+
+It calls <tt>rtree::bulk_remove(Iterator, Iterator)</tt>.
+
+\ingroup rtree_functions
+
+\param tree     The spatial index.
+\param first    The beginning of the range of values.
+\param last     The end of the range of values.
+
+\return         The number of removed values.
+*/
+template<typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+         typename Iterator>
+inline typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+bulk_remove(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> & tree,
+            Iterator first, Iterator last)
+{
+    return tree.bulk_remove(first, last);
+}
+
+/*!
+\brief Remove a range of values from the container at once.
+
+It calls <tt>rtree::bulk_remove(Range const&)</tt>.
+
+\ingroup rtree_functions
+
+\param tree     The spatial index.
+\param rng      The range of values.
+
+\return         The number of removed values.
+*/
+template<typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+         typename Range>
+inline typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+bulk_remove(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> & tree,
+            Range const& rng)
+{
+    return tree.bulk_remove(rng);
+}
+
 /*!
 \brief Finds values meeting passed predicates e.g. nearest to some Point and/or intersecting some Box.
 
@@ -2154,6 +3066,185 @@ query(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
     return tree.query(predicates, out_it);
 }
 
+/*!
+\brief Finds values meeting passed predicates for many queries at once.
+
+For each value meeting the predicates of a query a pair containing the index of
+the predicates in the range and the value is returned. The spatial queries are
+performed in one traversal of the tree and the pairs are not returned in any
+particular order. The k-nearest neighbor queries reuse the same buffers and the
+pairs are returned in the order of the predicates.
+
+\par Example
+\verbatim
+std::vector<std::pair<std::size_t, Value>> result;
+bgi::batch_query(tree, predicates, std::back_inserter(result));
+\endverbatim
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+If memory allocation throws.
+
+\ingroup rtree_functions
+
+\param tree         The rtree.
+\param predicates   The random access range of predicates.
+\param out_it       The output iterator of std::pair<size_type, value_type>.
+
+\return             The number of pairs returned.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename PredicatesRange, typename OutIter> inline
+typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+batch_query(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+            PredicatesRange const& predicates,
+            OutIter out_it)
+{
+    return tree.batch_query(predicates, out_it);
+}
+
+/*!
+\brief Finds values meeting passed predicates for many queries at once, in parallel.
+
+The range of predicates is divided into parts which are processed concurrently with
+the executor. For each value meeting the predicates of a query a pair containing the
+index of the predicates in the range and the value is returned.
+
+\par Example
+\verbatim
+std::vector<std::pair<std::size_t, Value>> result;
+bgi::batch_query(tree, predicates, std::back_inserter(result), bg::util::thread_executor());
+\endverbatim
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+If memory allocation throws.
+
+\ingroup rtree_functions
+
+\param tree         The rtree.
+\param predicates   The random access range of predicates.
+\param out_it       The output iterator of std::pair<size_type, value_type>.
+\param executor     The executor, e.g. boost::geometry::util::thread_executor.
+
+\return             The number of pairs returned.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename PredicatesRange, typename OutIter, typename Executor> inline
+typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+batch_query(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+            PredicatesRange const& predicates,
+            OutIter out_it,
+            Executor const& executor)
+{
+    return tree.batch_query(predicates, out_it, executor);
+}
+
+/*!
+\brief Finds pairs of values of two rtrees which indexables intersect.
+
+This function performs the spatial join of two rtrees. Both trees are traversed at
+the same time and only the pairs of nodes which boxes intersect are visited. For each
+pair of values which indexables intersect a std::pair containing the value of the first
+and the value of the second rtree is returned.
+
+\par Example
+\verbatim
+std::vector<std::pair<Parcel, Zone>> result;
+bgi::join(parcels, zones, std::back_inserter(result));
+\endverbatim
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+
+\ingroup rtree_functions
+
+\param tree1        The first rtree.
+\param tree2        The second rtree.
+\param out_it       The output iterator of std::pair of values.
+
+\return             The number of pairs returned.
+*/
+template <typename Value1, typename Parameters1, typename IndexableGetter1, typename EqualTo1, typename Allocator1,
+          typename Value2, typename Parameters2, typename IndexableGetter2, typename EqualTo2, typename Allocator2,
+          typename OutIter> inline
+typename rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1>::size_type
+join(rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1> const& tree1,
+     rtree<Value2, Parameters2, IndexableGetter2, EqualTo2, Allocator2> const& tree2,
+     OutIter out_it)
+{
+    return tree1.join(tree2, detail::rtree::visitors::join_always_true(), out_it);
+}
+
+/*!
+\brief Finds pairs of values of two rtrees which indexables intersect and which meet the predicate.
+
+For each pair of values which indexables intersect the binary predicate is called
+and if it returns true a std::pair containing the value of the first and the value
+of the second rtree is returned.
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+If the predicate throws.
+
+\ingroup rtree_functions
+
+\param tree1        The first rtree.
+\param tree2        The second rtree.
+\param pred         The binary predicate called for values of the first and second rtree.
+\param out_it       The output iterator of std::pair of values.
+
+\return             The number of pairs returned.
+*/
+template <typename Value1, typename Parameters1, typename IndexableGetter1, typename EqualTo1, typename Allocator1,
+          typename Value2, typename Parameters2, typename IndexableGetter2, typename EqualTo2, typename Allocator2,
+          typename BinaryPredicate, typename OutIter> inline
+typename rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1>::size_type
+join(rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1> const& tree1,
+     rtree<Value2, Parameters2, IndexableGetter2, EqualTo2, Allocator2> const& tree2,
+     BinaryPredicate const& pred,
+     OutIter out_it)
+{
+    return tree1.join(tree2, pred, out_it);
+}
+
+/*!
+\brief Finds pairs of values of two rtrees which indexables intersect and which meet the predicate, in parallel.
+
+The pairs of subtrees are joined concurrently with the executor. The pairs of values
+are returned in the same order as in the case of the serial version.
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+If the predicate throws.
+If memory allocation throws.
+
+\warning
+The predicate may be called concurrently from different threads.
+
+\ingroup rtree_functions
+
+\param tree1        The first rtree.
+\param tree2        The second rtree.
+\param pred         The binary predicate called for values of the first and second rtree.
+\param out_it       The output iterator of std::pair of values.
+\param executor     The executor, e.g. boost::geometry::util::thread_executor.
+
+\return             The number of pairs returned.
+*/
+template <typename Value1, typename Parameters1, typename IndexableGetter1, typename EqualTo1, typename Allocator1,
+          typename Value2, typename Parameters2, typename IndexableGetter2, typename EqualTo2, typename Allocator2,
+          typename BinaryPredicate, typename OutIter, typename Executor> inline
+typename rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1>::size_type
+join(rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1> const& tree1,
+     rtree<Value2, Parameters2, IndexableGetter2, EqualTo2, Allocator2> const& tree2,
+     BinaryPredicate const& pred,
+     OutIter out_it,
+     Executor const& executor)
+{
+    return tree1.join(tree2, pred, out_it, executor);
+}
+
 /*!
 \brief Returns the query iterator pointing at the begin of the query range.
 
@@ -2371,6 +3462,77 @@ inline void swap(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> &
     return l.swap(r);
 }
 
+/*!
+\brief The context of the k-nearest neighbor queries.
+
+The context keeps the memory allocated by the k-nearest neighbor query so it
+can be reused by the subsequent queries. It may be used with the queries of
+the rtree of type Rtree containing \c nearest() predicate created for the
+Geometry of type Geometry. The context may be used by one query at a time so
+each thread should use its own context.
+
+\par Example
+\verbatim
+bgi::nearest_query_context<Rtree, Point> context;
+tree.query(bgi::nearest(pt, 5), std::back_inserter(result), context);
+\endverbatim
+
+\tparam Rtree       The type of the rtree.
+\tparam Geometry    The type of Geometry passed to \c nearest() predicate.
+*/
+template <typename Rtree, typename Geometry>
+class nearest_query_context
+{
+    typedef typename detail::rtree::utilities::view<Rtree>::members_holder members_holder;
+    typedef detail::rtree::visitors::distance_query_buffers
+        <
+            members_holder, detail::predicates::nearest<Geometry>
+        > buffers_type;
+
+    template <typename V, typename P, typename I, typename E, typename A>
+    friend class rtree;
+
+public:
+    /*!
+    \brief Releases the memory kept by the context.
+
+    \par Throws
+    Nothing.
+    */
+    void clear()
+    {
+        m_buffers = buffers_type();
+    }
+
+private:
+    buffers_type m_buffers;
+};
+
+/*!
+\brief Finds values meeting passed predicates using the buffers of the context.
+
+It calls \c rtree::query(Predicates const&, OutIter, nearest_query_context<Rtree, Geometry> &).
+
+\ingroup rtree_functions
+
+\param tree         The rtree.
+\param predicates   Predicates containing \c nearest() predicate.
+\param out_it       The output iterator, e.g. generated by std::back_inserter().
+\param context      The context which may be used by one query at a time.
+
+\return             The number of values found.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Predicates, typename OutIter, typename Geometry> inline
+typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+query(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+      Predicates const& predicates,
+      OutIter out_it,
+      nearest_query_context<rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>, Geometry> & context)
+{
+    return tree.query(predicates, out_it, context);
+}
+
 }}} // namespace boost::geometry::index
 
 // Boost.Range adaptation
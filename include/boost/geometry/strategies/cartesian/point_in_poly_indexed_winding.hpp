@@ -0,0 +1,201 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_STRATEGY_CARTESIAN_POINT_IN_POLY_INDEXED_WINDING_HPP
+#define BOOST_GEOMETRY_STRATEGY_CARTESIAN_POINT_IN_POLY_INDEXED_WINDING_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <boost/geometry/algorithms/detail/within/point_in_geometry.hpp>
+#include <boost/geometry/algorithms/detail/within/winding_slab_index.hpp>
+
+#include <boost/geometry/core/coordinate_type.hpp>
+
+#include <boost/geometry/strategies/cartesian/point_in_poly_winding.hpp>
+#include <boost/geometry/strategies/relate/cartesian.hpp>
+
+#include <boost/geometry/views/detail/closed_clockwise_view.hpp>
+
+namespace boost { namespace geometry
+{
+
+namespace strategy { namespace within
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail
+{
+
+// The index of a ring and the address of this ring
+struct winding_ring_index
+{
+    template <typename Ring>
+    winding_ring_index(Ring const& ring, double epsilon,
+                       std::size_t segments_per_slab)
+        : ring(std::addressof(ring))
+        , index(ring, epsilon, segments_per_slab)
+    {}
+
+    void const* ring;
+    geometry::detail::within::winding_slab_index index;
+};
+
+struct winding_ring_index_less
+{
+    inline bool operator()(winding_ring_index const& index, void const* ring) const
+    {
+        return std::less<void const*>()(index.ring, ring);
+    }
+
+    inline bool operator()(winding_ring_index const& index1,
+                           winding_ring_index const& index2) const
+    {
+        return std::less<void const*>()(index1.ring, index2.ring);
+    }
+};
+
+} // namespace detail
+#endif // DOXYGEN_NO_DETAIL
+
+/*!
+\brief Within detection using winding rule in cartesian coordinate system,
+    accelerated by an index of the segments of the rings of a geometry.
+\ingroup strategies
+\details The index is built once in the constructor and then for each point
+    only the segments overlapping the x coordinate of the point are checked.
+    The results are the same as the results of cartesian_winding. The
+    geometry has to outlive the strategy and must not be modified. Rings
+    of other geometries are checked segment by segment, like by
+    cartesian_winding.
+\tparam CalculationType \tparam_calculation
+
+\qbk{
+[heading See also]
+[link geometry.reference.algorithms.within.within_3_with_strategy within (with strategy)]
+}
+ */
+template <typename CalculationType = void>
+class cartesian_indexed_winding
+    : public cartesian_winding<void, void, CalculationType>
+{
+    typedef cartesian_winding<void, void, CalculationType> base_t;
+    typedef std::vector<detail::winding_ring_index> indexes_type;
+
+public:
+    /*!
+    \brief Builds the index of the rings of a ring, polygon or multi_polygon
+    \param geometry The geometry
+    \param segments_per_slab The average number of segments per slab
+     */
+    template <typename Geometry>
+    explicit cartesian_indexed_winding(Geometry const& geometry,
+                                       std::size_t segments_per_slab = 4)
+    {
+        typedef typename geometry::coordinate_type<Geometry>::type coor_t;
+        typedef typename std::conditional
+            <
+                std::is_void<CalculationType>::value,
+                coor_t, CalculationType
+            >::type calc_t;
+
+        double const epsilon = geometry::detail::within::winding_slab_epsilon<calc_t>();
+
+        auto indexes = std::make_shared<indexes_type>();
+        geometry::detail::within::for_each_ring<Geometry>::apply(geometry,
+            [&](auto const& ring)
+            {
+                indexes->emplace_back(ring, epsilon, segments_per_slab);
+            });
+        std::sort(indexes->begin(), indexes->end(), detail::winding_ring_index_less());
+        m_indexes = indexes;
+    }
+
+    using base_t::apply;
+
+    // Checks the whole ring at once, called by point_in_geometry
+    template <typename Point, typename Ring>
+    inline int apply_ring(Point const& point, Ring const& ring) const
+    {
+        void const* const address = std::addressof(ring);
+        auto const it = std::lower_bound(m_indexes->begin(), m_indexes->end(),
+                                         address, detail::winding_ring_index_less());
+        base_t const& strategy = *this;
+        if (it == m_indexes->end() || it->ring != address)
+        {
+            // The ring doesn't belong to the indexed geometry
+            geometry::detail::closed_clockwise_view<Ring const> const view(ring);
+            return geometry::detail::within::point_in_range(point, view, strategy);
+        }
+
+        return it->index.apply(point, ring, strategy);
+    }
+
+private:
+    std::shared_ptr<indexes_type const> m_indexes;
+};
+
+
+}} // namespace strategy::within
+
+
+namespace strategies { namespace relate { namespace services
+{
+
+template <typename CalculationType>
+struct strategy_converter<strategy::within::cartesian_indexed_winding<CalculationType>>
+{
+    typedef strategy::within::cartesian_indexed_winding<CalculationType> indexed_type;
+
+    struct altered_strategy
+        : strategies::relate::cartesian<CalculationType>
+    {
+        typedef strategies::relate::cartesian<CalculationType> base_t;
+
+        explicit altered_strategy(indexed_type const& strategy)
+            : m_strategy(strategy)
+        {}
+
+        // The strategies for other geometries, e.g. segments of linear
+        // and areal geometries
+        using base_t::relate;
+
+        template <typename Geometry1, typename Geometry2>
+        indexed_type relate(Geometry1 const&, Geometry2 const&,
+                            std::enable_if_t
+                                <
+                                    util::is_pointlike<Geometry1>::value
+                                 && ( util::is_linear<Geometry2>::value
+                                   || util::is_polygonal<Geometry2>::value )
+                                > * = nullptr) const
+        {
+            return m_strategy;
+        }
+
+    private:
+        indexed_type m_strategy;
+    };
+
+    static auto get(indexed_type const& strategy)
+    {
+        return altered_strategy(strategy);
+    }
+};
+
+}}} // namespace strategies::relate::services
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_STRATEGY_CARTESIAN_POINT_IN_POLY_INDEXED_WINDING_HPP
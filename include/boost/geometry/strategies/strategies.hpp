@@ -66,6 +66,7 @@
 #include <boost/geometry/strategies/cartesian/point_in_poly_franklin.hpp>
 #include <boost/geometry/strategies/cartesian/point_in_poly_crossings_multiply.hpp>
 #include <boost/geometry/strategies/cartesian/point_in_poly_winding.hpp>
+#include <boost/geometry/strategies/cartesian/point_in_poly_indexed_winding.hpp>
 #include <boost/geometry/strategies/cartesian/line_interpolate.hpp>
 
 #include <boost/geometry/strategies/spherical/azimuth.hpp>
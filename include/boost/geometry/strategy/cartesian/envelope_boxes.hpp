@@ -27,7 +27,7 @@ public:
     {
         friend cartesian_boxes;
 
-        Box m_box;
+        Box m_box{};
         bool m_initialized = false;
     };
 
@@ -0,0 +1,59 @@
+// Boost.Geometry
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Licensed under the Boost Software License version 1.0.
+// http://www.boost.org/users/license.html
+
+#ifndef BOOST_GEOMETRY_UTIL_PARALLEL_HPP
+#define BOOST_GEOMETRY_UTIL_PARALLEL_HPP
+
+#include <cstddef>
+
+namespace boost { namespace geometry { namespace util
+{
+
+// Executors are the objects used by the algorithms performing the work in
+// parallel. An Executor has to provide the following members:
+//
+//   std::size_t concurrency() const;
+//     Returns the number of tasks which can be executed concurrently.
+//     It's used by the algorithms to decide how the work should be divided.
+//
+//   template <typename F> void operator()(std::size_t count, F && f) const;
+//     Calls f(i) for each i in [0, count), possibly concurrently. Returns when
+//     all calls are finished. If any call throws the exception is propagated
+//     to the caller after all started calls are finished. f is never called
+//     recursively from within f by the algorithms so the calls can be safely
+//     executed by a pool of threads which is not able to handle nested waits.
+//
+// This way e.g. a thread pool or an existing scheduler (TBB, OpenMP, etc.)
+// can be used.
+
+/*!
+\brief Executor calling all functions in the current thread.
+*/
+struct sequential_executor
+{
+    std::size_t concurrency() const
+    {
+        return 1;
+    }
+
+    template <typename F>
+    void operator()(std::size_t count, F && f) const
+    {
+        for (std::size_t i = 0 ; i < count ; ++i)
+        {
+            f(i);
+        }
+    }
+};
+
+// Executor calling functions in a group of std::threads, defined in
+// boost/geometry/util/thread_executor.hpp
+class thread_executor;
+
+}}} // namespace boost::geometry::util
+
+#endif // BOOST_GEOMETRY_UTIL_PARALLEL_HPP
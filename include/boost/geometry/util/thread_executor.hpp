@@ -0,0 +1,149 @@
+// Boost.Geometry
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Licensed under the Boost Software License version 1.0.
+// http://www.boost.org/users/license.html
+
+#ifndef BOOST_GEOMETRY_UTIL_THREAD_EXECUTOR_HPP
+#define BOOST_GEOMETRY_UTIL_THREAD_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/geometry/util/parallel.hpp>
+
+namespace boost { namespace geometry { namespace util
+{
+
+/*!
+\brief Executor calling functions in a group of std::threads.
+
+The threads are created for each call and the calls of the function object
+are distributed dynamically between the threads. The calling thread also
+participates in the work.
+*/
+class thread_executor
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param threads  The maximum number of threads used. If 0
+                    std::thread::hardware_concurrency() is used.
+    */
+    explicit thread_executor(std::size_t threads = 0)
+        : m_threads(threads)
+    {
+        if (m_threads == 0)
+        {
+            m_threads = std::thread::hardware_concurrency();
+        }
+        if (m_threads == 0)
+        {
+            m_threads = 1;
+        }
+    }
+
+    std::size_t concurrency() const
+    {
+        return m_threads;
+    }
+
+    template <typename F>
+    void operator()(std::size_t count, F && f) const
+    {
+        std::size_t const threads_count = (std::min)(m_threads, count);
+        if (threads_count <= 1)
+        {
+            sequential_executor()(count, f);
+            return;
+        }
+
+        worker<F> w(count, f);
+        std::vector<std::thread> threads;
+        threads.reserve(threads_count - 1);
+        try
+        {
+            for (std::size_t i = 1 ; i < threads_count ; ++i)
+            {
+                threads.emplace_back([&w]() { w.run(); });
+            }
+        }
+        catch (std::exception const&)
+        {
+            // the work is done by the threads created so far
+        }
+
+        w.run();
+        for (std::thread & t : threads)
+        {
+            t.join();
+        }
+
+        w.rethrow();
+    }
+
+private:
+    template <typename F>
+    class worker
+    {
+    public:
+        worker(std::size_t count, F & f)
+            : m_count(count), m_f(f), m_next(0), m_failed(false)
+        {}
+
+        void run()
+        {
+            for (;;)
+            {
+                std::size_t const i = m_next.fetch_add(1);
+                if (i >= m_count || m_failed.load())
+                {
+                    return;
+                }
+
+                try
+                {
+                    m_f(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (! m_exception)
+                    {
+                        m_exception = std::current_exception();
+                    }
+                    m_failed.store(true);
+                }
+            }
+        }
+
+        void rethrow()
+        {
+            if (m_exception)
+            {
+                std::rethrow_exception(m_exception);
+            }
+        }
+
+    private:
+        std::size_t m_count;
+        F & m_f;
+        std::atomic<std::size_t> m_next;
+        std::atomic<bool> m_failed;
+        std::mutex m_mutex;
+        std::exception_ptr m_exception;
+    };
+
+    std::size_t m_threads;
+};
+
+}}} // namespace boost::geometry::util
+
+#endif // BOOST_GEOMETRY_UTIL_THREAD_EXECUTOR_HPP
@@ -0,0 +1,183 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/index/flat_rtree.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+
+// The allocator counting the number of currently allocated bytes
+std::size_t allocated_bytes = 0;
+
+template <typename T>
+struct counting_allocator
+{
+    typedef T value_type;
+
+    counting_allocator() {}
+    template <typename U>
+    counting_allocator(counting_allocator<U> const& ) {}
+
+    T * allocate(std::size_t n)
+    {
+        allocated_bytes += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T * p, std::size_t n)
+    {
+        allocated_bytes -= n * sizeof(T);
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(counting_allocator<U> const& ) const { return true; }
+    template <typename U>
+    bool operator!=(counting_allocator<U> const& ) const { return false; }
+};
+
+template <typename Tree, typename Rtree>
+void test_memory(const char * name, Rtree const& t)
+{
+    std::size_t const before = allocated_bytes;
+    {
+        Tree ft(t);
+        std::size_t const bytes = allocated_bytes - before;
+        std::size_t const values_bytes = ft.size() * sizeof(B);
+        std::cout << double(bytes) / ft.size() << " bytes per value, "
+                  << double(bytes - values_bytes) / ft.size() << " without values - " << name << '\n';
+    }
+}
+
+template <typename Tree>
+void test_queries(const char * name, Tree const& t,
+                  std::vector<B> const& queries, std::vector<P> const& points)
+{
+    typedef boost::chrono::steady_clock clock_t;
+    typedef boost::chrono::duration<float> dur_t;
+
+    std::vector<B> result;
+    result.reserve(1000);
+
+    size_t found = 0;
+    clock_t::time_point start = clock_t::now();
+    for (B const& q : queries)
+    {
+        result.clear();
+        t.query(bgi::intersects(q), std::back_inserter(result));
+        found += result.size();
+    }
+    dur_t time = clock_t::now() - start;
+    std::cout << time << " - query " << queries.size() << " found " << found << " - " << name << '\n';
+
+    found = 0;
+    start = clock_t::now();
+    for (P const& p : points)
+    {
+        result.clear();
+        t.query(bgi::nearest(p, 5), std::back_inserter(result));
+        found += result.size();
+    }
+    time = clock_t::now() - start;
+    std::cout << time << " - knn " << points.size() << " found " << found << " - " << name << '\n';
+}
+
+int main()
+{
+    typedef boost::chrono::steady_clock clock_t;
+    typedef boost::chrono::duration<float> dur_t;
+
+    size_t values_count = 1000000;
+    size_t queries_count = 200000;
+
+    std::vector<B> values;
+    std::vector<B> queries;
+    std::vector<P> points;
+
+    {
+        boost::mt19937 rng;
+        float max_val = static_cast<float>(values_count / 2);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        values.reserve(values_count);
+        for (size_t i = 0 ; i < values_count ; ++i)
+        {
+            float x = rnd();
+            float y = rnd();
+            values.push_back(B(P(x - 0.5f, y - 0.5f), P(x + 0.5f, y + 0.5f)));
+        }
+
+        for (size_t i = 0 ; i < queries_count ; ++i)
+        {
+            float x = rnd();
+            float y = rnd();
+            queries.push_back(B(P(x - 10, y - 10), P(x + 10, y + 10)));
+            points.push_back(P(rnd(), rnd()));
+        }
+    }
+
+    typedef bgi::rtree<B, bgi::rstar<16, 4> > RT;
+    typedef bgi::flat_rtree<B, bgi::rstar<16, 4> > FRT;
+    typedef bgi::flat_rtree<B, bgi::rstar<16, 4>, bgi::indexable<B>, bgi::equal_to<B>,
+                            boost::container::new_allocator<B>, bgi::flat::quantized_layout<> > QFRT;
+
+    clock_t::time_point start = clock_t::now();
+    RT t(values);
+    dur_t time = clock_t::now() - start;
+    std::cout << time << " - pack " << values_count << '\n';
+
+    start = clock_t::now();
+    FRT ft(t);
+    time = clock_t::now() - start;
+    std::cout << time << " - flatten " << values_count << '\n';
+
+    start = clock_t::now();
+    QFRT qft(t);
+    time = clock_t::now() - start;
+    std::cout << time << " - flatten quantized " << values_count << '\n';
+
+    test_queries("rtree", t, queries, points);
+    test_queries("flat_rtree", ft, queries, points);
+    test_queries("flat_rtree quantized", qft, queries, points);
+
+    typedef counting_allocator<B> A;
+    test_memory<bgi::flat_rtree<B, bgi::rstar<16, 4>, bgi::indexable<B>, bgi::equal_to<B>, A> >("flat_rtree", t);
+    test_memory<bgi::flat_rtree<B, bgi::rstar<16, 4>, bgi::indexable<B>, bgi::equal_to<B>, A,
+                                bgi::flat::quantized_layout<> > >("flat_rtree quantized", t);
+    test_memory<bgi::flat_rtree<B, bgi::rstar<16, 4>, bgi::indexable<B>, bgi::equal_to<B>, A,
+                                bgi::flat::quantized_layout<std::uint8_t> > >("flat_rtree quantized 8-bit", t);
+
+    // the tree created by insertion, nodes scattered in memory
+    RT ti;
+    for (B const& b : values)
+    {
+        ti.insert(b);
+    }
+    FRT fti(ti);
+    QFRT qfti(ti);
+
+    test_queries("rtree inserted", ti, queries, points);
+    test_queries("flat_rtree inserted", fti, queries, points);
+    test_queries("flat_rtree quantized inserted", qfti, queries, points);
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/geometry/index/detail/rtree/utilities/view.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+
+// Counts the nodes which would be visited by the intersects() spatial query
+template <typename MembersHolder>
+struct count_visited_nodes
+    : public MembersHolder::visitor_const
+{
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    count_visited_nodes(B const& b) : box(b), nodes(0), leafs(0) {}
+
+    void operator()(internal_node const& n)
+    {
+        ++nodes;
+        auto const& elements = bgi::detail::rtree::elements(n);
+        for (auto const& el : elements)
+        {
+            if (bg::intersects(el.first, box))
+            {
+                bgi::detail::rtree::apply_visitor(*this, *el.second);
+            }
+        }
+    }
+
+    void operator()(leaf const& )
+    {
+        ++nodes;
+        ++leafs;
+    }
+
+    B box;
+    size_t nodes;
+    size_t leafs;
+};
+
+template <typename Params>
+void test_params(const char * name, std::vector<P> const& values, std::vector<B> const& queries)
+{
+    typedef boost::chrono::steady_clock clock_t;
+    typedef boost::chrono::duration<float> dur_t;
+    typedef bgi::rtree<P, Params> RT;
+
+    clock_t::time_point start = clock_t::now();
+    RT t;
+    for (P const& p : values)
+    {
+        t.insert(p);
+    }
+    dur_t time = clock_t::now() - start;
+    std::cout << time << " - insert " << values.size() << " - " << name << '\n';
+
+    typedef bgi::detail::rtree::utilities::view<RT> RTV;
+    RTV rtv(t);
+
+    size_t found = 0;
+    start = clock_t::now();
+    for (B const& q : queries)
+    {
+        std::vector<P> result;
+        t.query(bgi::intersects(q), std::back_inserter(result));
+        found += result.size();
+    }
+    time = clock_t::now() - start;
+
+    size_t nodes = 0, leafs = 0;
+    for (B const& q : queries)
+    {
+        count_visited_nodes<typename RTV::members_holder> v(q);
+        rtv.apply_visitor(v);
+        nodes += v.nodes;
+        leafs += v.leafs;
+    }
+    std::cout << time << " - query " << queries.size() << " found " << found
+              << " nodes visited " << nodes << " leafs visited " << leafs << '\n';
+}
+
+int main()
+{
+    size_t clusters_count = 100;
+    size_t values_count = 1000000;
+    size_t queries_count = 100000;
+
+    std::vector<P> values;
+    std::vector<B> queries;
+
+    // points clustered around "cities", e.g. GPS positions
+    {
+        boost::mt19937 rng;
+        boost::uniform_real<double> range(-1000, 1000);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<double> > rnd(rng, range);
+        boost::normal_distribution<double> normal(0, 5);
+        boost::variate_generator<boost::mt19937&, boost::normal_distribution<double> > nrnd(rng, normal);
+        boost::uniform_int<size_t> crange(0, clusters_count - 1);
+        boost::variate_generator<boost::mt19937&, boost::uniform_int<size_t> > crnd(rng, crange);
+
+        std::vector<P> clusters;
+        for (size_t i = 0 ; i < clusters_count ; ++i)
+        {
+            clusters.push_back(P(rnd(), rnd()));
+        }
+
+        values.reserve(values_count);
+        for (size_t i = 0 ; i < values_count ; ++i)
+        {
+            P const& c = clusters[crnd()];
+            values.push_back(P(bg::get<0>(c) + nrnd(), bg::get<1>(c) + nrnd()));
+        }
+
+        queries.reserve(queries_count);
+        for (size_t i = 0 ; i < queries_count ; ++i)
+        {
+            P const& c = clusters[crnd()];
+            double x = bg::get<0>(c) + nrnd();
+            double y = bg::get<1>(c) + nrnd();
+            queries.push_back(B(P(x - 0.5, y - 0.5), P(x + 0.5, y + 0.5)));
+        }
+    }
+
+    test_params<bgi::rstar<16, 4> >("rstar", values, queries);
+    test_params<bgi::kmeans<16, 4> >("kmeans", values, queries);
+    test_params<bgi::quadratic<16, 4> >("quadratic", values, queries);
+    test_params<bgi::linear<16, 4> >("linear", values, queries);
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// The box of a Linestring indexable is calculated from its points each time
+// the rtree needs it. Compare the rtree storing Linestrings with the rtree
+// storing the precalculated boxes for increasing numbers of points.
+
+#include <cstddef>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+typedef bg::model::linestring<P> L;
+typedef std::pair<B, std::size_t> BV;
+
+template <typename Rtree, typename Values>
+void test_rtree(const char * name, Values const& values, std::vector<B> const& queries)
+{
+    typedef boost::chrono::steady_clock clock_t;
+    typedef boost::chrono::duration<float> dur_t;
+
+    clock_t::time_point start = clock_t::now();
+    Rtree ti;
+    for (auto const& v : values)
+    {
+        ti.insert(v);
+    }
+    dur_t time = clock_t::now() - start;
+    std::cout << time << " - insert " << values.size() << " - " << name << '\n';
+
+    start = clock_t::now();
+    Rtree tp(values);
+    time = clock_t::now() - start;
+    std::cout << time << " - pack " << values.size() << " - " << name << '\n';
+
+    std::vector<typename Rtree::value_type> result;
+    std::size_t found = 0;
+    start = clock_t::now();
+    for (B const& q : queries)
+    {
+        result.clear();
+        tp.query(bgi::intersects(q), std::back_inserter(result));
+        found += result.size();
+    }
+    time = clock_t::now() - start;
+    std::cout << time << " - query " << queries.size() << " found " << found << " - " << name << '\n';
+}
+
+int main()
+{
+    std::size_t const values_count = 20000;
+    std::size_t const queries_count = 20000;
+    std::size_t const points_counts[] = { 2, 8, 32, 128 };
+
+    boost::mt19937 rng;
+    float const max_val = static_cast<float>(values_count / 2);
+    boost::uniform_real<float> range(-max_val, max_val);
+    boost::uniform_real<float> step_range(-1, 1);
+    boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+    boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > step(rng, step_range);
+
+    std::vector<B> queries;
+    for (std::size_t i = 0 ; i < queries_count ; ++i)
+    {
+        float const x = rnd();
+        float const y = rnd();
+        queries.push_back(B(P(x - 10, y - 10), P(x + 10, y + 10)));
+    }
+
+    for (std::size_t points_count : points_counts)
+    {
+        // random walks of similar extent regardless of the number of points
+        double const step_length = 8.0 / points_count;
+
+        std::vector<L> linestrings;
+        std::vector<BV> boxes;
+        for (std::size_t i = 0 ; i < values_count ; ++i)
+        {
+            L ls;
+            double x = rnd();
+            double y = rnd();
+            for (std::size_t j = 0 ; j < points_count ; ++j)
+            {
+                ls.push_back(P(x, y));
+                x += step() * step_length;
+                y += step() * step_length;
+            }
+            boxes.push_back(BV(bg::return_envelope<B>(ls), i));
+            linestrings.push_back(std::move(ls));
+        }
+
+        std::cout << "------ " << points_count << " points\n";
+        test_rtree<bgi::rtree<L, bgi::rstar<16, 4> > >("linestring", linestrings, queries);
+        test_rtree<bgi::rtree<BV, bgi::rstar<16, 4> > >("box", boxes, queries);
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/index/node_pool_allocator.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+
+// Inserts all of the values, removes every second one, inserts them again
+// and clears the tree, the allocator is used for each created or destroyed node
+template <typename Rtree>
+void test_rtree(const char * name, Rtree & t, std::vector<B> const& values, size_t cycles)
+{
+    typedef boost::chrono::steady_clock clock_t;
+    typedef boost::chrono::duration<float> dur_t;
+
+    dur_t insert_time(0), remove_time(0), clear_time(0);
+    size_t size = 0;
+    for (size_t c = 0 ; c < cycles ; ++c)
+    {
+        clock_t::time_point start = clock_t::now();
+        for (B const& b : values)
+        {
+            t.insert(b);
+        }
+        insert_time += clock_t::now() - start;
+
+        start = clock_t::now();
+        for (size_t i = 0 ; i < values.size() ; i += 2)
+        {
+            t.remove(values[i]);
+        }
+        for (size_t i = 0 ; i < values.size() ; i += 2)
+        {
+            t.insert(values[i]);
+        }
+        remove_time += clock_t::now() - start;
+
+        size += t.size();
+
+        start = clock_t::now();
+        t.clear();
+        clear_time += clock_t::now() - start;
+    }
+
+    std::cout << insert_time << " - insert " << values.size() * cycles << " - " << name << '\n';
+    std::cout << remove_time << " - remove/insert " << values.size() * cycles << " - " << name << '\n';
+    std::cout << clear_time << " - clear " << size << " - " << name << '\n';
+}
+
+int main()
+{
+    size_t values_count = 200000;
+    size_t cycles = 5;
+
+    std::vector<B> values;
+
+    {
+        boost::mt19937 rng;
+        float max_val = static_cast<float>(values_count / 2);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        values.reserve(values_count);
+        for (size_t i = 0 ; i < values_count ; ++i)
+        {
+            float x = rnd();
+            float y = rnd();
+            values.push_back(B(P(x - 0.5f, y - 0.5f), P(x + 0.5f, y + 0.5f)));
+        }
+    }
+
+    {
+        bgi::rtree<B, bgi::rstar<16, 4> > t;
+        test_rtree("rstar<16, 4> new", t, values, cycles);
+    }
+    {
+        bgi::rtree<B, bgi::rstar<16, 4>, bgi::indexable<B>, bgi::equal_to<B>,
+                   bgi::node_pool_allocator<B> > t;
+        test_rtree("rstar<16, 4> node_pool", t, values, cycles);
+    }
+    {
+        bgi::rtree<B, bgi::dynamic_rstar> t(bgi::dynamic_rstar(16, 4));
+        test_rtree("dynamic_rstar(16, 4) new", t, values, cycles);
+    }
+    {
+        bgi::rtree<B, bgi::dynamic_rstar, bgi::indexable<B>, bgi::equal_to<B>,
+                   bgi::node_pool_allocator<B> > t(bgi::dynamic_rstar(16, 4));
+        test_rtree("dynamic_rstar(16, 4) node_pool", t, values, cycles);
+    }
+
+    return 0;
+}
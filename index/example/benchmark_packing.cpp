@@ -0,0 +1,132 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/util/thread_executor.hpp>
+
+#include <boost/geometry/index/detail/rtree/utilities/view.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> P;
+typedef bg::model::box<P> B;
+typedef bgi::rtree<B, bgi::rstar<16, 4> > RT;
+
+// Counts the nodes which would be visited by the intersects() spatial query
+template <typename MembersHolder>
+struct count_visited_nodes
+    : public MembersHolder::visitor_const
+{
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    count_visited_nodes(B const& b) : box(b), nodes(0), leafs(0) {}
+
+    void operator()(internal_node const& n)
+    {
+        ++nodes;
+        auto const& elements = bgi::detail::rtree::elements(n);
+        for (auto const& el : elements)
+        {
+            if (bg::intersects(el.first, box))
+            {
+                bgi::detail::rtree::apply_visitor(*this, *el.second);
+            }
+        }
+    }
+
+    void operator()(leaf const& )
+    {
+        ++nodes;
+        ++leafs;
+    }
+
+    B box;
+    size_t nodes;
+    size_t leafs;
+};
+
+template <typename Packing>
+void test_packing(const char * name, std::vector<B> const& values, std::vector<B> const& queries)
+{
+    typedef boost::chrono::steady_clock clock_t;
+    typedef boost::chrono::duration<float> dur_t;
+
+    clock_t::time_point start = clock_t::now();
+    RT t(values.begin(), values.end(), Packing());
+    dur_t time = clock_t::now() - start;
+    std::cout << time << " - pack " << values.size() << " - " << name << '\n';
+
+    typedef bgi::detail::rtree::utilities::view<RT> RTV;
+    RTV rtv(t);
+
+    size_t nodes = 0, leafs = 0, found = 0;
+    start = clock_t::now();
+    for (B const& q : queries)
+    {
+        std::vector<B> result;
+        t.query(bgi::intersects(q), std::back_inserter(result));
+        found += result.size();
+
+        count_visited_nodes<typename RTV::members_holder> v(q);
+        rtv.apply_visitor(v);
+        nodes += v.nodes;
+        leafs += v.leafs;
+    }
+    time = clock_t::now() - start;
+    std::cout << time << " - query " << queries.size() << " found " << found
+              << " nodes visited " << nodes << " leafs visited " << leafs << '\n';
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 100000;
+
+    std::vector<B> values;
+    std::vector<B> queries;
+
+    {
+        boost::mt19937 rng;
+        float max_val = static_cast<float>(values_count / 2);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        values.reserve(values_count);
+        for (size_t i = 0 ; i < values_count ; ++i)
+        {
+            float x = rnd();
+            float y = rnd();
+            values.push_back(B(P(x - 0.5f, y - 0.5f), P(x + 0.5f, y + 0.5f)));
+        }
+
+        queries.reserve(queries_count);
+        for (size_t i = 0 ; i < queries_count ; ++i)
+        {
+            float x = rnd();
+            float y = rnd();
+            queries.push_back(B(P(x - 10, y - 10), P(x + 10, y + 10)));
+        }
+    }
+
+    test_packing<bgi::default_packing>("default", values, queries);
+    test_packing<bgi::hilbert_packing>("hilbert", values, queries);
+    test_packing<bgi::morton_packing>("morton", values, queries);
+    test_packing<bgi::parallel_packing<> >("parallel", values, queries);
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2011-2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/geometry/index/detail/rtree/utilities/view.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > P;
+typedef bg::model::box<P> B;
+typedef bgi::rtree<P, bgi::rstar<16, 4> > RT;
+
+// Counts the nodes which would be visited by the intersects() spatial query
+template <typename MembersHolder>
+struct count_visited_nodes
+    : public MembersHolder::visitor_const
+{
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    count_visited_nodes(B const& b) : box(b), nodes(0), leafs(0) {}
+
+    void operator()(internal_node const& n)
+    {
+        ++nodes;
+        auto const& elements = bgi::detail::rtree::elements(n);
+        for (auto const& el : elements)
+        {
+            if (bg::intersects(el.first, box))
+            {
+                bgi::detail::rtree::apply_visitor(*this, *el.second);
+            }
+        }
+    }
+
+    void operator()(leaf const& )
+    {
+        ++nodes;
+        ++leafs;
+    }
+
+    B box;
+    size_t nodes;
+    size_t leafs;
+};
+
+// Counts the nodes whose boxes span more than 90 degrees of longitude
+template <typename MembersHolder>
+struct count_wide_nodes
+    : public MembersHolder::visitor_const
+{
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    count_wide_nodes() : wide(0), all(0) {}
+
+    void operator()(internal_node const& n)
+    {
+        auto const& elements = bgi::detail::rtree::elements(n);
+        for (auto const& el : elements)
+        {
+            ++all;
+            if (bg::get<bg::max_corner, 0>(el.first) - bg::get<bg::min_corner, 0>(el.first) > 90)
+            {
+                ++wide;
+            }
+            bgi::detail::rtree::apply_visitor(*this, *el.second);
+        }
+    }
+
+    void operator()(leaf const& ) {}
+
+    size_t wide;
+    size_t all;
+};
+
+template <typename Packing>
+void test_packing(const char * name, std::vector<P> const& values, std::vector<B> const& queries)
+{
+    typedef boost::chrono::steady_clock clock_t;
+    typedef boost::chrono::duration<float> dur_t;
+
+    clock_t::time_point start = clock_t::now();
+    RT t(values.begin(), values.end(), Packing());
+    dur_t time = clock_t::now() - start;
+    std::cout << time << " - pack " << values.size() << " - " << name << '\n';
+
+    typedef bgi::detail::rtree::utilities::view<RT> RTV;
+    RTV rtv(t);
+
+    count_wide_nodes<typename RTV::members_holder> w;
+    rtv.apply_visitor(w);
+    std::cout << "nodes " << w.all << " wider than 90 degrees " << w.wide << '\n';
+
+    size_t nodes = 0, leafs = 0, found = 0;
+    start = clock_t::now();
+    for (B const& q : queries)
+    {
+        std::vector<P> result;
+        t.query(bgi::intersects(q), std::back_inserter(result));
+        found += result.size();
+
+        count_visited_nodes<typename RTV::members_holder> v(q);
+        rtv.apply_visitor(v);
+        nodes += v.nodes;
+        leafs += v.leafs;
+    }
+    time = clock_t::now() - start;
+    std::cout << time << " - query " << queries.size() << " found " << found
+              << " nodes visited " << nodes << " leafs visited " << leafs << '\n';
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 100000;
+
+    std::vector<P> values;
+    std::vector<B> queries;
+
+    {
+        boost::mt19937 rng;
+        boost::uniform_real<double> range(-1, 1);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<double> > rnd(rng, range);
+
+        double const r2d = 180.0 / bg::math::pi<double>();
+
+        // uniformly distributed on the sphere, 1/4 of points
+        // clustered around the antimeridian
+        values.reserve(values_count);
+        for (size_t i = 0 ; i < values_count ; ++i)
+        {
+            double lon = rnd() * 180;
+            if (i % 4 == 0)
+            {
+                lon = lon < 0 ? -180 - lon / 20 : 180 - lon / 20;
+            }
+            double lat = std::asin(rnd()) * r2d;
+            values.push_back(P(lon, lat));
+        }
+
+        // 2x2 degrees boxes, 1/4 of them crossing the antimeridian
+        queries.reserve(queries_count);
+        for (size_t i = 0 ; i < queries_count ; ++i)
+        {
+            double lon = i % 4 == 0 ? 179 + rnd() : rnd() * 179;
+            double lat = rnd() * 88;
+            queries.push_back(B(P(lon - 1, lat - 1), P(lon + 1, lat + 1)));
+        }
+    }
+
+    test_packing<bgi::default_packing>("default", values, queries);
+    test_packing<bgi::hilbert_packing>("hilbert", values, queries);
+
+    return 0;
+}
@@ -78,6 +78,46 @@ void test_rtree_value_exceptions(Parameters const& parameters = Parameters())
         BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(tree, false));
     }
 
+    throwing_value::reset_calls_counter();
+    throwing_value::set_max_calls((std::numeric_limits<size_t>::max)());
+    std::vector<Value> big_input;
+    generate::input<2>::apply(big_input, qbox, 4);
+    size_t const quarter = big_input.size() / 4;
+
+    for ( size_t i = 0 ; i < 2 * quarter ; i += 10 )
+    {
+        throwing_value::reset_calls_counter();
+        throwing_value::set_max_calls(100000);
+
+        Tree tree(parameters);
+
+        tree.insert(big_input.begin(), big_input.begin() + 3 * quarter);
+
+        throwing_value::reset_calls_counter();
+        throwing_value::set_max_calls(i);
+
+        BOOST_CHECK_THROW( tree.bulk_insert(big_input.begin() + 3 * quarter, big_input.end()), throwing_value_copy_exception );
+
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(tree, false));
+    }
+
+    for ( size_t i = 0 ; i < 2 * quarter ; i += 10 )
+    {
+        throwing_value::reset_calls_counter();
+        throwing_value::set_max_calls(100000);
+
+        Tree tree(parameters);
+
+        tree.insert(big_input.begin(), big_input.end());
+
+        throwing_value::reset_calls_counter();
+        throwing_value::set_max_calls(i);
+
+        BOOST_CHECK_THROW( tree.bulk_remove(big_input.begin() + quarter, big_input.begin() + 3 * quarter), throwing_value_copy_exception );
+
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(tree, false));
+    }
+
     for ( size_t i = 0 ; i < 20 ; i += 2 )
     {
         throwing_value::reset_calls_counter();
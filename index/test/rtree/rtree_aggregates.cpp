@@ -0,0 +1,166 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/util/thread_executor.hpp>
+
+// the sum of the integers stored in the values
+struct sum_aggregate
+{
+    typedef long result_type;
+
+    result_type identity() const { return 0; }
+
+    template <typename Box>
+    result_type value(std::pair<Box, int> const& v) const { return v.second; }
+
+    result_type combine(result_type a, result_type b) const { return a + b; }
+};
+
+template <typename Rtree, typename Box>
+void check_aggregate(Rtree const& rt, Box const& qbox)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> result;
+    rt.query(bgi::intersects(qbox), std::back_inserter(result));
+
+    auto const aggregate = rt.parameters().aggregate();
+    typename Rtree::aggregate_result_type expected = aggregate.identity();
+    for (value_t const& v : result)
+    {
+        expected = aggregate.combine(expected, aggregate.value(v));
+    }
+
+    BOOST_CHECK_EQUAL(rt.aggregate(qbox), expected);
+}
+
+template <typename Rtree, typename Box, std::size_t N>
+void check_aggregates(Rtree const& rt, Box const (&qboxes)[N])
+{
+    basictest::check_structure(rt);
+
+    for (Box const& qbox : qboxes)
+    {
+        check_aggregate(rt, qbox);
+    }
+
+    Box all;
+    bg::assign_values(all, -1000, -1000, 1000, 1000);
+    BOOST_CHECK_EQUAL(rt.aggregate(), rt.aggregate(all));
+}
+
+template <typename Params, typename Aggregate>
+void test_aggregates(Params const& params)
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef std::pair<box_t, int> value_t;
+    typedef bgi::aggregated<Params, Aggregate> aggregated_t;
+    typedef bgi::rtree<value_t, aggregated_t> rtree_t;
+
+    std::vector<value_t> values;
+    for (int i = 0 ; i < 1000 ; ++i)
+    {
+        double const x = i * 7919 % 113;
+        double const y = i * 104729 % 107;
+        values.push_back(value_t(box_t(point_t(x, y), point_t(x + i % 3, y + i % 5)), i));
+    }
+
+    std::vector<value_t> const first(values.begin(), values.begin() + 500);
+    std::vector<value_t> const second(values.begin() + 500, values.end());
+
+    box_t const qboxes[] = {
+        box_t(point_t(20, 30), point_t(70, 60)),
+        box_t(point_t(0, 0), point_t(10, 10)),
+        box_t(point_t(-10, -10), point_t(200, 200)),
+        box_t(point_t(500, 500), point_t(600, 600)),
+        box_t(point_t(50, 50), point_t(50, 50))
+    };
+
+    aggregated_t const aggregated(params);
+
+    // empty
+    rtree_t empty_rt(aggregated);
+    BOOST_CHECK_EQUAL(empty_rt.aggregate(), Aggregate().identity());
+    check_aggregates(empty_rt, qboxes);
+
+    // packing
+    rtree_t rt(values, aggregated);
+    check_aggregates(rt, qboxes);
+
+    rtree_t hilbert_rt(values, bgi::hilbert_packing(), aggregated);
+    check_aggregates(hilbert_rt, qboxes);
+
+    rtree_t parallel_rt(values, bgi::parallel_packing<>(bg::util::thread_executor(3)), aggregated);
+    check_aggregates(parallel_rt, qboxes);
+
+    // insertion
+    rtree_t inserted_rt(aggregated);
+    for (value_t const& v : values)
+    {
+        inserted_rt.insert(v);
+    }
+    check_aggregates(inserted_rt, qboxes);
+
+    // removal
+    for (value_t const& v : first)
+    {
+        inserted_rt.remove(v);
+    }
+    check_aggregates(inserted_rt, qboxes);
+
+    for (value_t const& v : second)
+    {
+        inserted_rt.remove(v);
+    }
+    BOOST_CHECK(inserted_rt.empty());
+    check_aggregates(inserted_rt, qboxes);
+
+    // bulk insertion and removal
+    rtree_t bulk_rt(first, aggregated);
+    bulk_rt.bulk_insert(second.begin(), second.end());
+    check_aggregates(bulk_rt, qboxes);
+
+    bulk_rt.bulk_remove(first.begin(), first.end());
+    check_aggregates(bulk_rt, qboxes);
+
+    // copying
+    rtree_t copied_rt(bulk_rt);
+    check_aggregates(copied_rt, qboxes);
+    copied_rt = rt;
+    check_aggregates(copied_rt, qboxes);
+
+    bulk_rt.bulk_remove(second.begin(), second.end());
+    BOOST_CHECK(bulk_rt.empty());
+    check_aggregates(bulk_rt, qboxes);
+}
+
+template <typename Params>
+void test_aggregates(Params const& params = Params())
+{
+    test_aggregates<Params, bgi::count_aggregate>(params);
+    test_aggregates<Params, sum_aggregate>(params);
+}
+
+int test_main(int, char* [])
+{
+    test_aggregates<bgi::linear<4, 2> >();
+    test_aggregates<bgi::quadratic<5, 2> >();
+    test_aggregates<bgi::rstar<8, 3> >();
+    test_aggregates<bgi::rstar<32, 8> >();
+    test_aggregates(bgi::dynamic_rstar(16, 4));
+
+    return 0;
+}
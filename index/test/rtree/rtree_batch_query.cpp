@@ -0,0 +1,253 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/util/thread_executor.hpp>
+
+template <typename Value>
+bool contains_value(std::vector<Value> const& values, Value const& v)
+{
+    for (Value const& w : values)
+    {
+        if (bg::equals(v, w))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Rtree, typename Predicates, typename Executor>
+void check_batch_query(Rtree const& rt, std::vector<Predicates> const& predicates, Executor const& executor)
+{
+    typedef typename Rtree::value_type value_t;
+    typedef typename Rtree::size_type size_type;
+
+    std::vector<std::pair<size_type, value_t> > batch_result;
+    size_type found = rt.batch_query(predicates, std::back_inserter(batch_result), executor);
+    BOOST_CHECK_EQUAL(found, batch_result.size());
+
+    std::vector<std::vector<value_t> > batch_values(predicates.size());
+    for (auto const& p : batch_result)
+    {
+        BOOST_CHECK(p.first < predicates.size());
+        if (p.first < predicates.size())
+        {
+            batch_values[p.first].push_back(p.second);
+        }
+    }
+
+    for (std::size_t i = 0 ; i < predicates.size() ; ++i)
+    {
+        std::vector<value_t> expected;
+        rt.query(predicates[i], std::back_inserter(expected));
+
+        BOOST_CHECK_EQUAL(batch_values[i].size(), expected.size());
+        for (value_t const& v : batch_values[i])
+        {
+            BOOST_CHECK(contains_value(expected, v));
+        }
+    }
+
+    std::vector<std::pair<size_type, value_t> > free_result;
+    BOOST_CHECK_EQUAL(bgi::batch_query(rt, predicates, std::back_inserter(free_result), executor), found);
+}
+
+template <typename Rtree, typename Predicates>
+void check_batch_query(Rtree const& rt, std::vector<Predicates> const& predicates)
+{
+    typedef typename Rtree::value_type value_t;
+    typedef typename Rtree::size_type size_type;
+
+    check_batch_query(rt, predicates, bg::util::sequential_executor());
+    check_batch_query(rt, predicates, bg::util::thread_executor(4));
+
+    std::vector<std::pair<size_type, value_t> > free_result;
+    size_type const found = bgi::batch_query(rt, predicates, std::back_inserter(free_result));
+    BOOST_CHECK_EQUAL(found, free_result.size());
+}
+
+// the spatial queries are performed in one traversal of the tree, each node is visited once
+template <typename Rtree, typename Box>
+void check_batch_traversal(Rtree const& rt, Box const& box, std::size_t count)
+{
+    typedef typename Rtree::value_type value_t;
+    typedef typename Rtree::size_type size_type;
+
+    std::vector<decltype(bgi::intersects(box))> predicates(count, bgi::intersects(box));
+
+    bgi::query_statistics single_stats;
+    std::vector<value_t> single_result;
+    rt.query(bgi::intersects(box), std::back_inserter(single_result), single_stats);
+
+    bgi::query_statistics batch_stats;
+    std::vector<std::pair<size_type, value_t> > batch_result;
+    size_type const found = rt.batch_query(predicates, std::back_inserter(batch_result), batch_stats);
+
+    BOOST_CHECK_EQUAL(found, single_result.size() * count);
+    BOOST_CHECK_EQUAL(batch_stats.internal_nodes, single_stats.internal_nodes);
+    BOOST_CHECK_EQUAL(batch_stats.leafs, single_stats.leafs);
+    BOOST_CHECK_EQUAL(batch_stats.predicates, single_stats.predicates * count);
+
+    // the sequential executor doesn't divide the work
+    std::vector<std::pair<size_type, value_t> > seq_result;
+    BOOST_CHECK_EQUAL(rt.batch_query(predicates, std::back_inserter(seq_result),
+                                     bg::util::sequential_executor()),
+                      found);
+    BOOST_CHECK_EQUAL(seq_result.size(), batch_result.size());
+    for (std::size_t i = 0 ; i < seq_result.size() && i < batch_result.size() ; ++i)
+    {
+        BOOST_CHECK_EQUAL(seq_result[i].first, batch_result[i].first);
+        BOOST_CHECK(bg::equals(seq_result[i].second, batch_result[i].second));
+    }
+}
+
+// the results of knn queries are grouped by the queries and returned in the same order as by query()
+template <typename Rtree, typename Predicates, typename Executor>
+void check_batch_nearest(Rtree const& rt, std::vector<Predicates> const& predicates, Executor const& executor)
+{
+    typedef typename Rtree::value_type value_t;
+    typedef typename Rtree::size_type size_type;
+
+    std::vector<std::pair<size_type, value_t> > expected;
+    for (std::size_t i = 0 ; i < predicates.size() ; ++i)
+    {
+        std::vector<value_t> result;
+        rt.query(predicates[i], std::back_inserter(result));
+        for (value_t const& v : result)
+        {
+            expected.push_back(std::make_pair(size_type(i), v));
+        }
+    }
+
+    std::vector<std::pair<size_type, value_t> > batch_result;
+    size_type found = bgi::batch_query(rt, predicates, std::back_inserter(batch_result), executor);
+    BOOST_CHECK_EQUAL(found, batch_result.size());
+    BOOST_CHECK_EQUAL(batch_result.size(), expected.size());
+    for (std::size_t i = 0 ; i < batch_result.size() && i < expected.size() ; ++i)
+    {
+        BOOST_CHECK_EQUAL(batch_result[i].first, expected[i].first);
+        BOOST_CHECK(bg::equals(batch_result[i].second, expected[i].second));
+    }
+}
+
+template <typename Rtree, typename Point>
+void check_nearest_context(Rtree const& rt, std::vector<Point> const& points)
+{
+    typedef typename Rtree::value_type value_t;
+
+    bgi::nearest_query_context<Rtree, Point> context;
+    for (std::size_t i = 0 ; i < points.size() ; ++i)
+    {
+        unsigned const k = unsigned(i % 7);
+
+        std::vector<value_t> expected;
+        rt.query(bgi::nearest(points[i], k), std::back_inserter(expected));
+
+        std::vector<value_t> result;
+        BOOST_CHECK_EQUAL(rt.query(bgi::nearest(points[i], k), std::back_inserter(result), context),
+                          expected.size());
+        BOOST_CHECK_EQUAL(result.size(), expected.size());
+        for (std::size_t j = 0 ; j < result.size() && j < expected.size() ; ++j)
+        {
+            BOOST_CHECK(bg::equals(result[j], expected[j]));
+        }
+
+        std::vector<value_t> result2;
+        bgi::query(rt, bgi::nearest(points[i], k) && bgi::intersects(rt.bounds()),
+                   std::back_inserter(result2), context);
+        BOOST_CHECK_EQUAL(result2.size(), expected.size());
+    }
+
+    context.clear();
+    std::vector<value_t> result;
+    rt.query(bgi::nearest(points.front(), 3), std::back_inserter(result), context);
+    BOOST_CHECK_EQUAL(result.size(), (std::min)(rt.size(), std::size_t(3)));
+}
+
+template <typename Value, typename Params>
+void test_batch_query(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+    typedef typename rtree_t::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    std::size_t const counts[] = { 0, 1, 17, 1000 };
+    for (std::size_t count : counts)
+    {
+        std::vector<Value> values;
+        generate::values(values, count);
+
+        rtree_t rt(values, params);
+
+        std::vector<box_t> boxes;
+        for (int i = 0 ; i < 50 ; ++i)
+        {
+            point_t min_p, max_p;
+            bg::assign_values(min_p, (i * 13) % 100, (i * 31) % 100);
+            bg::assign_values(max_p, (i * 13) % 100 + i % 20, (i * 31) % 100 + i % 10);
+            boxes.push_back(box_t(min_p, max_p));
+        }
+
+        std::vector<decltype(bgi::intersects(box_t()))> intersects_predicates;
+        std::vector<decltype(bgi::intersects(box_t()) && !bgi::within(box_t()))> compound_predicates;
+        for (box_t const& b : boxes)
+        {
+            intersects_predicates.push_back(bgi::intersects(b));
+            compound_predicates.push_back(bgi::intersects(b) && !bgi::within(b));
+        }
+
+        check_batch_query(rt, intersects_predicates);
+        check_batch_query(rt, compound_predicates);
+        check_batch_query(rt, std::vector<decltype(bgi::intersects(box_t()))>());
+        if ( ! rt.empty() )
+        {
+            check_batch_traversal(rt, rt.bounds(), 100);
+        }
+
+        std::vector<point_t> points;
+        std::vector<decltype(bgi::nearest(point_t(), 1))> nearest_predicates;
+        std::vector<decltype(bgi::nearest(point_t(), 1) && bgi::intersects(box_t()))> compound_nearest_predicates;
+        for (box_t const& b : boxes)
+        {
+            points.push_back(b.min_corner());
+            nearest_predicates.push_back(bgi::nearest(b.min_corner(), 5));
+            compound_nearest_predicates.push_back(bgi::nearest(b.min_corner(), 3) && bgi::intersects(b));
+        }
+
+        check_batch_nearest(rt, nearest_predicates, bg::util::sequential_executor());
+        check_batch_nearest(rt, nearest_predicates, bg::util::thread_executor(4));
+        check_batch_nearest(rt, compound_nearest_predicates, bg::util::thread_executor(3));
+        check_nearest_context(rt, points);
+    }
+}
+
+template <typename Value>
+void test_value()
+{
+    test_batch_query<Value, bgi::linear<4, 2> >();
+    test_batch_query<Value, bgi::quadratic<5, 2> >();
+    test_batch_query<Value, bgi::rstar<8, 3> >();
+    test_batch_query<Value>(bgi::dynamic_rstar(16, 4));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <vector>
+
+template <typename Rtree, typename Value>
+void check_values(Rtree const& rt, std::vector<Value> const& expected)
+{
+    BOOST_CHECK_EQUAL(rt.size(), expected.size());
+
+    // every value can be found
+    for ( Value const& v : expected )
+    {
+        BOOST_CHECK(rt.count(v) > 0);
+    }
+}
+
+template <typename Value, typename Params>
+void test_bulk_insert_remove(std::size_t initial_count, std::size_t delta_count,
+                             Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+
+    std::vector<Value> values;
+    generate::values(values, initial_count + delta_count, 113, 107);
+
+    std::vector<Value> initial(values.begin(), values.begin() + initial_count);
+    std::vector<Value> delta(values.begin() + initial_count, values.end());
+
+    // insert into tree created by the balancing algorithm
+    rtree_t rt(params);
+    rt.insert(initial.begin(), initial.end());
+    rt.bulk_insert(delta.begin(), delta.end());
+    basictest::check_structure(rt);
+    check_values(rt, values);
+
+    // insert into packed tree
+    rtree_t rt2(initial, params);
+    bgi::bulk_insert(rt2, delta);
+    basictest::check_structure(rt2);
+    check_values(rt2, values);
+
+    // insert in many steps
+    rtree_t rt3(initial, params);
+    for ( std::size_t i = 0 ; i < delta.size() ; i += 10 )
+    {
+        std::size_t const last = (std::min)(i + 10, delta.size());
+        rt3.bulk_insert(delta.begin() + i, delta.begin() + last);
+        basictest::check_structure(rt3);
+    }
+    check_values(rt3, values);
+
+    // remove the delta
+    BOOST_CHECK_EQUAL(rt.bulk_remove(delta.begin(), delta.end()), delta.size());
+    basictest::check_structure(rt);
+    check_values(rt, initial);
+
+    // values which are not stored are not removed
+    BOOST_CHECK_EQUAL(bgi::bulk_remove(rt, delta), 0u);
+    check_values(rt, initial);
+
+    // remove every second value
+    std::vector<Value> removed, kept;
+    for ( std::size_t i = 0 ; i < values.size() ; ++i )
+    {
+        (i % 2 == 0 ? removed : kept).push_back(values[i]);
+    }
+    BOOST_CHECK_EQUAL(rt2.bulk_remove(removed), removed.size());
+    basictest::check_structure(rt2);
+    check_values(rt2, kept);
+
+    // remove all values
+    BOOST_CHECK_EQUAL(rt3.bulk_remove(values), values.size());
+    basictest::check_structure(rt3);
+    BOOST_CHECK(rt3.empty());
+
+    // the tree is usable after removing all values
+    rt3.bulk_insert(initial);
+    basictest::check_structure(rt3);
+    check_values(rt3, initial);
+    rt3.insert(delta.begin(), delta.end());
+    rt3.remove(initial.begin(), initial.end());
+    basictest::check_structure(rt3);
+    check_values(rt3, delta);
+}
+
+template <typename Value, typename Params>
+void test_duplicates(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+
+    Value const v = generate::value<Value>::apply(1, 2);
+    std::vector<Value> values(50, v);
+
+    rtree_t rt(params);
+    rt.bulk_insert(values);
+    rt.bulk_insert(values.begin(), values.begin() + 40);
+    BOOST_CHECK_EQUAL(rt.size(), 90u);
+    basictest::check_structure(rt);
+
+    // only one value is removed for each passed value
+    BOOST_CHECK_EQUAL(rt.bulk_remove(values), 50u);
+    BOOST_CHECK_EQUAL(rt.count(v), 40u);
+    basictest::check_structure(rt);
+}
+
+template <typename Value>
+void test_value()
+{
+    std::size_t const counts[][2] = { {0, 5}, {1, 1}, {3, 50}, {100, 7}, {1000, 100}, {1000, 600}, {3000, 2000} };
+    for ( auto const& c : counts )
+    {
+        test_bulk_insert_remove<Value, bgi::linear<4, 2> >(c[0], c[1]);
+        test_bulk_insert_remove<Value, bgi::quadratic<5, 2> >(c[0], c[1]);
+        test_bulk_insert_remove<Value, bgi::rstar<8, 3> >(c[0], c[1]);
+        test_bulk_insert_remove<Value>(c[0], c[1], bgi::dynamic_rstar(16, 4));
+        test_bulk_insert_remove<Value>(c[0], c[1], bgi::dynamic_linear(3, 1));
+    }
+
+    test_duplicates<Value, bgi::quadratic<4, 2> >();
+    test_duplicates<Value>(bgi::dynamic_rstar(5, 2));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+    test_value<std::pair<box_t, int> >();
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <boost/geometry/index/concurrent_rtree.hpp>
+
+template <typename Rtree1, typename Rtree2, typename Predicates>
+void check_query(Rtree1 const& rt, Rtree2 const& crt, Predicates const& pred)
+{
+    typedef typename Rtree1::value_type value_t;
+
+    std::vector<value_t> expected;
+    rt.query(pred, std::back_inserter(expected));
+
+    std::vector<value_t> result;
+    std::size_t const found = crt.query(pred, std::back_inserter(result));
+    BOOST_CHECK_EQUAL(found, result.size());
+    basictest::exactly_the_same_outputs(rt, result, expected);
+}
+
+template <typename Value, typename Params>
+void test_concurrent_rtree(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+    typedef bgi::concurrent_rtree<Value, Params> concurrent_rtree_t;
+    typedef typename rtree_t::bounds_type box_t;
+
+    std::vector<Value> values;
+    generate::values(values, 300);
+
+    rtree_t rt(params);
+    concurrent_rtree_t crt(params);
+    BOOST_CHECK(crt.empty());
+
+    for (std::size_t i = 0 ; i < values.size() / 2 ; ++i)
+    {
+        rt.insert(values[i]);
+        bgi::insert(crt, values[i]);
+    }
+    rt.insert(values.begin() + values.size() / 2, values.end());
+    crt.insert(values.begin() + values.size() / 2, values.end());
+
+    BOOST_CHECK_EQUAL(crt.size(), rt.size());
+    BOOST_CHECK(bg::equals(crt.bounds(), rt.bounds()));
+
+    for (int i = 0 ; i < 10 ; ++i)
+    {
+        typedef typename bg::point_type<box_t>::type point_t;
+        point_t min_p, max_p;
+        bg::assign_values(min_p, (i * 13) % 100, (i * 31) % 100);
+        bg::assign_values(max_p, (i * 13) % 100 + 10, (i * 31) % 100 + 10);
+        box_t qbox(min_p, max_p);
+
+        check_query(rt, crt, bgi::intersects(qbox));
+        check_query(rt, crt, bgi::nearest(min_p, 5));
+    }
+
+    // remove
+    BOOST_CHECK_EQUAL(crt.remove(values[0]), rt.remove(values[0]));
+    BOOST_CHECK_EQUAL(bgi::remove(crt, values[1]), rt.remove(values[1]));
+    BOOST_CHECK_EQUAL(crt.remove(values.begin() + 10, values.begin() + 50),
+                      rt.remove(values.begin() + 10, values.begin() + 50));
+    BOOST_CHECK_EQUAL(crt.size(), rt.size());
+
+    // modify
+    crt.modify([&](typename concurrent_rtree_t::rtree_type & tree) {
+        tree.remove(values[100]);
+        tree.insert(values[0]);
+    });
+    rt.remove(values[100]);
+    rt.insert(values[0]);
+
+    {
+        typename concurrent_rtree_t::snapshot s = crt.get_snapshot();
+        BOOST_CHECK_EQUAL(s->size(), rt.size());
+        check_query(rt, *s, bgi::intersects(rt.bounds()));
+    }
+
+    // constructors
+    concurrent_rtree_t crt2(rt);
+    BOOST_CHECK_EQUAL(crt2.size(), rt.size());
+    concurrent_rtree_t crt3(values, params);
+    BOOST_CHECK_EQUAL(crt3.size(), values.size());
+
+    crt.clear();
+    BOOST_CHECK(crt.empty());
+}
+
+// The readers check if the snapshot is consistent while the writer modifies the tree
+template <typename Value, typename Params>
+void test_concurrent_access(Params const& params = Params())
+{
+    typedef bgi::concurrent_rtree<Value, Params> concurrent_rtree_t;
+
+    std::vector<Value> values;
+    for (int i = 0 ; i < 2000 ; ++i)
+    {
+        values.push_back(generate::value<Value>::apply(i % 100, i / 100));
+    }
+
+    concurrent_rtree_t crt(params);
+    std::atomic<bool> done(false);
+    std::atomic<std::size_t> errors(0);
+
+    std::vector<std::thread> readers;
+    for (int t = 0 ; t < 3 ; ++t)
+    {
+        readers.emplace_back([&]()
+        {
+            std::size_t prev_size = 0;
+            while (! done.load())
+            {
+                typename concurrent_rtree_t::snapshot s = crt.get_snapshot();
+                std::size_t const size = s->size();
+                std::vector<Value> result;
+                if (! s->empty())
+                {
+                    s->query(bgi::intersects(s->bounds()), std::back_inserter(result));
+                }
+                // the writer only inserts so the size can't decrease
+                if (result.size() != size || size < prev_size)
+                {
+                    ++errors;
+                }
+                prev_size = size;
+            }
+        });
+    }
+
+    for (std::size_t i = 0 ; i < values.size() ; i += 10)
+    {
+        crt.insert(values.begin() + i, values.begin() + i + 10);
+    }
+    done = true;
+
+    for (std::thread & t : readers)
+    {
+        t.join();
+    }
+
+    BOOST_CHECK_EQUAL(errors.load(), 0u);
+    BOOST_CHECK_EQUAL(crt.size(), values.size());
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_concurrent_rtree<point_t, bgi::linear<4, 2> >();
+    test_concurrent_rtree<box_t, bgi::quadratic<5, 2> >();
+    test_concurrent_rtree<std::pair<box_t, int>, bgi::rstar<8, 3> >();
+    test_concurrent_rtree<point_t>(bgi::dynamic_rstar(8, 3));
+
+    test_concurrent_access<point_t, bgi::rstar<8, 3> >();
+    test_concurrent_access<box_t>(bgi::dynamic_quadratic(8, 3));
+
+    return 0;
+}
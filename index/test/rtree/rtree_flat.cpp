@@ -0,0 +1,181 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/geometry/index/flat_rtree.hpp>
+
+template <typename Value>
+bool same_values(std::vector<Value> const& values1, std::vector<Value> const& values2)
+{
+    if (values1.size() != values2.size())
+    {
+        return false;
+    }
+    for (Value const& v1 : values1)
+    {
+        bool found = false;
+        for (Value const& v2 : values2)
+        {
+            if (bg::equals(v1, v2))
+            {
+                found = true;
+                break;
+            }
+        }
+        if (! found)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Rtree, typename FlatRtree, typename Predicates>
+void check_query(Rtree const& rt, FlatRtree const& frt, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected;
+    rt.query(pred, std::back_inserter(expected));
+
+    std::vector<value_t> result;
+    BOOST_CHECK_EQUAL(frt.query(pred, std::back_inserter(result)), expected.size());
+    BOOST_CHECK(same_values(result, expected));
+
+    std::vector<value_t> result2;
+    bgi::query(frt, pred, std::back_inserter(result2));
+    BOOST_CHECK(same_values(result2, expected));
+}
+
+// the values may be different in case of equal distances so compare the distances
+template <typename Rtree, typename FlatRtree, typename Geometry, typename Predicates>
+void check_nearest(Rtree const& rt, FlatRtree const& frt, Geometry const& g, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected;
+    rt.query(pred, std::back_inserter(expected));
+
+    std::vector<value_t> result;
+    BOOST_CHECK_EQUAL(frt.query(pred, std::back_inserter(result)), expected.size());
+    BOOST_CHECK_EQUAL(result.size(), expected.size());
+
+    std::vector<double> expected_dist, result_dist;
+    for (value_t const& v : expected)
+    {
+        expected_dist.push_back(bg::comparable_distance(g, v));
+    }
+    for (value_t const& v : result)
+    {
+        result_dist.push_back(bg::comparable_distance(g, v));
+    }
+    std::sort(expected_dist.begin(), expected_dist.end());
+    std::sort(result_dist.begin(), result_dist.end());
+    BOOST_CHECK(expected_dist == result_dist);
+}
+
+// returns true for each second value
+struct odd_x
+{
+    template <typename Value>
+    bool operator()(Value const& v) const
+    {
+        typedef bg::model::box<bg::model::point<double, 2, bg::cs::cartesian> > box_t;
+        return int(bg::get<bg::min_corner, 0>(bg::return_envelope<box_t>(v))) % 2 == 1;
+    }
+};
+
+template <typename Value, typename Params>
+void test_flat_rtree(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+    typedef bgi::flat_rtree<Value, Params> flat_rtree_t;
+    typedef typename rtree_t::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    std::size_t const counts[] = { 0, 1, 5, 17, 1000 };
+    for (std::size_t count : counts)
+    {
+        std::vector<Value> values;
+        generate::values(values, count);
+
+        rtree_t rt(params);
+        for (Value const& v : values)
+        {
+            rt.insert(v);
+        }
+
+        flat_rtree_t frt(rt);
+        flat_rtree_t frt_pack(values, params);
+
+        BOOST_CHECK_EQUAL(frt.size(), rt.size());
+        BOOST_CHECK_EQUAL(frt.empty(), rt.empty());
+        BOOST_CHECK_EQUAL(frt_pack.size(), values.size());
+        if (! rt.empty())
+        {
+            BOOST_CHECK(bg::equals(frt.bounds(), rt.bounds()));
+        }
+
+        // the values are stored in the order of leafs
+        std::vector<Value> rt_values(rt.begin(), rt.end());
+        std::vector<Value> frt_values(frt.begin(), frt.end());
+        BOOST_CHECK_EQUAL(rt_values.size(), frt_values.size());
+        for (std::size_t i = 0 ; i < rt_values.size() && i < frt_values.size() ; ++i)
+        {
+            BOOST_CHECK(bg::equals(rt_values[i], frt_values[i]));
+        }
+
+        rtree_t rt_pack(values, params);
+
+        for (int i = 0 ; i < 10 ; ++i)
+        {
+            point_t min_p, max_p, pt;
+            bg::assign_values(min_p, (i * 13) % 100, (i * 31) % 100);
+            bg::assign_values(max_p, (i * 13) % 100 + 5 + i, (i * 31) % 100 + 3 + i);
+            bg::assign_values(pt, (i * 17) % 100, (i * 23) % 100);
+            box_t b(min_p, max_p);
+
+            check_query(rt, frt, bgi::intersects(b));
+            check_query(rt, frt, bgi::within(b));
+            check_query(rt, frt, bgi::intersects(b) && !bgi::covered_by(b));
+            check_query(rt, frt, bgi::intersects(b) && bgi::satisfies(odd_x()));
+            check_query(rt_pack, frt_pack, bgi::intersects(b));
+
+            check_nearest(rt, frt, pt, bgi::nearest(pt, 5));
+            check_nearest(rt, frt, pt, bgi::nearest(pt, 1));
+            check_nearest(rt, frt, pt, bgi::nearest(pt, 5) && bgi::satisfies(odd_x()));
+            check_nearest(rt, frt, b, bgi::nearest(b, 3));
+            check_nearest(rt_pack, frt_pack, pt, bgi::nearest(pt, 7));
+        }
+    }
+}
+
+template <typename Value>
+void test_value()
+{
+    test_flat_rtree<Value, bgi::linear<4, 2> >();
+    test_flat_rtree<Value, bgi::quadratic<5, 2> >();
+    test_flat_rtree<Value, bgi::rstar<16, 4> >();
+    test_flat_rtree<Value>(bgi::dynamic_rstar(8, 3));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/index/flat_rtree_aggregates.hpp>
+
+// the sum of the integers stored in the values
+struct sum_aggregate
+{
+    typedef long result_type;
+
+    result_type identity() const { return 0; }
+
+    template <typename Box>
+    result_type value(std::pair<Box, int> const& v) const { return v.second; }
+
+    result_type combine(result_type a, result_type b) const { return a + b; }
+};
+
+// the envelope of the values
+template <typename Box>
+struct envelope_aggregate
+{
+    typedef Box result_type;
+
+    result_type identity() const
+    {
+        Box result;
+        bg::assign_inverse(result);
+        return result;
+    }
+
+    template <typename Value>
+    result_type value(Value const& v) const
+    {
+        Box result;
+        bg::envelope(bgi::indexable<Value>()(v), result);
+        return result;
+    }
+
+    result_type combine(result_type a, result_type const& b) const
+    {
+        bg::expand(a, b);
+        return a;
+    }
+};
+
+template <typename FlatRtree, typename Box>
+void check_aggregates(FlatRtree const& frt, Box const& qbox)
+{
+    typedef typename FlatRtree::value_type value_t;
+
+    bgi::flat_rtree_aggregates<FlatRtree> counts(frt);
+    bgi::flat_rtree_aggregates<FlatRtree, sum_aggregate> sums(frt);
+    bgi::flat_rtree_aggregates<FlatRtree, envelope_aggregate<Box> > envelopes(frt);
+
+    std::size_t expected_count = 0;
+    long expected_sum = 0;
+    Box expected_envelope = envelope_aggregate<Box>().identity();
+    for (value_t const& v : frt)
+    {
+        if (bg::intersects(v.first, qbox))
+        {
+            ++expected_count;
+            expected_sum += v.second;
+            bg::expand(expected_envelope, v.first);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(counts.query(qbox), expected_count);
+    BOOST_CHECK_EQUAL(sums.query(qbox), expected_sum);
+    if (expected_count > 0)
+    {
+        BOOST_CHECK(bg::equals(envelopes.query(qbox), expected_envelope));
+    }
+
+    BOOST_CHECK_EQUAL(counts.total(), frt.size());
+
+    std::vector<value_t> result;
+    frt.query(bgi::intersects(qbox), std::back_inserter(result));
+    BOOST_CHECK_EQUAL(result.size(), expected_count);
+}
+
+template <typename Params>
+void test_flat_aggregates(Params const& params = Params())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef std::pair<box_t, int> value_t;
+    typedef bgi::flat_rtree<value_t, Params> flat_rtree_t;
+
+    std::vector<value_t> values;
+    for (int i = 0 ; i < 2000 ; ++i)
+    {
+        double const x = i * 7919 % 113;
+        double const y = i * 104729 % 107;
+        values.push_back(value_t(box_t(point_t(x, y), point_t(x + i % 3, y + i % 5)), i));
+    }
+
+    flat_rtree_t frt(values, params);
+    flat_rtree_t empty_frt(params);
+    flat_rtree_t small_frt(std::vector<value_t>(values.begin(), values.begin() + 2), params);
+
+    box_t qboxes[] = {
+        box_t(point_t(20, 30), point_t(70, 60)),
+        box_t(point_t(0, 0), point_t(10, 10)),
+        box_t(point_t(-10, -10), point_t(200, 200)),
+        box_t(point_t(500, 500), point_t(600, 600)),
+        box_t(point_t(50, 50), point_t(50, 50))
+    };
+
+    for (box_t const& qbox : qboxes)
+    {
+        check_aggregates(frt, qbox);
+        check_aggregates(empty_frt, qbox);
+        check_aggregates(small_frt, qbox);
+    }
+
+    bgi::flat_rtree_aggregates<flat_rtree_t> empty_counts(empty_frt);
+    BOOST_CHECK_EQUAL(empty_counts.total(), 0u);
+}
+
+int test_main(int, char* [])
+{
+    test_flat_aggregates<bgi::linear<4, 2> >();
+    test_flat_aggregates<bgi::quadratic<5, 2> >();
+    test_flat_aggregates<bgi::rstar<8, 3> >();
+    test_flat_aggregates<bgi::rstar<32, 8> >();
+    test_flat_aggregates(bgi::dynamic_rstar(16, 4));
+
+    return 0;
+}
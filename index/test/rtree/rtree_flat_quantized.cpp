@@ -0,0 +1,228 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <boost/geometry/index/flat_rtree.hpp>
+
+template <typename Value>
+bool same_values(std::vector<Value> const& values1, std::vector<Value> const& values2)
+{
+    if (values1.size() != values2.size())
+    {
+        return false;
+    }
+    for (Value const& v1 : values1)
+    {
+        bool found = false;
+        for (Value const& v2 : values2)
+        {
+            if (bg::equals(v1, v2))
+            {
+                found = true;
+                break;
+            }
+        }
+        if (! found)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Rtree, typename QuantizedRtree, typename Predicates>
+void check_query(Rtree const& rt, QuantizedRtree const& qrt, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected;
+    rt.query(pred, std::back_inserter(expected));
+
+    std::vector<value_t> result;
+    BOOST_CHECK_EQUAL(qrt.query(pred, std::back_inserter(result)), expected.size());
+    BOOST_CHECK(same_values(result, expected));
+
+    std::vector<value_t> result2;
+    bgi::query(qrt, pred, std::back_inserter(result2));
+    BOOST_CHECK(same_values(result2, expected));
+}
+
+// the values may be different in case of equal distances so compare the distances
+template <typename Rtree, typename QuantizedRtree, typename Geometry, typename Predicates>
+void check_nearest(Rtree const& rt, QuantizedRtree const& qrt, Geometry const& g, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected;
+    rt.query(pred, std::back_inserter(expected));
+
+    std::vector<value_t> result;
+    BOOST_CHECK_EQUAL(qrt.query(pred, std::back_inserter(result)), expected.size());
+    BOOST_CHECK_EQUAL(result.size(), expected.size());
+
+    std::vector<double> expected_dist, result_dist;
+    for (value_t const& v : expected)
+    {
+        expected_dist.push_back(bg::comparable_distance(g, v));
+    }
+    for (value_t const& v : result)
+    {
+        result_dist.push_back(bg::comparable_distance(g, v));
+    }
+    std::sort(expected_dist.begin(), expected_dist.end());
+    std::sort(result_dist.begin(), result_dist.end());
+    BOOST_CHECK(expected_dist == result_dist);
+}
+
+// returns true for each second value
+struct odd_x
+{
+    template <typename Value>
+    bool operator()(Value const& v) const
+    {
+        typedef bg::model::box<bg::model::point<double, 2, bg::cs::cartesian> > box_t;
+        return int(bg::get<bg::min_corner, 0>(bg::return_envelope<box_t>(v))) % 2 == 1;
+    }
+};
+
+template <typename Value, typename Quantized, typename Params>
+void test_quantized_flat_rtree(std::vector<Value> const& values, Params const& params)
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+    typedef bgi::flat_rtree
+        <
+            Value, Params, bgi::indexable<Value>, bgi::equal_to<Value>,
+            boost::container::new_allocator<Value>, bgi::flat::quantized_layout<Quantized>
+        > quantized_rtree_t;
+    typedef typename rtree_t::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    rtree_t rt(params);
+    for (Value const& v : values)
+    {
+        rt.insert(v);
+    }
+
+    quantized_rtree_t qrt(rt);
+    quantized_rtree_t qrt_pack(values, params);
+
+    BOOST_CHECK_EQUAL(qrt.size(), rt.size());
+    BOOST_CHECK_EQUAL(qrt.empty(), rt.empty());
+    BOOST_CHECK_EQUAL(qrt_pack.size(), values.size());
+    if (! rt.empty())
+    {
+        // the box of the root is stored with full precision
+        BOOST_CHECK(bg::equals(qrt.bounds(), rt.bounds()));
+    }
+
+    rtree_t rt_pack(values, params);
+
+    box_t const bounds = rt.empty() ? box_t() : rt.bounds();
+    double const w = bg::get<bg::max_corner, 0>(bounds) - bg::get<bg::min_corner, 0>(bounds);
+    double const h = bg::get<bg::max_corner, 1>(bounds) - bg::get<bg::min_corner, 1>(bounds);
+    for (int i = 0 ; i < 10 ; ++i)
+    {
+        double const x = bg::get<bg::min_corner, 0>(bounds) + w * ((i * 13) % 100) / 100;
+        double const y = bg::get<bg::min_corner, 1>(bounds) + h * ((i * 31) % 100) / 100;
+        point_t min_p(x, y), max_p(x + w * (5 + i) / 100, y + h * (3 + i) / 100);
+        point_t pt(bg::get<bg::min_corner, 0>(bounds) + w * ((i * 17) % 100) / 100,
+                   bg::get<bg::min_corner, 1>(bounds) + h * ((i * 23) % 100) / 100);
+        box_t b(min_p, max_p);
+
+        check_query(rt, qrt, bgi::intersects(b));
+        check_query(rt, qrt, bgi::within(b));
+        check_query(rt, qrt, bgi::intersects(b) && !bgi::covered_by(b));
+        check_query(rt, qrt, bgi::intersects(b) && bgi::satisfies(odd_x()));
+        check_query(rt_pack, qrt_pack, bgi::intersects(b));
+        // the values touching the bounds of the nodes
+        check_query(rt, qrt, bgi::intersects(rt.bounds()));
+        check_query(rt, qrt, bgi::intersects(rt.bounds().min_corner()));
+
+        check_nearest(rt, qrt, pt, bgi::nearest(pt, 5));
+        check_nearest(rt, qrt, pt, bgi::nearest(pt, 1));
+        check_nearest(rt, qrt, pt, bgi::nearest(pt, 5) && bgi::satisfies(odd_x()));
+        check_nearest(rt, qrt, b, bgi::nearest(b, 3));
+        check_nearest(rt_pack, qrt_pack, pt, bgi::nearest(pt, 7));
+    }
+}
+
+template <typename Value, typename Params>
+void test_quantized(Params const& params = Params())
+{
+    std::size_t const counts[] = { 0, 1, 5, 17, 1000 };
+    for (std::size_t count : counts)
+    {
+        std::vector<Value> values;
+        generate::values(values, count);
+
+        test_quantized_flat_rtree<Value, std::uint16_t>(values, params);
+        test_quantized_flat_rtree<Value, std::uint8_t>(values, params);
+    }
+}
+
+// the flat_rtree stores the boxes with full precision by default
+template <typename Value, typename Params>
+void test_layout_tag()
+{
+    typedef bgi::flat_rtree
+        <
+            Value, Params, bgi::indexable<Value>, bgi::equal_to<Value>,
+            boost::container::new_allocator<Value>, bgi::flat::quantized_layout<>
+        > qrt_t;
+
+    BOOST_CHECK((std::is_same<typename qrt_t::layout_tag, bgi::flat::quantized_layout<std::uint16_t> >::value));
+    BOOST_CHECK((std::is_same<typename bgi::flat_rtree<Value, Params>::layout_tag, bgi::flat::layout>::value));
+}
+
+// the coordinates which can't be represented exactly, far from the origin
+template <typename Params>
+void test_quantized_far(Params const& params = Params())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+
+    std::vector<point_t> values;
+    for (std::size_t i = 0 ; i < 3000 ; ++i)
+    {
+        values.push_back(point_t(1e7 + 0.1 * double(i * 7919 % 1009), -3e5 + 0.3 * double(i * 104729 % 997)));
+    }
+
+    test_quantized_flat_rtree<point_t, std::uint16_t>(values, params);
+    test_quantized_flat_rtree<point_t, std::uint8_t>(values, params);
+}
+
+template <typename Value>
+void test_value()
+{
+    test_quantized<Value, bgi::linear<4, 2> >();
+    test_quantized<Value, bgi::quadratic<5, 2> >();
+    test_quantized<Value, bgi::rstar<16, 4> >();
+    test_quantized<Value>(bgi::dynamic_rstar(8, 3));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+
+    test_quantized_far<bgi::rstar<16, 4> >();
+    test_quantized_far<bgi::linear<32, 8> >();
+
+    test_layout_tag<point_t, bgi::rstar<16, 4> >();
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/util/thread_executor.hpp>
+
+struct x_less_than
+{
+    explicit x_less_than(double v) : value(v) {}
+
+    template <typename Value1, typename Value2>
+    bool operator()(Value1 const& v1, Value2 const& ) const
+    {
+        typedef bg::model::box<bg::model::point<double, 2, bg::cs::cartesian> > box_t;
+        return bg::get<bg::min_corner, 0>(bg::return_envelope<box_t>(v1)) < value;
+    }
+
+    double value;
+};
+
+template <typename Rtree1, typename Rtree2, typename Result, typename Pred>
+void expected_join(Rtree1 const& rt1, Rtree2 const& rt2, Pred const& pred, std::vector<Result> & result)
+{
+    typedef typename Rtree2::value_type value2_t;
+    for (auto const& v1 : rt1)
+    {
+        std::vector<value2_t> found;
+        rt2.query(bgi::intersects(rt1.indexable_get()(v1)), std::back_inserter(found));
+        for (value2_t const& v2 : found)
+        {
+            if (pred(v1, v2))
+            {
+                result.push_back(Result(v1, v2));
+            }
+        }
+    }
+}
+
+template <typename Result>
+bool contains_pair(std::vector<Result> const& results, Result const& r)
+{
+    for (Result const& s : results)
+    {
+        if (bg::equals(s.first, r.first) && bg::equals(s.second, r.second))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Result>
+void check_results(std::vector<Result> const& results, std::vector<Result> const& expected)
+{
+    BOOST_CHECK_EQUAL(results.size(), expected.size());
+    for (Result const& r : results)
+    {
+        BOOST_CHECK(contains_pair(expected, r));
+    }
+}
+
+template <typename Result>
+void check_identical(std::vector<Result> const& results1, std::vector<Result> const& results2)
+{
+    BOOST_CHECK_EQUAL(results1.size(), results2.size());
+    for (std::size_t i = 0 ; i < results1.size() && i < results2.size() ; ++i)
+    {
+        BOOST_CHECK(bg::equals(results1[i].first, results2[i].first)
+                 && bg::equals(results1[i].second, results2[i].second));
+    }
+}
+
+template <typename Value1, typename Value2, typename Params1, typename Params2>
+void test_join(Params1 const& params1, Params2 const& params2)
+{
+    typedef bgi::rtree<Value1, Params1> rtree1_t;
+    typedef bgi::rtree<Value2, Params2> rtree2_t;
+    typedef std::pair<Value1, Value2> result_t;
+
+    std::size_t const counts[] = { 0, 1, 17, 300 };
+    for (std::size_t count1 : counts)
+    {
+        for (std::size_t count2 : counts)
+        {
+            std::vector<Value1> values1;
+            std::vector<Value2> values2;
+            generate::values(values1, count1);
+            generate::values(values2, count2, 101, 97, 3);
+
+            rtree1_t rt1(values1, params1);
+            rtree2_t rt2(values2, params2);
+
+            bgi::detail::rtree::visitors::join_always_true always_true;
+            std::vector<result_t> expected;
+            expected_join(rt1, rt2, always_true, expected);
+
+            std::vector<result_t> result;
+            std::size_t found = bgi::join(rt1, rt2, std::back_inserter(result));
+            BOOST_CHECK_EQUAL(found, result.size());
+            check_results(result, expected);
+
+            x_less_than pred(50);
+            std::vector<result_t> expected_pred;
+            expected_join(rt1, rt2, pred, expected_pred);
+
+            std::vector<result_t> result_pred;
+            found = bgi::join(rt1, rt2, pred, std::back_inserter(result_pred));
+            BOOST_CHECK_EQUAL(found, result_pred.size());
+            check_results(result_pred, expected_pred);
+
+            std::vector<result_t> result_par;
+            found = bgi::join(rt1, rt2, pred, std::back_inserter(result_par),
+                              bg::util::thread_executor(3));
+            BOOST_CHECK_EQUAL(found, result_par.size());
+            check_identical(result_pred, result_par);
+
+            std::vector<result_t> result_seq;
+            rt1.join(rt2, pred, std::back_inserter(result_seq), bg::util::sequential_executor());
+            check_identical(result_pred, result_seq);
+        }
+    }
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_join<box_t, box_t>(bgi::quadratic<5, 2>(), bgi::quadratic<5, 2>());
+    test_join<point_t, box_t>(bgi::linear<4, 2>(), bgi::rstar<8, 3>());
+    test_join<box_t, point_t>(bgi::dynamic_rstar(16, 4), bgi::quadratic<5, 2>());
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/io/wkt/read.hpp>
+
+#include <boost/geometry/index/detail/rtree/utilities/print.hpp>
+
+template <typename Value>
+bool same_ids(std::vector<Value> result, std::vector<Value> expected)
+{
+    auto less = [](Value const& l, Value const& r) { return l.second < r.second; };
+    std::sort(result.begin(), result.end(), less);
+    std::sort(expected.begin(), expected.end(), less);
+    return result.size() == expected.size()
+        && std::equal(result.begin(), result.end(), expected.begin(),
+                      [](Value const& l, Value const& r) { return l.second == r.second; });
+}
+
+template <typename Rtree, typename Predicates, typename Check>
+void check_query(Rtree const& rt, std::vector<typename Rtree::value_type> const& values,
+                 Predicates const& pred, Check const& check)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected;
+    for (value_t const& v : values)
+    {
+        if (check(v.first))
+        {
+            expected.push_back(v);
+        }
+    }
+
+    std::vector<value_t> result;
+    BOOST_CHECK_EQUAL(rt.query(pred, std::back_inserter(result)), expected.size());
+    BOOST_CHECK(same_ids(result, expected));
+}
+
+template <typename Params>
+void test_linestring(Params const& params = Params())
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef bg::model::linestring<point_t> linestring_t;
+    typedef bg::model::polygon<point_t> polygon_t;
+    typedef std::pair<linestring_t, int> value_t;
+    typedef bgi::rtree<value_t, Params> rtree_t;
+
+    // diagonal polylines, the envelopes of many of them intersect the query polygon
+    std::vector<value_t> values;
+    for (int i = 0 ; i < 500 ; ++i)
+    {
+        double const x = i * 7919 % 97;
+        double const y = i * 104729 % 89;
+        linestring_t ls;
+        ls.push_back(point_t(x, y));
+        ls.push_back(point_t(x + 5, y + 5));
+        ls.push_back(point_t(x + 10, y + 4 + i % 7));
+        values.push_back(value_t(ls, i));
+    }
+
+    polygon_t poly;
+    bg::read_wkt("POLYGON((30 30,30 60,60 60,60 40,45 40,45 30,30 30))", poly);
+    box_t qbox(point_t(20, 20), point_t(40, 50));
+    point_t pt(50, 50);
+
+    rtree_t rt(params);
+    for (value_t const& v : values)
+    {
+        rt.insert(v);
+    }
+    basictest::check_structure(rt);
+
+    rtree_t packed(values, params);
+    basictest::check_structure(packed);
+
+    // the linestrings are printed as sequences of points
+    {
+        rtree_t single(params);
+        single.insert(values[0]);
+        std::ostringstream oss;
+        bgi::detail::rtree::utilities::print(oss, single);
+        BOOST_CHECK(oss.str().find("(0, 0)-(5, 5)-(10, 4)") != std::string::npos);
+    }
+
+    for (rtree_t const* r : {&rt, &packed})
+    {
+        check_query(*r, values, bgi::intersects(poly),
+                    [&](linestring_t const& ls) { return bg::intersects(ls, poly); });
+        check_query(*r, values, bgi::disjoint(poly),
+                    [&](linestring_t const& ls) { return bg::disjoint(ls, poly); });
+        check_query(*r, values, bgi::intersects(qbox),
+                    [&](linestring_t const& ls) { return bg::intersects(ls, qbox); });
+        check_query(*r, values, bgi::covered_by(qbox),
+                    [&](linestring_t const& ls) { return bg::covered_by(ls, qbox); });
+        check_query(*r, values, bgi::within_distance(pt, 5.0),
+                    [&](linestring_t const& ls) { return bg::distance(pt, ls) <= 5.0; });
+
+        // the query checks the linestrings, not only their envelopes
+        std::size_t envelopes_count = 0;
+        std::size_t exact_count = 0;
+        for (value_t const& v : values)
+        {
+            envelopes_count += bg::intersects(bg::return_envelope<box_t>(v.first), poly) ? 1 : 0;
+            exact_count += bg::intersects(v.first, poly) ? 1 : 0;
+        }
+        BOOST_CHECK(exact_count < envelopes_count);
+        std::vector<value_t> found;
+        BOOST_CHECK_EQUAL(r->query(bgi::intersects(poly), std::back_inserter(found)), exact_count);
+        for (value_t const& v : found)
+        {
+            BOOST_CHECK(bg::intersects(v.first, poly));
+        }
+
+        // k nearest
+        std::vector<value_t> result;
+        r->query(bgi::nearest(pt, 10), std::back_inserter(result));
+        BOOST_CHECK_EQUAL(result.size(), 10u);
+        std::vector<double> dists;
+        for (value_t const& v : values)
+        {
+            dists.push_back(bg::comparable_distance(pt, v.first));
+        }
+        std::sort(dists.begin(), dists.end());
+        double max_dist = 0;
+        for (value_t const& v : result)
+        {
+            max_dist = (std::max)(max_dist, double(bg::comparable_distance(pt, v.first)));
+        }
+        BOOST_CHECK_EQUAL(max_dist, dists[9]);
+    }
+
+    // remove half of the values
+    std::vector<value_t> remaining;
+    for (value_t const& v : values)
+    {
+        if (v.second % 2 == 0)
+        {
+            BOOST_CHECK_EQUAL(rt.remove(v), 1u);
+        }
+        else
+        {
+            remaining.push_back(v);
+        }
+    }
+    basictest::check_structure(rt);
+    BOOST_CHECK_EQUAL(rt.size(), remaining.size());
+    check_query(rt, remaining, bgi::intersects(poly),
+                [&](linestring_t const& ls) { return bg::intersects(ls, poly); });
+}
+
+int test_main(int, char* [])
+{
+    test_linestring<bgi::linear<4, 2> >();
+    test_linestring<bgi::quadratic<5, 2> >();
+    test_linestring<bgi::rstar<8, 3> >();
+    test_linestring(bgi::dynamic_rstar(16, 4));
+
+    return 0;
+}
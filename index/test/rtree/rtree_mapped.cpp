@@ -0,0 +1,170 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/geometry/index/mapped_rtree.hpp>
+
+// The buffer aligned as the memory returned by mmap
+struct image_buffer
+{
+    explicit image_buffer(std::string const& str)
+        : m_storage(str.size() / sizeof(std::uint64_t) + 1)
+        , m_size(str.size())
+    {
+        std::memcpy(m_storage.data(), str.data(), str.size());
+    }
+
+    char * data() { return reinterpret_cast<char *>(m_storage.data()); }
+    std::size_t size() const { return m_size; }
+
+private:
+    std::vector<std::uint64_t> m_storage;
+    std::size_t m_size;
+};
+
+template <typename Value>
+bool equal_values(std::vector<Value> const& values1, std::vector<Value> const& values2)
+{
+    if (values1.size() != values2.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0 ; i < values1.size() ; ++i)
+    {
+        if (! bgi::equal_to<Value>()(values1[i], values2[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename FlatRtree, typename MappedRtree, typename Predicates>
+void check_query(FlatRtree const& frt, MappedRtree const& mrt, Predicates const& pred)
+{
+    typedef typename FlatRtree::value_type value_t;
+
+    std::vector<value_t> expected;
+    frt.query(pred, std::back_inserter(expected));
+
+    // the structure is the same so the results are returned in the same order
+    std::vector<value_t> result;
+    BOOST_CHECK_EQUAL(mrt.query(pred, std::back_inserter(result)), expected.size());
+    BOOST_CHECK(equal_values(result, expected));
+
+    std::vector<value_t> result2;
+    bgi::query(mrt, pred, std::back_inserter(result2));
+    BOOST_CHECK(equal_values(result2, expected));
+}
+
+template <typename MappedRtree, typename Params>
+void check_throws(char const* data, std::size_t size, Params const& params)
+{
+    bool thrown = false;
+    try
+    {
+        MappedRtree mrt(data, size, params);
+        BOOST_CHECK(mrt.empty());
+    }
+    catch (std::runtime_error const&)
+    {
+        thrown = true;
+    }
+    BOOST_CHECK(thrown);
+}
+
+template <typename Value, typename Params>
+void test_mapped_rtree(Params const& params = Params())
+{
+    typedef bgi::flat_rtree<Value, Params> flat_rtree_t;
+    typedef bgi::mapped_rtree<Value, Params> mapped_rtree_t;
+    typedef typename flat_rtree_t::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    std::size_t const counts[] = { 0, 1, 5, 17, 1000 };
+    for (std::size_t count : counts)
+    {
+        std::vector<Value> values;
+        generate::values(values, count);
+
+        flat_rtree_t frt(values, params);
+
+        std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+        frt.save(ss);
+        image_buffer image(ss.str());
+
+        mapped_rtree_t mrt(image.data(), image.size(), params);
+
+        BOOST_CHECK_EQUAL(mrt.size(), frt.size());
+        BOOST_CHECK_EQUAL(mrt.empty(), frt.empty());
+        if (! frt.empty())
+        {
+            BOOST_CHECK(bg::equals(mrt.bounds(), frt.bounds()));
+        }
+        BOOST_CHECK(equal_values(std::vector<Value>(mrt.begin(), mrt.end()),
+                                 std::vector<Value>(frt.begin(), frt.end())));
+
+        for (int i = 0 ; i < 10 ; ++i)
+        {
+            point_t min_p, max_p, pt;
+            bg::assign_values(min_p, (i * 13) % 100, (i * 31) % 100);
+            bg::assign_values(max_p, (i * 13) % 100 + 5 + i, (i * 31) % 100 + 3 + i);
+            bg::assign_values(pt, (i * 17) % 100, (i * 23) % 100);
+            box_t b(min_p, max_p);
+
+            check_query(frt, mrt, bgi::intersects(b));
+            check_query(frt, mrt, bgi::within(b));
+            check_query(frt, mrt, bgi::intersects(b) && !bgi::covered_by(b));
+            check_query(frt, mrt, bgi::nearest(pt, 5));
+            check_query(frt, mrt, bgi::nearest(b, 3));
+        }
+
+        // truncated image
+        check_throws<mapped_rtree_t>(image.data(), image.size() - 1, params);
+        check_throws<mapped_rtree_t>(image.data(), 10, params);
+        check_throws<mapped_rtree_t>(0, 0, params);
+
+        // the image of different Values
+        typedef bg::model::point<float, 2, bg::cs::cartesian> other_t;
+        check_throws<bgi::mapped_rtree<other_t, Params> >(image.data(), image.size(), params);
+
+        // invalid magic number
+        image_buffer invalid(ss.str());
+        invalid.data()[0] = 'X';
+        check_throws<mapped_rtree_t>(invalid.data(), invalid.size(), params);
+    }
+}
+
+template <typename Value>
+void test_value()
+{
+    test_mapped_rtree<Value, bgi::linear<4, 2> >();
+    test_mapped_rtree<Value, bgi::quadratic<5, 2> >();
+    test_mapped_rtree<Value, bgi::rstar<16, 4> >();
+    test_mapped_rtree<Value>(bgi::dynamic_rstar(8, 3));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+    test_value<std::pair<box_t, int> >();
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <algorithm>
+#include <vector>
+
+template <typename Rtree, typename Geometry, typename Predicates>
+void check_nearest_iterator(Rtree const& rt, Geometry const& g, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+    typedef typename Rtree::indexable_type indexable_t;
+
+    std::vector<value_t> expected;
+    rt.query(pred, std::back_inserter(expected));
+
+    std::vector<double> expected_dist;
+    for (value_t const& v : expected)
+    {
+        expected_dist.push_back(bg::comparable_distance(g, bgi::indexable<value_t>()(v)));
+    }
+    std::sort(expected_dist.begin(), expected_dist.end());
+
+    std::vector<value_t> result;
+    std::vector<double> result_dist;
+    for (auto it = rt.nearest_qbegin(pred) ; it != rt.nearest_qend() ; ++it)
+    {
+        indexable_t const& i = bgi::indexable<value_t>()(*it);
+        BOOST_CHECK_CLOSE(double(it.comparable_distance()), double(bg::comparable_distance(g, i)), 0.0001);
+        BOOST_CHECK_CLOSE(double(it.distance()), double(bg::distance(g, i)), 0.0001);
+        result.push_back(*it);
+        result_dist.push_back(it.comparable_distance());
+    }
+
+    // the values are returned in the order of increasing distances,
+    // the values may be different in case of equal distances
+    BOOST_CHECK_EQUAL(result.size(), expected.size());
+    BOOST_CHECK(std::is_sorted(result_dist.begin(), result_dist.end()));
+    BOOST_CHECK(result_dist == expected_dist);
+}
+
+template <typename Rtree, typename Point>
+void check_nearest_until(Rtree const& rt, Point const& pt, double max_distance)
+{
+    typedef typename Rtree::value_type value_t;
+
+    // stop when the values are too far, k is greater than the number of values
+    std::size_t count = 0;
+    for (auto it = rt.nearest_qbegin(bgi::nearest(pt, rt.size() + 1)) ; it != rt.nearest_qend() ; ++it)
+    {
+        if (it.distance() > max_distance)
+            break;
+        ++count;
+    }
+
+    std::size_t expected = 0;
+    for (value_t const& v : rt)
+    {
+        if (bg::distance(pt, bgi::indexable<value_t>()(v)) <= max_distance)
+            ++expected;
+    }
+
+    BOOST_CHECK_EQUAL(count, expected);
+}
+
+template <typename Value, typename Params>
+void test_nearest_iterator(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+    typedef typename rtree_t::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    std::vector<Value> values;
+    generate::values(values, 500, 113, 107);
+
+    rtree_t rt(values, params);
+    rtree_t empty_rt(params);
+
+    point_t pt(50, 40);
+    box_t qbox;
+    bg::assign_values(qbox, 20, 30, 70, 60);
+
+    check_nearest_iterator(rt, pt, bgi::nearest(pt, 1));
+    check_nearest_iterator(rt, pt, bgi::nearest(pt, 10));
+    check_nearest_iterator(rt, pt, bgi::nearest(pt, 100));
+    check_nearest_iterator(rt, pt, bgi::nearest(pt, 1000));
+    check_nearest_iterator(rt, pt, bgi::nearest(pt, 0));
+    check_nearest_iterator(rt, pt, bgi::nearest(pt, 20) && bgi::intersects(qbox));
+    check_nearest_iterator(rt, pt, bgi::nearest(pt, 20) && bgi::disjoint(qbox));
+    check_nearest_iterator(empty_rt, pt, bgi::nearest(pt, 10));
+
+    check_nearest_until(rt, pt, 10.0);
+    check_nearest_until(rt, point_t(0, 0), 5.0);
+    check_nearest_until(empty_rt, pt, 10.0);
+
+    // copy of the iterator returns the same values
+    auto it = rt.nearest_qbegin(bgi::nearest(pt, 10));
+    ++it;
+    auto it2 = it;
+    for ( ; it != rt.nearest_qend() ; ++it, ++it2)
+    {
+        BOOST_CHECK(it2 != rt.nearest_qend());
+        BOOST_CHECK(bg::equals(*it, *it2));
+        BOOST_CHECK_EQUAL(it.comparable_distance(), it2.comparable_distance());
+    }
+    BOOST_CHECK(it2 == rt.nearest_qend());
+}
+
+template <typename Value>
+void test_value()
+{
+    test_nearest_iterator<Value, bgi::linear<4, 2> >();
+    test_nearest_iterator<Value, bgi::quadratic<5, 2> >();
+    test_nearest_iterator<Value, bgi::rstar<8, 3> >();
+    test_nearest_iterator<Value>(bgi::dynamic_rstar(16, 4));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/index/node_pool_allocator.hpp>
+
+template <typename Rtree, typename Value, typename Box>
+void check_query(Rtree const& rt, std::vector<Value> const& expected, Box const& qbox)
+{
+    BOOST_CHECK_EQUAL(rt.size(), expected.size());
+
+    std::vector<Value> expected_output;
+    for ( Value const& v : expected )
+    {
+        if ( bg::intersects(bgi::indexable<Value>()(v), qbox) )
+        {
+            expected_output.push_back(v);
+        }
+    }
+
+    std::vector<Value> output;
+    rt.query(bgi::intersects(qbox), std::back_inserter(output));
+    basictest::compare_outputs(rt, output, expected_output);
+}
+
+template <typename Value, typename Params>
+void test_node_pool_allocator(Params const& params = Params())
+{
+    typedef bgi::node_pool_allocator<Value> allocator_t;
+    typedef bgi::rtree<Value, Params, bgi::indexable<Value>, bgi::equal_to<Value>, allocator_t> rtree_t;
+    typedef typename rtree_t::bounds_type box_t;
+
+    std::vector<Value> values;
+    generate::values(values, 1000, 113, 107);
+
+    box_t qbox;
+    bg::assign_values(qbox, 20, 30, 70, 60);
+
+    allocator_t alloc(16);
+    rtree_t rt(params, bgi::indexable<Value>(), bgi::equal_to<Value>(), alloc);
+    BOOST_CHECK(rt.get_allocator() == alloc);
+    BOOST_CHECK_EQUAL(alloc.capacity(), 0u);
+
+    rt.insert(values.begin(), values.end());
+    basictest::check_structure(rt);
+    check_query(rt, values, qbox);
+    BOOST_CHECK(alloc.capacity() > 0u);
+
+    // remove and insert again, the released nodes are reused
+    std::vector<Value> remaining(values.begin() + values.size() / 2, values.end());
+    rt.remove(values.begin(), values.begin() + values.size() / 2);
+    basictest::check_structure(rt);
+    check_query(rt, remaining, qbox);
+
+    rt.insert(values.begin(), values.begin() + values.size() / 2);
+    basictest::check_structure(rt);
+    check_query(rt, values, qbox);
+
+    // the copy uses its own pool
+    rtree_t copy(rt);
+    BOOST_CHECK(!(copy.get_allocator() == rt.get_allocator()));
+    check_query(copy, values, qbox);
+    BOOST_CHECK(copy.get_allocator().capacity() > 0u);
+
+    // the memory is released when the tree is cleared
+    std::size_t const capacity = alloc.capacity();
+    copy.clear();
+    BOOST_CHECK_EQUAL(copy.get_allocator().capacity(), 0u);
+    BOOST_CHECK_EQUAL(alloc.capacity(), capacity);
+    check_query(rt, values, qbox);
+
+    // moving and swapping the trees moves the pools together with the nodes
+    rtree_t moved(std::move(rt));
+    BOOST_CHECK(moved.get_allocator() == alloc);
+    check_query(moved, values, qbox);
+
+    rtree_t packed(values, params);
+    packed.swap(moved);
+    BOOST_CHECK(packed.get_allocator() == alloc);
+    check_query(packed, values, qbox);
+    check_query(moved, values, qbox);
+
+    // the allocators are not equal so the values are copied
+    moved = std::move(packed);
+    BOOST_CHECK(packed.get_allocator() == alloc);
+    check_query(moved, values, qbox);
+
+    packed.clear();
+    BOOST_CHECK_EQUAL(alloc.capacity(), 0u);
+
+    // the pool can be used again after the release
+    packed.insert(values.begin(), values.end());
+    basictest::check_structure(packed);
+    check_query(packed, values, qbox);
+    BOOST_CHECK(alloc.capacity() > 0u);
+}
+
+template <typename Value>
+void test_value()
+{
+    test_node_pool_allocator<Value, bgi::linear<4, 2> >();
+    test_node_pool_allocator<Value, bgi::quadratic<5, 2> >();
+    test_node_pool_allocator<Value, bgi::rstar<8, 3> >();
+    test_node_pool_allocator<Value>(bgi::dynamic_rstar(16, 4));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+    test_value<std::pair<box_t, int> >();
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <vector>
+
+#include <boost/geometry/index/packing.hpp>
+#include <boost/geometry/util/thread_executor.hpp>
+
+// Stores the structure of the tree, the boxes of nodes and values
+template <typename MembersHolder>
+struct dump_tree
+    : public MembersHolder::visitor_const
+{
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+    typedef typename MembersHolder::box_type box_type;
+    typedef typename MembersHolder::value_type value_type;
+
+    void operator()(internal_node const& n)
+    {
+        auto const& elements = bgi::detail::rtree::elements(n);
+        counts.push_back(elements.size());
+        for (auto const& el : elements)
+        {
+            boxes.push_back(el.first);
+            bgi::detail::rtree::apply_visitor(*this, *el.second);
+        }
+    }
+
+    void operator()(leaf const& n)
+    {
+        auto const& elements = bgi::detail::rtree::elements(n);
+        counts.push_back(elements.size());
+        values.insert(values.end(), elements.begin(), elements.end());
+    }
+
+    std::vector<std::size_t> counts;
+    std::vector<box_type> boxes;
+    std::vector<value_type> values;
+};
+
+template <typename Rtree>
+void check_identical(Rtree const& rt1, Rtree const& rt2)
+{
+    typedef bgi::detail::rtree::utilities::view<Rtree> RTV;
+    RTV rtv1(rt1);
+    RTV rtv2(rt2);
+
+    dump_tree<typename RTV::members_holder> d1, d2;
+    rtv1.apply_visitor(d1);
+    rtv2.apply_visitor(d2);
+
+    BOOST_CHECK_EQUAL(rt1.size(), rt2.size());
+    BOOST_CHECK_EQUAL(rtv1.depth(), rtv2.depth());
+    BOOST_CHECK(d1.counts == d2.counts);
+    BOOST_CHECK_EQUAL(d1.boxes.size(), d2.boxes.size());
+    BOOST_CHECK_EQUAL(d1.values.size(), d2.values.size());
+    for (std::size_t i = 0 ; i < d1.boxes.size() && i < d2.boxes.size() ; ++i)
+    {
+        BOOST_CHECK(bg::equals(d1.boxes[i], d2.boxes[i]));
+    }
+    for (std::size_t i = 0 ; i < d1.values.size() && i < d2.values.size() ; ++i)
+    {
+        BOOST_CHECK(bg::equals(d1.values[i], d2.values[i]));
+    }
+}
+
+template <typename Value, typename Params>
+void test_pack_parallel(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+
+    std::size_t const counts[] = { 0, 1, 5, 17, 177, 1000, 10001 };
+    for (std::size_t count : counts)
+    {
+        std::vector<Value> values;
+        generate::values(values, count, 1009, 997);
+
+        rtree_t rt(values.begin(), values.end(), params);
+
+        rtree_t rt1(values.begin(), values.end(), bgi::parallel_packing<>(), params);
+        check_identical(rt, rt1);
+
+        rtree_t rt2(values, bgi::parallel_packing<>(bg::util::thread_executor(3)), params);
+        check_identical(rt, rt2);
+
+        bgi::parallel_packing<bg::util::sequential_executor> seq;
+        rtree_t rt3(values, seq, params);
+        check_identical(rt, rt3);
+
+        if ( count > 0 )
+        {
+            BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt1));
+            BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(rt1));
+            BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt1));
+        }
+    }
+}
+
+template <typename Value>
+void test_value()
+{
+    test_pack_parallel<Value, bgi::linear<4, 2> >();
+    test_pack_parallel<Value, bgi::quadratic<5, 2> >();
+    test_pack_parallel<Value, bgi::rstar<16, 4> >();
+    test_pack_parallel<Value>(bgi::dynamic_rstar(8, 3));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <vector>
+
+#include <boost/geometry/index/packing.hpp>
+
+template <typename Point>
+inline void fill(Point & pt, double x, double y)
+{
+    bg::set<0>(pt, x);
+    bg::set<1>(pt, y);
+}
+
+template <typename Point>
+inline void fill(bg::model::box<Point> & box, double x, double y)
+{
+    bg::set<0, 0>(box, x);
+    bg::set<0, 1>(box, y);
+    bg::set<1, 0>(box, x + 0.5);
+    bg::set<1, 1>(box, y + 0.5);
+}
+
+template <typename Value>
+void generate_values(std::vector<Value> & values, std::size_t count)
+{
+    // clustered, non-uniform data
+    unsigned int seed = 12345;
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        double const cx = double((seed >> 16) % 4) * 250;
+        seed = seed * 1103515245u + 12345u;
+        double const x = cx + double((seed >> 16) % 1000) / 10.0;
+        seed = seed * 1103515245u + 12345u;
+        double const y = double((seed >> 16) % 1000) / (1 + i % 7);
+
+        Value v;
+        fill(v, x, y);
+        values.push_back(v);
+    }
+}
+
+template <typename Rtree, typename Value>
+void check_rtree(Rtree const& rt, std::vector<Value> const& values)
+{
+    typedef typename Rtree::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    BOOST_CHECK_EQUAL(rt.size(), values.size());
+    if ( !values.empty() )
+    {
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(rt));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt));
+    }
+
+    for (double x = 0 ; x < 1000 ; x += 123)
+    {
+        box_t qbox(point_t(x, x / 2), point_t(x + 150, x / 2 + 200));
+
+        std::vector<Value> expected;
+        for (Value const& v : values)
+        {
+            if (bg::intersects(v, qbox))
+            {
+                expected.push_back(v);
+            }
+        }
+
+        std::vector<Value> result;
+        rt.query(bgi::intersects(qbox), std::back_inserter(result));
+        basictest::compare_outputs(rt, result, expected);
+
+        result.clear();
+        rt.query(bgi::nearest(point_t(x, x / 2), 5), std::back_inserter(result));
+        BOOST_CHECK_EQUAL(result.size(), (std::min)(values.size(), std::size_t(5)));
+    }
+}
+
+template <typename Value, typename Packing, typename Params>
+void test_packing(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+
+    std::size_t const counts[] = { 0, 1, 2, 5, 17, 100, 177, 1000, 3001 };
+    for (std::size_t count : counts)
+    {
+        std::vector<Value> values;
+        generate_values(values, count);
+
+        rtree_t rt1(values.begin(), values.end(), Packing(), params);
+        check_rtree(rt1, values);
+
+        rtree_t rt2(values, Packing(), params);
+        check_rtree(rt2, values);
+
+        rtree_t rt3(values.begin(), values.end(), params);
+        BOOST_CHECK_EQUAL(rt1.size(), rt3.size());
+    }
+}
+
+template <typename Value, typename Params>
+void test_packings(Params const& params = Params())
+{
+    test_packing<Value, bgi::default_packing>(params);
+    test_packing<Value, bgi::hilbert_packing>(params);
+    test_packing<Value, bgi::morton_packing>(params);
+}
+
+template <typename Value>
+void test_value()
+{
+    test_packings<Value, bgi::linear<4, 2> >();
+    test_packings<Value, bgi::quadratic<5, 2> >();
+    test_packings<Value, bgi::rstar<16, 4> >();
+    test_packings<Value>(bgi::dynamic_rstar(8, 3));
+    test_packings<Value>(bgi::dynamic_linear(3, 1));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+
+    return 0;
+}
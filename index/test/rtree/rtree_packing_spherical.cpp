@@ -0,0 +1,197 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <vector>
+
+#include <boost/geometry/index/detail/rtree/utilities/view.hpp>
+#include <boost/geometry/index/packing.hpp>
+
+template <typename Point>
+inline void fill(Point & pt, double x, double y)
+{
+    bg::set<0>(pt, x);
+    bg::set<1>(pt, y);
+}
+
+template <typename Point>
+inline void fill(bg::model::box<Point> & box, double x, double y)
+{
+    bg::set<0, 0>(box, x);
+    bg::set<0, 1>(box, y);
+    bg::set<1, 0>(box, x + 0.5);
+    bg::set<1, 1>(box, y + 0.5);
+}
+
+// Points or boxes around the antimeridian, for the first dense values
+// lon in [170, 180] or [-180, -170] and lat in [-10, 10], the rest in the
+// whole range of longitudes
+template <typename Value>
+void generate_values(std::vector<Value> & values, std::size_t count, std::size_t dense)
+{
+    unsigned int seed = 12345;
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        double const r1 = double((seed >> 16) % 1000) / 1000.0;
+        seed = seed * 1103515245u + 12345u;
+        double const r2 = double((seed >> 16) % 1000) / 1000.0;
+
+        double lon = -180 + r1 * 359;
+        double lat = -80 + r2 * 160;
+        if (i < dense)
+        {
+            lon = i % 2 == 0 ? 170 + r1 * 9.5 : -180 + r1 * 10;
+            lat = -10 + r2 * 20;
+        }
+
+        Value v;
+        fill(v, lon, lat);
+        values.push_back(v);
+    }
+}
+
+// Checks whether the nodes' boxes are not wider than the given value
+template <typename MembersHolder>
+struct check_nodes_widths
+    : public MembersHolder::visitor_const
+{
+    typedef typename MembersHolder::internal_node internal_node;
+    typedef typename MembersHolder::leaf leaf;
+
+    explicit check_nodes_widths(double w) : max_width(w), result(true) {}
+
+    void operator()(internal_node const& n)
+    {
+        auto const& elements = bgi::detail::rtree::elements(n);
+        for (auto const& el : elements)
+        {
+            if (bg::get<bg::max_corner, 0>(el.first) - bg::get<bg::min_corner, 0>(el.first) > max_width)
+            {
+                result = false;
+            }
+            bgi::detail::rtree::apply_visitor(*this, *el.second);
+        }
+    }
+
+    void operator()(leaf const& ) {}
+
+    double max_width;
+    bool result;
+};
+
+template <typename Rtree, typename Value>
+void check_rtree(Rtree const& rt, std::vector<Value> const& values)
+{
+    typedef typename Rtree::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    BOOST_CHECK_EQUAL(rt.size(), values.size());
+    if ( !values.empty() )
+    {
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(rt));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt));
+    }
+
+    // including boxes crossing the antimeridian
+    for (double x = 150 ; x < 200 ; x += 7)
+    {
+        box_t qbox;
+        fill(qbox, x, -5);
+        bg::set<1, 0>(qbox, x + 15);
+        bg::set<1, 1>(qbox, 5);
+
+        std::vector<Value> expected;
+        for (Value const& v : values)
+        {
+            if (bg::intersects(v, qbox))
+            {
+                expected.push_back(v);
+            }
+        }
+
+        std::vector<Value> result;
+        rt.query(bgi::intersects(qbox), std::back_inserter(result));
+        basictest::compare_outputs(rt, result, expected);
+
+        point_t qpt;
+        fill(qpt, x <= 180 ? x : x - 360, 0);
+        result.clear();
+        rt.query(bgi::nearest(qpt, 5), std::back_inserter(result));
+        BOOST_CHECK_EQUAL(result.size(), (std::min)(values.size(), std::size_t(5)));
+    }
+}
+
+template <typename Value, typename Packing, typename Params>
+void test_packing(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+
+    std::size_t const counts[] = { 0, 1, 2, 5, 17, 100, 177, 1000, 3001 };
+    for (std::size_t count : counts)
+    {
+        std::vector<Value> values;
+        generate_values(values, count, count / 2);
+
+        rtree_t rt1(values.begin(), values.end(), Packing(), params);
+        check_rtree(rt1, values);
+
+        rtree_t rt2(values, Packing(), params);
+        check_rtree(rt2, values);
+    }
+
+    // the nodes storing values lying on both sides of the antimeridian
+    // should not span the whole range of longitudes
+    {
+        std::vector<Value> values;
+        generate_values(values, 2000, 2000);
+
+        rtree_t rt(values, Packing(), params);
+        check_rtree(rt, values);
+
+        typedef bgi::detail::rtree::utilities::view<rtree_t> view_t;
+        view_t rtv(rt);
+        check_nodes_widths<typename view_t::members_holder> v(30);
+        rtv.apply_visitor(v);
+        BOOST_CHECK(v.result);
+    }
+}
+
+template <typename Value, typename Params>
+void test_packings(Params const& params = Params())
+{
+    test_packing<Value, bgi::default_packing>(params);
+    test_packing<Value, bgi::hilbert_packing>(params);
+    test_packing<Value, bgi::morton_packing>(params);
+}
+
+template <typename Value>
+void test_value()
+{
+    test_packings<Value, bgi::linear<4, 2> >();
+    test_packings<Value, bgi::rstar<16, 4> >();
+    test_packings<Value>(bgi::dynamic_quadratic(8, 3));
+}
+
+template <typename Point>
+void test_cs()
+{
+    test_value<Point>();
+    test_value<bg::model::box<Point> >();
+}
+
+int test_main(int, char* [])
+{
+    test_cs<bg::model::point<double, 2, bg::cs::spherical_equatorial<bg::degree> > >();
+    test_cs<bg::model::point<double, 2, bg::cs::geographic<bg::degree> > >();
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <tuple>
+#include <vector>
+
+#include <boost/geometry/index/detail/rtree/utilities/statistics.hpp>
+
+template <typename Rtree, typename Predicates>
+bgi::query_statistics check_query(Rtree const& rt, Predicates const& pred)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected;
+    rt.query(pred, std::back_inserter(expected));
+
+    bgi::query_statistics stats;
+    std::vector<value_t> result;
+    BOOST_CHECK_EQUAL(rt.query(pred, std::back_inserter(result), stats), expected.size());
+    basictest::compare_outputs(rt, result, expected);
+
+    return stats;
+}
+
+template <typename Value, typename Params>
+void test_query_statistics(Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+    typedef typename rtree_t::bounds_type box_t;
+    typedef typename bg::point_type<box_t>::type point_t;
+
+    std::vector<Value> values;
+    generate::values(values, 1000, 113, 107);
+
+    rtree_t rt(values, params);
+
+    std::size_t levels, nodes, leafs, values_count, values_min, values_max;
+    std::tie(levels, nodes, leafs, values_count, values_min, values_max)
+        = bgi::detail::rtree::utilities::statistics(rt);
+    BOOST_CHECK(levels > 1);
+
+    // all nodes are visited
+    box_t all_box;
+    bg::assign_values(all_box, -10, -10, 200, 200);
+    bgi::query_statistics stats = check_query(rt, bgi::intersects(all_box));
+    BOOST_CHECK_EQUAL(stats.internal_nodes, nodes);
+    BOOST_CHECK_EQUAL(stats.leafs, leafs);
+    BOOST_CHECK_EQUAL(stats.predicates, nodes + leafs - 1 + values_count);
+    BOOST_CHECK_EQUAL(stats.pruned_branches, 0u);
+    BOOST_CHECK_EQUAL(stats.max_branches, 0u);
+    BOOST_CHECK_EQUAL(stats.max_neighbors, 0u);
+
+    // only the root is visited
+    box_t far_box;
+    bg::assign_values(far_box, 500, 500, 600, 600);
+    stats = check_query(rt, bgi::intersects(far_box));
+    BOOST_CHECK_EQUAL(stats.internal_nodes, 1u);
+    BOOST_CHECK_EQUAL(stats.leafs, 0u);
+    BOOST_CHECK_EQUAL(stats.predicates, stats.pruned_branches);
+    BOOST_CHECK(stats.pruned_branches > 0u);
+
+    // some of the nodes are visited
+    box_t qbox;
+    bg::assign_values(qbox, 20, 30, 40, 50);
+    stats = check_query(rt, bgi::intersects(qbox));
+    BOOST_CHECK(0u < stats.leafs && stats.leafs < leafs);
+    BOOST_CHECK(stats.pruned_branches > 0u);
+
+    // k-nearest neighbors
+    point_t pt(50, 40);
+    stats = check_query(rt, bgi::nearest(pt, 5));
+    BOOST_CHECK(0u < stats.leafs && stats.leafs < leafs);
+    BOOST_CHECK(stats.internal_nodes > 0u);
+    BOOST_CHECK(stats.pruned_branches > 0u);
+    BOOST_CHECK(stats.max_branches > 0u);
+    BOOST_CHECK_EQUAL(stats.max_neighbors, 5u);
+
+    stats = check_query(rt, bgi::nearest(pt, 2000));
+    BOOST_CHECK_EQUAL(stats.internal_nodes, nodes);
+    BOOST_CHECK_EQUAL(stats.leafs, leafs);
+    BOOST_CHECK_EQUAL(stats.max_neighbors, values_count);
+
+    // the counters are accumulated
+    bgi::query_statistics stats1 = check_query(rt, bgi::intersects(qbox));
+    std::vector<Value> result;
+    bgi::query_statistics stats2;
+    rt.query(bgi::intersects(qbox), std::back_inserter(result), stats2);
+    rt.query(bgi::intersects(qbox), std::back_inserter(result), stats2);
+    BOOST_CHECK_EQUAL(stats2.internal_nodes, 2 * stats1.internal_nodes);
+    BOOST_CHECK_EQUAL(stats2.leafs, 2 * stats1.leafs);
+    BOOST_CHECK_EQUAL(stats2.predicates, 2 * stats1.predicates);
+    BOOST_CHECK_EQUAL(stats2.pruned_branches, 2 * stats1.pruned_branches);
+
+    // nothing is visited in the empty tree
+    rtree_t empty_rt(params);
+    stats = check_query(empty_rt, bgi::intersects(qbox));
+    BOOST_CHECK_EQUAL(stats.internal_nodes + stats.leafs + stats.predicates, 0u);
+}
+
+template <typename Value>
+void test_value()
+{
+    test_query_statistics<Value, bgi::linear<4, 2> >();
+    test_query_statistics<Value, bgi::quadratic<5, 2> >();
+    test_query_statistics<Value, bgi::rstar<8, 3> >();
+    test_query_statistics<Value>(bgi::dynamic_rstar(16, 4));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    test_value<point_t>();
+    test_value<box_t>();
+
+    return 0;
+}
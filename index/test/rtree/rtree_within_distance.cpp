@@ -0,0 +1,136 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/geometry/geometries/geometries.hpp>
+
+template <typename Point>
+inline void fill(Point & pt, double x, double y)
+{
+    bg::set<0>(pt, x);
+    bg::set<1>(pt, y);
+}
+
+template <typename Point>
+inline void fill(bg::model::box<Point> & box, double x, double y)
+{
+    bg::set<0, 0>(box, x);
+    bg::set<0, 1>(box, y);
+    bg::set<1, 0>(box, x + 2);
+    bg::set<1, 1>(box, y + 1);
+}
+
+template <typename Rtree, typename Geometry, typename Distance>
+void check_within_distance(Rtree const& rt, std::vector<typename Rtree::value_type> const& values,
+                           Geometry const& g, Distance const& distance)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> expected, expected_not;
+    for (value_t const& v : values)
+    {
+        if (bg::distance(g, v) <= distance)
+            expected.push_back(v);
+        else
+            expected_not.push_back(v);
+    }
+
+    std::vector<value_t> result;
+    BOOST_CHECK_EQUAL(rt.query(bgi::within_distance(g, distance), std::back_inserter(result)), expected.size());
+    basictest::compare_outputs(rt, result, expected);
+
+    std::vector<value_t> result_not;
+    rt.query(!bgi::within_distance(g, distance), std::back_inserter(result_not));
+    basictest::compare_outputs(rt, result_not, expected_not);
+
+    // the nodes further than the distance are not traversed
+    bgi::query_statistics stats;
+    result.clear();
+    rt.query(bgi::within_distance(g, distance), std::back_inserter(result), stats);
+    BOOST_CHECK(stats.predicates < rt.size() || expected.size() == rt.size());
+
+    // the k nearest values not further than the distance
+    std::size_t const k = 5;
+    result.clear();
+    rt.query(bgi::nearest(g, k) && bgi::within_distance(g, distance), std::back_inserter(result));
+    BOOST_CHECK_EQUAL(result.size(), (std::min)(k, expected.size()));
+    for (value_t const& v : result)
+    {
+        BOOST_CHECK(bg::distance(g, v) <= distance);
+    }
+
+    // the query iterator may be stopped at any point
+    std::size_t count = 0;
+    for (auto it = rt.qbegin(bgi::within_distance(g, distance)) ; it != rt.qend() ; ++it)
+    {
+        BOOST_CHECK(bg::distance(g, *it) <= distance);
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(count, expected.size());
+}
+
+template <typename Value, typename Params, typename Point>
+void test_within_distance(std::vector<double> const& distances, Params const& params = Params())
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+
+    std::vector<Value> values;
+    for (std::size_t i = 0 ; i < 1000 ; ++i)
+    {
+        Value v;
+        fill(v, double(int(i * 7919 % 113)) - 56, double(int(i * 104729 % 107)) / 2 - 26);
+        values.push_back(v);
+    }
+
+    rtree_t rt(values, params);
+    rtree_t empty_rt(params);
+
+    Point pt;
+    fill(pt, 1, 2);
+    Point pt2;
+    fill(pt2, 30, -10);
+
+    for (double d : distances)
+    {
+        check_within_distance(rt, values, pt, d);
+        check_within_distance(rt, values, pt2, d);
+        check_within_distance(empty_rt, std::vector<Value>(), pt, d);
+    }
+}
+
+template <typename Point>
+void test_cs(std::vector<double> const& distances)
+{
+    typedef bg::model::box<Point> box_t;
+
+    test_within_distance<Point, bgi::linear<4, 2>, Point>(distances);
+    test_within_distance<Point, bgi::quadratic<5, 2>, Point>(distances);
+    test_within_distance<Point, bgi::rstar<8, 3>, Point>(distances);
+    test_within_distance<Point, bgi::dynamic_rstar, Point>(distances, bgi::dynamic_rstar(16, 4));
+    test_within_distance<box_t, bgi::rstar<8, 3>, Point>(distances);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> pt_car;
+    typedef bg::model::point<double, 2, bg::cs::spherical_equatorial<bg::degree> > pt_sph;
+    typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > pt_geo;
+
+    test_cs<pt_car>({0.0, 1.5, 10.0, 35.0, 1000.0});
+    // radians on the unit sphere
+    test_cs<pt_sph>({0.0, 0.03, 0.2, 0.6, 4.0});
+    // meters
+    test_cs<pt_geo>({0.0, 150000.0, 1000000.0, 4000000.0, 30000000.0});
+
+    return 0;
+}
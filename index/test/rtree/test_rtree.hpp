@@ -628,6 +628,19 @@ struct input<3>
     }
 };
 
+// generate values scattered in [0, x_range) x [0, y_range) in pseudo-random order
+
+template <typename Value>
+inline void values(std::vector<Value> & output, std::size_t count,
+                   int x_range = 101, int y_range = 97, int seed = 0)
+{
+    for ( std::size_t i = 0 ; i < count ; ++i )
+    {
+        output.push_back(generate::value<Value>::apply(int((i * 7919 + seed) % x_range),
+                                                       int((i * 104729 + seed) % y_range)));
+    }
+}
+
 // generate_value_outside
 
 template <typename Value, size_t Dimension>
@@ -768,14 +781,23 @@ void check_fwd_iterators(QItF first, QItL last)
     BOOST_CHECK(first == last);
 }
 
-// spatial query
+// structure of the tree
 
-template <typename Rtree, typename Value, typename Predicates>
-void spatial_query(Rtree & rtree, Predicates const& pred, std::vector<Value> const& expected_output)
+template <typename Rtree>
+void check_structure(Rtree const& rtree)
 {
     BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rtree));
+    BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(rtree));
     if (!rtree.empty())
         BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rtree));
+}
+
+// spatial query
+
+template <typename Rtree, typename Value, typename Predicates>
+void spatial_query(Rtree & rtree, Predicates const& pred, std::vector<Value> const& expected_output)
+{
+    check_structure(rtree);
 
     std::vector<Value> output;
     size_t n = rtree.query(pred, std::back_inserter(output));
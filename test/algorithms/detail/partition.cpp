@@ -29,6 +29,7 @@
 # include <boost/geometry/io/svg/svg_mapper.hpp>
 #endif
 #include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/util/thread_executor.hpp>
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -339,6 +340,7 @@ void fill_points(Collection& collection, int seed, int size, int count)
     }
 }
 
+template <typename Backend>
 void test_many_points(int seed, int size, int count)
 {
     bg::model::multi_point<point_item> mp1, mp2;
@@ -384,7 +386,8 @@ void test_many_points(int seed, int size, int count)
         <
             bg::model::box<point_item>,
             bg::detail::partition::include_all_policy,
-            bg::detail::partition::include_all_policy
+            bg::detail::partition::include_all_policy,
+            Backend
         >::apply(mp1, mp2, visitor, expand_for_point(), overlaps_point(),
                  expand_for_point(), overlaps_point(), 2, box_visitor);
 
@@ -429,6 +432,7 @@ void fill_boxes(Collection& collection, int seed, int size, int count)
     }
 }
 
+template <typename Backend>
 void test_many_boxes(int seed, int size, int count)
 {
     typedef bg::model::box<point_item> box_type;
@@ -488,7 +492,8 @@ void test_many_boxes(int seed, int size, int count)
         <
             box_type,
             bg::detail::partition::include_all_policy,
-            bg::detail::partition::include_all_policy
+            bg::detail::partition::include_all_policy,
+            Backend
         >::apply(boxes, visitor, expand_for_box(), overlaps_box(),
                  2, partition_box_visitor);
 
@@ -496,6 +501,7 @@ void test_many_boxes(int seed, int size, int count)
     BOOST_CHECK_CLOSE(visitor.area, expected_area, 0.001);
 }
 
+template <typename Backend>
 void test_two_collections(int seed1, int seed2, int size, int count)
 {
     typedef bg::model::box<point_item> box_type;
@@ -556,7 +562,8 @@ void test_two_collections(int seed1, int seed2, int size, int count)
         <
             box_type,
             bg::detail::partition::include_all_policy,
-            bg::detail::partition::include_all_policy
+            bg::detail::partition::include_all_policy,
+            Backend
         >::apply(boxes1, boxes2, visitor, expand_for_box(), overlaps_box(),
                  expand_for_box(), overlaps_box(), 2, partition_box_visitor);
 
@@ -565,6 +572,7 @@ void test_two_collections(int seed1, int seed2, int size, int count)
 }
 
 
+template <typename Backend>
 void test_heterogenuous_collections(int seed1, int seed2, int size, int count)
 {
     typedef bg::model::box<point_item> box_type;
@@ -622,7 +630,8 @@ void test_heterogenuous_collections(int seed1, int seed2, int size, int count)
         <
             box_type,
             bg::detail::partition::include_all_policy,
-            bg::detail::partition::include_all_policy
+            bg::detail::partition::include_all_policy,
+            Backend
         >::apply(points, boxes, visitor1, expand_for_point(), overlaps_point(),
                  expand_for_box(), overlaps_box(), 2, partition_box_visitor);
 
@@ -631,7 +640,8 @@ void test_heterogenuous_collections(int seed1, int seed2, int size, int count)
         <
             box_type,
             bg::detail::partition::include_all_policy,
-            bg::detail::partition::include_all_policy
+            bg::detail::partition::include_all_policy,
+            Backend
         >::apply(boxes, points, visitor2, expand_for_box(), overlaps_box(),
                  expand_for_point(), overlaps_point(), 2, partition_box_visitor);
 
@@ -639,29 +649,202 @@ void test_heterogenuous_collections(int seed1, int seed2, int size, int count)
     BOOST_CHECK_EQUAL(visitor2.count, expected_count);
 }
 
-int test_main( int , char* [] )
+// One huge box and many tiny boxes clustered in its corner
+template <typename Backend>
+void test_skewed_boxes(int seed, int count)
 {
-    test_all<bg::model::d2::point_xy<double> >();
+    typedef bg::model::box<point_item> box_type;
+    std::vector<box_item<box_type> > boxes1, boxes2;
+
+    std::uniform_int_distribution<int> distribution(0, 999);
+    std::seed_seq ssq{seed};
+    std::default_random_engine re(ssq);
+
+    boxes1.push_back(box_item<box_type>(1, "box(0 0,1000000 1000000)"));
+    for (int i = 0; i < count; i++)
+    {
+        double const x = distribution(re) / 1000.0;
+        double const y = distribution(re) / 1000.0;
+        double const w = distribution(re) / 100000.0;
+        box_item<box_type> item(i + 2);
+        bg::assign_values(item.box, x, y, x + w, y + w);
+        (i % 2 == 0 ? boxes1 : boxes2).push_back(item);
+    }
+
+    int expected_count1 = 0;
+    for (box_item<box_type> const& item1 : boxes1)
+    {
+        for (box_item<box_type> const& item2 : boxes1)
+        {
+            if (item1.id < item2.id && bg::intersects(item1.box, item2.box))
+            {
+                expected_count1++;
+            }
+        }
+    }
+    int expected_count2 = 0;
+    for (box_item<box_type> const& item1 : boxes1)
+    {
+        for (box_item<box_type> const& item2 : boxes2)
+        {
+            if (bg::intersects(item1.box, item2.box))
+            {
+                expected_count2++;
+            }
+        }
+    }
 
-    test_many_points(12345, 20, 40);
-    test_many_points(54321, 20, 60);
-    test_many_points(67890, 20, 80);
-    test_many_points(98765, 20, 100);
+    bg::detail::partition::visit_no_policy partition_box_visitor;
+
+    box_visitor<box_type> visitor1;
+    bg::partition
+        <
+            box_type,
+            bg::detail::partition::include_all_policy,
+            bg::detail::partition::include_all_policy,
+            Backend
+        >::apply(boxes1, visitor1, expand_for_box(), overlaps_box(),
+                 16, partition_box_visitor);
+
+    box_visitor<box_type> visitor2;
+    bg::partition
+        <
+            box_type,
+            bg::detail::partition::include_all_policy,
+            bg::detail::partition::include_all_policy,
+            Backend
+        >::apply(boxes1, boxes2, visitor2, expand_for_box(), overlaps_box(),
+                 expand_for_box(), overlaps_box(), 16, partition_box_visitor);
+
+    BOOST_CHECK_EQUAL(visitor1.count, expected_count1);
+    BOOST_CHECK_EQUAL(visitor2.count, expected_count2);
+}
+
+// Records the ids of the pairs of overlapping boxes
+struct pairs_visitor
+{
+    std::vector<std::pair<int, int> > pairs;
+
+    template <typename Item1, typename Item2>
+    inline bool apply(Item1 const& item1, Item2 const& item2)
+    {
+        if (bg::intersects(item1.box, item2.box))
+        {
+            pairs.push_back(std::make_pair(item1.id, item2.id));
+        }
+        return true;
+    }
+};
+
+struct bail_out_visitor
+{
+    int count;
+
+    bail_out_visitor()
+        : count(0)
+    {}
+
+    template <typename Item1, typename Item2>
+    inline bool apply(Item1 const& , Item2 const& )
+    {
+        return ++count < 10;
+    }
+};
+
+template <typename Executor>
+void test_parallel(int seed1, int seed2, int size, int count,
+                   std::size_t parts_count, Executor const& executor)
+{
+    typedef bg::model::box<point_item> box_type;
+    typedef bg::partition<box_type> partition_type;
+    std::vector<box_item<box_type> > boxes1, boxes2;
+
+    fill_boxes(boxes1, seed1, size, count);
+    fill_boxes(boxes2, seed2, size, count);
+
+    // The merged pairs of the parts should be the same as the sequential ones
+    {
+        pairs_visitor expected;
+        partition_type::apply(boxes1, expected, expand_for_box(), overlaps_box(), 2);
+
+        std::vector<pairs_visitor> visitors(parts_count);
+        BOOST_CHECK(partition_type::apply_parallel(boxes1, visitors,
+                        expand_for_box(), overlaps_box(), 2, executor));
+
+        std::vector<std::pair<int, int> > result;
+        for (pairs_visitor const& v : visitors)
+        {
+            result.insert(result.end(), v.pairs.begin(), v.pairs.end());
+        }
+        BOOST_CHECK(result == expected.pairs);
+    }
+
+    {
+        pairs_visitor expected;
+        partition_type::apply(boxes1, boxes2, expected,
+                              expand_for_box(), overlaps_box(),
+                              expand_for_box(), overlaps_box(), 2);
+
+        std::vector<pairs_visitor> visitors(parts_count);
+        BOOST_CHECK(partition_type::apply_parallel(boxes1, boxes2, visitors,
+                        expand_for_box(), overlaps_box(),
+                        expand_for_box(), overlaps_box(), 2, executor));
+
+        std::vector<std::pair<int, int> > result;
+        for (pairs_visitor const& v : visitors)
+        {
+            result.insert(result.end(), v.pairs.begin(), v.pairs.end());
+        }
+        BOOST_CHECK(result == expected.pairs);
+    }
+
+    if (count > 10)
+    {
+        std::vector<bail_out_visitor> visitors(parts_count);
+        BOOST_CHECK(! partition_type::apply_parallel(boxes1, visitors,
+                        expand_for_box(), overlaps_box(), 2, executor));
+    }
+}
+
+template <typename Backend>
+void test_many(Backend const& )
+{
+    test_many_points<Backend>(12345, 20, 40);
+    test_many_points<Backend>(54321, 20, 60);
+    test_many_points<Backend>(67890, 20, 80);
+    test_many_points<Backend>(98765, 20, 100);
     for (int i = 1; i < 10; i++)
     {
-        test_many_points(i, 30, i * 20);
+        test_many_points<Backend>(i, 30, i * 20);
     }
 
-    test_many_boxes(12345, 20, 40);
+    test_many_boxes<Backend>(12345, 20, 40);
     for (int i = 1; i < 10; i++)
     {
-        test_many_boxes(i, 20, i * 10);
+        test_many_boxes<Backend>(i, 20, i * 10);
     }
 
-    test_two_collections(12345, 54321, 20, 40);
-    test_two_collections(67890, 98765, 20, 60);
+    test_two_collections<Backend>(12345, 54321, 20, 40);
+    test_two_collections<Backend>(67890, 98765, 20, 60);
+
+    test_heterogenuous_collections<Backend>(67890, 98765, 20, 60);
+
+    test_skewed_boxes<Backend>(12345, 200);
+    test_skewed_boxes<Backend>(54321, 500);
+}
+
+int test_main( int , char* [] )
+{
+    test_all<bg::model::d2::point_xy<double> >();
+
+    test_many(bg::detail::partition::recursive_backend());
+    test_many(bg::detail::partition::sweep_backend());
+    test_many(bg::detail::partition::adaptive_backend());
 
-    test_heterogenuous_collections(67890, 98765, 20, 60);
+    test_parallel(12345, 54321, 20, 5, 4, bg::util::sequential_executor());
+    test_parallel(12345, 54321, 20, 40, 1, bg::util::sequential_executor());
+    test_parallel(12345, 54321, 20, 40, 4, bg::util::thread_executor(4));
+    test_parallel(67890, 98765, 100, 1000, 16, bg::util::thread_executor(4));
 
     return 0;
 }
@@ -1293,6 +1293,65 @@ BOOST_AUTO_TEST_CASE( test_is_valid_multipolygon )
     test_open_multipolygons<point_type, false>();
 }
 
+// Many long and thin holes or polygons, the boxes of all of them span the
+// whole width of the polygon so the recursive partition can't separate them
+template <typename Point>
+inline void test_many_strips()
+{
+    typedef bg::model::polygon<Point> polygon_t;
+    typedef bg::model::multi_polygon<polygon_t> multi_polygon_t;
+    typedef typename polygon_t::ring_type ring_t;
+
+    std::size_t const count = 2000;
+    auto strip = [](double y, double x1, double x2, double h)
+    {
+        ring_t r;
+        bg::append(r, Point(x1, y));
+        bg::append(r, Point(x1, y + h));
+        bg::append(r, Point(x2, y + h));
+        bg::append(r, Point(x2, y));
+        bg::append(r, Point(x1, y));
+        return r;
+    };
+
+    polygon_t poly;
+    bg::append(poly.outer(), Point(-1, -1));
+    bg::append(poly.outer(), Point(-1, 2.0 * count));
+    bg::append(poly.outer(), Point(1001, 2.0 * count));
+    bg::append(poly.outer(), Point(1001, -1));
+    bg::append(poly.outer(), Point(-1, -1));
+    multi_polygon_t mpoly;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        poly.inners().push_back(strip(2.0 * i, 0, 1000, 1));
+        mpoly.resize(mpoly.size() + 1);
+        mpoly.back().outer() = strip(2.0 * i, 0, 1000, 1);
+    }
+    bg::correct(poly);
+    bg::correct(mpoly);
+
+    bg::validity_failure_type failure;
+    BOOST_CHECK(bg::is_valid(poly, failure));
+    BOOST_CHECK(bg::is_valid(mpoly, failure));
+
+    // a hole inside another hole, a polygon inside another polygon
+    poly.inners().push_back(strip(2.0 * count - 1.75, 500, 501, 0.5));
+    mpoly.resize(mpoly.size() + 1);
+    mpoly.back().outer() = strip(2.0 * count - 1.75, 500, 501, 0.5);
+    bg::correct(poly);
+    bg::correct(mpoly);
+
+    BOOST_CHECK(! bg::is_valid(poly, failure));
+    BOOST_CHECK_EQUAL(failure, bg::failure_nested_interior_rings);
+    BOOST_CHECK(! bg::is_valid(mpoly, failure));
+    BOOST_CHECK_EQUAL(failure, bg::failure_intersecting_interiors);
+}
+
+BOOST_AUTO_TEST_CASE( test_is_valid_many_strips )
+{
+    test_many_strips<point_type>();
+}
+
 
 template <typename CoordinateType, typename Geometry>
 inline void check_one(Geometry const& geometry)
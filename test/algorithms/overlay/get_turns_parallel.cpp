@@ -0,0 +1,167 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/detail/overlay/get_turns.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/policies/robustness/get_rescale_policy.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/util/thread_executor.hpp>
+
+
+template <typename G1, typename G2, typename Executor>
+void test_geometries(std::string const& caseid, G1 const& g1, G2 const& g2,
+                     Executor const& executor)
+{
+    typedef typename bg::point_type<G1>::type point_type;
+    typedef typename bg::strategies::relate::services::default_strategy
+        <
+            G1, G2
+        >::type strategy_type;
+    typedef typename bg::rescale_policy_type<point_type>::type rescale_policy_type;
+    typedef bg::detail::overlay::turn_info
+        <
+            point_type,
+            typename bg::detail::segment_ratio_type<point_type, rescale_policy_type>::type
+        > turn_info;
+
+    strategy_type strategy;
+    rescale_policy_type rescale_policy
+        = bg::get_rescale_policy<rescale_policy_type>(g1, g2, strategy);
+
+    std::vector<turn_info> turns, turns_parallel;
+    bg::detail::get_turns::no_interrupt_policy policy;
+    bg::get_turns<false, false, bg::detail::overlay::assign_null_policy>(g1, g2,
+        strategy, rescale_policy, turns, policy);
+    bg::get_turns<false, false, bg::detail::overlay::assign_null_policy>(g1, g2,
+        strategy, rescale_policy, turns_parallel, policy, executor);
+
+    // The turns are the same and in the same order
+    BOOST_CHECK_MESSAGE(turns.size() == turns_parallel.size(),
+                        caseid << " count: " << turns_parallel.size()
+                        << " expected: " << turns.size());
+    for (std::size_t i = 0; i < turns.size() && i < turns_parallel.size(); ++i)
+    {
+        turn_info const& t = turns[i];
+        turn_info const& tp = turns_parallel[i];
+        BOOST_CHECK_MESSAGE(bg::get<0>(t.point) == bg::get<0>(tp.point)
+                            && bg::get<1>(t.point) == bg::get<1>(tp.point)
+                            && t.method == tp.method
+                            && t.operations[0].seg_id == tp.operations[0].seg_id
+                            && t.operations[1].seg_id == tp.operations[1].seg_id
+                            && t.operations[0].operation == tp.operations[0].operation
+                            && t.operations[1].operation == tp.operations[1].operation,
+                            caseid << " different turn at " << i);
+    }
+}
+
+template <typename G1, typename G2>
+void test_geometries(std::string const& caseid, G1 const& g1, G2 const& g2)
+{
+    test_geometries(caseid + "_seq", g1, g2, bg::util::sequential_executor());
+    test_geometries(caseid + "_thr", g1, g2, bg::util::thread_executor(4));
+}
+
+template <typename G1, typename G2>
+void test_wkt(std::string const& caseid, std::string const& wkt1, std::string const& wkt2)
+{
+    G1 g1;
+    G2 g2;
+    bg::read_wkt(wkt1, g1);
+    bg::read_wkt(wkt2, g2);
+    bg::correct(g1);
+    bg::correct(g2);
+    test_geometries(caseid, g1, g2);
+}
+
+// Star-shaped polygon with many vertices, consisting of many sections
+template <typename Polygon>
+Polygon star(std::size_t count, double cx, double cy, double phase)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    Polygon result;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double const a = phase + 2.0 * 3.14159265358979 * double(i) / double(count);
+        double const r = i % 2 == 0 ? 10.0 : 7.0 + (i % 5) * 0.3;
+        bg::append(result.outer(), point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+    }
+    bg::append(result.outer(), bg::range::front(result.outer()));
+    bg::correct(result);
+    return result;
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+    typedef bg::model::linestring<P> linestring;
+    typedef bg::model::box<P> box;
+
+    test_wkt<polygon, polygon>("simplex",
+        "POLYGON((0 0,0 4,4 4,4 0,0 0))",
+        "POLYGON((2 2,2 6,6 6,6 2,2 2))");
+    test_wkt<polygon, polygon>("disjoint",
+        "POLYGON((0 0,0 1,1 1,1 0,0 0))",
+        "POLYGON((2 2,2 3,3 3,3 2,2 2))");
+    test_wkt<polygon, multi_polygon>("poly_multi",
+        "POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,8 2,8 8,2 8,2 2))",
+        "MULTIPOLYGON(((1 1,1 3,3 3,3 1,1 1)),((7 7,7 11,11 11,11 7,7 7)))");
+    // reversed dispatch
+    test_wkt<multi_polygon, polygon>("multi_poly",
+        "MULTIPOLYGON(((1 1,1 3,3 3,3 1,1 1)),((7 7,7 11,11 11,11 7,7 7)))",
+        "POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,8 2,8 8,2 8,2 2))");
+    test_wkt<linestring, polygon>("line_poly",
+        "LINESTRING(-1 5,11 5,11 6,-1 6)",
+        "POLYGON((0 0,0 10,10 10,10 0,0 0))");
+    // calculated sequentially
+    test_wkt<polygon, box>("poly_box",
+        "POLYGON((0 0,0 4,4 4,4 0,0 0))",
+        "BOX(2 2,6 6)");
+
+    test_geometries("star_100", star<polygon>(100, 0, 0, 0), star<polygon>(100, 3, 1, 0.01));
+    test_geometries("star_2000", star<polygon>(2000, 0, 0, 0), star<polygon>(2000, 2, 1, 0.001));
+
+    multi_polygon stars1, stars2;
+    for (int i = 0; i < 5; ++i)
+    {
+        stars1.push_back(star<polygon>(300, i * 25.0, 0, 0));
+        stars2.push_back(star<polygon>(300, i * 25.0 + 4, 3, 0.002));
+    }
+    test_geometries("stars", stars1, stars2);
+
+    // Many sections spread in both dimensions, divided by many levels
+    // of the partition into many subsets of pairs
+    multi_polygon grid1, grid2;
+    for (int i = 0; i < 12; ++i)
+    {
+        for (int j = 0; j < 12; ++j)
+        {
+            grid1.push_back(star<polygon>(60, i * 25.0, j * 25.0, 0));
+            grid2.push_back(star<polygon>(60, i * 25.0 + 4, j * 25.0 + 3, 0.002));
+        }
+    }
+    test_geometries("stars_grid", grid1, grid2);
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/is_valid.hpp>
+#include <boost/geometry/algorithms/num_geometries.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/strategies/cartesian.hpp>
+#include <boost/geometry/util/thread_executor.hpp>
+
+
+// Squares of the size of 1.5 placed every 1 unit, overlapping the neighbours,
+// every 7th square is skipped so the result has holes
+template <typename Polygon>
+std::vector<Polygon> grid_of_squares(int size, double offset = 0)
+{
+    std::vector<Polygon> result;
+    for (int i = 0; i < size; ++i)
+    {
+        for (int j = 0; j < size; ++j)
+        {
+            if ((i * size + j) % 7 == 3)
+            {
+                continue;
+            }
+            double const x = i + offset;
+            double const y = j + offset * 0.5;
+            Polygon square;
+            bg::read_wkt("POLYGON((" + std::to_string(x) + " " + std::to_string(y) + ","
+                                     + std::to_string(x) + " " + std::to_string(y + 1.5) + ","
+                                     + std::to_string(x + 1.5) + " " + std::to_string(y + 1.5) + ","
+                                     + std::to_string(x + 1.5) + " " + std::to_string(y) + ","
+                                     + std::to_string(x) + " " + std::to_string(y) + "))", square);
+            bg::correct(square);
+            result.push_back(square);
+        }
+    }
+    return result;
+}
+
+template <typename Polygons, typename MultiPolygon>
+MultiPolygon union_one_by_one(Polygons const& polygons)
+{
+    MultiPolygon result;
+    for (auto const& polygon : polygons)
+    {
+        MultiPolygon temp;
+        bg::union_(result, polygon, temp);
+        result = std::move(temp);
+    }
+    return result;
+}
+
+template <typename MultiPolygon>
+void check_result(std::string const& caseid, MultiPolygon const& result,
+                  MultiPolygon const& expected)
+{
+    BOOST_CHECK_MESSAGE(bg::is_valid(result), caseid << " result is not valid");
+    BOOST_CHECK_MESSAGE(bg::num_geometries(result) == bg::num_geometries(expected),
+                        caseid << " count: " << bg::num_geometries(result)
+                        << " expected: " << bg::num_geometries(expected));
+    BOOST_CHECK_CLOSE(bg::area(result), bg::area(expected), 0.0001);
+}
+
+template <typename P>
+void test_grid(std::string const& caseid, int size, double offset)
+{
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    std::vector<polygon> const polygons = grid_of_squares<polygon>(size, offset);
+    multi_polygon const expected = union_one_by_one<std::vector<polygon>, multi_polygon>(polygons);
+
+    {
+        multi_polygon result;
+        bg::union_(polygons, result);
+        check_result(caseid + "_default", result, expected);
+    }
+    {
+        multi_polygon result;
+        bg::union_(polygons, result, bg::strategies::relate::cartesian<>());
+        check_result(caseid + "_strategy", result, expected);
+    }
+    {
+        multi_polygon result;
+        bg::union_(polygons, result, bg::strategies::relate::cartesian<>(),
+                   bg::util::thread_executor(4));
+        check_result(caseid + "_parallel", result, expected);
+    }
+    {
+        multi_polygon input, result;
+        for (auto const& p : polygons)
+        {
+            input.push_back(p);
+        }
+        bg::union_(input, result);
+        check_result(caseid + "_multi", result, expected);
+    }
+}
+
+template <typename P>
+void test_disjoint_and_empty()
+{
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    std::vector<polygon> polygons(3);
+    bg::read_wkt("POLYGON((0 0,0 1,1 1,1 0,0 0))", polygons[0]);
+    bg::read_wkt("POLYGON((5 5,5 6,6 6,6 5,5 5))", polygons[2]);
+
+    multi_polygon result;
+    bg::union_(polygons, result);
+    BOOST_CHECK_EQUAL(bg::num_geometries(result), 2u);
+    BOOST_CHECK_CLOSE(bg::area(result), 2.0, 0.0001);
+
+    // the result is appended to the output
+    bg::union_(std::vector<polygon>(1, polygons[0]), result);
+    BOOST_CHECK_EQUAL(bg::num_geometries(result), 3u);
+
+    multi_polygon empty_result;
+    bg::union_(std::vector<polygon>(), empty_result);
+    BOOST_CHECK_EQUAL(bg::num_geometries(empty_result), 0u);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+
+    test_grid<point_type>("grid_1", 1, 0);
+    test_grid<point_type>("grid_5", 5, 0);
+    test_grid<point_type>("grid_12", 12, 0.25);
+    test_grid<point_type>("grid_23", 23, 0.1);
+    test_disjoint_and_empty<point_type>();
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+#include <boost/geometry/algorithms/within_each.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/strategies/cartesian/point_in_poly_crossings_multiply.hpp>
+#include <boost/geometry/strategies/cartesian/point_in_poly_franklin.hpp>
+#include <boost/geometry/strategies/cartesian/point_in_poly_indexed_winding.hpp>
+
+
+// The points inside, outside, on the edges and equal to the vertices,
+// more than one block
+template <typename Point>
+std::vector<Point> test_points()
+{
+    std::vector<Point> result;
+    for (int x = -2; x <= 24; ++x)
+    {
+        for (int y = -2; y <= 24; ++y)
+        {
+            result.push_back(Point(x * 0.5, y * 0.5));
+        }
+    }
+    for (int i = 0; i < 300; ++i)
+    {
+        result.push_back(Point(i * 0.0377, 10 - i * 0.0237));
+    }
+    return result;
+}
+
+template <typename Points, typename Geometry, typename Strategy>
+void check_points(Points const& points, Geometry const& geometry, Strategy const& strategy)
+{
+    std::vector<bool> within, covered_by, within_s, covered_by_s;
+    bg::within_each(points, geometry, std::back_inserter(within));
+    bg::covered_by_each(points, geometry, std::back_inserter(covered_by));
+    bg::within_each(points, geometry, std::back_inserter(within_s), strategy);
+    bg::covered_by_each(points, geometry, std::back_inserter(covered_by_s), strategy);
+
+    BOOST_CHECK_EQUAL(within.size(), points.size());
+    BOOST_CHECK_EQUAL(covered_by.size(), points.size());
+    BOOST_CHECK_EQUAL(within_s.size(), points.size());
+    BOOST_CHECK_EQUAL(covered_by_s.size(), points.size());
+
+    for (std::size_t i = 0; i < points.size() && i < within.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(within[i], bg::within(points[i], geometry));
+        BOOST_CHECK_EQUAL(covered_by[i], bg::covered_by(points[i], geometry));
+        BOOST_CHECK_EQUAL(within_s[i], bg::within(points[i], geometry, strategy));
+        BOOST_CHECK_EQUAL(covered_by_s[i], bg::covered_by(points[i], geometry, strategy));
+    }
+}
+
+template <typename Geometry>
+void test_geometry(Geometry const& geometry)
+{
+    typedef typename bg::point_type<Geometry>::type point_type;
+
+    std::vector<point_type> const points = test_points<point_type>();
+
+    check_points(points, geometry, bg::strategy::within::cartesian_winding<>());
+    check_points(points, geometry, bg::strategy::within::crossings_multiply<point_type>());
+    check_points(points, geometry, bg::strategy::within::franklin<point_type>());
+    check_points(points, geometry, bg::strategy::within::cartesian_indexed_winding<>(geometry));
+}
+
+template <typename Geometry>
+void test_wkt(std::string const& wkt)
+{
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+    test_geometry(geometry);
+}
+
+// Star-shaped ring with many vertices, also lying on the grid of test points
+template <typename Ring>
+void test_star(std::size_t count)
+{
+    typedef typename bg::point_type<Ring>::type point_type;
+    typedef typename bg::coordinate_type<Ring>::type coordinate_type;
+
+    Ring ring;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double const a = -2.0 * 3.14159265358979 * double(i) / double(count);
+        double const r = i % 7 == 0 ? 2 : i % 2 == 0 ? 5.5 : 4;
+        coordinate_type const x = coordinate_type(std::floor((5 + r * std::cos(a)) * 2) / 2);
+        coordinate_type const y = coordinate_type(std::floor((5 + r * std::sin(a)) * 2) / 2);
+        bg::append(ring, point_type(x, y));
+    }
+    bg::correct(ring);
+    test_geometry(ring);
+}
+
+template <typename P, bool ClockWise, bool Closed>
+void test_all()
+{
+    typedef bg::model::ring<P, ClockWise, Closed> ring;
+    typedef bg::model::polygon<P, ClockWise, Closed> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    std::string const r = ClockWise
+        ? "POLYGON((0 0,0 10,3 7,5 10,10 10,10 0,6 0,5 4,4 0,0 0))"
+        : "POLYGON((0 0,4 0,5 4,6 0,10 0,10 10,5 10,3 7,0 10,0 0))";
+    std::string const p = ClockWise
+        ? "POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,4 2,4 4,2 4,2 2),(5 5,8 5,8 8,5 8,5 5))"
+        : "POLYGON((0 0,10 0,10 10,0 10,0 0),(2 2,2 4,4 4,4 2,2 2),(5 5,5 8,8 8,8 5,5 5))";
+    std::string const mp = ClockWise
+        ? "MULTIPOLYGON(((0 0,0 5,5 5,5 0,0 0),(1 1,4 1,4 4,1 4,1 1)),((5 5,5 10,10 10,10 5,5 5)),((2 2,2 3,3 3,3 2,2 2)))"
+        : "MULTIPOLYGON(((0 0,5 0,5 5,0 5,0 0),(1 1,1 4,4 4,4 1,1 1)),((5 5,10 5,10 10,5 10,5 5)),((2 2,3 2,3 3,2 3,2 2)))";
+
+    test_wkt<ring>(r);
+    test_wkt<ring>("POLYGON((0 0))");
+    test_wkt<polygon>(p);
+    test_wkt<polygon>(r);
+    test_wkt<multi_polygon>(mp);
+    test_wkt<multi_polygon>("MULTIPOLYGON()");
+
+    test_star<ring>(1000);
+}
+
+void test_spherical()
+{
+    typedef bg::model::point<double, 2, bg::cs::spherical_equatorial<bg::degree> > point_type;
+    typedef bg::model::polygon<point_type> polygon;
+
+    polygon poly;
+    bg::read_wkt("POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,4 2,4 4,2 4,2 2))", poly);
+
+    std::vector<point_type> const points = test_points<point_type>();
+    std::vector<bool> within, covered_by;
+    bg::within_each(points, poly, std::back_inserter(within));
+    bg::covered_by_each(points, poly, std::back_inserter(covered_by));
+
+    BOOST_CHECK_EQUAL(within.size(), points.size());
+    for (std::size_t i = 0; i < points.size() && i < within.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(within[i], bg::within(points[i], poly));
+        BOOST_CHECK_EQUAL(covered_by[i], bg::covered_by(points[i], poly));
+    }
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+
+    test_all<point_type, true, true>();
+    test_all<point_type, true, false>();
+    test_all<point_type, false, true>();
+    test_all<point_type, false, false>();
+
+    test_all<bg::model::point<float, 2, bg::cs::cartesian>, true, true>();
+    test_all<bg::model::point<int, 2, bg::cs::cartesian>, true, true>();
+
+    test_spherical();
+
+    return 0;
+}
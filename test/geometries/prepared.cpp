@@ -0,0 +1,224 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/detail/overlay/get_turns.hpp>
+#include <boost/geometry/algorithms/disjoint.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/equals.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/algorithms/relate.hpp>
+#include <boost/geometry/algorithms/relation.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/geometries/prepared.hpp>
+#include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/strategies/relate/cartesian.hpp>
+
+
+template <typename Point, typename Geometry>
+void check_point(Point const& pt, Geometry const& geometry,
+                 bg::prepared<Geometry> const& prepared)
+{
+    BOOST_CHECK_EQUAL(bg::within(pt, prepared), bg::within(pt, geometry));
+    BOOST_CHECK_EQUAL(bg::covered_by(pt, prepared), bg::covered_by(pt, geometry));
+    BOOST_CHECK_EQUAL(bg::intersects(pt, prepared), bg::intersects(pt, geometry));
+    BOOST_CHECK_EQUAL(bg::disjoint(pt, prepared), bg::disjoint(pt, geometry));
+    BOOST_CHECK_EQUAL(bg::relation(pt, prepared).str(), bg::relation(pt, geometry).str());
+    BOOST_CHECK_EQUAL(bg::relate(pt, prepared, bg::de9im::mask("T*F**F***")),
+                      bg::relate(pt, geometry, bg::de9im::mask("T*F**F***")));
+}
+
+// get_turns uses the cached sections and finds the same turns
+template <typename Geometry>
+void test_sections(Geometry const& geometry, bg::prepared<Geometry> const& prepared)
+{
+    typedef typename bg::point_type<Geometry>::type point_type;
+    typedef bg::model::linestring<point_type> linestring;
+    typedef bg::model::polygon<point_type> polygon;
+    typedef typename bg::prepared<Geometry>::sections_type sections_type;
+    typedef bg::detail::overlay::turn_info
+        <
+            point_type, bg::segment_ratio<typename bg::coordinate_type<point_type>::type>
+        > turn_info;
+
+    sections_type expected;
+    bg::sectionalize
+        <
+            bg::prepared<Geometry>::sections_reversed,
+            std::integer_sequence<std::size_t, 0, 1>
+        >(geometry, bg::detail::no_rescale_policy(), expected);
+    BOOST_CHECK_EQUAL(prepared.sections().size(), expected.size());
+
+    bg::strategies::relate::cartesian<> const strategy;
+    typedef bg::detail::get_turns::geometry_sections
+        <
+            bg::prepared<Geometry>::sections_reversed, bg::prepared<Geometry>
+        > geometry_sections;
+    sections_type storage;
+    sections_type const* const none = nullptr;
+    BOOST_CHECK(&geometry_sections::apply(prepared, bg::detail::no_rescale_policy(),
+                    strategy, storage, 1, none) == &prepared.sections());
+
+    // only the sections overlapping the other sections are used
+    BOOST_CHECK(&geometry_sections::apply(prepared, bg::detail::no_rescale_policy(),
+                    strategy, storage, 1, &expected) == &prepared.sections());
+    sections_type other;
+    if (! expected.empty())
+    {
+        other.push_back(expected.front());
+        sections_type const& filtered = geometry_sections::apply(prepared,
+            bg::detail::no_rescale_policy(), strategy, storage, 1, &other);
+        BOOST_CHECK(! filtered.empty());
+        BOOST_CHECK(filtered.size() <= expected.size());
+        BOOST_CHECK(bg::equals(filtered.front().bounding_box, expected.front().bounding_box));
+    }
+    other.clear();
+    BOOST_CHECK(geometry_sections::apply(prepared, bg::detail::no_rescale_policy(),
+                    strategy, storage, 1, &other).empty());
+
+    linestring ls;
+    bg::read_wkt("LINESTRING(-1 1,2 8,11 3,4 1,4 6)", ls);
+    std::vector<turn_info> turns, expected_turns;
+    bg::detail::get_turns::no_interrupt_policy policy;
+    bg::get_turns<false, bg::prepared<Geometry>::sections_reversed,
+                  bg::detail::overlay::assign_null_policy>(ls, prepared,
+        strategy, bg::detail::no_rescale_policy(), turns, policy);
+    bg::get_turns<false, bg::prepared<Geometry>::sections_reversed,
+                  bg::detail::overlay::assign_null_policy>(ls, geometry,
+        strategy, bg::detail::no_rescale_policy(), expected_turns, policy);
+    BOOST_CHECK_EQUAL(turns.size(), expected_turns.size());
+    for (std::size_t i = 0; i < turns.size() && i < expected_turns.size(); ++i)
+    {
+        BOOST_CHECK(bg::equals(turns[i].point, expected_turns[i].point));
+        BOOST_CHECK(turns[i].operations[1].seg_id == expected_turns[i].operations[1].seg_id);
+    }
+
+    // repeated predicates of linear and areal geometries
+    std::string const linestrings[] = {
+        "LINESTRING(1 1,1 9,9 9)", "LINESTRING(2 1,4 2)", "LINESTRING(0 0,0 10)",
+        "LINESTRING(5 5,11 5)", "LINESTRING(3 3,3 4)", "LINESTRING(3 3,6 6)" };
+    for (std::string const& wkt : linestrings)
+    {
+        bg::read_wkt(wkt, ls);
+        BOOST_CHECK_MESSAGE(bg::within(ls, prepared) == bg::within(ls, geometry), wkt);
+        BOOST_CHECK_MESSAGE(bg::disjoint(ls, prepared) == bg::disjoint(ls, geometry), wkt);
+        BOOST_CHECK_MESSAGE(bg::relation(ls, prepared).str() == bg::relation(ls, geometry).str(), wkt);
+    }
+    std::string const polygons[] = {
+        "POLYGON((5 5,5 8,8 8,8 5,5 5))", "POLYGON((1 1,1 3,3 3,3 1,1 1))",
+        "POLYGON((0 0,0 10,10 10,10 0,0 0))", "POLYGON((3 3,3 4,4 4,4 3,3 3))",
+        "POLYGON((5 5,5 12,12 12,12 5,5 5))", "POLYGON((20 20,20 21,21 21,21 20,20 20))" };
+    for (std::string const& wkt : polygons)
+    {
+        polygon poly;
+        bg::read_wkt(wkt, poly);
+        bg::correct(poly);
+        BOOST_CHECK_MESSAGE(bg::within(poly, prepared) == bg::within(poly, geometry), wkt);
+        BOOST_CHECK_MESSAGE(bg::covered_by(poly, prepared) == bg::covered_by(poly, geometry), wkt);
+        BOOST_CHECK_MESSAGE(bg::disjoint(poly, prepared) == bg::disjoint(poly, geometry), wkt);
+        BOOST_CHECK_MESSAGE(bg::relation(poly, prepared).str() == bg::relation(poly, geometry).str(), wkt);
+    }
+}
+
+template <typename Geometry>
+void test_geometry(std::string const& wkt)
+{
+    typedef typename bg::point_type<Geometry>::type point_type;
+    typedef bg::model::box<point_type> box_type;
+
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+
+    bg::prepared<Geometry> const prepared(geometry);
+
+    box_type expected_box, box;
+    bg::envelope(geometry, expected_box);
+    bg::envelope(prepared, box);
+    BOOST_CHECK(bg::equals(box, expected_box));
+
+    // points inside, outside, on the edges and equal to the vertices
+    for (int x = -2; x <= 24; ++x)
+    {
+        for (int y = -2; y <= 24; ++y)
+        {
+            check_point(point_type(x * 0.5, y * 0.5), geometry, prepared);
+        }
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        check_point(point_type(i * 0.113, 10 - i * 0.071), geometry, prepared);
+    }
+
+    // non-pointlike geometries
+    bg::model::linestring<point_type> ls;
+    bg::read_wkt("LINESTRING(1 1,2 8,11 3)", ls);
+    BOOST_CHECK_EQUAL(bg::intersects(ls, prepared), bg::intersects(ls, geometry));
+    BOOST_CHECK_EQUAL(bg::within(ls, prepared), bg::within(ls, geometry));
+    BOOST_CHECK_EQUAL(bg::relation(ls, prepared).str(), bg::relation(ls, geometry).str());
+
+    bg::model::polygon<point_type> poly;
+    bg::read_wkt("POLYGON((2 2,2 3,3 3,3 2,2 2))", poly);
+    BOOST_CHECK_EQUAL(bg::within(poly, prepared), bg::within(poly, geometry));
+    BOOST_CHECK_EQUAL(bg::covered_by(poly, prepared), bg::covered_by(poly, geometry));
+    BOOST_CHECK_EQUAL(bg::disjoint(poly, prepared), bg::disjoint(poly, geometry));
+    BOOST_CHECK_EQUAL(bg::relation(poly, prepared).str(), bg::relation(poly, geometry).str());
+
+    bg::model::multi_point<point_type> mpt;
+    bg::read_wkt("MULTIPOINT(1 1,5 5,11 11,0 0)", mpt);
+    BOOST_CHECK_EQUAL(bg::within(mpt, prepared), bg::within(mpt, geometry));
+    BOOST_CHECK_EQUAL(bg::intersects(mpt, prepared), bg::intersects(mpt, geometry));
+
+    test_sections(geometry, prepared);
+}
+
+template <typename P, bool ClockWise, bool Closed>
+void test_all()
+{
+    typedef bg::model::ring<P, ClockWise, Closed> ring;
+    typedef bg::model::polygon<P, ClockWise, Closed> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    std::string const r = ClockWise
+        ? "POLYGON((0 0,0 10,3 7,5 10,10 10,10 0,6 0,5 4,4 0,0 0))"
+        : "POLYGON((0 0,4 0,5 4,6 0,10 0,10 10,5 10,3 7,0 10,0 0))";
+    std::string const p = ClockWise
+        ? "POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,4 2,4 4,2 4,2 2),(5 5,8 5,8 8,5 8,5 5))"
+        : "POLYGON((0 0,10 0,10 10,0 10,0 0),(2 2,2 4,4 4,4 2,2 2),(5 5,5 8,8 8,8 5,5 5))";
+    std::string const mp = ClockWise
+        ? "MULTIPOLYGON(((0 0,0 5,5 5,5 0,0 0),(1 1,4 1,4 4,1 4,1 1)),((5 5,5 10,10 10,10 5,5 5)),((2 2,2 3,3 3,3 2,2 2)))"
+        : "MULTIPOLYGON(((0 0,5 0,5 5,0 5,0 0),(1 1,1 4,4 4,4 1,1 1)),((5 5,10 5,10 10,5 10,5 5)),((2 2,3 2,3 3,2 3,2 2)))";
+
+    test_geometry<ring>(r);
+    test_geometry<ring>("POLYGON((0 0))");
+    test_geometry<polygon>(p);
+    test_geometry<polygon>(r);
+    test_geometry<multi_polygon>(mp);
+    test_geometry<multi_polygon>("MULTIPOLYGON()");
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+
+    test_all<point_type, true, true>();
+    test_all<point_type, true, false>();
+    test_all<point_type, false, true>();
+    test_all<point_type, false, false>();
+
+    test_all<bg::model::point<int, 2, bg::cs::cartesian>, true, true>();
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Robustness Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the times of the sequential and the parallel get_turns
+// and checks that both generate the same turns in the same order.
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/algorithms/detail/overlay/get_turns.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/policies/robustness/get_rescale_policy.hpp>
+#include <boost/geometry/util/thread_executor.hpp>
+
+namespace bg = boost::geometry;
+
+using point_type = bg::model::d2::point_xy<double>;
+using polygon_type = bg::model::polygon<point_type>;
+using multi_polygon_type = bg::model::multi_polygon<polygon_type>;
+
+polygon_type star(std::size_t count, double cx, double cy, double phase)
+{
+    polygon_type result;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double const a = phase + 2.0 * 3.14159265358979 * double(i) / double(count);
+        double const r = i % 2 == 0 ? 10.0 : 7.0 + (i % 5) * 0.3;
+        bg::append(result.outer(), point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+    }
+    bg::append(result.outer(), bg::range::front(result.outer()));
+    bg::correct(result);
+    return result;
+}
+
+template <typename Turns>
+bool same_turns(Turns const& turns1, Turns const& turns2)
+{
+    if (turns1.size() != turns2.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < turns1.size(); ++i)
+    {
+        auto const& t1 = turns1[i];
+        auto const& t2 = turns2[i];
+        if (! bg::equals(t1.point, t2.point)
+            || t1.method != t2.method
+            || ! (t1.operations[0].seg_id == t2.operations[0].seg_id)
+            || ! (t1.operations[1].seg_id == t2.operations[1].seg_id))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Geometry1, typename Geometry2>
+void test_get_turns(std::string const& caseid,
+                    Geometry1 const& g1, Geometry2 const& g2,
+                    std::size_t threads, int repeat = 3)
+{
+    using strategy_type = typename bg::strategies::relate::services::default_strategy
+        <
+            Geometry1, Geometry2
+        >::type;
+    using turn_info = bg::detail::overlay::turn_info
+        <
+            point_type, bg::segment_ratio<double>
+        >;
+
+    strategy_type strategy;
+    bg::detail::no_rescale_policy rescale_policy;
+    bg::detail::get_turns::no_interrupt_policy policy;
+
+    std::vector<turn_info> turns_seq, turns_par;
+
+    // The minimal time of the repeated calls
+    auto measure = [&](std::vector<turn_info>& turns, auto const& call)
+    {
+        double best = 0;
+        for (int i = 0; i < repeat; ++i)
+        {
+            turns.clear();
+            auto const start = std::chrono::steady_clock::now();
+            call(turns);
+            auto const finish = std::chrono::steady_clock::now();
+            double const elapsed
+                = std::chrono::duration<double, std::milli>(finish - start).count();
+            if (i == 0 || elapsed < best)
+            {
+                best = elapsed;
+            }
+        }
+        return best;
+    };
+
+    double const time_seq = measure(turns_seq, [&](std::vector<turn_info>& turns)
+    {
+        bg::get_turns<false, false, bg::detail::overlay::assign_null_policy>(g1, g2,
+            strategy, rescale_policy, turns, policy);
+    });
+    double const time_par = measure(turns_par, [&](std::vector<turn_info>& turns)
+    {
+        bg::get_turns<false, false, bg::detail::overlay::assign_null_policy>(g1, g2,
+            strategy, rescale_policy, turns, policy, bg::util::thread_executor(threads));
+    });
+
+    std::cout << std::setw(16) << std::left << caseid
+              << " turns: " << std::setw(8) << turns_seq.size()
+              << " sequential: " << std::setprecision(4) << std::setw(8) << time_seq
+              << " ms, " << threads << " threads: " << std::setw(8) << time_par
+              << " ms" << std::endl;
+
+    if (! same_turns(turns_seq, turns_par))
+    {
+        std::cerr << "ERROR: " << caseid << " turns are different" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t const threads = argc > 1 ? std::stoul(argv[1]) : 4;
+
+    test_get_turns("star_2000", star(2000, 0, 0, 0), star(2000, 2, 1, 0.001), threads);
+    test_get_turns("star_20000", star(20000, 0, 0, 0), star(20000, 2, 1, 0.0001), threads);
+
+    multi_polygon_type stars1, stars2;
+    for (int i = 0; i < 100; ++i)
+    {
+        for (int j = 0; j < 100; ++j)
+        {
+            stars1.push_back(star(40, i * 25.0, j * 25.0, 0));
+            stars2.push_back(star(40, i * 25.0 + 4, j * 25.0 + 3, 0.002));
+        }
+    }
+    test_get_turns("stars_100x100", stars1, stars2, threads);
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2023 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/geometries/prepared.hpp>
+#include <boost/geometry/io/wkt/wkt.hpp>
+#include <boost/geometry/strategies/cartesian/point_in_poly_indexed_winding.hpp>
+
+
+template <typename Point, typename Geometry, typename Strategy>
+void check_point(Point const& pt, Geometry const& geometry, Strategy const& strategy,
+                 bg::prepared<Geometry> const& prepared)
+{
+    BOOST_CHECK_EQUAL(bg::within(pt, geometry, strategy), bg::within(pt, geometry));
+    BOOST_CHECK_EQUAL(bg::covered_by(pt, geometry, strategy), bg::covered_by(pt, geometry));
+    // The prepared geometry uses its own index of the rings
+    BOOST_CHECK_EQUAL(bg::within(pt, prepared, strategy), bg::within(pt, geometry));
+    BOOST_CHECK_EQUAL(bg::covered_by(pt, prepared, strategy), bg::covered_by(pt, geometry));
+}
+
+template <typename Geometry>
+void test_geometry(Geometry const& geometry, std::size_t segments_per_slab = 4)
+{
+    typedef typename bg::point_type<Geometry>::type point_type;
+
+    bg::strategy::within::cartesian_indexed_winding<> const s(geometry, segments_per_slab);
+    bg::prepared<Geometry> const prepared(geometry);
+
+    // points inside, outside, on the edges and equal to the vertices
+    for (int x = -2; x <= 24; ++x)
+    {
+        for (int y = -2; y <= 24; ++y)
+        {
+            check_point(point_type(x * 0.5, y * 0.5), geometry, s, prepared);
+        }
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        check_point(point_type(i * 0.113, 10 - i * 0.071), geometry, s, prepared);
+    }
+}
+
+template <typename Geometry>
+void test_wkt(std::string const& wkt)
+{
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+    test_geometry(geometry);
+    test_geometry(geometry, 1);
+    test_geometry(geometry, 1000);
+}
+
+// Star-shaped ring with many vertices, also lying on the grid of test points
+template <typename Ring>
+void test_star(std::size_t count)
+{
+    typedef typename bg::point_type<Ring>::type point_type;
+    typedef typename bg::coordinate_type<Ring>::type coordinate_type;
+
+    Ring ring;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double const a = -2.0 * 3.14159265358979 * double(i) / double(count);
+        double const r = i % 7 == 0 ? 2 : i % 2 == 0 ? 5.5 : 4;
+        coordinate_type const x = coordinate_type(std::floor((5 + r * std::cos(a)) * 2) / 2);
+        coordinate_type const y = coordinate_type(std::floor((5 + r * std::sin(a)) * 2) / 2);
+        bg::append(ring, point_type(x, y));
+    }
+    bg::correct(ring);
+    test_geometry(ring);
+}
+
+template <typename P, bool ClockWise, bool Closed>
+void test_all()
+{
+    typedef bg::model::ring<P, ClockWise, Closed> ring;
+    typedef bg::model::polygon<P, ClockWise, Closed> polygon;
+    typedef bg::model::multi_polygon<polygon> multi_polygon;
+
+    std::string const r = ClockWise
+        ? "POLYGON((0 0,0 10,3 7,5 10,10 10,10 0,6 0,5 4,4 0,0 0))"
+        : "POLYGON((0 0,4 0,5 4,6 0,10 0,10 10,5 10,3 7,0 10,0 0))";
+    std::string const p = ClockWise
+        ? "POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,4 2,4 4,2 4,2 2),(5 5,8 5,8 8,5 8,5 5))"
+        : "POLYGON((0 0,10 0,10 10,0 10,0 0),(2 2,2 4,4 4,4 2,2 2),(5 5,5 8,8 8,8 5,5 5))";
+    std::string const mp = ClockWise
+        ? "MULTIPOLYGON(((0 0,0 5,5 5,5 0,0 0),(1 1,4 1,4 4,1 4,1 1)),((5 5,5 10,10 10,10 5,5 5)),((2 2,2 3,3 3,3 2,2 2)))"
+        : "MULTIPOLYGON(((0 0,5 0,5 5,0 5,0 0),(1 1,1 4,4 4,4 1,1 1)),((5 5,10 5,10 10,5 10,5 5)),((2 2,3 2,3 3,2 3,2 2)))";
+
+    test_wkt<ring>(r);
+    test_wkt<ring>("POLYGON((0 0))");
+    test_wkt<ring>("POLYGON((5 0,5 10,5 0))");
+    test_wkt<polygon>(p);
+    test_wkt<polygon>(r);
+    test_wkt<multi_polygon>(mp);
+    test_wkt<multi_polygon>("MULTIPOLYGON()");
+
+    test_star<ring>(1000);
+}
+
+template <typename P>
+void test_other_geometries()
+{
+    typedef bg::model::linestring<P> linestring;
+    typedef bg::model::polygon<P> polygon;
+    typedef bg::model::multi_point<P> multi_point;
+
+    polygon poly;
+    bg::read_wkt("POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,4 2,4 4,2 4,2 2))", poly);
+    bg::strategy::within::cartesian_indexed_winding<> const s(poly);
+
+    std::string const linestrings[] = {
+        "LINESTRING(1 1,1 9,9 9)", "LINESTRING(1 1,5 5)", "LINESTRING(0 0,0 10)",
+        "LINESTRING(5 5,11 5)", "LINESTRING(2.5 2.5,3.5 3.5)" };
+    for (std::string const& wkt : linestrings)
+    {
+        linestring ls;
+        bg::read_wkt(wkt, ls);
+        BOOST_CHECK_MESSAGE(bg::within(ls, poly, s) == bg::within(ls, poly), wkt);
+        BOOST_CHECK_MESSAGE(bg::covered_by(ls, poly, s) == bg::covered_by(ls, poly), wkt);
+    }
+
+    // The rings of the second polygon are not indexed and are checked
+    // segment by segment
+    std::string const polygons[] = {
+        "POLYGON((5 5,5 8,8 8,8 5,5 5))", "POLYGON((1 1,1 3,3 3,3 1,1 1))",
+        "POLYGON((0 0,0 10,10 10,10 0,0 0))", "POLYGON((2.5 2.5,2.5 3.5,3.5 3.5,3.5 2.5,2.5 2.5))",
+        "POLYGON((5 5,5 12,12 12,12 5,5 5))" };
+    for (std::string const& wkt : polygons)
+    {
+        polygon other;
+        bg::read_wkt(wkt, other);
+        BOOST_CHECK_MESSAGE(bg::within(other, poly, s) == bg::within(other, poly), wkt);
+        BOOST_CHECK_MESSAGE(bg::covered_by(other, poly, s) == bg::covered_by(other, poly), wkt);
+        for (int x = 0; x <= 24; ++x)
+        {
+            for (int y = 0; y <= 24; ++y)
+            {
+                P const pt(x * 0.5, y * 0.5);
+                BOOST_CHECK_EQUAL(bg::within(pt, other, s), bg::within(pt, other));
+                BOOST_CHECK_EQUAL(bg::covered_by(pt, other, s), bg::covered_by(pt, other));
+            }
+        }
+    }
+
+    multi_point mpt;
+    bg::read_wkt("MULTIPOINT(1 1,5 5,3 3)", mpt);
+    BOOST_CHECK_EQUAL(bg::within(mpt, poly, s), bg::within(mpt, poly));
+    bg::read_wkt("MULTIPOINT(1 1,5 5,9 9)", mpt);
+    BOOST_CHECK_EQUAL(bg::within(mpt, poly, s), bg::within(mpt, poly));
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+
+    test_all<point_type, true, true>();
+    test_all<point_type, true, false>();
+    test_all<point_type, false, true>();
+    test_all<point_type, false, false>();
+
+    test_all<bg::model::point<float, 2, bg::cs::cartesian>, true, true>();
+    test_all<bg::model::point<int, 2, bg::cs::cartesian>, true, true>();
+
+    test_other_geometries<point_type>();
+
+    return 0;
+}